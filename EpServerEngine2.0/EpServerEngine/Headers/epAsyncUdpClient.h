@@ -141,6 +141,13 @@ namespace epse{
 		*/
 		virtual void execute();
 
+		/*!
+		Deliver the packet received to the callback object
+		@param[in] passPacket the packet received
+		@remark the reference of passPacket is released.
+		*/
+		void deliverPacket(Packet *passPacket);
+
 		/*!
 		Actually Disconnect from the server
 		*/
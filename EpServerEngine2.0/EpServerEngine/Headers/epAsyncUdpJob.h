@@ -0,0 +1,106 @@
+/*! 
+@file epAsyncUdpJob.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Asynchronous UDP Job Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Asynchronous UDP Job.
+
+*/
+#ifndef __EP_ASYNC_UDP_JOB_H__
+#define __EP_ASYNC_UDP_JOB_H__
+
+#include "epServerEngine.h"
+
+namespace epse{
+
+	class AsyncUdpSocket;
+
+	/*! 
+	@class AsyncUdpJob epAsyncUdpJob.h
+	@brief A class for Asynchronous UDP Job.
+
+	The job dispatches the datagrams queued in the socket on the worker thread.
+	Only one job is pushed for a socket at a time, so the datagrams from the
+	same client are processed in order.
+	*/
+	class EP_SERVER_ENGINE AsyncUdpJob:public BaseJob{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Job
+		@param[in] socket the socket to dispatch the datagrams
+		@param[in] priority the priority of the job
+		@param[in] lockPolicyType The lock policy
+		*/
+		AsyncUdpJob(AsyncUdpSocket *socket,Priority priority=PRIORITY_NORMAL,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Job
+		*/
+		virtual ~AsyncUdpJob();
+
+		/*!
+		Return the socket set for this object
+		@return the pointer to the socket
+		*/
+		AsyncUdpSocket *GetSocket();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Job
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		AsyncUdpJob(const AsyncUdpJob& b):BaseJob(b)
+		{}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		AsyncUdpJob & operator=(const AsyncUdpJob&b){return *this;}
+
+	private:
+		/// pointer to the socket
+		AsyncUdpSocket *m_socket;
+	};
+}
+
+#endif //__EP_ASYNC_UDP_JOB_H__
\ No newline at end of file
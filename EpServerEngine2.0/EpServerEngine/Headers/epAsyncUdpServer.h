@@ -41,12 +41,16 @@ An Interface for Asynchronous UDP Server.
 
 #include "epServerEngine.h"
 #include "epBaseUdpServer.h"
+#include "epJobScheduler.h"
 
 namespace epse{
 
 	/*! 
 	@class AsyncUdpServer epAsyncUdpServer.h
 	@brief A class for Asynchronous UDP Server.
+
+	The datagrams of all the clients are dispatched on a fixed number of
+	worker threads, in order for each client and in parallel across clients.
 	*/
 	class EP_SERVER_ENGINE AsyncUdpServer:public BaseUdpServer{
 		friend class AsyncUdpSocket;
@@ -101,6 +105,11 @@ namespace epse{
 		@remark if argument is NULL then previously setting value is used
 		*/
 		bool StartServer(const ServerOps &ops=ServerOps::defaultServerOps);
+
+		/*!
+		Stop the server
+		*/
+		virtual void StopServer();
 	
 	private:
 	
@@ -108,9 +117,28 @@ namespace epse{
 		Listening Loop Function
 		*/
 		virtual void execute();
+
+		/*!
+		Deliver the datagram received to the socket of the sender, or accept the sender as new socket
+		@param[in] clientSockAddr the address of the sender
+		@param[in] slot the slot the datagram is received into, or NULL if received into the heap buffer
+		@param[in] packetData the datagram received
+		@param[in] recvLength the byte size of the datagram, or less than or equal to 0 if the receive failed
+		*/
+		void processDatagram(const sockaddr &clientSockAddr,PacketSlot *slot,const char *packetData,int recvLength);
+
+		/*!
+		Add new job to the worker thread.
+		@param[in] job the job to push to the worker thread.
+		*/
+		void pushJob(BaseJob * job);
+
 	
 		/// Flag for Asynchronous Receive
 		bool m_isAsynchronousReceive;
+
+		/// Work-stealing scheduler of the worker threads
+		JobScheduler m_jobScheduler;
 	
 	};
 }
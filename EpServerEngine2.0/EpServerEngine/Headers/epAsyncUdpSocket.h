@@ -47,6 +47,9 @@ namespace epse
 	/*! 
 	@class AsyncUdpSocket epAsyncUdpSocket.h
 	@brief A class for Asynchronous UDP Socket.
+
+	The socket has no thread of its own. The datagrams received are queued,
+	and dispatched in order on the worker threads of the server.
 	*/
 	class EP_SERVER_ENGINE AsyncUdpSocket:public BaseUdpSocket
 	{
@@ -72,6 +75,12 @@ namespace epse
 		virtual ~AsyncUdpSocket();
 		
 			
+		/*!
+		Check if the connection is alive
+		@return true if the connection is alive otherwise false
+		*/
+		bool IsConnectionAlive() const;
+
 		/*!
 		Kill the connection
 		*/
@@ -82,6 +91,7 @@ namespace epse
 		Set the Maximum Processor Count for the Socket.
 		@param[in] maxProcessorCount The Maximum Processor Count to set.
 		@remark 0 means there is no limit
+		@remark the datagrams are dispatched on the worker threads of the server, so it is kept only for the compatibility.
 		*/
 		void SetMaximumProcessorCount(unsigned int maxProcessorCount);
 
@@ -101,6 +111,7 @@ namespace epse
 		/*!
 		Set the asynchronous receive flag for the Socket.
 		@param[in] isASynchronousReceive The flag whether to receive asynchronously.
+		@remark if false, the datagrams are dispatched on the listening thread of the server instead of the worker threads.
 		*/
 		void SetIsAsynchronousReceive(bool isASynchronousReceive);
 
@@ -112,6 +123,7 @@ namespace epse
 
 	private:	
 		friend class BaseServerUDP;
+		friend class AsyncUdpProcessor;
 
 		/*!
 		Actually Kill the connection
@@ -121,6 +133,7 @@ namespace epse
 		
 		/*!
 		thread loop function
+		@remark the socket is not started as a thread, but it dispatches the datagrams queued if called.
 		*/
 		virtual void execute();
 				
@@ -130,6 +143,24 @@ namespace epse
 		*/
 		virtual void addPacket(Packet *packet);
 
+		/*!
+		Push the job to dispatch the datagrams queued to the worker thread of the server
+		*/
+		void scheduleDispatch();
+
+		/*!
+		Dispatch the datagrams queued in order up to UDP_PEER_DISPATCH_BATCH_COUNT
+		@remark if more datagrams are left, the job is pushed again to let the other sockets run.
+		*/
+		void dispatchPackets();
+
+		/*!
+		Dispatch the given datagram to the callback object
+		@param[in] packet the datagram to dispatch
+		@return true if the connection is still alive otherwise false
+		*/
+		bool processPacket(Packet *packet);
+
 	private:
 		/*!
 		Default Copy Constructor
@@ -149,12 +180,15 @@ namespace epse
 		AsyncUdpSocket & operator=(const AsyncUdpSocket&b){return *this;}
 	private:
 
-		/// Thread Stop Event
-		/// @remark if this is raised, the thread should quickly stop.
-		epl::EventEx m_threadStopEvent;
+		/// Connection status
+		bool m_isConnected;
+
+		/// Flag whether the job to dispatch the datagrams is pushed
+		/// @remark protected by m_listLock.
+		bool m_isScheduled;
 
-		/// processor thread list
-		ServerObjectList m_processorList;
+		/// Flag whether OnNewConnection is called
+		bool m_isNewConnectionNotified;
 
 		/// Maximum Processor Count
 		unsigned int m_maxProcessorCount;
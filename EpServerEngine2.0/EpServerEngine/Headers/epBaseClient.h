@@ -48,6 +48,8 @@ An Interface for Base Client.
 #include "epBaseServerObject.h"
 #include "epServerConf.h"
 #include "epClientInterfaces.h"
+#include "epMessageDispatcher.h"
+#include "epCompressor.h"
 
 #include <windows.h>
 #include <winsock2.h>
@@ -174,13 +176,21 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL)=0;
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false)=0;
+
+		/*!
+		Get the statistics of the compression
+		@return the statistics of the compression
+		*/
+		Compressor::Statistics GetCompressionStatistics() const;
 	
 
 	protected:
+		friend class IocpClientProcessor;
 
 		/*!
 		Actually set the hostname for the server.
@@ -212,6 +222,14 @@ namespace epse{
 		*/
 		void resetClient();
 
+		/*!
+		Dispatch the packet received to the handler registered for its message type.
+		@param[in] packet the packet received
+		@return true if dispatched otherwise false
+		@remark the caller must deliver the packet to OnReceived if false is returned.
+		*/
+		bool dispatchReceived(const Packet *packet);
+
 
 	protected:
 		/// port
@@ -232,6 +250,12 @@ namespace epse{
 		/// Callback Object
 		ClientCallbackInterface *m_callBackObj;
 
+		/// Message Dispatcher
+		ClientMessageDispatcher *m_messageDispatcher;
+
+		/// Compressor
+		Compressor m_compressor;
+
 		/// connection socket
 		SOCKET m_connectSocket;
 	};
@@ -48,6 +48,7 @@ An Interface for Base Server.
 #include "epBaseServerObject.h"
 #include "epServerInterfaces.h"
 #include "epServerObjectList.h"
+#include "epCompressor.h"
 
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -176,6 +177,12 @@ namespace epse{
 		*/
 		void ShutdownAllClient();
 
+		/*!
+		Get the statistics of the compression
+		@return the statistics of the compression
+		*/
+		Compressor::Statistics GetCompressionStatistics() const;
+
 	protected:
 		/*!
 		Actually set the port for the server.
@@ -241,6 +248,12 @@ namespace epse{
 	
 		/// Callback Object
 		ServerCallbackInterface *m_callBackObj;
+
+		/// Message Dispatcher
+		ServerMessageDispatcher *m_messageDispatcher;
+
+		/// Compressor
+		Compressor m_compressor;
 	};
 }
 #endif //__EP_BASE_SERVER_H__
\ No newline at end of file
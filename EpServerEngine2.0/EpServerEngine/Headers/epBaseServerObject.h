@@ -40,6 +40,7 @@ An Interface for Base Server Object.
 
 #include "epServerEngine.h"
 #include "epServerConf.h"
+#include <winsock2.h>
 
 namespace epse{
 
@@ -92,6 +93,13 @@ namespace epse{
 		@return the current time for waiting in millisecond
 		*/
 		virtual unsigned int GetWaitTime() const;
+
+		/*!
+		Get the id of this object given by the container
+		@return the id of this object
+		@remark OBJECT_ID_NONE is returned if this object has never been pushed into a container.
+		*/
+		unsigned int GetObjectId() const;
 		
 
 
@@ -112,6 +120,21 @@ namespace epse{
 		@return true if successfully removed otherwise false
 		*/
 		bool removeSelfFromContainer();
+
+		/*!
+		Get the address to index this object by in the container
+		@param[out] retSockAddr the address of this object
+		@return true if this object has the address otherwise false
+		*/
+		virtual bool getIndexAddress(sockaddr &retSockAddr) const;
+
+		/*!
+		Called when the thread terminated.
+		@param[in] exitCode the exit code of the thread
+		@param[in] isInDeletion the flag whether the thread class is in deletion or not
+		@remark returns the buffers cached by the thread exiting to the Buffer Pool.
+		*/
+		virtual void onTerminated(unsigned long exitCode,bool isInDeletion=false);
 	protected:
 
 		/// Lock Policy
@@ -124,6 +147,9 @@ namespace epse{
 
 		/// container lock
 		epl::BaseLock *m_containerLock;
+
+		/// Object id given by the container
+		unsigned int m_objectId;
 	};
 }
 
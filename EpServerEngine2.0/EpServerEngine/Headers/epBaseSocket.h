@@ -43,6 +43,9 @@ An Interface for Base Socket.
 #include "epServerPacketProcessor.h"
 #include "epServerConf.h"
 #include "epServerObjectList.h"
+#include "epTimer.h"
+#include "epSocketPool.h"
+#include "epMessageDispatcher.h"
 
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -59,12 +62,13 @@ An Interface for Base Socket.
 
 namespace epse
 {
+	class IocpServerJob;
 
 	/*! 
 	@class BaseSocket epBaseSocket.h
 	@brief A class for Base Socket.
 	*/
-	class EP_SERVER_ENGINE BaseSocket:public BaseServerObject,public SocketInterface
+	class EP_SERVER_ENGINE BaseSocket:public BaseServerObject,public SocketInterface,public TimerCallbackInterface
 	{
 	public:
 		/*!
@@ -89,10 +93,11 @@ namespace epse
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL)=0;
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false)=0;
 
 		
 		/*!
@@ -157,9 +162,30 @@ namespace epse
 		*/
 		ServerCallbackInterface *GetCallbackObject();
 
+		/*!
+		Get the idle timeout for the Socket.
+		@return the time in millisecond to disconnect the socket receiving nothing.
+		*/
+		virtual unsigned int GetIdleTimeout() const;
+
+		/*!
+		Set the idle timeout for the Socket.
+		@param[in] milliSec the time in millisecond to disconnect the socket receiving nothing. (IDLE_TIMEOUT_INFINITE to disable)
+		@remark ignored if the socket is not driven by an Event Loop.
+		*/
+		virtual void SetIdleTimeout(unsigned int milliSec);
+
+		/*!
+		Called when the idle timer is expired.
+		@param[in] timer the expired timer
+		*/
+		virtual void OnTimer(Timer *timer);
+
 
 	protected:	
 		friend class IocpServerProcessor;
+		friend class IocpServerJob;
+		friend class SocketPool;
 	
 		/*!
 		Actually Kill the connection
@@ -172,6 +198,22 @@ namespace epse
 		*/
 		virtual void killConnectionNoCallBack(){}
 
+		/*!
+		Submit the overlapped operation for the given job
+		@param[in] job the send or receive job to submit
+		@remark IOCP Use ONLY!
+		*/
+		virtual void submitJob(IocpServerJob *job){}
+
+		/*!
+		Handle the completion of the overlapped operation for the given job
+		@param[in] job the job whose operation is completed
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		@remark IOCP Use ONLY!
+		*/
+		virtual void completeJob(IocpServerJob *job,unsigned int transferredByte,bool isSucceeded){}
+
 		/*!
 		thread loop function
 		*/
@@ -183,12 +225,72 @@ namespace epse
 		*/
 		virtual void setOwner(BaseServerObject * owner );
 
+		/*!
+		Set the Message Dispatcher for the packets received.
+		@param[in] messageDispatcher The Message Dispatcher (NULL to deliver every packet to OnReceived)
+		*/
+		void setMessageDispatcher(ServerMessageDispatcher *messageDispatcher);
+
+		/*!
+		Dispatch the packet received to the handler registered for its message type.
+		@param[in] packet the packet received
+		@return true if dispatched otherwise false
+		@remark the caller must deliver the packet to OnReceived if false is returned.
+		*/
+		bool dispatchReceived(const Packet *packet);
+
 		/*!
 		Set the Sock Address for this socket.
 		@param[in] sockAddr The Sock Address for this socket.
 		*/
 		virtual void setSockAddr(sockaddr sockAddr);
 
+		/*!
+		Get the address to index this socket by in the container
+		@param[out] retSockAddr the Sock Address of this socket
+		@return true
+		*/
+		virtual bool getIndexAddress(sockaddr &retSockAddr) const;
+
+		/*!
+		Set the Event Loop to drive the idle timer of this socket.
+		@param[in] eventLoop The Event Loop for the idle timer.
+		*/
+		void setTimerEventLoop(EventLoop *eventLoop);
+
+		/*!
+		Update the last time the data is received with the cached time of the Event Loop.
+		*/
+		void updateLastActiveTime();
+
+		/*!
+		Cancel the idle timer of this socket.
+		*/
+		void cancelIdleTimer();
+
+		/*!
+		Set the pool to recycle this socket after disconnected.
+		@param[in] socketPool The pool to recycle this socket.
+		*/
+		void setSocketPool(SocketPool *socketPool);
+
+		/*!
+		Retire this socket to the pool after disconnected.
+		*/
+		void retireToPool();
+
+		/*!
+		Check if this socket can be recycled.
+		@return true if this socket is disconnected and no longer referenced except by the pool otherwise false
+		*/
+		virtual bool isRecyclable();
+
+		/*!
+		Reset the state of the previous connection to recycle this socket.
+		@remark Subclasses must call the reset of the parent class.
+		*/
+		virtual void resetConnection();
+
 
 	protected:
 		/*!
@@ -225,6 +327,21 @@ namespace epse
 
 		///Sock Address
 		sockaddr m_sockAddr;
+
+		/// Event Loop driving the idle timer
+		EventLoop *m_timerEventLoop;
+		/// Idle timer
+		Timer *m_idleTimer;
+		/// Idle timeout in millisecond
+		unsigned int m_idleTimeout;
+		/// Last time the data is received
+		volatile unsigned int m_lastActiveTime;
+
+		/// Pool to recycle this socket
+		SocketPool *m_socketPool;
+
+		/// Message Dispatcher
+		ServerMessageDispatcher *m_messageDispatcher;
 	};
 
 }
@@ -40,6 +40,8 @@ An Interface for Base TCP Client.
 
 #include "epServerEngine.h"
 #include "epBaseClient.h"
+#include "epReceiveBuffer.h"
+#include "epSendBuffer.h"
 
 namespace epse{
 
@@ -98,10 +100,24 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
+
+		/*!
+		Get the send coalescing flag for the Client.
+		@return The flag whether to coalesce the packets sent concurrently.
+		*/
+		virtual bool GetIsSendCoalescing() const;
+
+		/*!
+		Set the send coalescing flag for the Client.
+		@param[in] isSendCoalescing The flag whether to coalesce the packets sent concurrently.
+		@remark the packets sent while another Send is writing are written together in a single write.
+		*/
+		virtual void SetIsSendCoalescing(bool isSendCoalescing);
 
 	protected:
 
@@ -109,10 +125,26 @@ namespace epse{
 
 		/*!
 		Receive the packet from the server
-		@param[out] packet the packet received
-		@return received byte size
+		@param[out] retPacket the packet received
+		@return received byte size including the size field, 0 if the connection is closed, or negative if error occurred
+		@remark as much data as available is read at once, and the rest of the packets are kept in the receive buffer.
+		@remark the caller must call ReleaseObj() for retPacket to avoid the memory leak.
+		*/
+		int receive(Packet *&retPacket);
+
+		/*!
+		Pop the first packet from the receive buffer, delivering the chunks in front to the callback object
+		@return the packet popped, or NULL if no complete packet is in the receive buffer
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
 		*/
-		int receive(Packet &packet);
+		Packet *popPacket();
+
+		/*!
+		Set the limits of the packets to receive from the server.
+		@param[in] maxFrameByteSize the maximum byte size of the packet
+		@param[in] chunkByteSize the byte size of the chunks to deliver the larger packet in
+		*/
+		void setReceiveLimit(unsigned int maxFrameByteSize,unsigned int chunkByteSize);
 
 		/*!
 		Actually processing the client thread
@@ -127,8 +159,16 @@ namespace epse{
 
 	protected:
 
-		/// Temp Packet;
-		Packet m_recvSizePacket;
+		/// Frame Codec of the connection
+		FrameCodec m_frameCodec;
+
+		/// Receive Buffer
+		ReceiveBuffer m_recvBuffer;
+
+		/// Packets waiting to be written together
+		SendBuffer m_pendingSendBuffer;
+		/// flag for the send coalescing
+		bool m_isSendCoalescing;
 
 
 	};
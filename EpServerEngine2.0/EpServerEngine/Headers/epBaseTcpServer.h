@@ -95,6 +95,20 @@ namespace epse{
 		*/
 		virtual void StopServer();
 
+	protected:
+		/// byte size of the send queue to notify full
+		unsigned int m_sendQueueHighWatermark;
+		/// byte size of the send queue to notify drained
+		unsigned int m_sendQueueLowWatermark;
+		/// byte size of the send queue to disconnect the slow client
+		unsigned int m_sendQueueLimit;
+		/// highest version of the frame to accept from the clients
+		unsigned int m_frameVersion;
+		/// maximum byte size of the packet to receive from the clients
+		unsigned int m_maxFrameByteSize;
+		/// byte size of the chunks to deliver the larger packet in
+		unsigned int m_receiveChunkByteSize;
+
 	private:
 
 		/*!
@@ -40,6 +40,9 @@ An Interface for Base TCP Socket.
 
 #include "epServerEngine.h"
 #include "epBaseSocket.h"
+#include "epReceiveBuffer.h"
+#include "epSendBuffer.h"
+#include "epSendQueue.h"
 
 namespace epse
 {
@@ -73,10 +76,24 @@ namespace epse
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
+
+		/*!
+		Get the send coalescing flag for the Socket.
+		@return The flag whether to coalesce the packets sent concurrently.
+		*/
+		virtual bool GetIsSendCoalescing() const;
+
+		/*!
+		Set the send coalescing flag for the Socket.
+		@param[in] isSendCoalescing The flag whether to coalesce the packets sent concurrently.
+		@remark the packets sent while another Send is writing are written together in a single write.
+		*/
+		virtual void SetIsSendCoalescing(bool isSendCoalescing);
 		
 
 		/*!
@@ -88,6 +105,7 @@ namespace epse
 	protected:	
 		friend class SyncTcpServer;
 		friend class AsyncTcpServer;
+		friend class EventTcpServer;
 		/*!
 		Actually Kill the connection
 		*/
@@ -101,10 +119,19 @@ namespace epse
 		/*!
 		Receive the packet from the client
 		@remark  Subclasses must implement this
-		@param[out] packet the packet received
-		@return received byte size
+		@param[out] retPacket the packet received
+		@return received byte size including the size field, 0 if the connection is closed, or negative if error occurred
+		@remark as much data as available is read at once, and the rest of the packets are kept in the receive buffer.
+		@remark the caller must call ReleaseObj() for retPacket to avoid the memory leak.
+		*/
+		int receive(Packet *&retPacket);
+
+		/*!
+		Pop the first packet from the receive buffer, delivering the chunks in front to the callback object
+		@return the packet popped, or NULL if no complete packet is in the receive buffer
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
 		*/
-		int receive(Packet &packet);
+		Packet *popPacket();
 	
 		/*!
 		Set the argument for the base server worker thread.
@@ -112,6 +139,39 @@ namespace epse
 		*/
 		void setClientSocket(const SOCKET& clientSocket );
 
+		/*!
+		Set the watermarks and the limit of the send queue.
+		@param[in] highWatermark the byte size to call OnSendQueueFull
+		@param[in] lowWatermark the byte size to call OnSendQueueDrained
+		@param[in] limit the byte size to disconnect the slow client
+		*/
+		void setSendQueueWatermark(unsigned int highWatermark,unsigned int lowWatermark,unsigned int limit);
+
+		/*!
+		Set the highest version of the frame to accept from the client.
+		@param[in] frameVersion the highest version of the frame
+		*/
+		void setFrameVersion(unsigned int frameVersion);
+
+		/*!
+		Set the compressor to compress with if the client offers the compression.
+		@param[in] compressor the compressor of the server
+		@remark must be set before the frame version.
+		*/
+		void setCompressor(Compressor *compressor);
+
+		/*!
+		Set the limits of the packets to receive from the client.
+		@param[in] maxFrameByteSize the maximum byte size of the packet
+		@param[in] chunkByteSize the byte size of the chunks to deliver the larger packet in
+		*/
+		void setReceiveLimit(unsigned int maxFrameByteSize,unsigned int chunkByteSize);
+
+		/*!
+		Reset the state of the previous connection to recycle this socket.
+		*/
+		virtual void resetConnection();
+
 
 
 	protected:
@@ -142,8 +202,19 @@ namespace epse
 		/// send lock
 		epl::BaseLock *m_sendLock;
 
-		/// Temp Packet;
-		Packet m_recvSizePacket;
+		/// Frame Codec of the connection
+		FrameCodec m_frameCodec;
+
+		/// Receive Buffer
+		ReceiveBuffer m_recvBuffer;
+
+		/// Packets waiting to be written together
+		SendBuffer m_pendingSendBuffer;
+		/// flag for the send coalescing
+		bool m_isSendCoalescing;
+
+		/// Outbound queue drained by the I/O thread
+		SendQueue m_sendQueue;
 	};
 
 }
@@ -42,6 +42,8 @@ An Interface for Base UDP Client.
 #include "epBaseClient.h"
 #include "epServerObjectList.h"
 #include "epClientPacketProcessor.h"
+#include "epReliableUdpSession.h"
+#include "epUdpFragmentSession.h"
 
 
 namespace epse{
@@ -50,7 +52,7 @@ namespace epse{
 	@class BaseUdpClient epBaseUdpClient.h
 	@brief A class for Base UDP Client.
 	*/
-	class EP_SERVER_ENGINE BaseUdpClient:public BaseClient{
+	class EP_SERVER_ENGINE BaseUdpClient:public BaseClient, public DatagramSenderInterface{
 
 	public:
 		/*!
@@ -87,6 +89,7 @@ namespace epse{
 		/*!
 		Get the maximum packet byte size
 		@return the maximum packet byte size
+		@remark the byte marking the compression is excluded while the compression is enabled.
 		*/
 		virtual unsigned int GetMaxPacketByteSize() const;
 
@@ -108,10 +111,31 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
+		@remark the packet larger than the maximum packet byte size is sent in the fragments with the UDP fragmentation.
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
+
+		/*!
+		Send the packet to the server on the given channel
+		@param[in] packet the packet to be sent
+		@param[in] channel the channel to send the packet on
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark the reliable packet is retransmitted until acknowledged.
+		@remark SEND_STATUS_FAIL_NOT_SUPPORTED if the client is not connected with the reliable UDP.
+		*/
+		virtual int Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus=NULL);
+
+		/*!
+		Get the smoothed round trip time to the server
+		@return the smoothed round trip time in millisecond, or 0 if not measured yet
+		@remark measured only with the reliable UDP.
+		*/
+		unsigned int GetRoundTripTime() const;
 	
 	protected:
 		/*!
@@ -127,6 +151,75 @@ namespace epse{
 		*/
 		int receive(Packet &packet);
 
+		/*!
+		Send the datagram to the server as it is
+		@param[in] datagram the datagram to be sent
+		@param[in] waitTimeInMilliSec wait time for sending the datagram in millisecond
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		*/
+		int sendTo(const Packet &datagram, unsigned int waitTimeInMilliSec,SendStatus *sendStatus);
+
+		/*!
+		Compress the datagram, and send it to the server with the marker of the compression in front
+		@param[in] datagram the datagram to be sent
+		@param[in] sendStatus the status of Send
+		@return the byte size of the datagram given
+		@remark return -1 if error occurred
+		*/
+		int sendCompressedTo(const Packet &datagram,SendStatus *sendStatus);
+
+		/*!
+		Send the datagram to the server as it is
+		@param[in] datagram the datagram to be sent
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		*/
+		virtual int SendDatagram(const Packet &datagram,SendStatus *sendStatus=NULL);
+
+		/*!
+		Set up the sessions the datagrams are exchanged through
+		@param[in] isReliable the flag whether to use the Reliable UDP Session
+		@param[in] isFragmented the flag whether to use the UDP Fragment Session
+		@remark the receive wakes up every RELIABLE_UDP_TICK_MILLISEC with the reliable UDP.
+		@remark the Reliable UDP Session sends through the UDP Fragment Session if both are used.
+		*/
+		void setUpSessions(bool isReliable,bool isFragmented);
+
+		/*!
+		Retransmit the reliable datagrams not acknowledged within the time-out
+		@return false if the server is not responding otherwise true
+		*/
+		bool updateReliable();
+
+		/*!
+		Create the packet to deliver from the datagram received
+		@param[in] packetData the datagram received
+		@param[in] byteSize the byte size of the datagram
+		@return the new packet, or NULL if the datagram has no packet to deliver yet
+		@remark with the reliable UDP, the rest of the packets to deliver are taken by popReceivedPacket.
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *createReceivedPacket(const char *packetData,unsigned int byteSize);
+
+		/*!
+		Create the packet to deliver from the datagram without the marker of the compression
+		@param[in] packetData the datagram
+		@param[in] byteSize the byte size of the datagram
+		@return the new packet, or NULL if the datagram has no packet to deliver yet
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *createSessionPacket(const char *packetData,unsigned int byteSize);
+
+		/*!
+		Take the packet left to deliver by the Reliable UDP Session
+		@return the packet to deliver, or NULL if none is left
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *popReceivedPacket();
+
 		/*!
 		Actually processing the client thread
 		@remark  Subclasses must implement this
@@ -152,6 +245,12 @@ namespace epse{
 		/// internal variable2
 		struct addrinfo *m_ptr;
 
+		/// Session of the reliable UDP (NULL if not used)
+		ReliableUdpSession *m_reliableSession;
+
+		/// Session of the UDP fragmentation (NULL if not used)
+		UdpFragmentSession *m_fragmentSession;
+
 	};
 }
 
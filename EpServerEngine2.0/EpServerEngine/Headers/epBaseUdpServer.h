@@ -41,6 +41,18 @@ An Interface for Base UDP Server.
 
 #include "epServerEngine.h"
 #include "epBaseServer.h"
+#include "epPacketSlab.h"
+#include "epBaseUdpSocket.h"
+
+#if defined(UDP_SEND_MSG_SIZE) && defined(UDP_RECV_MAX_COALESCED_SIZE) && (WINVER>=WINDOWS_VISTA)
+/*!
+@def EP_UDP_SEGMENTATION_OFFLOAD
+@brief the UDP segmentation offload is available
+
+Macro defined if the SDK has the options for UDP Send Offload and UDP Receive Offload.
+*/
+#define EP_UDP_SEGMENTATION_OFFLOAD
+#endif //defined(UDP_SEND_MSG_SIZE) && defined(UDP_RECV_MAX_COALESCED_SIZE) && (WINVER>=WINDOWS_VISTA)
 
 namespace epse{
 
@@ -100,6 +112,7 @@ namespace epse{
 		/*!
 		Get the maximum packet byte size
 		@return the maximum packet byte size
+		@remark the byte marking the compression is excluded while the compression is enabled.
 		*/
 		unsigned int GetMaxPacketByteSize() const;
 
@@ -122,6 +135,17 @@ namespace epse{
 
 
 
+		/*! 
+		@struct PendingDatagram epBaseUdpServer.h
+		@brief A struct for the datagram held to be sent together with the next one.
+		*/
+		struct PendingDatagram{
+			/// copy of the datagram
+			Packet *m_packet;
+			/// address of the client
+			sockaddr m_sockAddr;
+		};
+
 		/*!
 		Send the packet to the client
 		@param[in] packet the packet to be sent
@@ -130,9 +154,101 @@ namespace epse{
 		@param[in] sendStatus the status of Send
 		@return sent byte size
 		@remark return -1 if error occurred
+		@remark the datagrams held by queueSend are sent first, after the same wait.
 		*/
 		int send(const Packet &packet,const sockaddr &clientSockAddr, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
 
+		/*!
+		Hold the copy of the packet to be sent together with the next packet sent
+		@param[in] packet the packet to be sent
+		@param[in] clientSockAddr the client socket address, which the packet will be delivered
+		@param[in] waitTimeInMilliSec wait time for sending in millisecond, if the datagrams held are flushed
+		@param[in] sendStatus the status of Send
+		@return the byte size of the packet held, or the sent byte size if flushed
+		@remark return -1 if error occurred
+		@remark the datagrams held are flushed with the packet once UDP_SEND_BATCH_COUNT_MAX are held.
+		*/
+		int queueSend(const Packet &packet,const sockaddr &clientSockAddr, unsigned int waitTimeInMilliSec,SendStatus *sendStatus);
+
+		/*!
+		Send the datagram to the client without waiting
+		@param[in] packet the packet to be sent
+		@param[in] clientSockAddr the client socket address, which the packet will be delivered
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark m_sendLock must be held by the caller.
+		*/
+		int sendDatagram(const Packet &packet,const sockaddr &clientSockAddr,SendStatus *sendStatus);
+
+		/*!
+		Send all the datagrams held in order
+		@remark m_sendLock must be held by the caller.
+		@remark the datagram failed to send is dropped as the network would.
+		*/
+		void flushPendingSend();
+
+		/*!
+		Release all the datagrams held without sending
+		*/
+		void clearPendingSend();
+
+		/*!
+		Send the packet to the client split into the datagrams of the given byte size
+		@param[in] packet the packet to be split and sent
+		@param[in] clientSockAddr the client socket address, which the packet will be delivered
+		@param[in] segmentByteSize the byte size of each datagram (the last one can be smaller)
+		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark if the send is offloaded, the segments up to the maximum datagram byte size are sent at once.
+		*/
+		int sendSegments(const Packet &packet,const sockaddr &clientSockAddr,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+
+		/*!
+		Send the segments to the client in a single send, to be split by the network stack
+		@param[in] packetData the segments to be sent
+		@param[in] byteSize the byte size of the segments
+		@param[in] clientSockAddr the client socket address, which the segments will be delivered
+		@param[in] segmentByteSize the byte size of each datagram
+		@param[in] waitTimeInMilliSec wait time for sending in millisecond
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		*/
+		int sendOffloaded(const char *packetData,unsigned int byteSize,const sockaddr &clientSockAddr,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec,SendStatus *sendStatus);
+
+		/*!
+		Compress the packet, and send it to the client with the marker of the compression in front
+		@param[in] packet the packet to be sent
+		@param[in] clientSockAddr the client socket address, which the packet will be delivered
+		@param[in] sendStatus the status of Send
+		@return the byte size of the packet given
+		@remark return -1 if error occurred
+		@remark m_sendLock must be held by the caller.
+		*/
+		int sendCompressed(const Packet &packet,const sockaddr &clientSockAddr,SendStatus *sendStatus);
+
+		/*!
+		Create the packet of the datagram received
+		@param[in] slot the slot the datagram is received into, or NULL if received into the heap buffer
+		@param[in] packetData the datagram received
+		@param[in] byteSize the byte size of the datagram
+		@return the new packet referencing the slot, or the copy of the datagram if the slot is NULL
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *createReceivedPacket(PacketSlot *slot,const char *packetData,unsigned int byteSize);
+
+		/*!
+		Wait for the listen socket to be able to send
+		@param[in] waitTimeInMilliSec wait time in millisecond
+		@param[in] sendStatus the status of Send
+		@return positive if able to send, 0 if timed out, or SOCKET_ERROR if select failed
+		@remark it returns right away if waitTimeInMilliSec is WAITTIME_INIFINITE, since the blocking send waits anyway.
+		*/
+		int waitForSend(unsigned int waitTimeInMilliSec,SendStatus *sendStatus);
+
 
 		/*!
 		Compare given clientSocket with BaseServerObject's socket
@@ -142,6 +258,36 @@ namespace epse{
 		*/
 		static bool socketCompare(sockaddr const & clientSocket, const BaseServerObject*obj );
 
+		/*!
+		Deliver the packet received to the socket
+		@param[in] socket the socket of the sender
+		@param[in] packet the packet received
+		@remark with the reliable UDP or the UDP fragmentation, the packets processed by the sessions of the socket are delivered instead.
+		*/
+		void deliverPacket(BaseUdpSocket *socket,Packet *packet);
+
+		/*!
+		Deliver the datagram without the marker of the compression to the socket
+		@param[in] socket the socket of the sender
+		@param[in] packet the datagram received
+		@remark with the reliable UDP or the UDP fragmentation, the packets processed by the sessions of the socket are delivered instead.
+		*/
+		void deliverDatagram(BaseUdpSocket *socket,Packet *packet);
+
+		/*!
+		Retransmit the reliable datagrams of all the sockets, and kill the sockets not responding
+		@remark does nothing if called again within RELIABLE_UDP_TICK_MILLISEC.
+		*/
+		void updateReliableSockets();
+
+		/*!
+		Collect the socket with its reference retained
+		@param[in] obj the socket
+		@param[in] argCount the number of arguments
+		@param[in] args the pointer to the vector to collect into
+		*/
+		static void collectSocket(BaseServerObject *obj,unsigned int argCount,va_list args);
+
 
 
 	protected:
@@ -151,6 +297,27 @@ namespace epse{
 		/// send lock
 		epl::BaseLock *m_sendLock;
 
+		/// Datagrams held to be sent together with the next one
+		vector<PendingDatagram> m_pendingSendList;
+
+		/// Flag for the segmentation offload requested
+		bool m_isSegmentationOffload;
+
+		/// Flag whether the network stack accepted UDP Send Offload
+		bool m_isSendOffloaded;
+
+		/// Slab the datagrams are received into
+		PacketSlab *m_receiveSlab;
+
+		/// Flag for the reliable UDP
+		bool m_isReliableUdp;
+
+		/// Flag for the UDP fragmentation
+		bool m_isFragmentedUdp;
+
+		/// Time the reliable datagrams are checked last
+		unsigned int m_lastReliableUpdateTime;
+
 	};
 }
 #endif //__EP_BASE_UDP_SERVER_H__
\ No newline at end of file
@@ -40,6 +40,8 @@ An Interface for Base UDP Socket.
 
 #include "epServerEngine.h"
 #include "epBaseSocket.h"
+#include "epReliableUdpSession.h"
+#include "epUdpFragmentSession.h"
 #include <queue>
 using namespace std;
 
@@ -50,8 +52,9 @@ namespace epse
 	@class BaseUdpSocket epBaseUdpSocket.h
 	@brief A class for Base UDP Socket.
 	*/
-	class EP_SERVER_ENGINE BaseUdpSocket:public BaseSocket
+	class EP_SERVER_ENGINE BaseUdpSocket:public BaseSocket, public DatagramSenderInterface
 	{
+		friend class BaseUdpServer;
 		friend class SyncUdpServer;
 		friend class AsyncUdpServer;
 	public:
@@ -78,10 +81,43 @@ namespace epse
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
+		@remark the packet larger than the maximum packet byte size is sent in the fragments with the UDP fragmentation.
+		@remark if isMoreComing is true, the datagram is held by the server and sent with the next packet sent without it.
 		*/
-		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
+
+		/*!
+		Send the packet to the client on the given channel
+		@param[in] packet the packet to be sent
+		@param[in] channel the channel to send the packet on
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark the reliable packet is retransmitted until acknowledged.
+		@remark SEND_STATUS_FAIL_NOT_SUPPORTED if the server is not started with the reliable UDP.
+		*/
+		virtual int Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus=NULL);
+
+		/*!
+		Get the smoothed round trip time to the client
+		@return the smoothed round trip time in millisecond, or 0 if not measured yet
+		@remark measured only with the reliable UDP.
+		*/
+		unsigned int GetRoundTripTime() const;
+
+		/*!
+		Send the packet to the client split into the datagrams of the given byte size
+		@param[in] packet the packet to be split and sent
+		@param[in] segmentByteSize the byte size of each datagram (the last one can be smaller)
+		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		*/
+		virtual int SendSegments(const Packet &packet,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
 
 		
 		/*!
@@ -122,6 +158,34 @@ namespace epse
 		@param[in] maxPacketSize the maximum packet byte size to set
 		*/
 		void setMaxPacketByteSize(unsigned int maxPacketSize);
+
+		/*!
+		Set up the sessions the datagrams are exchanged through
+		@param[in] isReliable the flag whether to use the Reliable UDP Session
+		@param[in] isFragmented the flag whether to use the UDP Fragment Session
+		@remark the Reliable UDP Session sends through the UDP Fragment Session if both are used.
+		*/
+		void setUpSessions(bool isReliable,bool isFragmented);
+
+		/*!
+		Retransmit the reliable datagrams not acknowledged within the time-out
+		@return false if the client is not responding otherwise true
+		*/
+		bool updateReliable();
+
+		/*!
+		Reset the state of the previous connection to recycle this socket.
+		*/
+		virtual void resetConnection();
+
+		/*!
+		Send the datagram to the client as it is
+		@param[in] datagram the datagram to be sent
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		*/
+		virtual int SendDatagram(const Packet &datagram,SendStatus *sendStatus=NULL);
 	protected:
 		/*!
 		Default Copy Constructor
@@ -149,6 +213,12 @@ namespace epse
 
 		/// Packet List
 		queue<Packet*> m_packetList;
+
+		/// Session of the reliable UDP (NULL if not used)
+		ReliableUdpSession *m_reliableSession;
+
+		/// Session of the UDP fragmentation (NULL if not used)
+		UdpFragmentSession *m_fragmentSession;
 	};
 
 }
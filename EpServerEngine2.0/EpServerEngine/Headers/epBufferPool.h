@@ -0,0 +1,291 @@
+/*! 
+@file epBufferPool.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Buffer Pool Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Buffer Pool.
+
+*/
+#ifndef __EP_BUFFER_POOL_H__
+#define __EP_BUFFER_POOL_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class BufferPool epBufferPool.h
+	@brief A class for Buffer Pool.
+
+	The pool rounds the buffer up to the power of 2 size class, and keeps the
+	buffers freed in the cache of the thread to reuse without the lock. The
+	cache moves BUFFER_POOL_BATCH_COUNT buffers at once from and to the global
+	depot, and the depot carves the new buffers from the chunks reserved,
+	which are never returned until the pool is destroyed.
+	@remark the buffers cached by the thread exited without FlushThreadCache are not reused before Windows Vista.
+	*/
+	class EP_SERVER_ENGINE BufferPool{
+
+	public:
+		/*! 
+		@struct Statistics epBufferPool.h
+		@brief A struct for the statistics of the Buffer Pool.
+		*/
+		struct Statistics{
+			/// number of the allocations served by the buffers freed before
+			unsigned __int64 hitCount;
+			/// number of the allocations served by the new memory
+			unsigned __int64 missCount;
+			/// byte size of the buffers allocated and not freed yet
+			__int64 outstandingByteSize;
+			/// byte size of the chunks reserved
+			unsigned __int64 reservedByteSize;
+		};
+
+		/// Buffer Pool shared by the packets
+		static BufferPool defaultBufferPool;
+
+		/*!
+		Default Constructor
+
+		Initializes the Pool
+		*/
+		BufferPool();
+
+		/*!
+		Default Destructor
+
+		Destroy the Pool
+		@remark all the buffers of the pool are released regardless of being freed.
+		*/
+		virtual ~BufferPool();
+
+		/*!
+		Allocate the buffer
+		@param[in] byteSize the byte size of the buffer
+		@return the buffer allocated
+		*/
+		void *Allocate(unsigned int byteSize);
+
+		/*!
+		Free the buffer allocated by the pool
+		@param[in] buffer the buffer to free
+		@remark NULL is ignored.
+		*/
+		void Free(void *buffer);
+
+		/*!
+		Resize the buffer allocated by the pool
+		@param[in] buffer the buffer to resize
+		@param[in] byteSize the new byte size of the buffer
+		@return the buffer resized
+		@remark the content is kept up to the smaller byte size.
+		*/
+		void *Reallocate(void *buffer,unsigned int byteSize);
+
+		/*!
+		Return the buffers cached by the calling thread to the depot and release its cache
+		@remark should be called before the thread exits, and the engine threads call it by themselves.
+		@remark the user threads sending or releasing the packets must call it before Windows Vista,
+		        where the cache is not released by the system as the thread exits.
+		@remark the thread gets a new cache if it allocates again.
+		*/
+		void FlushThreadCache();
+
+		/*!
+		Set whether the chunks are reserved on the large pages
+		@param[in] isLargePage the flag whether to use the large pages
+		@remark falls back to the normal pages if the large pages are not available.
+		@remark applied to the chunks reserved afterwards.
+		*/
+		void SetLargePage(bool isLargePage);
+
+		/*!
+		Get the statistics of the pool
+		@return the statistics of the pool
+		@remark the counts of the threads running are read without the synchronization.
+		*/
+		Statistics GetStatistics() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Pool
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		BufferPool(const BufferPool& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		BufferPool & operator=(const BufferPool&b){return *this;}
+
+		/*!
+		Enumerator for the buffer of the pool
+		*/
+		enum BufferPoolHeader{
+			/// Byte size of the header in front of every buffer
+			BUFFER_POOL_HEADER_BYTE_SIZE=16,
+			/// Class index of the buffer allocated from the heap directly
+			BUFFER_POOL_CLASS_HEAP=BUFFER_POOL_CLASS_COUNT,
+		};
+
+		/*! 
+		@struct BufferHeader epBufferPool.h
+		@brief A struct for the header in front of every buffer.
+		*/
+		struct BufferHeader{
+			/// next buffer freed in the list
+			BufferHeader *m_next;
+			/// size class of the buffer
+			unsigned int m_classIdx;
+			/// byte size of the buffer allocated from the heap directly
+			unsigned int m_byteSize;
+		};
+
+		/*! 
+		@struct ThreadCache epBufferPool.h
+		@brief A struct for the buffers cached by a thread.
+		*/
+		struct ThreadCache{
+			/// buffers freed for each size class
+			BufferHeader *m_freeList[BUFFER_POOL_CLASS_COUNT];
+			/// number of the buffers freed for each size class
+			unsigned int m_freeCount[BUFFER_POOL_CLASS_COUNT];
+			/// number of the allocations served by the buffers freed before
+			unsigned __int64 m_hitCount;
+			/// number of the allocations served by the new memory
+			unsigned __int64 m_missCount;
+			/// byte size allocated minus freed by the thread
+			__int64 m_outstandingByteSize;
+			/// pool the cache belongs to
+			BufferPool *m_pool;
+		};
+
+		/*!
+		Get the size class of the byte size
+		@param[in] byteSize the byte size of the buffer
+		@return the index of the size class, or BUFFER_POOL_CLASS_HEAP if too large
+		*/
+		static unsigned int getClassIdx(unsigned int byteSize);
+
+		/*!
+		Get the byte size of the size class
+		@param[in] classIdx the index of the size class
+		@return the byte size of the buffer of the size class
+		*/
+		static unsigned int getClassByteSize(unsigned int classIdx);
+
+		/*!
+		Get the cache of the calling thread
+		@return the cache of the calling thread
+		*/
+		ThreadCache *getThreadCache();
+
+		/*!
+		Fill the cache with the buffers of the size class from the depot
+		@param[in] cache the cache of the calling thread
+		@param[in] classIdx the index of the size class
+		@return true if the buffers freed before are moved, false if carved newly
+		*/
+		bool refillCache(ThreadCache *cache,unsigned int classIdx);
+
+		/*!
+		Return the buffers of the size class from the cache to the depot
+		@param[in] cache the cache of the calling thread
+		@param[in] classIdx the index of the size class
+		@param[in] count the number of the buffers to return
+		*/
+		void returnCache(ThreadCache *cache,unsigned int classIdx,unsigned int count);
+
+		/*!
+		Return all the buffers of the cache to the depot and delete the cache
+		@param[in] cache the cache to release
+		@remark the cache must be detached from the thread before.
+		*/
+		void releaseCache(ThreadCache *cache);
+
+#if (WINVER>=WINDOWS_VISTA)
+		/*!
+		Release the cache of the thread exiting
+		@param[in] cache the cache of the thread exiting
+		@remark called by the system as the thread exits or the fiber local storage is freed.
+		*/
+		static void WINAPI onThreadExit(void *cache);
+#endif //(WINVER>=WINDOWS_VISTA)
+
+		/*!
+		Carve the new buffers of the size class into the depot
+		@param[in] classIdx the index of the size class
+		@remark m_depotLock must be held by the caller.
+		*/
+		void carveChunk(unsigned int classIdx);
+
+	private:
+		/// index of the thread local storage for the cache (fiber local storage from Windows Vista)
+		DWORD m_tlsIdx;
+
+		/// buffers returned to the depot for each size class
+		BufferHeader *m_depotList[BUFFER_POOL_CLASS_COUNT];
+		/// number of the buffers in the depot for each size class
+		unsigned int m_depotCount[BUFFER_POOL_CLASS_COUNT];
+
+		/// caches of all the threads
+		vector<ThreadCache*> m_cacheList;
+		/// chunks reserved
+		vector<void*> m_chunkList;
+		/// byte size of the chunks reserved
+		unsigned __int64 m_reservedByteSize;
+		/// number of the allocations served by the buffers freed before in the caches released
+		unsigned __int64 m_releasedHitCount;
+		/// number of the allocations served by the new memory in the caches released
+		unsigned __int64 m_releasedMissCount;
+		/// byte size allocated minus freed by the threads whose caches are released
+		__int64 m_releasedOutstandingByteSize;
+
+		/// flag whether the chunks are reserved on the large pages
+		bool m_isLargePage;
+
+		/// depot lock
+		epl::BaseLock *m_depotLock;
+	};
+}
+#endif //__EP_BUFFER_POOL_H__
\ No newline at end of file
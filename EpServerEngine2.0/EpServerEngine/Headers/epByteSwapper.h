@@ -0,0 +1,111 @@
+/*! 
+@file epByteSwapper.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Byte Swapper Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Byte Swapper.
+
+*/
+#ifndef __EP_BYTE_SWAPPER_H__
+#define __EP_BYTE_SWAPPER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+
+namespace epse{
+
+	/*! 
+	@class ByteSwapper epByteSwapper.h
+	@brief A class for Byte Swapper.
+
+	The byte swapper copies the arrays of the values reversing the bytes of
+	each value, 16 bytes at a time with SSE2 where available, to serialize
+	the values in the byte order other than the host.
+	*/
+	class EP_SERVER_ENGINE ByteSwapper{
+
+	public:
+		/*!
+		Check if the given byte order is the byte order of the host
+		@param[in] byteOrder the byte order to check
+		@return true if the byte order is the host's otherwise false
+		*/
+		static bool IsHostByteOrder(ByteOrder byteOrder);
+
+		/*!
+		Copy the 16-bit values reversing the bytes of each
+		@param[out] retDst the buffer to copy to
+		@param[in] src the values to copy from
+		@param[in] count the number of the values
+		@remark the buffers may be unaligned but must not overlap.
+		*/
+		static void SwapCopy16(void *retDst,const void *src,size_t count);
+
+		/*!
+		Copy the 32-bit values reversing the bytes of each
+		@param[out] retDst the buffer to copy to
+		@param[in] src the values to copy from
+		@param[in] count the number of the values
+		@remark the buffers may be unaligned but must not overlap.
+		*/
+		static void SwapCopy32(void *retDst,const void *src,size_t count);
+
+		/*!
+		Copy the 64-bit values reversing the bytes of each
+		@param[out] retDst the buffer to copy to
+		@param[in] src the values to copy from
+		@param[in] count the number of the values
+		@remark the buffers may be unaligned but must not overlap.
+		*/
+		static void SwapCopy64(void *retDst,const void *src,size_t count);
+
+		/*!
+		Copy the values of the given byte size converting the byte order
+		@param[out] retDst the buffer to copy to
+		@param[in] src the values to copy from
+		@param[in] elementByteSize the byte size of each value
+		@param[in] count the number of the values
+		@param[in] shouldSwap the flag whether to reverse the bytes of each value
+		@remark the values of 1 byte or not swapped are copied as they are.
+		*/
+		static void Copy(void *retDst,const void *src,size_t elementByteSize,size_t count,bool shouldSwap);
+
+	private:
+		/*!
+		Default Constructor
+		@remark Constructor prohibited
+		*/
+		ByteSwapper(){}
+	};
+}
+
+#endif //__EP_BYTE_SWAPPER_H__
\ No newline at end of file
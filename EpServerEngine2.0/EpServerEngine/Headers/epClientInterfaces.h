@@ -45,6 +45,11 @@ An Interface for Client Interfaces.
 
 namespace epse{
 	class ClientCallbackInterface;
+	class ClientInterface;
+	template<typename SourceInterface> class MessageDispatcher;
+
+	/// Message Dispatcher for the packets received by the clients
+	typedef MessageDispatcher<ClientInterface> ClientMessageDispatcher;
 
 	
 	/*! 
@@ -78,6 +83,74 @@ namespace epse{
 		*/
 		unsigned int workerThreadCount;
 
+		/*!
+		The flag for the reliable UDP.
+		@remark every datagram carries the header of the channel, so the server must use the reliable UDP as well.
+		@remark For UDP Client Use Only!
+		*/
+		bool isReliableUdp;
+
+		/*!
+		The flag for the UDP fragmentation.
+		@remark the packet larger than the maximum datagram is sent in the fragments, and reassembled by the receiver.
+		@remark every datagram carries the header of the fragment, so the server must use the UDP fragmentation as well.
+		@remark For UDP Client Use Only!
+		*/
+		bool isFragmentedUdp;
+
+		/*!
+		The highest version of the frame to offer to the server.
+		@remark the server must be able to parse the control frame of the offer, even if it keeps the legacy frame.
+		@remark For TCP Client Use Only!
+		*/
+		unsigned int frameVersion;
+
+		/*!
+		The dispatcher calling the handler registered for the message type of the packet received.
+		@remark the packet of the message type with no handler is delivered to OnReceived.
+		@remark the message type is carried only by the compact frame, so every other packet has the message type 0.
+		@remark For Asynchronous and IOCP Client Use Only!
+		*/
+		ClientMessageDispatcher *messageDispatcher;
+
+		/*!
+		The minimum byte size of the packet to compress.
+		@remark COMPRESSION_THRESHOLD_NONE disables the compression.
+		@remark TCP offers the compression to the server, and compresses only if accepted.
+		@remark every datagram of UDP carries the byte marking the compression, so the server must use the compression as well.
+		*/
+		unsigned int compressionThreshold;
+
+		/*!
+		The dictionary of the bytes typical for the packets, shared with the server.
+		@remark TCP uses the dictionary only if the server has the same dictionary, and UDP server must have the same dictionary.
+		@remark the dictionary is copied when connected.
+		*/
+		const void *compressionDictionary;
+
+		/*!
+		The byte size of the dictionary.
+		@remark only the last COMPRESSION_DICTIONARY_BYTE_SIZE_MAX bytes are used.
+		*/
+		unsigned int compressionDictionaryByteSize;
+
+		/*!
+		The maximum byte size of the packet to receive from the server.
+		@remark the connection is closed when the larger packet is received, before the packet is buffered.
+		@remark FRAME_BYTE_SIZE_MAX_DEFAULT by default, and FRAME_BYTE_SIZE_UNLIMITED for no limit.
+		@remark the packet delivered in the chunks is limited as well, so raise it to stream the larger packets.
+		@remark For TCP Client Use Only!
+		*/
+		unsigned int maxFrameByteSize;
+
+		/*!
+		The byte size of the chunks to deliver the larger packet in, through OnReceiveChunk.
+		@remark the packet is not buffered as a whole, so the memory of the client is bounded by the chunk.
+		@remark RECEIVE_CHUNK_BYTE_SIZE_NONE to deliver every packet as a whole.
+		@remark For TCP Client Use Only!
+		*/
+		unsigned int receiveChunkByteSize;
+
 		/*!
 		Default Constructor
 
@@ -92,6 +165,15 @@ namespace epse{
 			waitTimeMilliSec=WAITTIME_INIFINITE;
 			maximumProcessorCount=PROCESSOR_LIMIT_INFINITE;
 			workerThreadCount=0;
+			isReliableUdp=false;
+			isFragmentedUdp=false;
+			frameVersion=FRAME_VERSION_LEGACY;
+			messageDispatcher=NULL;
+			compressionThreshold=COMPRESSION_THRESHOLD_NONE;
+			compressionDictionary=NULL;
+			compressionDictionaryByteSize=0;
+			maxFrameByteSize=FRAME_BYTE_SIZE_MAX_DEFAULT;
+			receiveChunkByteSize=RECEIVE_CHUNK_BYTE_SIZE_NONE;
 		}
 
 		static ClientOps defaultClientOps;
@@ -184,10 +266,29 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of send.
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
+		@remark for TCP, the packet with isMoreComing is held and written together with the next packet sent without it.
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL)=0;
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false)=0;
+
+		/*!
+		Send the packet to the server on the given channel
+		@param[in] packet the packet to be sent
+		@param[in] channel the channel to send the packet on
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark the reliable packet is retransmitted until acknowledged.
+		@remark for UDP Client with the reliable UDP Use Only!
+		*/
+		virtual int Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus=NULL)
+		{
+			if(sendStatus)
+				*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+			return -1;
+		}
 
 		/*!
 		Receive the packet from the client
@@ -244,6 +345,27 @@ namespace epse{
 		*/
 		virtual unsigned int GetMaxPacketByteSize() const{return 0;}
 
+		/*!
+		Get the send coalescing flag for the Client.
+		@return The flag whether to coalesce the packets sent concurrently.
+		@remark for TCP Client Use Only!
+		*/
+		virtual bool GetIsSendCoalescing() const
+		{
+			return false;
+		}
+
+		/*!
+		Set the send coalescing flag for the Client.
+		@param[in] isSendCoalescing The flag whether to coalesce the packets sent concurrently.
+		@remark the packets sent while another Send is writing are written together in a single write.
+		@remark for TCP Client Use Only!
+		*/
+		virtual void SetIsSendCoalescing(bool isSendCoalescing)
+		{
+			return;
+		}
+
 		
 
 	};
@@ -263,6 +385,18 @@ namespace epse{
 		*/
 		virtual void OnReceived(ClientInterface *client,const Packet*receivedPacket,ReceiveStatus status)=0;
 
+		/*!
+		Received the chunk of the packet larger than the chunk byte size from the server.
+		@param[in] client the client which received the chunk
+		@param[in] offset the offset of the chunk in the packet
+		@param[in] data the data of the chunk
+		@param[in] byteSize the byte size of the chunk
+		@param[in] isLast the flag whether the chunk is the last of the packet
+		@remark data is valid only until returned, and called on the receiving thread in order.
+		@remark for TCP Client with receiveChunkByteSize set Use Only!
+		*/
+		virtual void OnReceiveChunk(ClientInterface *client,unsigned int offset,const char *data,unsigned int byteSize,bool isLast){}
+
 		
 		/*!
 		Sent the packet from the client.
@@ -0,0 +1,246 @@
+/*! 
+@file epCompressor.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Compressor Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Compressor.
+
+*/
+#ifndef __EP_COMPRESSOR_H__
+#define __EP_COMPRESSOR_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epLzCodec.h"
+
+namespace epse{
+
+	/*! 
+	@class Compressor epCompressor.h
+	@brief A class for Compressor.
+
+	The compressor compresses the packet of the threshold or larger with the
+	LZ Codec, and keeps the packet raw if the compressed is not smaller. The
+	compressed packet is the original byte size in the host byte order
+	followed by the block of the codec.
+
+	The datagram of UDP has no connection to negotiate, so the datagram is
+	prefixed with the byte marking whether it is compressed, while the
+	compression is enabled. The server and the client must be configured the
+	same.
+	*/
+	class EP_SERVER_ENGINE Compressor{
+
+	public:
+		/*! 
+		@struct Statistics epCompressor.h
+		@brief A struct for the statistics of the Compressor.
+		*/
+		struct Statistics{
+			/// number of the packets compressed
+			unsigned __int64 compressedPacketCount;
+			/// byte size of the packets compressed before the compression
+			unsigned __int64 rawByteSize;
+			/// byte size of the packets compressed after the compression
+			unsigned __int64 compressedByteSize;
+			/// time spent compressing including the packets not worth compressing in microsecond
+			unsigned __int64 compressMicroSec;
+			/// number of the packets decompressed
+			unsigned __int64 decompressedPacketCount;
+			/// time spent decompressing in microsecond
+			unsigned __int64 decompressMicroSec;
+		};
+
+		/*!
+		Default Constructor
+
+		Initializes the Compressor disabled
+		@param[in] lockPolicyType The lock policy of the statistics
+		*/
+		Compressor(epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Compressor
+		@param[in] b the second object
+		@remark the statistics are not copied.
+		*/
+		Compressor(const Compressor& b);
+
+		/*!
+		Default Destructor
+
+		Destroy the Compressor
+		*/
+		virtual ~Compressor();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark the statistics are not copied.
+		*/
+		Compressor & operator=(const Compressor&b);
+
+		/*!
+		Configure the Compressor
+		@param[in] threshold the minimum byte size of the packet to compress
+		@param[in] dictionary the dictionary shared with the peer (NULL for no dictionary)
+		@param[in] dictionaryByteSize the byte size of the dictionary
+		@remark COMPRESSION_THRESHOLD_NONE disables the compression.
+		@remark must not be called while any connection is compressing.
+		*/
+		void Configure(unsigned int threshold,const void *dictionary,unsigned int dictionaryByteSize);
+
+		/*!
+		Check if the compression is enabled
+		@return true if the compression is enabled otherwise false
+		*/
+		bool IsEnabled() const;
+
+		/*!
+		Get the id of the dictionary
+		@return the id of the dictionary, or 0 if there is no dictionary
+		*/
+		unsigned int GetDictionaryId() const;
+
+		/*!
+		Compress the given data
+		@param[in] data the data to compress
+		@param[in] byteSize the byte size of the data
+		@param[in] useDictionary the flag whether to refer to the dictionary
+		@return the packet compressed, or NULL if the data is not worth compressing
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *Compress(const char *data,unsigned int byteSize,bool useDictionary);
+
+		/*!
+		Decompress the given data
+		@param[in] data the data compressed
+		@param[in] byteSize the byte size of the data
+		@param[in] useDictionary the flag whether to refer to the dictionary
+		@param[in] maxByteSize the maximum byte size of the data decompressed
+		@return the packet decompressed, or NULL if the data is corrupted or too large
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *Decompress(const char *data,unsigned int byteSize,bool useDictionary,unsigned int maxByteSize=FRAME_BYTE_SIZE_UNLIMITED);
+
+		/*!
+		Compress the given packet to send in the datagram
+		@param[in] packet the packet to compress
+		@param[out] retMarker the byte to send in front of the packet returned or the packet given
+		@return the packet compressed, or NULL to send the packet given
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *CompressDatagram(const Packet &packet,char &retMarker);
+
+		/*!
+		Decompress the datagram received
+		@param[in] datagram the datagram with the marker in front
+		@param[in] maxByteSize the maximum byte size of the packet carried by the datagram
+		@param[out] retPacket the packet carried by the datagram
+		@return true if successfully decompressed otherwise false
+		@remark the caller must call ReleaseObj() for retPacket to avoid the memory leak.
+		@remark the packet decompressed larger than maxByteSize is never allocated, so a small datagram cannot claim a large buffer.
+		*/
+		bool DecompressDatagram(const Packet &datagram,unsigned int maxByteSize,Packet *&retPacket);
+
+		/*!
+		Get the statistics of the Compressor
+		@return the statistics of the Compressor
+		@remark the statistics are counted under the lock, since the 64-bit interlocked functions are not available on the 32-bit Windows XP.
+		@remark the codec keeps its state per call, so the lock is only held to add up the statistics.
+		*/
+		Statistics GetStatistics() const;
+
+		/*!
+		Reset the statistics of the Compressor
+		*/
+		void ResetStatistics();
+
+	private:
+		/*!
+		Enumerator for the marker of the datagram
+		*/
+		enum DatagramMarker{
+			/// Marker of the datagram raw
+			DATAGRAM_MARKER_RAW=0,
+			/// Marker of the datagram compressed
+			DATAGRAM_MARKER_COMPRESSED,
+			/// Marker of the datagram compressed with the dictionary
+			DATAGRAM_MARKER_DICTIONARY,
+		};
+
+		/*!
+		Enumerator for the compressed packet
+		*/
+		enum CompressedHeader{
+			/// Byte size of the original byte size in front of the block
+			COMPRESSED_HEADER_BYTE_SIZE=4,
+			/// Maximum ratio of the original byte size to the block
+			COMPRESSED_RATIO_MAX=255,
+		};
+
+		/*!
+		Get the current tick of the performance counter
+		@return the current tick
+		*/
+		static LONGLONG getTick();
+
+	private:
+		/// LZ Codec
+		LzCodec m_codec;
+		/// minimum byte size of the packet to compress
+		unsigned int m_threshold;
+
+		/// lock policy
+		epl::LockPolicy m_lockPolicy;
+		/// lock for the statistics
+		epl::BaseLock *m_lock;
+		/// number of the packets compressed
+		unsigned __int64 m_compressedPacketCount;
+		/// byte size of the packets compressed before the compression
+		unsigned __int64 m_rawByteSize;
+		/// byte size of the packets compressed after the compression
+		unsigned __int64 m_compressedByteSize;
+		/// ticks spent compressing
+		LONGLONG m_compressTick;
+		/// number of the packets decompressed
+		unsigned __int64 m_decompressedPacketCount;
+		/// ticks spent decompressing
+		LONGLONG m_decompressTick;
+	};
+}
+
+#endif //__EP_COMPRESSOR_H__
\ No newline at end of file
@@ -0,0 +1,356 @@
+/*! 
+@file epEventLoop.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Event Loop Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Event Loop.
+
+*/
+#ifndef __EP_EVENT_LOOP_H__
+#define __EP_EVENT_LOOP_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epTimingWheel.h"
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif //WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+#include <winsock2.h>
+
+
+// Need to link with Ws2_32.lib
+#pragma comment (lib, "Ws2_32.lib")
+
+namespace epse{
+
+	class EventLoopCallbackInterface;
+
+	/*! 
+	@struct IoContext epEventLoop.h
+	@brief A structure for the overlapped operation context.
+	*/
+	struct IoContext{
+		/// Overlapped structure
+		/// @remark must be the first member
+		OVERLAPPED m_overlapped;
+		/// Callback Object to notify when the operation is completed
+		EventLoopCallbackInterface *m_callBackObj;
+		/// Operation type defined by the callback object
+		unsigned int m_operation;
+
+		/*!
+		Default Constructor
+
+		Initializes the Context
+		*/
+		IoContext()
+		{
+			epl::System::Memset(&m_overlapped,0,sizeof(OVERLAPPED));
+			m_callBackObj=NULL;
+			m_operation=0;
+		}
+
+		/*!
+		Reset the overlapped structure before reuse
+		*/
+		void Reset()
+		{
+			epl::System::Memset(&m_overlapped,0,sizeof(OVERLAPPED));
+		}
+	};
+
+	/*! 
+	@class EventLoopCallbackInterface epEventLoop.h
+	@brief A class for Event Loop Callback Interface.
+	*/
+	class EP_SERVER_ENGINE EventLoopCallbackInterface{
+	public:
+		/*!
+		Default Destructor
+
+		Destroy the Interface
+		*/
+		virtual ~EventLoopCallbackInterface(){}
+
+		/*!
+		Called when the operation with given context is completed.
+		@param[in] context the context of the completed operation
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		@remark called from the event loop thread
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)=0;
+
+		/*!
+		Called when the timer with given context is expired.
+		@param[in] context the context of the expired timer
+		@param[in] isSucceeded the flag whether the timer is expired, or false if the Event Loop is stopped
+		@remark called from the event loop thread
+		*/
+		virtual void OnTimerExpired(TimerContext *context,bool isSucceeded){}
+	};
+
+	/*! 
+	@class EventLoop epEventLoop.h
+	@brief A class for Event Loop.
+
+	Each Event Loop owns a completion port and a single thread dispatching
+	the completions of all the sockets associated with it, so the callbacks
+	for a socket are never called concurrently.
+	The Event Loop also owns a Timing Wheel and a coarse clock cached once
+	per iteration, so the timers cost nothing until they expire.
+	*/
+	class EP_SERVER_ENGINE EventLoop:protected epl::Thread{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Event Loop
+		@param[in] waitTimeMilliSec wait time for Event Loop Thread to terminate
+		@param[in] lockPolicyType The lock policy
+		*/
+		EventLoop(unsigned int waitTimeMilliSec=WAITTIME_INIFINITE,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Event Loop
+		*/
+		virtual ~EventLoop();
+
+		/*!
+		Start the Event Loop
+		@return true if successfully started otherwise false
+		*/
+		bool StartLoop();
+
+		/*!
+		Stop the Event Loop
+		@remark the operations pending are dispatched before the thread terminates.
+		*/
+		void StopLoop();
+
+		/*!
+		Check if the Event Loop is started
+		@return true if the Event Loop is started otherwise false
+		*/
+		bool IsLoopStarted() const;
+
+		/*!
+		Get the id of the Event Loop thread
+		@return the id of the Event Loop thread
+		*/
+		unsigned int GetLoopThreadId() const;
+
+		/*!
+		Associate the given socket with the Event Loop
+		@param[in] socket the socket to associate
+		@return true if successfully associated otherwise false
+		@remark the socket stays associated until it is closed.
+		*/
+		bool Register(SOCKET socket);
+
+		/*!
+		Post the given context to the Event Loop as if its operation is completed
+		@param[in] context the context to post
+		@param[in] transferredByte the number of bytes to report
+		@return true if successfully posted otherwise false
+		*/
+		bool Post(IoContext *context,unsigned int transferredByte=0);
+		/*!
+		Notify the Event Loop that an operation is issued on the socket associated
+		@remark must be called before the operation is issued, and AbortIo must be called if failed to issue.
+		@remark the Event Loop does not terminate until the operations notified are completed.
+		*/
+		void BeginIo();
+		/*!
+		Notify the Event Loop that the operation notified by BeginIo is failed to issue
+		*/
+		void AbortIo();
+
+		/*!
+		Add the timer to expire after the given delay
+		@param[in] context the context of the timer
+		@param[in] delayMilliSec the delay in millisecond
+		@remark must be called on the Event Loop thread.
+		@remark the timers still pending when the Event Loop is stopped are expired with failure.
+		*/
+		void AddTimer(TimerContext *context,unsigned int delayMilliSec);
+
+		/*!
+		Remove the timer
+		@param[in] context the context of the timer
+		@return true if the timer was pending otherwise false
+		@remark must be called on the Event Loop thread.
+		*/
+		bool RemoveTimer(TimerContext *context);
+
+		/*!
+		Get the time cached at the beginning of the current iteration
+		@return the cached time in millisecond
+		@remark the time wraps around like GetTickCount.
+		*/
+		unsigned int GetCachedTime() const;
+
+		/*!
+		Set the wait time for the thread termination
+		@param[in] milliSec the time for waiting in millisecond
+		*/
+		void SetWaitTime(unsigned int milliSec);
+
+		/*!
+		Get the wait time for the thread termination
+		@return the current time for waiting in millisecond
+		*/
+		unsigned int GetWaitTime() const;
+
+	private:
+		/*!
+		Enumerator for the completion key
+		*/
+		enum EventLoopKey{
+			/// Key for the socket operations
+			EVENT_LOOP_KEY_DEFAULT=0,
+			/// Key to stop the Event Loop
+			EVENT_LOOP_KEY_STOP,
+		};
+
+		/*!
+		@struct CompletionEntry epEventLoop.h
+		@brief A struct for the completion dequeued.
+		*/
+		struct CompletionEntry{
+			/// the overlapped structure of the completion
+			OVERLAPPED *m_overlapped;
+			/// the completion key
+			ULONG_PTR m_completionKey;
+			/// the number of bytes transferred
+			unsigned int m_transferredByte;
+			/// the flag whether the operation succeeded
+			bool m_isSucceeded;
+		};
+
+		/*!
+		Dispatch Loop Function
+		*/
+		virtual void execute();
+
+		/*!
+		Called when the thread terminated.
+		@param[in] exitCode the exit code of the thread
+		@param[in] isInDeletion the flag whether the thread class is in deletion or not
+		@remark returns the buffers cached by the thread exiting to the Buffer Pool.
+		*/
+		virtual void onTerminated(unsigned long exitCode,bool isInDeletion=false);
+
+		/*!
+		Dispatch the given completion to its callback object
+		@param[in] overlapped the overlapped structure of the completion
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		*/
+		void dispatch(OVERLAPPED *overlapped,unsigned int transferredByte,bool isSucceeded);
+
+		/*!
+		Dequeue the completions queued up to EVENT_LOOP_COMPLETION_BATCH_COUNT
+		@param[out] entryList the array to store the completions dequeued
+		@param[out] retEntryCount the number of the completions dequeued
+		@param[in] waitTime the time in millisecond to wait for the first completion
+		@return false if the completion port is closed otherwise true
+		@remark retEntryCount is 0 if timed out.
+		*/
+		bool dequeue(CompletionEntry *entryList,unsigned int &retEntryCount,DWORD waitTime);
+
+		/*!
+		Update the cached time
+		@remark the time elapsed while no timer is pending is discarded, so the timers added by the completions dispatched next count from now.
+		*/
+		void updateTime();
+
+		/*!
+		Advance the Timing Wheel by the time elapsed, and dispatch the timers expired
+		*/
+		void expireTimers();
+
+		/*!
+		Dispatch all the timers pending with failure
+		*/
+		void clearTimers();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Event Loop
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		EventLoop(const EventLoop& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		EventLoop & operator=(const EventLoop&b){return *this;}
+
+	private:
+		/// Completion port handle
+		HANDLE m_completionPort;
+		/// flag whether the Event Loop is stopping
+		bool m_isStopping;
+		/// number of the operations not dispatched yet
+		volatile LONG m_pendingIoCount;
+
+		/// Wait Time in Milliseconds
+		unsigned int m_waitTime;
+
+		/// general lock
+		epl::BaseLock *m_loopLock;
+
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+
+		/// Timing Wheel of the timers
+		TimingWheel m_timingWheel;
+		/// Time cached at the beginning of the current iteration
+		volatile unsigned int m_cachedTime;
+		/// Time elapsed in millisecond not yet advanced in the Timing Wheel
+		unsigned int m_elapsedMilliSec;
+	};
+}
+#endif //__EP_EVENT_LOOP_H__
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*! 
+@file epEventLoopGroup.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Event Loop Group Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Event Loop Group.
+
+*/
+#ifndef __EP_EVENT_LOOP_GROUP_H__
+#define __EP_EVENT_LOOP_GROUP_H__
+
+#include "epServerEngine.h"
+#include "epEventLoop.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class EventLoopGroup epEventLoopGroup.h
+	@brief A class for Event Loop Group.
+
+	A fixed set of Event Loops handing out a loop per socket in round-robin order.
+	*/
+	class EP_SERVER_ENGINE EventLoopGroup{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Event Loop Group
+		@param[in] waitTimeMilliSec wait time for Event Loop Thread to terminate
+		@param[in] lockPolicyType The lock policy
+		*/
+		EventLoopGroup(unsigned int waitTimeMilliSec=WAITTIME_INIFINITE,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Event Loop Group
+		*/
+		virtual ~EventLoopGroup();
+
+		/*!
+		Start the Event Loops
+		@param[in] eventLoopCount the number of Event Loops (0 for the number of cores)
+		@return true if at least one Event Loop is started otherwise false
+		@remark the Event Loops previously started are stopped first.
+		*/
+		bool StartLoops(unsigned int eventLoopCount=0);
+
+		/*!
+		Stop and delete all the Event Loops
+		*/
+		void StopLoops();
+
+		/*!
+		Get the Event Loop for the new socket in round-robin order
+		@return the Event Loop for the new socket
+		@remark returns NULL if no Event Loop is started.
+		*/
+		EventLoop *GetEventLoop();
+
+		/*!
+		Returns the number of Event Loops started
+		@return the number of Event Loops started
+		*/
+		size_t Count() const;
+
+		/*!
+		Set the wait time for the thread termination
+		@param[in] milliSec the time for waiting in millisecond
+		*/
+		void SetWaitTime(unsigned int milliSec);
+
+		/*!
+		Get the wait time for the thread termination
+		@return the current time for waiting in millisecond
+		*/
+		unsigned int GetWaitTime() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Event Loop Group
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		EventLoopGroup(const EventLoopGroup& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		EventLoopGroup & operator=(const EventLoopGroup&b){return *this;}
+
+	private:
+		/// Event Loop list
+		vector<EventLoop*> m_eventLoopList;
+
+		/// Index of the Event Loop for the next socket
+		unsigned int m_nextEventLoopIdx;
+
+		/// Wait Time in Milliseconds
+		unsigned int m_waitTime;
+
+		/// list lock
+		epl::BaseLock *m_listLock;
+
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+	};
+}
+#endif //__EP_EVENT_LOOP_GROUP_H__
\ No newline at end of file
@@ -0,0 +1,187 @@
+/*! 
+@file epEventTcpServer.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Event TCP Server Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Event TCP Server.
+
+*/
+#ifndef __EP_EVENT_TCP_SERVER_H__
+#define __EP_EVENT_TCP_SERVER_H__
+
+#include "epServerEngine.h"
+#include "epBaseTcpServer.h"
+#include "epEventLoopGroup.h"
+#include "epEventTcpShard.h"
+#include "epTimerList.h"
+#include "epSocketPool.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class EventTcpServer epEventTcpServer.h
+	@brief A class for Event TCP Server.
+
+	All the accepted sockets are driven by a small fixed set of Event Loops
+	instead of a thread per connection.
+	In the shard-per-core mode, each shard accepts from the listening socket
+	by itself, and owns its Event Loop and the accepted sockets.
+	*/
+	class EP_SERVER_ENGINE EventTcpServer:public BaseTcpServer, public TimerCallbackInterface{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Server
+		@param[in] lockPolicyType The lock policy
+		*/
+		EventTcpServer(epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Server
+		@param[in] b the second object
+		*/
+		EventTcpServer(const EventTcpServer& b);
+		/*!
+		Default Destructor
+
+		Destroy the Server
+		*/
+		virtual ~EventTcpServer();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		EventTcpServer & operator=(const EventTcpServer&b);
+
+		/*!
+		Start the server
+		@param[in] ops the server options
+		@return true if successfully started otherwise false
+		@remark if argument is NULL then previously setting value is used
+		@remark ops.workerThreadCount is the number of Event Loops. (0 for the number of cores)
+		*/
+		virtual bool StartServer(const ServerOps &ops=ServerOps::defaultServerOps);
+
+		/*!
+		Stop the server
+		*/
+		virtual void StopServer();
+
+		/*!
+		Get the number of the shards
+		@return the number of the shards
+		@remark returns 0 if the server is not in the shard-per-core mode.
+		*/
+		unsigned int GetShardCount() const;
+
+		/*!
+		Post the message to the given shard
+		@param[in] fromShardIndex the index of the shard sending the message
+		@param[in] toShardIndex the index of the shard to receive the message
+		@param[in] message the message to post
+		@return true if successfully posted otherwise false
+		@remark must be called on the Event Loop thread of the shard sending the message.
+		@remark the message is delivered by OnShardMessage on the Event Loop thread of the receiving shard.
+		*/
+		bool PostToShard(unsigned int fromShardIndex,unsigned int toShardIndex,Packet *message);
+
+		/*!
+		Schedule the timer to call OnTimer of the callback object
+		@param[in] delayMilliSec the delay in millisecond to expire
+		@param[in] periodMilliSec the period in millisecond to expire again after the first (0 to expire once)
+		@param[in] shardIndex the index of the shard to expire the timer on
+		@return the id of the timer, or TIMER_ID_NONE if failed
+		@remark the server must be started.
+		@remark shardIndex is ignored if the server is not in the shard-per-core mode.
+		*/
+		unsigned int ScheduleTimer(unsigned int delayMilliSec,unsigned int periodMilliSec=0,unsigned int shardIndex=0);
+
+		/*!
+		Cancel the timer
+		@param[in] timerId the id of the timer to cancel
+		@return true if the timer is cancelled otherwise false
+		*/
+		bool CancelTimer(unsigned int timerId);
+
+	private:
+		friend class EventTcpShard;
+
+		/*!
+		Called when the timer scheduled by the server is expired.
+		@param[in] timer the expired timer
+		*/
+		virtual void OnTimer(Timer *timer);
+
+		/*!
+		Listening Loop Function
+		*/
+		virtual void execute() ;
+
+		/*!
+		Accept the sockets until the listening socket is closed
+		@param[in] shard the shard to own the accepted sockets
+		@remark if shard is NULL, the sockets are owned by the server and driven by the Event Loop Group.
+		*/
+		void acceptLoop(EventTcpShard *shard);
+
+		/*!
+		Stop and delete all the shards
+		*/
+		void deleteShards();
+
+		/// Event Loops driving the sockets
+		EventLoopGroup m_eventLoopGroup;
+
+		/// Flag whether the server is in the shard-per-core mode
+		bool m_isShardPerCore;
+		/// Shards of the server
+		vector<EventTcpShard*> m_shardList;
+
+		/// Timers scheduled by the server
+		TimerList m_timerList;
+
+		/// Disconnected sockets to recycle
+		SocketPool m_socketPool;
+
+	};
+}
+#endif //__EP_EVENT_TCP_SERVER_H__
\ No newline at end of file
@@ -0,0 +1,191 @@
+/*! 
+@file epEventTcpShard.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Event TCP Shard Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Event TCP Shard.
+
+*/
+#ifndef __EP_EVENT_TCP_SHARD_H__
+#define __EP_EVENT_TCP_SHARD_H__
+
+#include "epServerEngine.h"
+#include "epEventLoop.h"
+#include "epServerObjectList.h"
+#include "epShardChannel.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	class EventTcpServer;
+
+	/*! 
+	@class EventTcpShard epEventTcpShard.h
+	@brief A class for Event TCP Shard.
+
+	The shard owns its acceptor thread, its Event Loop and its socket list,
+	so the accepted sockets never share the state with the other shards.
+	The shards talk to each other only through the Shard Channels.
+	*/
+	class EP_SERVER_ENGINE EventTcpShard:protected epl::Thread, public EventLoopCallbackInterface{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Shard
+		@param[in] server the server owning this shard
+		@param[in] shardIndex the index of this shard
+		@param[in] shardCount the number of the shards of the server
+		@param[in] waitTimeMilliSec wait time for the threads to terminate
+		@param[in] lockPolicyType The lock policy
+		*/
+		EventTcpShard(EventTcpServer *server,unsigned int shardIndex,unsigned int shardCount,unsigned int waitTimeMilliSec=WAITTIME_INIFINITE,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Shard
+		*/
+		virtual ~EventTcpShard();
+
+		/*!
+		Start the Event Loop and the acceptor of the shard
+		@return true if successfully started otherwise false
+		*/
+		bool StartShard();
+
+		/*!
+		Stop the acceptor, kill all the sockets of the shard, and stop the Event Loop
+		@remark the listening socket must be closed before to stop the acceptor.
+		*/
+		void StopShard();
+
+		/*!
+		Wait for the acceptor of the shard to terminate
+		@param[in] waitTimeInMilliSec wait time in millisecond
+		*/
+		void WaitForAcceptor(unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE);
+
+		/*!
+		Get the index of the shard
+		@return the index of the shard
+		*/
+		unsigned int GetShardIndex() const;
+
+		/*!
+		Get the id of the Event Loop thread of the shard
+		@return the id of the Event Loop thread of the shard
+		*/
+		unsigned int GetLoopThreadId() const;
+
+		/*!
+		Post the message from the given shard to this shard
+		@param[in] fromShardIndex the index of the shard sending the message
+		@param[in] message the message to post
+		@return true if successfully posted otherwise false
+		@remark must be called on the Event Loop thread of the shard sending the message.
+		@remark fails when the channel from the sending shard is full.
+		*/
+		bool PostMessage(unsigned int fromShardIndex,Packet *message);
+
+		/*!
+		Called when the operation with given context is completed.
+		@param[in] context the context of the completed operation
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded);
+
+	private:
+		friend class EventTcpServer;
+
+		/*!
+		Accepting Loop Function
+		*/
+		virtual void execute();
+
+		/*!
+		Kill the connection of the given socket
+		@param[in] socketObj the socket to kill
+		@param[in] argCount the number of the arguments
+		@param[in] args the arguments
+		*/
+		static void killConnection(BaseServerObject *socketObj,unsigned int argCount,va_list args);
+
+		/*!
+		Deliver all the messages in the channels to the callback object
+		*/
+		void drainMessages();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Shard
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		EventTcpShard(const EventTcpShard& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		EventTcpShard & operator=(const EventTcpShard&b){return *this;}
+
+	private:
+		/// Server owning this shard
+		EventTcpServer *m_server;
+		/// Index of this shard
+		unsigned int m_shardIndex;
+		/// Wait Time in Milliseconds
+		unsigned int m_waitTime;
+
+		/// Event Loop driving the sockets of this shard
+		EventLoop m_eventLoop;
+		/// Sockets accepted by this shard
+		ServerObjectList m_socketList;
+
+		/// Channels of the messages to this shard, one per sending shard
+		vector<ShardChannel*> m_channelList;
+		/// Context for the request to deliver the messages
+		IoContext m_messageContext;
+		/// Flag whether the request to deliver the messages is pending
+		volatile LONG m_isMessageScheduled;
+	};
+}
+#endif //__EP_EVENT_TCP_SHARD_H__
\ No newline at end of file
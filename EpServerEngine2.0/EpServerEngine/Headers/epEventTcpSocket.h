@@ -0,0 +1,283 @@
+/*! 
+@file epEventTcpSocket.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Event TCP Socket Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Event TCP Socket.
+
+*/
+#ifndef __EP_EVENT_TCP_SOCKET_H__
+#define __EP_EVENT_TCP_SOCKET_H__
+
+#include "epServerEngine.h"
+#include "epBaseTcpSocket.h"
+#include "epEventLoop.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse
+{
+
+	/*! 
+	@class EventTcpSocket epEventTcpSocket.h
+	@brief A class for Event TCP Socket.
+
+	The socket does not own a thread. It is driven by the Event Loop it is
+	assigned to: a zero-byte overlapped receive reports when the data is
+	available, and then the socket reads without blocking until the kernel
+	buffer is drained, then re-arms the zero-byte receive.
+	*/
+	class EP_SERVER_ENGINE EventTcpSocket:public BaseTcpSocket, public EventLoopCallbackInterface
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Socket
+		@param[in] callBackObj the callback object
+		@param[in] eventLoop the Event Loop to drive this socket
+		@param[in] waitTimeMilliSec wait time for Socket Thread to terminate
+		@param[in] lockPolicyType The lock policy
+		*/
+		EventTcpSocket(ServerCallbackInterface *callBackObj,EventLoop *eventLoop,unsigned int waitTimeMilliSec=WAITTIME_INIFINITE,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Socket
+		*/
+		virtual ~EventTcpSocket();
+
+		/*!
+		Check if the connection is alive
+		@return true if the connection is alive otherwise false
+		*/
+		virtual bool IsConnectionAlive() const;
+
+		/*!
+		Kill the connection
+		*/
+		virtual void KillConnection();
+
+		/*!
+		Send the packet to the client
+		@param[in] packet the packet to be sent
+		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
+		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark never blocks. The packet is pushed to the lock-free send queue, and written by the Event Loop.
+		@remark the packet with isMoreComing is written together with the next packet sent without it.
+		*/
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
+
+		/*!
+		Get the index of the shard owning this socket
+		@return the index of the shard
+		@remark returns 0 if the server is not in the shard-per-core mode.
+		*/
+		unsigned int GetShardIndex() const;
+
+		/*!
+		Called when the operation with given context is completed.
+		@param[in] context the context of the completed operation
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded);
+
+	private:
+		friend class EventTcpServer;
+
+		/*!
+		Enumerator for the operation type
+		*/
+		enum EventTcpOperation{
+			/// Connection start
+			EVENT_TCP_OPERATION_START=0,
+			/// Zero-byte receive for readiness
+			EVENT_TCP_OPERATION_READ,
+			/// Overlapped send of the queued data
+			EVENT_TCP_OPERATION_WRITE,
+			/// Request to drain the send queue
+			EVENT_TCP_OPERATION_FLUSH,
+		};
+
+		/*! 
+		@struct ReceivedItem epEventTcpSocket.h
+		@brief A struct for the packet or the chunk received, delivered after the lock is released.
+		*/
+		struct ReceivedItem{
+			/// packet received, or the copy of the chunk
+			Packet *m_packet;
+			/// flag whether the item is the chunk of the larger packet
+			bool m_isChunk;
+			/// offset of the chunk in the packet
+			unsigned int m_chunkOffset;
+			/// flag whether the chunk is the last of the packet
+			bool m_isLastChunk;
+		};
+
+		/*!
+		Set the Event Loop to drive the socket
+		@param[in] eventLoop the Event Loop to drive this socket
+		@remark used when the socket is recycled for a new connection.
+		*/
+		void setEventLoop(EventLoop *eventLoop);
+
+		/*!
+		Reset the state of the previous connection to recycle this socket.
+		*/
+		virtual void resetConnection();
+
+		/*!
+		Register the socket to the Event Loop and start the connection
+		@return true if successfully started otherwise false
+		*/
+		bool startConnection();
+
+		/*!
+		Actually Kill the connection
+		*/
+		virtual void killConnection();
+
+		/*!
+		Actually Kill the connection without Callback
+		*/
+		virtual void killConnectionNoCallBack();
+
+		/*!
+		thread loop function
+		@remark the Event TCP Socket never starts its thread.
+		*/
+		virtual void execute();
+
+		/*!
+		Post the zero-byte receive to get notified when the data is available
+		@return true if successfully posted otherwise false
+		*/
+		bool armRead();
+
+		/*!
+		Read all available data without blocking and collect the complete packets and chunks
+		@param[out] itemList the complete packets and chunks received in order
+		@return true if the connection is still open otherwise false
+		@remark m_baseSocketLock must be held by the caller, and the connection is not killed here.
+		*/
+		bool readAvailable(vector<ReceivedItem> &itemList);
+
+		/*!
+		Deliver the packets and chunks received to the callback object
+		@param[in] itemList the packets and chunks to deliver
+		@remark must be called without m_baseSocketLock held, and the packets are released.
+		*/
+		void deliverReceived(vector<ReceivedItem> &itemList);
+
+		/*!
+		Post the overlapped send of the queued data
+		@return true if successfully posted otherwise false
+		@remark m_sendLock must be held by the caller.
+		*/
+		bool flushSend();
+
+		/*!
+		Handle the completion of the overlapped send
+		@param[in] transferredByte the number of bytes sent
+		@param[in] isSucceeded the flag whether the send succeeded
+		@return true if the connection is still alive otherwise false
+		*/
+		bool onWriteCompleted(unsigned int transferredByte,bool isSucceeded);
+
+		/*!
+		Request the Event Loop to drain the send queue
+		@return true if successfully requested otherwise false
+		@remark nothing is posted if the request is already pending.
+		*/
+		bool scheduleFlush();
+
+		/*!
+		Drain the send queue and post the overlapped send on the Event Loop
+		*/
+		void onFlushRequested();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Socket
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		EventTcpSocket(const EventTcpSocket& b):BaseTcpSocket(b)
+		{}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		EventTcpSocket & operator=(const EventTcpSocket&b){return *this;}
+
+	private:
+		/// Event Loop driving this socket
+		EventLoop *m_eventLoop;
+		/// Index of the shard owning this socket
+		unsigned int m_shardIndex;
+
+		/// Connection status
+		bool m_isConnected;
+
+		/// Context for the connection start
+		IoContext m_startContext;
+		/// Context for the zero-byte receive
+		IoContext m_readContext;
+		/// Context for the overlapped send
+		IoContext m_writeContext;
+		/// Context for the request to drain the send queue
+		IoContext m_flushContext;
+		/// Flag whether the request to drain the send queue is pending
+		volatile LONG m_isFlushScheduled;
+
+		/// Data drained from the send queue and waiting for the overlapped send
+		vector<char> m_sendBuffer;
+		/// Data of the overlapped send in progress
+		vector<char> m_sendingBuffer;
+		/// Flag whether the overlapped send is in progress
+		bool m_isSending;
+	};
+
+}
+
+#endif //__EP_EVENT_TCP_SOCKET_H__
\ No newline at end of file
@@ -0,0 +1,340 @@
+/*! 
+@file epFrameCodec.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Frame Codec Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Frame Codec.
+
+*/
+#ifndef __EP_FRAME_CODEC_H__
+#define __EP_FRAME_CODEC_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epCompressor.h"
+
+namespace epse{
+
+	/*! 
+	@class FrameCodec epFrameCodec.h
+	@brief A class for Frame Codec.
+
+	The codec writes and parses the header in front of every packet on the
+	TCP stream of a connection. The legacy frame is the 4-byte size field in
+	the host byte order. The compact frame is a byte of the version and the
+	flags, followed by the message type and the size in varints.
+
+	The compact frame is negotiated per connection. The client offers its
+	version in a control frame sent in front of its first packet, and the
+	server answers with a control frame switching to the lower of the two
+	versions in front of its next packet. The client switches as well in
+	front of its next packet, so every direction switches in band.
+
+	The compression is negotiated in the same way. The client offers the id
+	of its dictionary in a control frame, and the server accepts it with the
+	id agreed, which is 0 if the dictionaries differ, and compresses from the
+	next frame. The client compresses once the acceptance is received. The
+	frame compressed is marked by the highest bit of the legacy size field,
+	or the highest bit of the flags field of the compact frame.
+	@remark EncodeHeader must be called in the order the frames are written, and
+	DecodeHeader and ProcessControl in the order the frames are received.
+	*/
+	class EP_SERVER_ENGINE FrameCodec{
+
+	public:
+		/*! 
+		@struct FrameHeader epFrameCodec.h
+		@brief A struct for the frame header parsed.
+		*/
+		struct FrameHeader{
+			/// byte size of the header
+			unsigned int m_headerByteSize;
+			/// byte size of the packet following the header
+			unsigned int m_payloadByteSize;
+			/// message type of the packet
+			unsigned short m_messageType;
+			/// flags of the packet
+			unsigned char m_flags;
+			/// flag whether the frame is the control frame without the packet
+			bool m_isControl;
+			/// code of the control frame
+			unsigned char m_controlCode;
+			/// flag whether the header is not valid, so the stream can not be parsed any further
+			bool m_isCorrupted;
+			/// value carried by the control frame
+			unsigned int m_controlValue;
+			/// flag whether the packet is compressed
+			bool m_isCompressed;
+		};
+
+		/*!
+		Default Constructor
+
+		Initializes the Codec with the legacy frame
+		*/
+		FrameCodec();
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Codec
+		@param[in] b the second object
+		*/
+		FrameCodec(const FrameCodec& b);
+
+		/*!
+		Default Destructor
+
+		Destroy the Codec
+		*/
+		virtual ~FrameCodec();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		FrameCodec & operator=(const FrameCodec&b);
+
+		/*!
+		Reset the codec to the legacy frame for the new connection
+		@param[in] frameVersion the highest version of the frame to negotiate
+		@param[in] isOffering the flag whether to offer the version to the peer
+		@remark the client offers, and the server accepts the offer.
+		@remark FRAME_VERSION_LEGACY does not negotiate at all.
+		*/
+		void Reset(unsigned int frameVersion,bool isOffering);
+
+		/*!
+		Set the compressor to negotiate the compression with
+		@param[in] compressor the compressor (NULL for no compression)
+		@remark must be set before Reset.
+		*/
+		void SetCompressor(Compressor *compressor);
+
+		/*!
+		Check if the frames sent are compressed
+		@return true if the frames sent are compressed otherwise false
+		*/
+		bool IsCompressing() const;
+
+		/*!
+		Check if the frames marked compressed can be received
+		@return true if the compression is negotiated with the compressor otherwise false
+		@remark the frame marked compressed before the negotiation is corrupted.
+		*/
+		bool IsDecompressible() const;
+
+		/*!
+		Get the version of the frame sent
+		@return the version of the frame sent
+		*/
+		unsigned int GetSendVersion() const;
+
+		/*!
+		Get the version of the frame received
+		@return the version of the frame received
+		*/
+		unsigned int GetReceiveVersion() const;
+
+		/*!
+		Write the header of the given packet with the control frames pending in front of it
+		@param[in] packet the packet to write the header of
+		@param[out] retHeader the buffer of FRAME_HEADER_BYTE_SIZE_MAX to write into
+		@return the byte size written
+		*/
+		unsigned int EncodeHeader(const Packet &packet,char *retHeader);
+
+		/*!
+		Write the header of the packet with the control frames pending in front of it
+		@param[in] payloadByteSize the byte size of the packet
+		@param[in] messageType the message type of the packet
+		@param[in] flags the flags of the packet
+		@param[out] retHeader the buffer of FRAME_HEADER_BYTE_SIZE_MAX to write into
+		@return the byte size written
+		*/
+		unsigned int EncodeHeader(unsigned int payloadByteSize,unsigned short messageType,unsigned char flags,char *retHeader);
+
+		/*!
+		Compress the given packet if negotiated, and write its header with the control frames pending in front of it
+		@param[in] packet the packet to write the frame of
+		@param[out] retHeader the buffer of FRAME_HEADER_BYTE_SIZE_MAX to write into
+		@param[out] retCompressedPacket the packet compressed to send instead, or NULL to send the packet given
+		@return the byte size of the header written
+		@remark the caller must call ReleaseObj() for retCompressedPacket to avoid the memory leak.
+		*/
+		unsigned int EncodeFrame(const Packet &packet,char *retHeader,Packet *&retCompressedPacket);
+
+		/*!
+		Compress the given packet if negotiated, and write its header with the control frames pending in front of it
+		@param[in] data the packet to write the frame of
+		@param[in] byteSize the byte size of the packet
+		@param[in] messageType the message type of the packet
+		@param[in] flags the flags of the packet
+		@param[out] retHeader the buffer of FRAME_HEADER_BYTE_SIZE_MAX to write into
+		@param[out] retCompressedPacket the packet compressed to send instead, or NULL to send the packet given
+		@return the byte size of the header written
+		@remark the caller must call ReleaseObj() for retCompressedPacket to avoid the memory leak.
+		*/
+		unsigned int EncodeFrame(const char *data,unsigned int byteSize,unsigned short messageType,unsigned char flags,char *retHeader,Packet *&retCompressedPacket);
+
+		/*!
+		Decompress the packet of the frame marked compressed
+		@param[in] data the packet received
+		@param[in] byteSize the byte size of the packet
+		@param[in] maxByteSize the maximum byte size of the packet decompressed
+		@return the packet decompressed, or NULL if the packet is corrupted or too large
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *DecompressPayload(const char *data,unsigned int byteSize,unsigned int maxByteSize=FRAME_BYTE_SIZE_UNLIMITED);
+
+		/*!
+		Parse the header at the front of the given data
+		@param[in] data the data received
+		@param[in] byteSize the byte size of the data
+		@param[out] retHeader the header parsed
+		@return true if the header is complete otherwise false
+		@remark the complete header may be corrupted, so check m_isCorrupted of the header parsed.
+		*/
+		bool DecodeHeader(const char *data,unsigned int byteSize,FrameHeader &retHeader) const;
+
+		/*!
+		Apply the control frame received
+		@param[in] header the header of the control frame
+		@return true if applied otherwise false
+		@remark the unknown control frame or version is the corrupted stream, so the connection must be closed.
+		*/
+		bool ProcessControl(const FrameHeader &header);
+
+		/*!
+		Write the legacy header of the packet
+		@param[in] payloadByteSize the byte size of the packet
+		@param[out] retHeader the buffer to write into
+		@return the byte size written
+		*/
+		static unsigned int EncodeLegacyHeader(unsigned int payloadByteSize,char *retHeader);
+
+		/*!
+		Parse the header of the given version at the front of the given data
+		@param[in] frameVersion the version of the frame
+		@param[in] data the data received
+		@param[in] byteSize the byte size of the data
+		@param[out] retHeader the header parsed
+		@return true if the header is complete otherwise false
+		@remark the complete header may be corrupted, so check m_isCorrupted of the header parsed.
+		*/
+		static bool DecodeHeader(unsigned int frameVersion,const char *data,unsigned int byteSize,FrameHeader &retHeader);
+
+	private:
+		/*!
+		Enumerator for the control frame
+		*/
+		enum FrameControl{
+			/// Kind of the control frame offering the version
+			FRAME_CONTROL_OFFER=1,
+			/// Kind of the control frame switching to the version
+			FRAME_CONTROL_SWITCH,
+			/// Kind of the control frame offering or accepting the compression with the dictionary id
+			FRAME_CONTROL_COMPRESSION,
+			/// Byte size of the control frame (size field and code)
+			FRAME_CONTROL_BYTE_SIZE=5,
+			/// Byte size of the control frame carrying the value
+			FRAME_CONTROL_VALUE_BYTE_SIZE=9,
+			/// Byte size of the legacy header
+			FRAME_LEGACY_HEADER_BYTE_SIZE=4,
+			/// Method of the compression carried in the code of the control frame
+			FRAME_COMPRESSION_METHOD_LZ=1,
+			/// Bit of the flags field marking the compact frame compressed
+			FRAME_FLAG_COMPRESSED=0x08,
+		};
+
+		/*!
+		Write the control frame
+		@param[in] kind the kind of the control frame
+		@param[in] frameVersion the version carried
+		@param[out] retHeader the buffer to write into
+		@return the byte size written
+		*/
+		static unsigned int encodeControl(unsigned int kind,unsigned int frameVersion,char *retHeader);
+
+		/*!
+		Write the control frame carrying the value
+		@param[in] kind the kind of the control frame
+		@param[in] code the code in the kind
+		@param[in] value the value carried
+		@param[out] retHeader the buffer to write into
+		@return the byte size written
+		*/
+		static unsigned int encodeControl(unsigned int kind,unsigned int code,unsigned int value,char *retHeader);
+
+		/*!
+		Write the control frames pending and the header of the packet
+		@param[in] payloadByteSize the byte size of the packet
+		@param[in] messageType the message type of the packet
+		@param[in] flags the flags of the packet
+		@param[in] isCompressed the flag whether the packet is compressed
+		@param[out] retHeader the buffer of FRAME_HEADER_BYTE_SIZE_MAX to write into
+		@return the byte size written
+		*/
+		unsigned int encodeHeader(unsigned int payloadByteSize,unsigned short messageType,unsigned char flags,bool isCompressed,char *retHeader);
+
+	private:
+		/// highest version of the frame to negotiate
+		unsigned int m_frameVersion;
+		/// flag whether to offer the version to the peer
+		bool m_isOffering;
+		/// flag whether the offer is not sent yet
+		volatile LONG m_isOfferPending;
+		/// version to switch the frame sent to in front of the next packet
+		volatile LONG m_pendingSendVersion;
+		/// version of the frame sent
+		volatile unsigned int m_sendVersion;
+		/// version of the frame received
+		unsigned int m_receiveVersion;
+
+		/// compressor to negotiate the compression with
+		Compressor *m_compressor;
+		/// flag whether the compression offer is not sent yet
+		volatile LONG m_isCompressionOfferPending;
+		/// flag whether the compression acceptance is not sent yet
+		volatile LONG m_isCompressionAcceptPending;
+		/// dictionary id accepted
+		unsigned int m_acceptedDictionaryId;
+		/// flag whether the compression is negotiated
+		volatile LONG m_isCompressing;
+		/// flag whether the dictionary is agreed with the peer
+		volatile LONG m_isDictionaryAgreed;
+	};
+}
+
+#endif //__EP_FRAME_CODEC_H__
\ No newline at end of file
@@ -40,13 +40,14 @@ An Interface for IOCP Server Job.
 
 #include "epServerEngine.h"
 #include "epBaseSocket.h"
+#include "epEventLoop.h"
 
 namespace epse{
 		/*! 
 	@class IocpServerJob epIocpServerJob.h
 	@brief A class for IOCP SERVER Job.
 	*/
-	class EP_SERVER_ENGINE IocpServerJob:public BaseJob{
+	class EP_SERVER_ENGINE IocpServerJob:public BaseJob, public EventLoopCallbackInterface{
 
 	public:
 		/// Enumerator for server job type
@@ -123,6 +124,34 @@ namespace epse{
 		*/
 		ServerCallbackInterface *GetCallBackObject();
 
+		/*!
+		Return the context for the overlapped operation of this object
+		@return the pointer to the context
+		*/
+		IoContext *GetIoContext();
+
+		/*!
+		Notify the completion of the send job
+		@param[in] status the status of the send
+		*/
+		void CompleteSend(SendStatus status);
+
+		/*!
+		Notify the completion of the receive job
+		@param[in] receivedPacket the packet received
+		@param[in] status the status of the receive
+		*/
+		void CompleteReceive(const Packet *receivedPacket,ReceiveStatus status);
+
+		/*!
+		Called when the overlapped operation of this job is completed.
+		@param[in] context the context of the completed operation
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		@remark releases the reference held by the operation.
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded);
+
 
 	protected:
 		/// pointer to the packet
@@ -139,6 +168,19 @@ namespace epse{
 
 		/// callback object for job completion
 		ServerCallbackInterface *m_callBackObj;
+		/// context for the overlapped operation
+		IoContext m_ioContext;
+		/// byte size of the packet
+		unsigned int m_packetByteSize;
+		/// frame header sent in front of the packet
+		char m_frameHeader[FRAME_HEADER_BYTE_SIZE_MAX];
+		/// byte size of the frame header
+		unsigned int m_frameHeaderByteSize;
+		/// packet compressed sent in place of the packet
+		Packet *m_compressedPacket;
+	private:
+		friend class IocpTcpSocket;
+		friend class IocpUdpSocket;
 
 	};
 }
@@ -40,6 +40,7 @@ An Interface for IOCP TCP Client.
 
 #include "epServerEngine.h"
 #include "epBaseTcpClient.h"
+#include "epJobScheduler.h"
 
 #include <vector>
 #include <queue>
@@ -52,7 +53,7 @@ namespace epse{
 	@class IocpTcpClient epIocpTcpClient.h
 	@brief A class for IOCP TCP Client.
 	*/
-	class EP_SERVER_ENGINE IocpTcpClient:public BaseTcpClient, public WorkerThreadDelegate{
+	class EP_SERVER_ENGINE IocpTcpClient:public BaseTcpClient{
 	public:
 		/*!
 		Default Constructor
@@ -131,10 +132,11 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
 
 		/*!
 		Receive the packet from the server
@@ -157,12 +159,6 @@ namespace epse{
 		void disconnect();
 
 	private:
-		/*!
-		Call Back Function.
-		@param[in] p the argument for call back function.
-		*/
-		virtual void CallBackFunc(BaseWorkerThread *p);
-
 		/*!
 		Add new job to the worker thread.
 		@param[in] job the job to push to the worker thread.
@@ -172,13 +168,8 @@ namespace epse{
 		/// Status for connection
 		bool m_isConnected;
 
-		/// general lock 
-		epl::BaseLock *m_workerLock;
-
-		/// Worker thread list
-		vector<BaseWorkerThread*> m_workerList;
-		/// worker thread list with no job
-		queue<BaseWorkerThread*> m_emptyWorkerList;
+		/// Work-stealing scheduler of the worker threads
+		JobScheduler m_jobScheduler;
 
 	};
 }
@@ -41,13 +41,17 @@ An Interface for IOCP TCP Server.
 
 #include "epServerEngine.h"
 #include "epBaseTcpServer.h"
+#include "epEventLoopGroup.h"
+#include "epTimerList.h"
+#include "epSocketPool.h"
+#include "epJobScheduler.h"
 
 namespace epse{
 		/*! 
 	@class IocpTcpServer epIocpTcpServer.h
 	@brief A class for IOCP TCP Server.
 	*/
-	class EP_SERVER_ENGINE IocpTcpServer:public BaseTcpServer, public WorkerThreadDelegate{
+	class EP_SERVER_ENGINE IocpTcpServer:public BaseTcpServer, public TimerCallbackInterface{
 		public:
 		/*!
 		Default Constructor
@@ -91,15 +95,32 @@ namespace epse{
 		Stop the server
 		*/
 		virtual void StopServer();
+
+		/*!
+		Schedule the timer to call OnTimer of the callback object
+		@param[in] delayMilliSec the delay in millisecond to expire
+		@param[in] periodMilliSec the period in millisecond to expire again after the first (0 to expire once)
+		@return the id of the timer, or TIMER_ID_NONE if failed
+		@remark the server must be started.
+		*/
+		unsigned int ScheduleTimer(unsigned int delayMilliSec,unsigned int periodMilliSec=0);
+
+		/*!
+		Cancel the timer
+		@param[in] timerId the id of the timer to cancel
+		@return true if the timer is cancelled otherwise false
+		*/
+		bool CancelTimer(unsigned int timerId);
 	private:
 
-			
 		/*!
-		Call Back Function.
-		@param[in] p the argument for call back function.
+		Called when the timer scheduled by the server is expired.
+		@param[in] timer the expired timer
 		*/
-		virtual void CallBackFunc(BaseWorkerThread *p);
+		virtual void OnTimer(Timer *timer);
+
 
+			
 		friend class IocpTcpSocket;
 
 		/*!
@@ -113,13 +134,17 @@ namespace epse{
 		*/
 		virtual void execute() ;
 
-		/// general lock 
-		epl::BaseLock *m_workerLock;
+		/// Work-stealing scheduler of the worker threads
+		JobScheduler m_jobScheduler;
+
+		/// Event Loops dispatching the completions of the overlapped operations
+		EventLoopGroup m_eventLoopGroup;
+
+		/// Timers scheduled by the server
+		TimerList m_timerList;
 
-		/// Worker thread list
-		vector<BaseWorkerThread*> m_workerList;
-		/// worker thread list with no job
-		queue<BaseWorkerThread*> m_emptyWorkerList;
+		/// Disconnected sockets to recycle
+		SocketPool m_socketPool;
 
 	};
 }
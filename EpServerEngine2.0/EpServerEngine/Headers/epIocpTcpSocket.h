@@ -40,6 +40,10 @@ An Interface for IOCP TCP Socket.
 
 #include "epServerEngine.h"
 #include "epBaseTcpSocket.h"
+#include "epEventLoop.h"
+#include <queue>
+
+using namespace std;
 
 namespace epse
 {
@@ -113,10 +117,11 @@ namespace epse
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
 
 
 		/*!
@@ -144,6 +149,57 @@ namespace epse
 		*/
 		virtual void execute();
 
+		/*!
+		Submit the overlapped operation for the given job
+		@param[in] job the send or receive job to submit
+		*/
+		virtual void submitJob(IocpServerJob *job);
+
+		/*!
+		Handle the completion of the overlapped operation for the given job
+		@param[in] job the job whose operation is completed
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		*/
+		virtual void completeJob(IocpServerJob *job,unsigned int transferredByte,bool isSucceeded);
+
+		/*!
+		Reset the state of the previous connection to recycle this socket.
+		*/
+		virtual void resetConnection();
+
+		/*!
+		Post the overlapped send of the packet of the given job
+		@param[in] job the send job
+		*/
+		void postSend(IocpServerJob *job);
+
+		/*!
+		Complete the send job, and stop accounting its packet in the send queue
+		@param[in] job the send job
+		@param[in] status the status of Send
+		*/
+		void completeSend(IocpServerJob *job,SendStatus status);
+
+		/*!
+		Post the overlapped receive for the first receive job waiting
+		@return true if successfully posted otherwise false
+		@remark m_baseSocketLock must be held by the caller.
+		*/
+		bool postReceive();
+
+		/*!
+		Complete all the receive jobs waiting with the given status
+		@param[in] status the status to complete the first job with
+		@remark the rest of the jobs are completed with RECEIVE_STATUS_FAIL_NOT_CONNECTED.
+		*/
+		void failReceiveJobs(ReceiveStatus status);
+		/*!
+		Set the Event Loop completing the overlapped operations of the socket
+		@param[in] eventLoop the Event Loop
+		*/
+		void setEventLoop(EventLoop *eventLoop);
+
 		
 	private:
 		/*!
@@ -169,6 +225,13 @@ namespace epse
 
 		/// Connection status
 		bool m_isConnected;
+
+		/// Receive jobs waiting in order
+		/// @remark only the first job has the overlapped receive in progress.
+		queue<IocpServerJob*> m_receiveJobList;
+
+		/// Event Loop completing the overlapped operations
+		EventLoop *m_eventLoop;
 	};
 
 }
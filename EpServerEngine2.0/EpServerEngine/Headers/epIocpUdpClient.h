@@ -40,6 +40,7 @@ An Interface for IOCP UDP Client.
 
 #include "epServerEngine.h"
 #include "epBaseUdpClient.h"
+#include "epJobScheduler.h"
 
 #include <vector>
 #include <queue>
@@ -52,7 +53,7 @@ namespace epse{
 	@class IocpUdpClient epIocpUdpClient.h
 	@brief A class for IOCP UDP Client.
 	*/
-	class EP_SERVER_ENGINE IocpUdpClient:public BaseUdpClient, public WorkerThreadDelegate{
+	class EP_SERVER_ENGINE IocpUdpClient:public BaseUdpClient{
 
 	public:
 		/*!
@@ -133,10 +134,11 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
 	
 		/*!
 		Receive the packet from the server
@@ -159,12 +161,6 @@ namespace epse{
 		void disconnect();
 
 	private:
-		/*!
-		Call Back Function.
-		@param[in] p the argument for call back function.
-		*/
-		virtual void CallBackFunc(BaseWorkerThread *p);
-
 		/*!
 		Add new job to the worker thread.
 		@param[in] job the job to push to the worker thread.
@@ -174,13 +170,8 @@ namespace epse{
 		/// Flag for connection
 		bool m_isConnected;
 
-		/// general lock 
-		epl::BaseLock *m_workerLock;
-
-		/// Worker thread list
-		vector<BaseWorkerThread*> m_workerList;
-		/// worker thread list with no job
-		queue<BaseWorkerThread*> m_emptyWorkerList;
+		/// Work-stealing scheduler of the worker threads
+		JobScheduler m_jobScheduler;
 	};
 }
 
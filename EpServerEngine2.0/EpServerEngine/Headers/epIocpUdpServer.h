@@ -41,13 +41,44 @@ An Interface for IOCP UDP Server.
 
 #include "epServerEngine.h"
 #include "epBaseUdpServer.h"
+#include "epEventLoopGroup.h"
+#include "epTimerList.h"
+#include "epSocketPool.h"
+#include "epJobScheduler.h"
+#include <mswsock.h>
 
 namespace epse{
+
+	/*! 
+	@struct UdpReceiveContext epIocpUdpServer.h
+	@brief A struct for the overlapped receive of a datagram on the listen socket.
+	*/
+	struct UdpReceiveContext:public IoContext{
+		/// slot of the receive slab to receive the datagram into
+		PacketSlot *m_slot;
+		/// heap buffer to receive the datagram into if all the slots are in use
+		char *m_buffer;
+		/// WSABUF pointing the buffer
+		WSABUF m_wsaBuf;
+		/// address of the sender
+		sockaddr m_sockAddr;
+		/// byte size of the address
+		int m_sockAddrSize;
+		/// flags of the receive
+		DWORD m_flags;
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+		/// message for WSARecvMsg
+		WSAMSG m_msg;
+		/// control buffer receiving the segment size of the coalesced datagrams
+		ULONG_PTR m_controlBuffer[8];
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	};
+
 		/*! 
 	@class IocpUdpServer epIocpUdpServer.h
 	@brief A class for IOCP UDP Server.
 	*/
-	class EP_SERVER_ENGINE IocpUdpServer:public BaseUdpServer, public WorkerThreadDelegate{
+	class EP_SERVER_ENGINE IocpUdpServer:public BaseUdpServer, public TimerCallbackInterface, public EventLoopCallbackInterface{
 		public:
 		/*!
 		Default Constructor
@@ -91,15 +122,72 @@ namespace epse{
 		Stop the server
 		*/
 		virtual void StopServer();
+
+		/*!
+		Schedule the timer to call OnTimer of the callback object
+		@param[in] delayMilliSec the delay in millisecond to expire
+		@param[in] periodMilliSec the period in millisecond to expire again after the first (0 to expire once)
+		@return the id of the timer, or TIMER_ID_NONE if failed
+		@remark the server must be started.
+		*/
+		unsigned int ScheduleTimer(unsigned int delayMilliSec,unsigned int periodMilliSec=0);
+
+		/*!
+		Cancel the timer
+		@param[in] timerId the id of the timer to cancel
+		@return true if the timer is cancelled otherwise false
+		*/
+		bool CancelTimer(unsigned int timerId);
 	private:
 
-			
 		/*!
-		Call Back Function.
-		@param[in] p the argument for call back function.
+		Called when the timer scheduled by the server is expired.
+		@param[in] timer the expired timer
+		*/
+		virtual void OnTimer(Timer *timer);
+
+		/*!
+		Called when the overlapped receive on the listen socket is completed.
+		@param[in] context the receive context completed
+		@param[in] transferredByte the byte size of the datagram received
+		@param[in] isSucceeded the flag whether the receive succeeded
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded);
+
+		/*!
+		Post the overlapped receive on the listen socket with the given context
+		@param[in] context the receive context
+		@return true if successfully posted otherwise false
+		*/
+		bool postReceive(UdpReceiveContext *context);
+
+		/*!
+		Stop accounting a receive in progress, and wake up the listening thread if none is left
 		*/
-		virtual void CallBackFunc(BaseWorkerThread *p);
+		void finishReceive();
 
+		/*!
+		Deliver the datagram received to the socket of the sender, or accept the sender as new socket
+		@param[in] clientSockAddr the address of the sender
+		@param[in] slot the slot the datagram is received into, or NULL if received into the heap buffer
+		@param[in] packetData the datagram received
+		@param[in] recvLength the byte size of the datagram, or less than or equal to 0 if the receive failed
+		*/
+		void processDatagram(const sockaddr &clientSockAddr,PacketSlot *slot,const char *packetData,int recvLength);
+
+		/*!
+		Delete all the receive contexts
+		*/
+		void deleteReceiveContexts();
+
+		/*!
+		Enable UDP Receive Offload on the listen socket if requested
+		@remark m_recvMsgFunc is left NULL if the network stack does not support it.
+		*/
+		void enableReceiveOffload();
+
+
+			
 		friend class IocpUdpSocket;
 
 		/*!
@@ -113,13 +201,37 @@ namespace epse{
 		*/
 		virtual void execute() ;
 
-		/// general lock 
-		epl::BaseLock *m_workerLock;
+		/// Work-stealing scheduler of the worker threads
+		JobScheduler m_jobScheduler;
+
+		/// Event Loops dispatching the completions of the overlapped operations
+		EventLoopGroup m_eventLoopGroup;
+
+		/// Timers scheduled by the server
+		TimerList m_timerList;
+
+		/// Id of the timer retransmitting the reliable datagrams
+		unsigned int m_reliableTimerId;
+
+		/// Disconnected sockets to recycle
+		SocketPool m_socketPool;
+
+		/// Receive contexts each with its own buffer
+		vector<UdpReceiveContext*> m_receiveContextList;
+
+		/// Number of the receives in progress
+		volatile LONG m_pendingReceiveCount;
+
+		/// Event set when no receive is in progress
+		epl::EventEx m_receiveStoppedEvent;
+
+		/// Event Loop receiving the datagrams and completing the sends
+		EventLoop *m_eventLoop;
 
-		/// Worker thread list
-		vector<BaseWorkerThread*> m_workerList;
-		/// worker thread list with no job
-		queue<BaseWorkerThread*> m_emptyWorkerList;
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+		/// WSARecvMsg receiving the coalesced datagrams with their segment size
+		LPFN_WSARECVMSG m_recvMsgFunc;
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
 
 	};
 }
@@ -40,6 +40,7 @@ An Interface for IOCP UDP Socket.
 
 #include "epServerEngine.h"
 #include "epBaseUdpSocket.h"
+#include "epEventLoop.h"
 
 namespace epse
 {
@@ -108,15 +109,21 @@ namespace epse
 		friend class IocpUdpServer;
 		friend class IocpUdpProcessor;
 
+		/*!
+		Reset the state of the previous connection to recycle this socket.
+		*/
+		virtual void resetConnection();
+
 		/*!
 		Send the packet to the server
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
 		*/
-		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL);
+		int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false);
 
 
 		/*!
@@ -150,6 +157,39 @@ namespace epse
 		*/
 		virtual void addPacket(Packet *packet);
 
+		/*!
+		Submit the overlapped operation for the given job
+		@param[in] job the send or receive job to submit
+		@remark the receive job waits until the packet is added if no packet is received yet.
+		*/
+		virtual void submitJob(IocpServerJob *job);
+
+		/*!
+		Handle the completion of the overlapped operation for the given job
+		@param[in] job the job whose operation is completed
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		*/
+		virtual void completeJob(IocpServerJob *job,unsigned int transferredByte,bool isSucceeded);
+
+		/*!
+		Complete the given receive job with the given packet
+		@param[in] job the receive job
+		@param[in] packet the packet received
+		*/
+		void deliverPacket(IocpServerJob *job,Packet *packet);
+
+		/*!
+		Complete all the receive jobs waiting with RECEIVE_STATUS_FAIL_NOT_CONNECTED
+		*/
+		void failReceiveJobs();
+
+		/*!
+		Set the Event Loop completing the overlapped operations of the socket
+		@param[in] eventLoop the Event Loop
+		*/
+		void setEventLoop(EventLoop *eventLoop);
+
 		
 	private:
 		/*!
@@ -177,6 +217,12 @@ namespace epse
 
 		/// Connection status
 		bool m_isConnected;
+
+		/// Receive jobs waiting for the packet
+		queue<IocpServerJob*> m_receiveJobList;
+
+		/// Event Loop completing the overlapped operations
+		EventLoop *m_eventLoop;
 	};
 
 }
@@ -0,0 +1,133 @@
+/*! 
+@file epJobDeque.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Job Deque Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Job Deque.
+
+*/
+#ifndef __EP_JOB_DEQUE_H__
+#define __EP_JOB_DEQUE_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+
+namespace epse{
+
+	/*! 
+	@class JobDeque epJobDeque.h
+	@brief A class for Job Deque.
+
+	The lock-free bounded work-stealing deque of the jobs owned by a single
+	worker. The owner pushes and pops at the bottom without any contention,
+	while the other workers steal the oldest jobs from the top. Only the last
+	job left is raced for with a compare-and-swap.
+	@remark Push and Pop must be called only from the owner thread, and Steal from any thread.
+	*/
+	class EP_SERVER_ENGINE JobDeque{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Deque
+		@param[in] capacity the number of the jobs the deque can hold
+		@remark the capacity is rounded up to the power of two.
+		*/
+		JobDeque(unsigned int capacity=JOB_QUEUE_CAPACITY_DEFAULT);
+
+		/*!
+		Default Destructor
+
+		Destroy the Deque
+		@remark the jobs not popped are released.
+		*/
+		virtual ~JobDeque();
+
+		/*!
+		Push the job to the bottom of the deque
+		@param[in] job the job to push
+		@return true if pushed otherwise false when the deque is full
+		@remark the deque holds the reference of the job until popped or stolen.
+		*/
+		bool Push(BaseJob *job);
+
+		/*!
+		Pop the last job pushed from the bottom of the deque
+		@return the job or NULL if the deque is empty
+		@remark the caller must call ReleaseObj() for the job to avoid the memory leak.
+		*/
+		BaseJob *Pop();
+
+		/*!
+		Steal the oldest job from the top of the deque
+		@return the job or NULL if the deque is empty or the job is taken by the others
+		@remark the caller must call ReleaseObj() for the job to avoid the memory leak.
+		*/
+		BaseJob *Steal();
+
+		/*!
+		Check if the deque is empty
+		@return true if empty otherwise false
+		*/
+		bool IsEmpty() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Deque
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		JobDeque(const JobDeque& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		JobDeque & operator=(const JobDeque&b){return *this;}
+
+	private:
+		/// ring of the jobs
+		BaseJob **m_ring;
+		/// capacity of the ring
+		unsigned int m_capacity;
+		/// position to steal, advanced only with compare-and-swap
+		volatile LONG m_top;
+		/// position to push, written only by the owner
+		volatile LONG m_bottom;
+	};
+}
+#endif //__EP_JOB_DEQUE_H__
\ No newline at end of file
@@ -0,0 +1,143 @@
+/*! 
+@file epJobPriorityQueue.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Job Priority Queue Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Job Priority Queue.
+
+*/
+#ifndef __EP_JOB_PRIORITY_QUEUE_H__
+#define __EP_JOB_PRIORITY_QUEUE_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epJobRing.h"
+
+namespace epse{
+
+	/*! 
+	@class JobPriorityQueue epJobPriorityQueue.h
+	@brief A class for Job Priority Queue.
+
+	The lock-free queue of the jobs ordered by the priority, which any number
+	of the threads can push to and pop from at the same time. The priorities
+	are mapped to the fixed number of the buckets, each a Job Ring, so both
+	the push and the pop are done in the constant time regardless of the depth
+	of the queue. The jobs in the same bucket are popped in the order pushed.
+	*/
+	class EP_SERVER_ENGINE JobPriorityQueue{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Queue
+		@param[in] capacity the number of the jobs each bucket can hold
+		*/
+		JobPriorityQueue(unsigned int capacity=JOB_QUEUE_CAPACITY_DEFAULT);
+
+		/*!
+		Default Destructor
+
+		Destroy the Queue
+		@remark the jobs not popped are released.
+		*/
+		virtual ~JobPriorityQueue();
+
+		/*!
+		Push the job to the bucket of its priority
+		@param[in] job the job to push
+		@return true if pushed otherwise false when the bucket is full
+		@remark the queue holds the reference of the job until popped.
+		*/
+		bool Push(BaseJob *job);
+
+		/*!
+		Pop the job of the highest priority from the queue
+		@return the job or NULL if the queue is empty
+		@remark the caller must call ReleaseObj() for the job to avoid the memory leak.
+		*/
+		BaseJob *Pop();
+
+		/*!
+		Pop the job of the highest priority from the buckets of the given priority and above
+		@param[in] minPriority the lowest priority to pop
+		@return the job or NULL if no job of the priority given or above
+		@remark the caller must call ReleaseObj() for the job to avoid the memory leak.
+		*/
+		BaseJob *Pop(Priority minPriority);
+
+		/*!
+		Erase the given job from the queue
+		@param[in] job the job to erase
+		@return true if erased otherwise false when the job is not in the queue
+		*/
+		bool Erase(BaseJob *job);
+
+		/*!
+		Check if the queue is empty
+		@return true if empty otherwise false
+		*/
+		bool IsEmpty() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Queue
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		JobPriorityQueue(const JobPriorityQueue& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		JobPriorityQueue & operator=(const JobPriorityQueue&b){return *this;}
+
+		/*!
+		Get the index of the bucket for the given priority
+		@param[in] priority the priority of the job
+		@return the index of the bucket
+		@remark the bucket of the higher priority has the higher index.
+		*/
+		static unsigned int getBucketIdx(Priority priority);
+
+	private:
+		/// buckets from the lowest priority to the highest
+		JobRing *m_buckets[JOB_PRIORITY_BUCKET_COUNT];
+	};
+}
+#endif //__EP_JOB_PRIORITY_QUEUE_H__
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*! 
+@file epJobRing.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Job Ring Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Job Ring.
+
+*/
+#ifndef __EP_JOB_RING_H__
+#define __EP_JOB_RING_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+
+namespace epse{
+
+	/*! 
+	@class JobRing epJobRing.h
+	@brief A class for Job Ring.
+
+	The lock-free bounded ring of the jobs, which any number of the threads
+	can push to and pop from at the same time. Each slot carries the sequence
+	number of the position it is ready for, so the producers and the consumers
+	only race on the position with a single compare-and-swap.
+
+	The job erased is taken out of its slot, and the slot is skipped when popped.
+	*/
+	class EP_SERVER_ENGINE JobRing{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Ring
+		@param[in] capacity the number of the jobs the ring can hold
+		@remark the capacity is rounded up to the power of two.
+		*/
+		JobRing(unsigned int capacity=JOB_QUEUE_CAPACITY_DEFAULT);
+
+		/*!
+		Default Destructor
+
+		Destroy the Ring
+		@remark the jobs not popped are released.
+		*/
+		virtual ~JobRing();
+
+		/*!
+		Push the job to the ring
+		@param[in] job the job to push
+		@return true if pushed otherwise false when the ring is full
+		@remark the ring holds the reference of the job until popped.
+		*/
+		bool Push(BaseJob *job);
+
+		/*!
+		Pop the first job from the ring
+		@return the job or NULL if the ring is empty
+		@remark the caller must call ReleaseObj() for the job to avoid the memory leak.
+		*/
+		BaseJob *Pop();
+
+		/*!
+		Erase the given job from the ring
+		@param[in] job the job to erase
+		@return true if erased otherwise false when the job is not in the ring
+		*/
+		bool Erase(BaseJob *job);
+
+		/*!
+		Check if the ring is empty
+		@return true if empty otherwise false
+		*/
+		bool IsEmpty() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Ring
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		JobRing(const JobRing& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		JobRing & operator=(const JobRing&b){return *this;}
+
+	private:
+		/*! 
+		@struct Slot epJobRing.h
+		@brief A struct for the slot of the ring.
+		*/
+		struct Slot{
+			/// position the slot is ready to be pushed or popped at
+			volatile LONG m_sequence;
+			/// job in the slot, or NULL if erased
+			BaseJob * volatile m_job;
+		};
+
+		/// slots of the ring
+		Slot *m_slots;
+		/// capacity of the ring
+		unsigned int m_capacity;
+		/// position to push
+		volatile LONG m_pushIdx;
+		/// position to pop
+		volatile LONG m_popIdx;
+	};
+}
+#endif //__EP_JOB_RING_H__
\ No newline at end of file
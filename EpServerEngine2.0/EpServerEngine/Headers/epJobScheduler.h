@@ -0,0 +1,278 @@
+/*! 
+@file epJobScheduler.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Job Scheduler Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Job Scheduler.
+
+*/
+#ifndef __EP_JOB_SCHEDULER_H__
+#define __EP_JOB_SCHEDULER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epJobPriorityQueue.h"
+#include "epJobDeque.h"
+#include <vector>
+#include <queue>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class JobScheduler epJobScheduler.h
+	@brief A class for Work-Stealing Job Scheduler.
+
+	A fixed set of the worker threads processing the jobs pushed with the
+	given Job Processor, without any lock shared by the workers.
+
+	Each worker owns a deque for the jobs pushed from its own thread, such as
+	the job re-queuing itself, and an inbox ordered by the priority for the jobs
+	pushed from the other threads and the jobs of the priority above normal.
+	The jobs from the other threads go to the inbox of the worker
+	chosen by the thread pushing, so the same thread keeps feeding the same
+	worker. The worker out of the jobs steals from the deques and the inboxes
+	of the others before it sleeps, and the sleeping worker is woken up when a
+	job is pushed to it or a job is pushed while it could steal one.
+	@remark the jobs of the priority above normal are processed first, while the
+	jobs of the normal priority and below are processed in no particular order
+	of the priority.
+	*/
+	class EP_SERVER_ENGINE JobScheduler{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Job Scheduler
+		@param[in] waitTimeMilliSec wait time for the worker threads to terminate
+		@param[in] lockPolicyType The lock policy
+		*/
+		JobScheduler(unsigned int waitTimeMilliSec=WAITTIME_INIFINITE,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Job Scheduler
+		*/
+		virtual ~JobScheduler();
+
+		/*!
+		Start the worker threads
+		@param[in] workerCount the number of the worker threads (0 for twice the number of cores)
+		@param[in] jobProcessor the Job Processor shared by the worker threads
+		@return true if at least one worker thread is started otherwise false
+		@remark the worker threads previously started are stopped first.
+		*/
+		bool StartWorkers(unsigned int workerCount,BaseJobProcessor *jobProcessor);
+
+		/*!
+		Stop all the worker threads and release the jobs not processed
+		*/
+		void StopWorkers();
+
+		/*!
+		Push the job to be processed by a worker thread
+		@param[in] job the job to push
+		@return true if pushed otherwise false when no worker thread is started
+		@remark the scheduler holds the reference of the job until processed.
+		@remark the worker list is read only while the workers are started, and
+		StopWorkers waits for the threads in Push before the list can be changed.
+		*/
+		bool Push(BaseJob *job);
+
+		/*!
+		Returns the number of the worker threads started
+		@return the number of the worker threads started
+		*/
+		size_t Count() const;
+
+		/*!
+		Set the wait time for the thread termination
+		@param[in] milliSec the time for waiting in millisecond
+		*/
+		void SetWaitTime(unsigned int milliSec);
+
+		/*!
+		Get the wait time for the thread termination
+		@return the current time for waiting in millisecond
+		*/
+		unsigned int GetWaitTime() const;
+
+	private:
+		/*! 
+		@class Worker epJobScheduler.h
+		@brief A class for the worker thread of the Job Scheduler.
+		*/
+		class Worker:public BaseWorkerThread{
+		public:
+			/*!
+			Default Constructor
+
+			Initializes the Worker
+			@param[in] scheduler the Job Scheduler owning the worker
+			@param[in] workerIdx the index of the worker in the scheduler
+			@param[in] lockPolicyType The lock policy
+			*/
+			Worker(JobScheduler *scheduler,unsigned int workerIdx,epl::LockPolicy lockPolicyType);
+
+			/// Job Scheduler owning the worker
+			JobScheduler *m_scheduler;
+			/// index of the worker in the scheduler
+			unsigned int m_workerIdx;
+			/// jobs pushed from the worker thread itself
+			JobDeque m_deque;
+			/// jobs pushed from the other threads or above the normal priority
+			JobPriorityQueue m_inbox;
+			/// number of the jobs the worker looked for
+			unsigned int m_jobCount;
+			/// flag whether the worker is sleeping
+			volatile LONG m_isSleeping;
+			/// event to wake up the worker
+			epl::EventEx m_wakeEvent;
+
+		protected:
+			/*!
+			Process the jobs until the scheduler stops
+			*/
+			virtual void execute();
+		};
+
+		friend class Worker;
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Job Scheduler
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		JobScheduler(const JobScheduler& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		JobScheduler & operator=(const JobScheduler&b){return *this;}
+
+		/*!
+		Find the next job for the given worker
+		@param[in] worker the worker looking for the job
+		@return the job found or NULL if none
+		@remark the caller must call ReleaseObj() for the job to avoid the memory leak.
+		*/
+		BaseJob *findJob(Worker *worker);
+
+		/*!
+		Steal a job from the workers other than the given worker
+		@param[in] worker the worker stealing
+		@return the job stolen or NULL if none
+		*/
+		BaseJob *stealJob(Worker *worker);
+
+		/*!
+		Pop a job pushed while all the queues were full
+		@return the job popped or NULL if none
+		*/
+		BaseJob *popOverflow();
+
+		/*!
+		Check if any job is left to process or steal
+		@return true if any job is left otherwise false
+		*/
+		bool hasJob() const;
+
+		/*!
+		Put the given worker to sleep until woken up
+		@param[in] worker the worker to put to sleep
+		*/
+		void sleep(Worker *worker);
+
+		/*!
+		Wake up the given worker if sleeping, otherwise any sleeping worker to steal
+		@param[in] worker the worker the job is pushed to or NULL
+		*/
+		void wakeUp(Worker *worker);
+
+		/*!
+		Delete all the workers and release the jobs left
+		*/
+		void deleteWorkers();
+
+		/*!
+		Push the job to the workers started
+		@param[in] job the job to push
+		*/
+		void pushJob(BaseJob *job);
+
+	private:
+		/// worker list, changed only while no worker runs and no thread is in Push
+		vector<Worker*> m_workerList;
+
+		/// jobs pushed while all the queues were full
+		queue<BaseJob*> m_overflowList;
+
+		/// number of the jobs in the overflow list
+		volatile LONG m_overflowCount;
+
+		/// number of the workers sleeping
+		volatile LONG m_sleepingCount;
+
+		/// flag whether the worker threads are started
+		volatile LONG m_isStarted;
+
+		/// number of the threads in Push reading the worker list
+		volatile LONG m_pushingCount;
+
+		/// thread local storage index of the worker of the current thread
+		DWORD m_tlsIdx;
+
+		/// Job Processor shared by the workers
+		BaseJobProcessor *m_jobProcessor;
+
+		/// Wait Time in Milliseconds
+		unsigned int m_waitTime;
+
+		/// list lock
+		epl::BaseLock *m_listLock;
+
+		/// overflow list lock
+		epl::BaseLock *m_overflowLock;
+
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+	};
+}
+#endif //__EP_JOB_SCHEDULER_H__
\ No newline at end of file
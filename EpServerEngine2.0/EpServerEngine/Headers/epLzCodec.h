@@ -0,0 +1,176 @@
+/*! 
+@file epLzCodec.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief LZ Codec Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for LZ Codec.
+
+*/
+#ifndef __EP_LZ_CODEC_H__
+#define __EP_LZ_CODEC_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class LzCodec epLzCodec.h
+	@brief A class for LZ Codec.
+
+	A byte-oriented LZ77 codec in the block format of LZ4, tuned for the speed
+	over the ratio. Every sequence is a token of the literal length and the
+	match length, the literals, and the 2-byte offset of the match.
+
+	The codec can be primed with a dictionary of the bytes typical for the
+	packets, so the matches of the small packet can refer to the dictionary
+	as if it were in front of the packet. The hash table of the dictionary is
+	built once, and copied for every packet compressed.
+	*/
+	class EP_SERVER_ENGINE LzCodec{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Codec without the dictionary
+		*/
+		LzCodec();
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Codec
+		@param[in] b the second object
+		*/
+		LzCodec(const LzCodec& b);
+
+		/*!
+		Default Destructor
+
+		Destroy the Codec
+		*/
+		virtual ~LzCodec();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		LzCodec & operator=(const LzCodec&b);
+
+		/*!
+		Set the dictionary
+		@param[in] dictionary the dictionary (NULL to clear)
+		@param[in] byteSize the byte size of the dictionary
+		@remark only the last COMPRESSION_DICTIONARY_BYTE_SIZE_MAX bytes are used.
+		@remark must not be called while compressing or decompressing.
+		*/
+		void SetDictionary(const void *dictionary,unsigned int byteSize);
+
+		/*!
+		Get the id of the dictionary, which is the checksum of the dictionary
+		@return the id of the dictionary, or 0 if there is no dictionary
+		*/
+		unsigned int GetDictionaryId() const;
+
+		/*!
+		Compress the given data
+		@param[in] src the data to compress
+		@param[in] srcByteSize the byte size of the data
+		@param[out] retDst the buffer to write into
+		@param[in] dstByteSize the byte size of the buffer
+		@param[in] useDictionary the flag whether to refer to the dictionary
+		@return the byte size written, or 0 if the buffer is not large enough
+		@remark the buffer of GetCompressBound(srcByteSize) always fits.
+		*/
+		unsigned int Compress(const void *src,unsigned int srcByteSize,void *retDst,unsigned int dstByteSize,bool useDictionary) const;
+
+		/*!
+		Decompress the given data
+		@param[in] src the data to decompress
+		@param[in] srcByteSize the byte size of the data
+		@param[out] retDst the buffer to write into
+		@param[in] dstByteSize the byte size of the data decompressed
+		@param[in] useDictionary the flag whether to refer to the dictionary
+		@return true if exactly dstByteSize is decompressed otherwise false
+		@remark the data corrupted is detected without reading or writing out of the buffers.
+		*/
+		bool Decompress(const void *src,unsigned int srcByteSize,void *retDst,unsigned int dstByteSize,bool useDictionary) const;
+
+		/*!
+		Get the byte size of the buffer large enough to compress the data of the given byte size
+		@param[in] byteSize the byte size of the data
+		@return the byte size of the buffer
+		*/
+		static unsigned int GetCompressBound(unsigned int byteSize);
+
+	private:
+		/*!
+		Enumerator for the parameters of the block format
+		*/
+		enum LzParameter{
+			/// Number of bits of the hash
+			LZ_HASH_BITS=12,
+			/// Number of the entries of the hash table
+			LZ_HASH_ENTRY_COUNT=1<<LZ_HASH_BITS,
+			/// Minimum length of the match
+			LZ_MATCH_LENGTH_MIN=4,
+			/// Maximum offset of the match
+			LZ_OFFSET_MAX=65535,
+			/// Number of the bytes at the end always sent as the literals
+			LZ_LAST_LITERAL_COUNT=5,
+			/// Number of the bytes at the end no match starts in
+			LZ_MATCH_FIND_LIMIT=12,
+			/// Value of the length field to be continued in the following bytes
+			LZ_LENGTH_MASK=15,
+		};
+
+		/*!
+		Build the hash table of the dictionary
+		*/
+		void buildDictionaryHashTable();
+
+	private:
+		/// dictionary
+		vector<char> m_dictionary;
+		/// hash table of the positions in the dictionary
+		vector<unsigned int> m_dictionaryHashTable;
+		/// id of the dictionary
+		unsigned int m_dictionaryId;
+	};
+}
+
+#endif //__EP_LZ_CODEC_H__
\ No newline at end of file
@@ -0,0 +1,311 @@
+/*! 
+@file epMessageDispatcher.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Message Dispatcher Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Message Dispatcher.
+
+*/
+#ifndef __EP_MESSAGE_DISPATCHER_H__
+#define __EP_MESSAGE_DISPATCHER_H__
+
+#include "epServerEngine.h"
+#include "epPacket.h"
+#include "epPacketContainer.h"
+#include "epBaseServerObject.h"
+#include "epEventLoopGroup.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse
+{
+	/*! 
+	@class MessageDispatcher epMessageDispatcher.h
+	@brief A class for Message Dispatcher.
+
+	A jump table indexed by the message type of the packet received,
+	which calls the handler registered for the type instead of OnReceived.
+	The handlers are bound at compile time by the template arguments, so
+	the dispatch costs a table lookup and a single call through the function pointer.
+	*/
+	template<typename SourceInterface>
+	class MessageDispatcher:public EventLoopCallbackInterface
+	{
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Message Dispatcher
+		*/
+		MessageDispatcher()
+		{
+		}
+
+		/*!
+		Default Destructor
+
+		Destroy the Message Dispatcher
+		*/
+		virtual ~MessageDispatcher()
+		{
+		}
+
+		/*!
+		Register the handler taking the Packet Container of the given type for the message type
+		@param[in] messageType the message type to handle
+		@param[in] owner the object to call the handler on
+		@param[in] workerGroup the Event Loops to call the handler on (NULL to call on the receiving thread)
+		@remark the handler is given as the template argument, for example
+		Register<MyHandler,LoginPacket,char,&MyHandler::OnLogin>(MESSAGE_TYPE_LOGIN,&myHandler)
+		@remark the packet smaller than sizeof(PacketStruct) is dropped.
+		@remark must be called before the server is started or the client is connected.
+		*/
+		template<typename Owner,typename PacketStruct,typename ArrayType,void (Owner::*Handler)(SourceInterface*,const PacketContainer<PacketStruct,ArrayType>&)>
+		void Register(unsigned short messageType,Owner *owner,EventLoopGroup *workerGroup=NULL)
+		{
+			setEntry(messageType,&invokeContainer<Owner,PacketStruct,ArrayType,Handler>,owner,workerGroup);
+		}
+
+		/*!
+		Register the handler taking the raw Packet for the message type
+		@param[in] messageType the message type to handle
+		@param[in] owner the object to call the handler on
+		@param[in] workerGroup the Event Loops to call the handler on (NULL to call on the receiving thread)
+		@remark must be called before the server is started or the client is connected.
+		*/
+		template<typename Owner,void (Owner::*Handler)(SourceInterface*,const Packet&)>
+		void RegisterPacket(unsigned short messageType,Owner *owner,EventLoopGroup *workerGroup=NULL)
+		{
+			setEntry(messageType,&invokePacket<Owner,Handler>,owner,workerGroup);
+		}
+
+		/*!
+		Unregister the handler for the message type
+		@param[in] messageType the message type to stop handling
+		@remark must be called before the server is started or the client is connected.
+		*/
+		void Unregister(unsigned short messageType)
+		{
+			if(messageType<m_entryList.size())
+				m_entryList[messageType]=Entry();
+		}
+
+		/*!
+		Check if the handler is registered for the message type
+		@param[in] messageType the message type to check
+		@return true if the handler is registered otherwise false
+		*/
+		bool IsRegistered(unsigned short messageType) const
+		{
+			return (messageType<m_entryList.size() && m_entryList[messageType].m_handler!=NULL);
+		}
+
+		/*!
+		Dispatch the packet received to the handler registered for its message type
+		@param[in] source the socket or the client which received the packet
+		@param[in] sourceObj the server object of the source
+		@param[in] packet the packet received
+		@return true if the handler is registered otherwise false
+		@remark the caller must deliver the packet to OnReceived if false is returned.
+		@remark the packets routed to the Event Loops are not ordered with the packets of the other message types.
+		*/
+		bool Dispatch(SourceInterface *source,BaseServerObject *sourceObj,const Packet *packet)
+		{
+			if(!packet)
+				return false;
+			unsigned short messageType=packet->GetMessageType();
+			if(messageType>=m_entryList.size() || !m_entryList[messageType].m_handler)
+				return false;
+
+			const Entry &entry=m_entryList[messageType];
+			EventLoop *eventLoop=NULL;
+			if(entry.m_workerGroup)
+				eventLoop=entry.m_workerGroup->GetEventLoop();
+			if(!eventLoop)
+			{
+				entry.m_handler(entry.m_owner,source,*packet);
+				return true;
+			}
+
+			DispatchContext *context=EP_NEW DispatchContext();
+			context->m_callBackObj=this;
+			context->m_entry=entry;
+			context->m_source=source;
+			context->m_sourceObj=sourceObj;
+			context->m_packet=const_cast<Packet*>(packet);
+			sourceObj->RetainObj();
+			context->m_packet->RetainObj();
+			if(!eventLoop->Post(context))
+			{
+				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Post failed, handled on the receiving thread...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+				context->m_packet->ReleaseObj();
+				sourceObj->ReleaseObj();
+				EP_DELETE context;
+				entry.m_handler(entry.m_owner,source,*packet);
+			}
+			return true;
+		}
+
+	private:
+		/// Handler function type bound to the member function of the owner
+		typedef void (*HandlerFunc)(void *owner,SourceInterface *source,const Packet &packet);
+
+		/*!
+		@struct Entry epMessageDispatcher.h
+		@brief A struct for the entry of the jump table.
+		*/
+		struct Entry{
+			/// Handler function
+			HandlerFunc m_handler;
+			/// Object to call the handler on
+			void *m_owner;
+			/// Event Loops to call the handler on
+			EventLoopGroup *m_workerGroup;
+
+			/*!
+			Default Constructor
+
+			Initializes the Entry
+			*/
+			Entry()
+			{
+				m_handler=NULL;
+				m_owner=NULL;
+				m_workerGroup=NULL;
+			}
+		};
+
+		/*!
+		@struct DispatchContext epMessageDispatcher.h
+		@brief A struct for the packet routed to the Event Loop.
+		*/
+		struct DispatchContext:public IoContext{
+			/// Entry of the handler
+			Entry m_entry;
+			/// Source of the packet
+			SourceInterface *m_source;
+			/// Server object of the source
+			BaseServerObject *m_sourceObj;
+			/// Packet received
+			Packet *m_packet;
+		};
+
+		/*!
+		Set the entry of the jump table for the message type
+		@param[in] messageType the message type
+		@param[in] handler the handler function
+		@param[in] owner the object to call the handler on
+		@param[in] workerGroup the Event Loops to call the handler on
+		*/
+		void setEntry(unsigned short messageType,HandlerFunc handler,void *owner,EventLoopGroup *workerGroup)
+		{
+			EP_ASSERT(owner);
+			if(messageType>=m_entryList.size())
+				m_entryList.resize(static_cast<size_t>(messageType)+1);
+			m_entryList[messageType].m_handler=handler;
+			m_entryList[messageType].m_owner=owner;
+			m_entryList[messageType].m_workerGroup=workerGroup;
+		}
+
+		/*!
+		Call the handler taking the Packet Container
+		@param[in] owner the object to call the handler on
+		@param[in] source the source of the packet
+		@param[in] packet the packet received
+		*/
+		template<typename Owner,typename PacketStruct,typename ArrayType,void (Owner::*Handler)(SourceInterface*,const PacketContainer<PacketStruct,ArrayType>&)>
+		static void invokeContainer(void *owner,SourceInterface *source,const Packet &packet)
+		{
+			if(packet.GetPacketByteSize()<sizeof(PacketStruct))
+			{
+				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Packet smaller than the PacketStruct dropped...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,owner);
+				return;
+			}
+			// the container refers to the payload of the packet without copying
+			PacketContainer<PacketStruct,ArrayType> container(packet.GetPacket(),packet.GetPacketByteSize(),false,epl::LOCK_POLICY_NONE);
+			(static_cast<Owner*>(owner)->*Handler)(source,container);
+		}
+
+		/*!
+		Call the handler taking the raw Packet
+		@param[in] owner the object to call the handler on
+		@param[in] source the source of the packet
+		@param[in] packet the packet received
+		*/
+		template<typename Owner,void (Owner::*Handler)(SourceInterface*,const Packet&)>
+		static void invokePacket(void *owner,SourceInterface *source,const Packet &packet)
+		{
+			(static_cast<Owner*>(owner)->*Handler)(source,packet);
+		}
+
+		/*!
+		Call the handler of the packet routed to the Event Loop.
+		@param[in] context the context of the packet routed
+		@param[in] transferredByte not used
+		@param[in] isSucceeded the flag whether the context is dispatched
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)
+		{
+			DispatchContext *dispatchContext=static_cast<DispatchContext*>(context);
+			if(isSucceeded)
+				dispatchContext->m_entry.m_handler(dispatchContext->m_entry.m_owner,dispatchContext->m_source,*dispatchContext->m_packet);
+			dispatchContext->m_packet->ReleaseObj();
+			dispatchContext->m_sourceObj->ReleaseObj();
+			EP_DELETE dispatchContext;
+		}
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Message Dispatcher
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		MessageDispatcher(const MessageDispatcher& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		MessageDispatcher & operator=(const MessageDispatcher&b){return *this;}
+
+	private:
+		/// Jump table indexed by the message type
+		vector<Entry> m_entryList;
+	};
+}
+
+#endif //__EP_MESSAGE_DISPATCHER_H__
\ No newline at end of file
@@ -39,14 +39,38 @@ An Interface for Packet.
 #define __EP_PACKET_H__
 
 #include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacketSlab.h"
+#include "epBufferPool.h"
 
 namespace epse{
 
+	/*! 
+	@struct PacketBuffer epPacket.h
+	@brief A struct for the heap buffer shared by the packets.
+	@remark the payload follows the struct in the same buffer of the Buffer Pool.
+	*/
+	struct PacketBuffer{
+		/// number of the packets referencing the buffer
+		volatile LONG m_refCount;
+		/// byte size of the payload
+		unsigned int m_byteSize;
+	};
+
 	/*! 
 	@class Packet epPacket.h
 	@brief A class for Packet.
+
+	The packet is immutable once built, so it carries no lock. It must be
+	synchronized externally if SetPacket is called while shared by threads.
+	The payload up to PACKET_INLINE_BYTE_SIZE is stored inline, and the larger
+	payload is stored in the heap buffer shared by the parts of the packet.
+	The copy of the packet allocated gets its own payload.
+	The packet allocated keeps the headroom in front of the payload and the
+	tailroom behind it, so the headers and the trailers are added in place
+	while the packet is the only one referencing the memory.
 	*/
-	class EP_SERVER_ENGINE Packet:public epl::SmartObject{
+	class EP_SERVER_ENGINE Packet{
 
 	public:
 		/*!
@@ -57,14 +81,50 @@ namespace epse{
 		@param[in] byteSize the byte size of the packet given
 		@param[in] shouldAllocate flag for the allocation of memory for itself
 		@param[in] lockPolicyType The lock policy
+		@remark lockPolicyType is only kept for the compatibility since the packet carries no lock.
 		*/
 		Packet(const void *packet=NULL, unsigned int byteSize=0, bool shouldAllocate=true, epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
 
+		/*!
+		Default Constructor
+
+		Initializes the Packet with the headroom and the tailroom reserved
+		@param[in] packet packet to copy from
+		@param[in] byteSize the byte size of the packet given
+		@param[in] headroomByteSize the byte size to reserve in front of the packet
+		@param[in] tailroomByteSize the byte size to reserve behind the packet
+		*/
+		Packet(const void *packet, unsigned int byteSize, unsigned int headroomByteSize, unsigned int tailroomByteSize);
+
+		/*!
+		Default Constructor
+
+		Initializes the Packet referencing the slot of the Packet Slab without copying
+		@param[in] slot the slot holding the packet
+		@param[in] offset the offset of the packet in the slot
+		@param[in] byteSize the byte size of the packet
+		@param[in] lockPolicyType The lock policy
+		@remark the slot is retained until the packet is destroyed or set again.
+		*/
+		Packet(PacketSlot *slot, unsigned int offset, unsigned int byteSize, epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Constructor
+
+		Initializes the Packet as the part of the given packet
+		@param[in] b the original Packet object
+		@param[in] offset the offset of the part in the original packet
+		@param[in] byteSize the byte size of the part
+		@remark the slot of the Packet Slab or the heap buffer is shared without copying, otherwise the part is copied.
+		*/
+		Packet(const Packet& b, unsigned int offset, unsigned int byteSize);
+
 		/*!
 		Default Copy Constructor
 
 		Initializes the Packet
 		@param[in] b the original Packet object
+		@remark the packet allocated is copied, otherwise the memory of b is referenced.
 		*/
 		Packet(const Packet& b);
 
@@ -74,6 +134,7 @@ namespace epse{
 		the Packet set as given packet b
 		@param[in] b right side of packet
 		@return this object
+		@remark the packet allocated is copied, otherwise the memory of b is referenced.
 		*/
 		Packet & operator=(const Packet&b);
 
@@ -84,6 +145,38 @@ namespace epse{
 		*/
 		virtual ~Packet();
 
+#if !defined(_DEBUG)
+		/*!
+		Increment this object's reference count
+		*/
+		void RetainObj();
+
+		/*!
+		Decrement this object's reference count
+		if the reference count is 0 then delete this object.
+		*/
+		void ReleaseObj();
+#else //!defined(_DEBUG)
+		// parenthesized not to be expanded by the macros of SmartObject
+
+		/*!
+		Increment this object's reference count
+		*/
+		void (RetainObj)(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum);
+
+		/*!
+		Decrement this object's reference count
+		if the reference count is 0 then delete this object.
+		*/
+		void (ReleaseObj)(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum);
+#endif //!defined(_DEBUG)
+
+		/*!
+		Returns the current reference count.
+		@return the current reference count.
+		*/
+		int GetReferenceCount() const;
+
 		/*!
 		Return the currently stored packet byte size
 		@return byte size of the holding packet
@@ -112,22 +205,161 @@ namespace epse{
 		*/
 		void SetPacket(const void* packet, unsigned int packetByteSize);
 
+		/*!
+		Get the message type of the packet
+		@return the message type carried by the frame header
+		@remark 0 if the packet is received in the legacy frame.
+		*/
+		unsigned short GetMessageType() const;
+
+		/*!
+		Set the message type of the packet
+		@param[in] messageType the message type to be carried by the frame header
+		@remark only sent if the compact frame is negotiated with the peer.
+		*/
+		void SetMessageType(unsigned short messageType);
+
+		/*!
+		Get the flags of the packet
+		@return the flags carried by the frame header
+		*/
+		unsigned char GetFrameFlags() const;
+
+		/*!
+		Set the flags of the packet
+		@param[in] flags the flags up to FRAME_FLAGS_MAX to be carried by the frame header
+		@remark only sent if the compact frame is negotiated with the peer.
+		*/
+		void SetFrameFlags(unsigned char flags);
+
+		/*!
+		Get the byte size of the headroom writable in front of the packet
+		@return the byte size of the headroom
+		@remark 0 is returned if the memory is shared with other packets or not allocated by this object.
+		*/
+		unsigned int GetHeadroomByteSize() const;
+
+		/*!
+		Get the byte size of the tailroom writable behind the packet
+		@return the byte size of the tailroom
+		@remark 0 is returned if the memory is shared with other packets or not allocated by this object.
+		*/
+		unsigned int GetTailroomByteSize() const;
+
+		/*!
+		Prepend the header to the packet
+		@param[in] header the header data
+		@param[in] byteSize the byte size of the header
+		@remark the header is written in the headroom if enough, otherwise the packet is copied once into the new memory.
+		*/
+		void PushHeader(const void *header, unsigned int byteSize);
+
+		/*!
+		Append the trailer to the packet
+		@param[in] trailer the trailer data
+		@param[in] byteSize the byte size of the trailer
+		@remark the trailer is written in the tailroom if enough, otherwise the packet is copied once into the new memory.
+		*/
+		void PushTrailer(const void *trailer, unsigned int byteSize);
+
+		/*!
+		Extend the packet at the back to write the trailer in place
+		@param[in] byteSize the byte size of the trailer
+		@return the start of the trailer to write
+		@remark the tailroom is grown to the packet size at least if not enough, so appending repeatedly copies the packet logarithmic times.
+		@remark the trailer is uninitialized, and the packet must not be shared with other packets while written.
+		*/
+		char *ExtendTrailer(unsigned int byteSize);
+
+		/*!
+		Remove the header from the front of the packet without copying
+		@param[in] byteSize the byte size of the header
+		@remark the bytes removed become the headroom.
+		*/
+		void PullHeader(unsigned int byteSize);
+
+		/*!
+		Remove the trailer from the back of the packet without copying
+		@param[in] byteSize the byte size of the trailer
+		@remark the bytes removed become the tailroom.
+		*/
+		void PullTrailer(unsigned int byteSize);
+
+		/*!
+		Write the header right in front of the packet without changing the packet
+		@param[in] header the header data
+		@param[in] byteSize the byte size of the header
+		@return true if written in the headroom otherwise false
+		@remark if succeeded, the header and the packet are contiguous from GetPacket()-byteSize.
+		@remark the caller must own the packet exclusively, since the headroom is shared by every copy
+				retained and sent concurrently. Senders of the engine write it only if the packet is not retained.
+		*/
+		bool WriteHeadroom(const void *header, unsigned int byteSize);
+
 	private:
 
 		/*!
-		Reset Packet
+		Allocate the memory of the packet
+		@param[in] headroomByteSize the byte size to reserve in front of the packet
+		@param[in] byteSize the byte size to allocate
+		@param[in] tailroomByteSize the byte size to reserve behind the packet
+		@remark the memory is inline if small enough, otherwise a new heap buffer.
+		*/
+		void allocatePacket(unsigned int headroomByteSize, unsigned int byteSize, unsigned int tailroomByteSize);
+
+		/*!
+		Move the packet into the new memory with the headroom and the tailroom given
+		@param[in] headroomByteSize the byte size to reserve in front of the packet
+		@param[in] tailroomByteSize the byte size to reserve behind the packet
+		*/
+		void reallocatePacket(unsigned int headroomByteSize, unsigned int tailroomByteSize);
+
+		/*!
+		Get the memory owned by this object only
+		@param[out] retRoom the start of the memory
+		@param[out] retRoomByteSize the byte size of the memory
+		@return true if this object owns the memory exclusively otherwise false
 		*/
-		void resetPacket();
+		bool getExclusiveRoom(char *&retRoom, unsigned int &retRoomByteSize) const;
+
+		/*!
+		Copy the given packet
+		@param[in] b the original Packet object
+		@remark only the packet not allocated is referenced without copying.
+		*/
+		void copyPacket(const Packet& b);
+
+		/*!
+		Reference the part of the given packet
+		@param[in] b the original Packet object
+		@param[in] offset the offset of the part in the original packet
+		@param[in] byteSize the byte size of the part
+		*/
+		void referencePacket(const Packet& b, unsigned int offset, unsigned int byteSize);
+
+		/*!
+		Release the memory referenced
+		*/
+		void releasePacket();
+
 		/// packet
 		char *m_packet;
 		/// packet Byte Size
 		unsigned int m_packetSize;
 		/// flag whether memory is allocated in this object or now
 		bool m_isAllocated;
-		/// lock
-		epl::BaseLock *m_packetLock;
-		/// Lock Policy
-		epl::LockPolicy m_lockPolicy;
+		/// slot of the Packet Slab referenced
+		PacketSlot *m_slot;
+		/// heap buffer referenced
+		PacketBuffer *m_buffer;
+		/// message type carried by the frame header
+		unsigned short m_messageType;
+		/// flags carried by the frame header
+		unsigned char m_frameFlags;
+		/// reference count
+		volatile LONG m_refCount;
+		/// inline buffer for the small packet
+		char m_inlineBuffer[PACKET_INLINE_BYTE_SIZE];
 	};
 }
 
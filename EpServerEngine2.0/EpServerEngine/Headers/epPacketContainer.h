@@ -43,6 +43,7 @@ Sang Yong Yoon <flyingshiri@gmail.com>
 #define __EP_PACKET_CONTAINER_H__
 
 #include "epServerEngine.h"
+#include "epBufferPool.h"
 
 namespace epse
 {
@@ -241,7 +242,7 @@ namespace epse
 	{
 		if(shouldAllocate)
 		{
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>(EP_Malloc(sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)) ));
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>(BufferPool::defaultBufferPool.Allocate(sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)) ));
 			EP_ASSERT(m_packetContainer);
 			m_length=arraySize;
 		}
@@ -274,7 +275,7 @@ namespace epse
 	{
 		if(shouldAllocate)
 		{
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( EP_Malloc(sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)) ) );
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( BufferPool::defaultBufferPool.Allocate(sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)) ) );
 			EP_ASSERT(m_packetContainer);
 			epl::System::Memcpy(m_packetContainer,&packet,sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)));
 			m_length=arraySize;
@@ -318,7 +319,7 @@ namespace epse
 
 		if(m_isAllocated)
 		{
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( EP_Malloc(byteSize) );
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( BufferPool::defaultBufferPool.Allocate(byteSize) );
 			EP_ASSERT(m_packetContainer);
 			epl::System::Memcpy(m_packetContainer,rawData,byteSize);
 			m_length=(byteSize-sizeof(PacketContainerStruct))/sizeof(ArrayType);
@@ -369,7 +370,7 @@ namespace epse
 		LockObj lock(orig.m_packetContainerLock);
 		if(orig.m_isAllocated)
 		{
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( EP_Malloc(sizeof(PacketContainerStruct) + (orig.m_length*sizeof(ArrayType)) ) );
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( BufferPool::defaultBufferPool.Allocate(sizeof(PacketContainerStruct) + (orig.m_length*sizeof(ArrayType)) ) );
 			EP_ASSERT(m_packetContainer);
 			m_packetContainer->m_packet=orig.m_packetContainer->m_packet;
 			m_length=orig.m_length;
@@ -391,7 +392,7 @@ namespace epse
 	{
 		m_packetContainerLock->Lock();
 		if(m_isAllocated && m_packetContainer)
-			EP_Free(m_packetContainer);	
+			BufferPool::defaultBufferPool.Free(m_packetContainer);	
 		m_packetContainer=NULL;
 		m_packetContainerLock->Unlock();
 		if(m_packetContainerLock)
@@ -417,12 +418,12 @@ namespace epse
 	{
 		epl::LockObj lock(m_packetContainerLock);
 		if(m_isAllocated && m_packetContainer)
-			EP_Free(m_packetContainer);
+			BufferPool::defaultBufferPool.Free(m_packetContainer);
 		m_packetContainer=NULL;
 
 		if(m_isAllocated)
 		{
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( EP_Malloc(sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)) ) );
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( BufferPool::defaultBufferPool.Allocate(sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)) ) );
 			EP_ASSERT(m_packetContainer);
 			epl::System::Memcpy(m_packetContainer,&packet,sizeof(PacketContainerStruct) + (arraySize*sizeof(ArrayType)));
 			m_length=arraySize;
@@ -445,12 +446,12 @@ namespace epse
 
 
 		if(m_isAllocated && m_packetContainer)
-			EP_Free(m_packetContainer);
+			BufferPool::defaultBufferPool.Free(m_packetContainer);
 		m_packetContainer=NULL;
 
 		if(m_isAllocated)
 		{
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( EP_Malloc(byteSize) );
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>( BufferPool::defaultBufferPool.Allocate(byteSize) );
 			EP_ASSERT(m_packetContainer);
 			epl::System::Memcpy(m_packetContainer,rawData,byteSize);
 			m_length=(byteSize-sizeof(PacketContainerStruct))/sizeof(ArrayType);
@@ -544,7 +545,7 @@ namespace epse
 		{
 			m_packetContainerLock->Lock();
 			if(m_isAllocated && m_packetContainer)
-				EP_Free(m_packetContainer);	
+				BufferPool::defaultBufferPool.Free(m_packetContainer);	
 			m_packetContainer=NULL;
 			m_packetContainerLock->Unlock();
 			if(m_packetContainerLock)
@@ -571,7 +572,7 @@ namespace epse
 			LockObj lock(b.m_packetContainerLock);
 			if(b.m_isAllocated)
 			{
-				m_packetContainer=reinterpret_cast<PacketContainerStruct*>( EP_Malloc(sizeof(PacketContainerStruct) + (b.m_length*sizeof(ArrayType)) ) );
+				m_packetContainer=reinterpret_cast<PacketContainerStruct*>( BufferPool::defaultBufferPool.Allocate(sizeof(PacketContainerStruct) + (b.m_length*sizeof(ArrayType)) ) );
 				EP_ASSERT(m_packetContainer);
 				m_packetContainer->m_packet=b.m_packetContainer->m_packet;
 				m_length=b.m_length;
@@ -615,7 +616,7 @@ namespace epse
 				EP_ASSERT_EXPR(arrSize>=m_length,_T("Given size = %d is smaller than the original = %d.\r\nNew array size must be (greater than/equal to) original array size."),arrSize,m_length);
 			}
 			
-			m_packetContainer=reinterpret_cast<PacketContainerStruct*>(EP_Realloc(m_packetContainer,sizeof(PacketContainerStruct)+ (arrSize*sizeof(ArrayType))));
+			m_packetContainer=reinterpret_cast<PacketContainerStruct*>(BufferPool::defaultBufferPool.Reallocate(m_packetContainer,sizeof(PacketContainerStruct)+ (arrSize*sizeof(ArrayType))));
 			epl::System::Memset(((char*)m_packetContainer)+sizeof(PacketContainerStruct)+ (m_length*sizeof(ArrayType)),0,((arrSize-m_length)*sizeof(ArrayType)));
 			EP_ASSERT(m_packetContainer);
 			m_length=arrSize;
@@ -0,0 +1,309 @@
+/*! 
+@file epPacketReader.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Packet Reader Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Packet Reader.
+
+*/
+#ifndef __EP_PACKET_READER_H__
+#define __EP_PACKET_READER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epByteSwapper.h"
+
+namespace epse{
+
+	/*! 
+	@class PacketReader epPacketReader.h
+	@brief A class for Packet Reader.
+
+	The packet reader parses the values in place over the packet received,
+	as epl::Stream does over its own buffer, so the packet is not copied into
+	the stream first. The reader shares the memory of the packet given, and
+	the bytes and the strings may be referenced in place without copying.
+
+	The values are read in the byte order given, and the arrays are
+	converted as a whole by the Byte Swapper if it is not the host's. The
+	format is the same as the Packet Writer.
+	*/
+	class EP_SERVER_ENGINE PacketReader{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Reader
+		@param[in] packet the packet to read
+		@param[in] byteOrder the byte order to read the values in
+		@remark the memory of the packet is shared without copying.
+		*/
+		PacketReader(const Packet &packet,ByteOrder byteOrder=BYTE_ORDER_LITTLE_ENDIAN);
+
+		/*!
+		Default Destructor
+
+		Destroy the Reader
+		*/
+		virtual ~PacketReader();
+
+		/*!
+		Get the byte order to read the values in
+		@return the byte order of the values
+		*/
+		ByteOrder GetByteOrder() const;
+
+		/*!
+		Return the byte size of the packet
+		@return the byte size of the packet
+		*/
+		unsigned int GetStreamSize() const;
+
+		/*!
+		Return the bytes of the packet
+		@return the bytes of the packet
+		*/
+		const char *GetBuffer() const;
+
+		/*!
+		Set the seek offset.
+		@param[in] offset the offset from the start of the packet
+		@return true if successful, otherwise false.
+		*/
+		bool SetSeek(unsigned int offset);
+
+		/*!
+		Get the current seek offset.
+		@return the current seek offset.
+		*/
+		unsigned int GetSeek() const;
+
+		/*!
+		Get the byte size left to read
+		@return the byte size left to read
+		*/
+		unsigned int GetRemainingByteSize() const;
+
+		/*!
+		Read the short value from the stream.
+		@param[out] retVal the short value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadShort(short &retVal);
+
+		/*!
+		Read the unsigned short value from the stream.
+		@param[out] retVal the unsigned short value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadUShort(unsigned short &retVal);
+
+		/*!
+		Read the int value from the stream.
+		@param[out] retVal the int value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadInt(int &retVal);
+
+		/*!
+		Read the unsigned int value from the stream.
+		@param[out] retVal the unsigned int value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadUInt(unsigned int &retVal);
+
+		/*!
+		Read the float value from the stream.
+		@param[out] retVal the float value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadFloat(float &retVal);
+
+		/*!
+		Read the double value from the stream.
+		@param[out] retVal the double value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadDouble(double &retVal);
+
+		/*!
+		Read the byte value from the stream.
+		@param[out] retVal the byte value read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadByte(unsigned char &retVal);
+
+		/*!
+		Read the short values from the stream.
+		@param[out] retShortList the short values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadShorts(short *retShortList,size_t listSize);
+
+		/*!
+		Read the unsigned short values from the stream.
+		@param[out] retUShortList the unsigned short values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadUShorts(unsigned short *retUShortList,size_t listSize);
+
+		/*!
+		Read the int values from the stream.
+		@param[out] retIntList the int values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadInts(int *retIntList,size_t listSize);
+
+		/*!
+		Read the unsigned int values from the stream.
+		@param[out] retUIntList the unsigned int values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadUInts(unsigned int *retUIntList,size_t listSize);
+
+		/*!
+		Read the float values from the stream.
+		@param[out] retFloatList the float values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadFloats(float *retFloatList,size_t listSize);
+
+		/*!
+		Read the double values from the stream.
+		@param[out] retDoubleList the double values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadDoubles(double *retDoubleList,size_t listSize);
+
+		/*!
+		Read the byte values from the stream.
+		@param[out] retByteList the byte values read from the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool ReadBytes(unsigned char *retByteList,size_t listSize);
+
+		/*!
+		Read the byte values in place without copying.
+		@param[out] retByteList the byte values in the packet
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		@remark retByteList is valid while the Reader exists.
+		*/
+		bool ReadBytesInPlace(const unsigned char *&retByteList,size_t listSize);
+
+		/*!
+		Read the part of the packet without copying
+		@param[in] byteSize the byte size of the part
+		@return the packet of the part, or NULL if not enough left
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *ReadPacket(unsigned int byteSize);
+
+		/*!
+		Read the string from the stream.
+		@param[out] retString the string read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadString(epl::EpString &retString);
+
+		/*!
+		Read the wide string from the stream.
+		@param[out] retString the wide string read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadWString(epl::EpWString &retString);
+
+		/*!
+		Read the TString from the stream.
+		@param[out] retString the TString read from the stream
+		@return true if successful, otherwise false.
+		*/
+		bool ReadTString(epl::EpTString &retString);
+
+		/*!
+		Read the string in place without copying.
+		@param[out] retString the characters in the packet, not terminated by null
+		@param[out] retLength the number of the characters
+		@return true if successful, otherwise false.
+		@remark retString is valid while the Reader exists.
+		*/
+		bool ReadStringInPlace(const char *&retString,unsigned int &retLength);
+
+	private:
+		/*!
+		Read the values converting the byte order
+		@param[out] retValues the values read
+		@param[in] elementByteSize the byte size of each value
+		@param[in] count the number of the values
+		@return true if successful, otherwise false.
+		*/
+		bool read(void *retValues,size_t elementByteSize,size_t count);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Reader
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		PacketReader(const PacketReader& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		PacketReader & operator=(const PacketReader&b){return *this;}
+
+	private:
+		/// packet read sharing the memory
+		Packet m_packet;
+		/// byte order of the values
+		ByteOrder m_byteOrder;
+		/// flag whether the byte order is not the host's
+		bool m_shouldSwap;
+		/// seek offset
+		unsigned int m_offset;
+	};
+}
+
+#endif //__EP_PACKET_READER_H__
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*! 
+@file epPacketSlab.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Packet Slab Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Packet Slab.
+
+*/
+#ifndef __EP_PACKET_SLAB_H__
+#define __EP_PACKET_SLAB_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	class PacketSlab;
+
+	/*! 
+	@struct PacketSlot epPacketSlab.h
+	@brief A struct for a slot of the Packet Slab.
+	*/
+	struct PacketSlot{
+		/// slab owning this slot
+		PacketSlab *m_slab;
+		/// buffer of this slot
+		char *m_buffer;
+		/// reference count
+		volatile LONG m_refCount;
+	};
+
+	/*! 
+	@class PacketSlab epPacketSlab.h
+	@brief A class for Packet Slab.
+
+	The slab allocates the buffers of all its slots at once, and the datagram
+	is received straight into a slot, which the Packet references without
+	copying. The slot goes back to the slab when its last reference is released.
+	@remark the slab is kept alive until all the slots acquired are released.
+	*/
+	class EP_SERVER_ENGINE PacketSlab:public epl::SmartObject{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Slab
+		@param[in] slotCount the number of the slots
+		@param[in] slotByteSize the byte size of each slot
+		@param[in] lockPolicyType The lock policy
+		*/
+		PacketSlab(unsigned int slotCount,unsigned int slotByteSize,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Slab
+		*/
+		virtual ~PacketSlab();
+
+		/*!
+		Take a free slot from the slab
+		@return the slot with the reference count of 1, or NULL if all the slots are in use
+		@remark the caller must call ReleaseSlot() for the slot returned.
+		*/
+		PacketSlot *Acquire();
+
+		/*!
+		Increment the reference count of the slot
+		@param[in] slot the slot to retain
+		*/
+		static void RetainSlot(PacketSlot *slot);
+
+		/*!
+		Decrement the reference count of the slot
+		@param[in] slot the slot to release
+		@remark the slot goes back to its slab if the reference count is 0.
+		*/
+		static void ReleaseSlot(PacketSlot *slot);
+
+		/*!
+		Get the byte size of each slot
+		@return the byte size of each slot
+		*/
+		unsigned int GetSlotByteSize() const;
+
+		/*!
+		Get the number of the slots
+		@return the number of the slots
+		*/
+		unsigned int GetSlotCount() const;
+
+		/*!
+		Get the number of the slots not in use
+		@return the number of the slots not in use
+		*/
+		size_t GetFreeSlotCount() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Slab
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		PacketSlab(const PacketSlab& b):SmartObject(b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		PacketSlab & operator=(const PacketSlab&b){return *this;}
+
+		/*!
+		Put the slot no longer referenced back to the free list
+		@param[in] slot the slot to put back
+		*/
+		void recycle(PacketSlot *slot);
+
+	private:
+		/// buffer of all the slots
+		char *m_buffer;
+		/// slots
+		PacketSlot *m_slotList;
+		/// slots not in use
+		vector<PacketSlot*> m_freeSlotList;
+		/// number of the slots
+		unsigned int m_slotCount;
+		/// byte size of each slot
+		unsigned int m_slotByteSize;
+
+		/// slab lock
+		epl::BaseLock *m_slabLock;
+	};
+}
+#endif //__EP_PACKET_SLAB_H__
\ No newline at end of file
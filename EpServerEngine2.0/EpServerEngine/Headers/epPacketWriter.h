@@ -0,0 +1,306 @@
+/*! 
+@file epPacketWriter.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Packet Writer Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Packet Writer.
+
+*/
+#ifndef __EP_PACKET_WRITER_H__
+#define __EP_PACKET_WRITER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epByteSwapper.h"
+
+namespace epse{
+
+	/*! 
+	@class PacketWriter epPacketWriter.h
+	@brief A class for Packet Writer.
+
+	The packet writer serializes the values directly into the packet to send,
+	as epl::Stream does into its own buffer, so the values are not copied
+	again to build the packet. The packet grows geometrically, and keeps the
+	headroom for the frame header prepended in place.
+
+	The values are written in the byte order given, and the arrays are
+	converted as a whole by the Byte Swapper if it is not the host's. The
+	string is written as the number of the characters in unsigned int
+	followed by the characters without the null terminator, and the wide
+	character is written as 16-bit.
+	*/
+	class EP_SERVER_ENGINE PacketWriter{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Writer
+		@param[in] byteOrder the byte order to write the values in
+		@param[in] reserveByteSize the byte size to reserve for the packet when writing starts
+		*/
+		PacketWriter(ByteOrder byteOrder=BYTE_ORDER_LITTLE_ENDIAN,unsigned int reserveByteSize=PACKET_WRITER_BYTE_SIZE_DEFAULT);
+
+		/*!
+		Default Destructor
+
+		Destroy the Writer
+		*/
+		virtual ~PacketWriter();
+
+		/*!
+		Get the byte order to write the values in
+		@return the byte order of the values
+		*/
+		ByteOrder GetByteOrder() const;
+
+		/*!
+		Clear the values written
+		*/
+		void Clear();
+
+		/*!
+		Return the byte size written
+		@return the byte size written
+		*/
+		unsigned int GetStreamSize() const;
+
+		/*!
+		Return the bytes written
+		@return the bytes written, or NULL if nothing is written
+		*/
+		const char *GetBuffer() const;
+
+		/*!
+		Take the packet written, and start the new packet
+		@return the packet written
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *Detach();
+
+		/*!
+		Write the short value to the stream.
+		@param[in] value the short value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteShort(const short value);
+
+		/*!
+		Write the unsigned short value to the stream.
+		@param[in] value the unsigned short value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteUShort(const unsigned short value);
+
+		/*!
+		Write the int value to the stream.
+		@param[in] value the int value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteInt(const int value);
+
+		/*!
+		Write the unsigned int value to the stream.
+		@param[in] value the unsigned int value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteUInt(const unsigned int value);
+
+		/*!
+		Write the float value to the stream.
+		@param[in] value the float value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteFloat(const float value);
+
+		/*!
+		Write the double value to the stream.
+		@param[in] value the double value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteDouble(const double value);
+
+		/*!
+		Write the byte value to the stream.
+		@param[in] value the byte value to write to the stream
+		@return true if successful, otherwise false.
+		*/
+		bool WriteByte(const unsigned char value);
+
+		/*!
+		Write the short values to the stream.
+		@param[in] shortList the short values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteShorts(const short *shortList, size_t listSize);
+
+		/*!
+		Write the unsigned short values to the stream.
+		@param[in] ushortList the unsigned short values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteUShorts(const unsigned short *ushortList, size_t listSize);
+
+		/*!
+		Write the int values to the stream.
+		@param[in] intList the int values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteInts(const int *intList,size_t listSize);
+
+		/*!
+		Write the unsigned int values to the stream.
+		@param[in] uintList the unsigned int values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteUInts(const unsigned int *uintList,size_t listSize);
+
+		/*!
+		Write the float values to the stream.
+		@param[in] floatList the float values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteFloats(const float *floatList, size_t listSize);
+
+		/*!
+		Write the double values to the stream.
+		@param[in] doubleList the double values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteDoubles(const double *doubleList,size_t listSize);
+
+		/*!
+		Write the byte values to the stream.
+		@param[in] byteList the byte values to write to the stream
+		@param[in] listSize the size of the list
+		@return true if successful, otherwise false.
+		*/
+		bool WriteBytes(const unsigned char* byteList,size_t listSize);
+
+		/*!
+		Write given string to the stream
+		@param[in] str the string to write.
+		@return true if successfully written otherwise false
+		*/
+		bool WriteString(const char *str);
+
+		/*!
+		Write given wide string to the stream
+		@param[in] str the string to write.
+		@return true if successfully written otherwise false
+		*/
+		bool WriteWString(const wchar_t *str);
+
+		/*!
+		Write given TString to the stream
+		@param[in] str the string to write.
+		@return true if successfully written otherwise false
+		*/
+		bool WriteTString(const TCHAR *str);
+
+		/*!
+		Write given string to the stream
+		@param[in] str the string to write.
+		@return true if successfully written otherwise false
+		*/
+		bool WriteString(const epl::EpString &str);
+
+		/*!
+		Write given wide string to the stream
+		@param[in] str the string to write.
+		@return true if successfully written otherwise false
+		*/
+		bool WriteWString(const epl::EpWString &str);
+
+		/*!
+		Write given TString to the stream
+		@param[in] str the string to write.
+		@return true if successfully written otherwise false
+		*/
+		bool WriteTString(const epl::EpTString &str);
+
+	private:
+		/*!
+		Write the values converting the byte order
+		@param[in] values the values to write
+		@param[in] elementByteSize the byte size of each value
+		@param[in] count the number of the values
+		@return true if successful, otherwise false.
+		*/
+		bool write(const void *values,size_t elementByteSize,size_t count);
+
+		/*!
+		Write the wide characters as 16-bit
+		@param[in] str the characters to write
+		@param[in] length the number of the characters
+		@return true if successful, otherwise false.
+		*/
+		bool writeWideCharacters(const wchar_t *str,size_t length);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Writer
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		PacketWriter(const PacketWriter& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		PacketWriter & operator=(const PacketWriter&b){return *this;}
+
+	private:
+		/// packet written
+		Packet *m_packet;
+		/// byte order of the values
+		ByteOrder m_byteOrder;
+		/// flag whether the byte order is not the host's
+		bool m_shouldSwap;
+		/// byte size to reserve when writing starts
+		unsigned int m_reserveByteSize;
+	};
+}
+
+#endif //__EP_PACKET_WRITER_H__
\ No newline at end of file
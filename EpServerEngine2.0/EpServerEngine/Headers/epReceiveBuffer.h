@@ -0,0 +1,259 @@
+/*! 
+@file epReceiveBuffer.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Receive Buffer Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Receive Buffer.
+
+*/
+#ifndef __EP_RECEIVE_BUFFER_H__
+#define __EP_RECEIVE_BUFFER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epFrameCodec.h"
+
+namespace epse{
+
+	/*! 
+	@class ReceiveBuffer epReceiveBuffer.h
+	@brief A class for Receive Buffer.
+
+	The stream received from the connection is read into the buffer as much as
+	available at once, and every complete framed packet is sliced out of the
+	buffer in order. The frames are parsed by the Frame Codec set, or as the
+	legacy frames if not set.
+
+	The frame larger than the maximum byte size is never buffered, and marks
+	the buffer corrupted since the rest of the stream cannot be parsed. If the
+	chunk byte size is set, the packet larger than the chunk is popped in the
+	chunks as received instead of as a whole, so the buffer does not grow
+	beyond a chunk. The packet compressed is still buffered as a whole to be
+	decompressed at once.
+	@remark the buffer is not thread-safe. The owner must serialize the access.
+	*/
+	class EP_SERVER_ENGINE ReceiveBuffer{
+
+	public:
+		/*! 
+		@struct Chunk epReceiveBuffer.h
+		@brief A struct for the chunk of the packet popped in part.
+		*/
+		struct Chunk{
+			/// message type of the packet
+			unsigned short m_messageType;
+			/// offset of the chunk in the packet
+			unsigned int m_offset;
+			/// data of the chunk in the buffer
+			const char *m_data;
+			/// byte size of the chunk
+			unsigned int m_byteSize;
+			/// flag whether the chunk is the last of the packet
+			bool m_isLast;
+		};
+
+		/*!
+		Default Constructor
+
+		Initializes the Buffer
+		@param[in] byteSize the initial byte size of the buffer
+		*/
+		ReceiveBuffer(unsigned int byteSize=RECEIVE_BUFFER_BYTE_SIZE_DEFAULT);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Buffer
+		@param[in] b the second object
+		*/
+		ReceiveBuffer(const ReceiveBuffer& b);
+
+		/*!
+		Default Destructor
+
+		Destroy the Buffer
+		*/
+		virtual ~ReceiveBuffer();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		ReceiveBuffer & operator=(const ReceiveBuffer&b);
+
+		/*!
+		Set the Frame Codec to parse the frames with
+		@param[in] frameCodec the Frame Codec of the connection
+		@remark the Frame Codec is owned by the connection, so it is not copied with the buffer.
+		*/
+		void SetFrameCodec(FrameCodec *frameCodec);
+
+		/*!
+		Set the maximum byte size of the packet to receive
+		@param[in] maxFrameByteSize the maximum byte size of the packet
+		@remark FRAME_BYTE_SIZE_MAX_DEFAULT by default, and FRAME_BYTE_SIZE_UNLIMITED for no limit.
+		*/
+		void SetMaxFrameByteSize(unsigned int maxFrameByteSize);
+
+		/*!
+		Set the byte size of the chunks to pop the large packet in
+		@param[in] chunkByteSize the byte size of the chunk
+		@remark RECEIVE_CHUNK_BYTE_SIZE_NONE to pop every packet as a whole.
+		*/
+		void SetChunkByteSize(unsigned int chunkByteSize);
+
+		/*!
+		Get the free space to receive into
+		@param[out] writableByteSize the byte size of the free space
+		@return the pointer to the free space
+		@remark the buffer grows if the packet waiting is larger than the buffer.
+		*/
+		char *GetWriteBuffer(unsigned int &writableByteSize);
+
+		/*!
+		Commit the bytes received into the free space
+		@param[in] byteSize the byte size received
+		*/
+		void CommitWrite(unsigned int byteSize);
+
+		/*!
+		Check if the complete packet is in the buffer
+		@return true if the complete packet is in the buffer otherwise false
+		*/
+		bool IsPacketAvailable() const;
+
+		/*!
+		Check if the stream received can not be parsed any further
+		@return true if the corrupted frame or the packet exceeding the maximum byte size is received otherwise false
+		@remark the connection must be closed, since no more packet is popped.
+		*/
+		bool IsCorrupted() const;
+
+		/*!
+		Slice out the first complete packet from the buffer
+		@return the new packet if the complete packet is in the buffer otherwise NULL
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		@remark the packet compressed is decompressed, and the stream is corrupted if it fails.
+		*/
+		Packet *PopPacket();
+
+		/*!
+		Pop the next chunk of the packet larger than the chunk byte size
+		@param[out] retChunk the chunk popped
+		@return true if the chunk is popped otherwise false
+		@remark the data of the chunk is valid until the buffer is written again.
+		@remark PopPacket returns NULL while the packet in front is popped in the chunks.
+		*/
+		bool PopChunk(Chunk &retChunk);
+
+		/*!
+		Get the byte size of the data received but not popped yet
+		@return the byte size of the data not popped yet
+		*/
+		unsigned int GetReadableByteSize() const;
+
+		/*!
+		Discard all the data in the buffer
+		*/
+		void Clear();
+
+	private:
+		/*!
+		Get the byte size of the first packet including its frame header
+		@return the byte size of the first packet or 0 if the frame header is not complete or corrupted
+		*/
+		unsigned int getFrontPacketByteSize() const;
+
+		/*!
+		Parse the frame header at the read position
+		@param[out] retHeader the header parsed
+		@return true if the header is complete otherwise false
+		*/
+		bool getFrontHeader(FrameCodec::FrameHeader &retHeader) const;
+
+		/*!
+		Check if the packet of the given header exceeds the maximum byte size
+		@param[in] header the header of the packet
+		@return true if the packet is too large otherwise false
+		*/
+		bool isTooLarge(const FrameCodec::FrameHeader &header) const;
+
+		/*!
+		Check if the packet of the given header is popped in the chunks
+		@param[in] header the header of the packet
+		@return true if the packet is popped in the chunks otherwise false
+		*/
+		bool isChunked(const FrameCodec::FrameHeader &header) const;
+
+		/*!
+		Apply and discard the control frames at the read position
+		*/
+		void consumeControlFrames();
+
+		/*!
+		Move the data not popped yet to the front of the buffer with the given byte size
+		@param[in] byteSize the new byte size of the buffer
+		*/
+		void relocate(unsigned int byteSize);
+
+	private:
+		/// buffer
+		char *m_buffer;
+		/// byte size of the buffer
+		unsigned int m_bufferByteSize;
+		/// initial byte size of the buffer
+		unsigned int m_defaultByteSize;
+		/// read position
+		unsigned int m_readIdx;
+		/// write position
+		unsigned int m_writeIdx;
+		/// Frame Codec of the connection
+		FrameCodec *m_frameCodec;
+		/// flag whether the corrupted frame is received
+		bool m_isCorrupted;
+		/// maximum byte size of the packet
+		unsigned int m_maxFrameByteSize;
+		/// byte size of the chunk
+		unsigned int m_chunkByteSize;
+		/// flag whether the packet in front is being popped in the chunks
+		bool m_isChunking;
+		/// message type of the packet popped in the chunks
+		unsigned short m_chunkMessageType;
+		/// offset of the next chunk
+		unsigned int m_chunkOffset;
+		/// byte size of the packet left to pop in the chunks
+		unsigned int m_chunkRemainingByteSize;
+	};
+}
+#endif //__EP_RECEIVE_BUFFER_H__
\ No newline at end of file
@@ -0,0 +1,311 @@
+/*! 
+@file epReliableUdpSession.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Reliable UDP Session Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Reliable UDP Session.
+
+*/
+#ifndef __EP_RELIABLE_UDP_SESSION_H__
+#define __EP_RELIABLE_UDP_SESSION_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include <winsock2.h>
+#include <queue>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class DatagramSenderInterface epReliableUdpSession.h
+	@brief A class for the interface sending the datagram to the peer of the Reliable UDP Session.
+	*/
+	class EP_SERVER_ENGINE DatagramSenderInterface{
+	public:
+		/*!
+		Send the datagram to the peer as it is
+		@param[in] datagram the datagram to be sent
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		*/
+		virtual int SendDatagram(const Packet &datagram,SendStatus *sendStatus=NULL)=0;
+	};
+
+	/*! 
+	@class ReliableUdpSession epReliableUdpSession.h
+	@brief A class for Reliable UDP Session.
+
+	The session puts the header of the channel in front of every datagram
+	exchanged with a peer. The datagrams on the reliable channels carry the
+	sequence numbers, and the peer acknowledges them with the cumulative
+	acknowledgement and the selective acknowledgement bits. The datagram not
+	acknowledged within the retransmission time-out, which follows the round
+	trip time measured, is sent again.
+	@remark Update must be called periodically to retransmit.
+	*/
+	class EP_SERVER_ENGINE ReliableUdpSession{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Session
+		@param[in] sender the object sending the datagram to the peer
+		@param[in] maxDatagramByteSize the maximum byte size of the datagram
+		@param[in] lockPolicyType The lock policy
+		*/
+		ReliableUdpSession(DatagramSenderInterface *sender,unsigned int maxDatagramByteSize,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Session
+		*/
+		virtual ~ReliableUdpSession();
+
+		/*!
+		Send the packet to the peer on the given channel
+		@param[in] packet the packet to be sent
+		@param[in] channel the channel to send the packet on
+		@param[in] sendStatus the status of Send
+		@return sent byte size of the packet
+		@remark return -1 if error occurred
+		@remark SEND_STATUS_FAIL_SEND_QUEUE_FULL if the window of the channel is full.
+		*/
+		int Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus=NULL);
+
+		/*!
+		Process the datagram received from the peer
+		@param[in] datagram the datagram received
+		@param[in] byteSize the byte size of the datagram
+		@remark the packets to deliver are taken by PopPacket.
+		*/
+		void Receive(const char *datagram,unsigned int byteSize);
+
+		/*!
+		Take the packet to deliver in order
+		@return the packet to deliver, or NULL if none is left
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *PopPacket();
+
+		/*!
+		Retransmit the datagrams not acknowledged within the time-out
+		@return false if the peer is not responding after RELIABLE_UDP_RETRANSMIT_LIMIT retransmissions, otherwise true
+		*/
+		bool Update();
+
+		/*!
+		Get the smoothed round trip time
+		@return the smoothed round trip time in millisecond, or 0 if not measured yet
+		*/
+		unsigned int GetRoundTripTime() const;
+
+		/*!
+		Get the retransmission time-out
+		@return the retransmission time-out in millisecond
+		*/
+		unsigned int GetRetransmissionTimeout() const;
+
+		/*!
+		Set the maximum byte size of the datagram
+		@param[in] maxDatagramByteSize the maximum byte size of the datagram
+		*/
+		void SetMaxDatagramByteSize(unsigned int maxDatagramByteSize);
+
+		/*!
+		Discard all the state of the channels
+		*/
+		void Reset();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Session
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		ReliableUdpSession(const ReliableUdpSession& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		ReliableUdpSession & operator=(const ReliableUdpSession&b){return *this;}
+
+		/*!
+		Enumerator for the header of the datagram
+		*/
+		enum ReliableUdpHeader{
+			/// Type of the datagram carrying the packet
+			RELIABLE_UDP_HEADER_TYPE_DATA=1,
+			/// Type of the datagram carrying the acknowledgement
+			RELIABLE_UDP_HEADER_TYPE_ACK,
+			/// Byte size of the header carrying the packet (type, channel and sequence)
+			RELIABLE_UDP_DATA_HEADER_BYTE_SIZE=6,
+			/// Byte size of the acknowledgement (type, channel, cumulative sequence and selective bits)
+			RELIABLE_UDP_ACK_BYTE_SIZE=10,
+			/// Number of the sequences acknowledged selectively
+			RELIABLE_UDP_ACK_BIT_COUNT=32,
+		};
+
+		/*! 
+		@struct SendSlot epReliableUdpSession.h
+		@brief A struct for the datagram sent but not acknowledged.
+		*/
+		struct SendSlot{
+			/// datagram sent, or NULL if acknowledged
+			Packet *m_datagram;
+			/// time sent last
+			unsigned int m_sentTime;
+			/// number of the retransmissions
+			unsigned int m_retransmitCount;
+		};
+
+		/*! 
+		@struct SendChannel epReliableUdpSession.h
+		@brief A struct for the sending state of the reliable channel.
+		*/
+		struct SendChannel{
+			/// oldest sequence not acknowledged
+			unsigned int m_sendBase;
+			/// sequence of the next packet
+			unsigned int m_nextSequence;
+			/// datagrams in flight indexed by the sequence
+			SendSlot m_slotList[RELIABLE_UDP_WINDOW_SIZE];
+		};
+
+		/*! 
+		@struct ReceiveChannel epReliableUdpSession.h
+		@brief A struct for the receiving state of the reliable channel.
+		*/
+		struct ReceiveChannel{
+			/// oldest sequence not received
+			unsigned int m_receiveBase;
+			/// flags for the sequences received ahead of the base
+			bool m_isReceivedList[RELIABLE_UDP_WINDOW_SIZE];
+			/// packets received ahead of the base waiting to be delivered in order
+			Packet *m_packetList[RELIABLE_UDP_WINDOW_SIZE];
+		};
+
+		/*!
+		Get the sending state of the channel
+		@param[in] channel the reliable channel
+		@return the sending state of the channel
+		*/
+		SendChannel *getSendChannel(UdpChannel channel);
+
+		/*!
+		Get the receiving state of the channel
+		@param[in] channel the reliable channel
+		@return the receiving state of the channel
+		*/
+		ReceiveChannel *getReceiveChannel(UdpChannel channel);
+
+		/*!
+		Process the datagram carrying the packet on the reliable channel
+		@param[in] channel the reliable channel
+		@param[in] sequence the sequence of the packet
+		@param[in] packetData the packet
+		@param[in] byteSize the byte size of the packet
+		*/
+		void receiveReliable(UdpChannel channel,unsigned int sequence,const char *packetData,unsigned int byteSize);
+
+		/*!
+		Process the acknowledgement from the peer
+		@param[in] channel the reliable channel
+		@param[in] ackBase the sequence, all before which are received by the peer
+		@param[in] ackBits the bits for the sequences received after ackBase
+		*/
+		void receiveAck(UdpChannel channel,unsigned int ackBase,unsigned int ackBits);
+
+		/*!
+		Send the acknowledgement of the channel to the peer
+		@param[in] channel the reliable channel
+		@param[in] receiveChannel the receiving state of the channel
+		*/
+		void sendAck(UdpChannel channel,ReceiveChannel *receiveChannel);
+
+		/*!
+		Mark the datagram in flight as acknowledged
+		@param[in] slot the slot of the datagram
+		@param[in] currentTime the current time
+		*/
+		void acknowledge(SendSlot &slot,unsigned int currentTime);
+
+		/*!
+		Update the round trip time with the sample measured
+		@param[in] sample the round trip time measured in millisecond
+		*/
+		void updateRoundTripTime(unsigned int sample);
+
+		/*!
+		Delete the state of all the channels
+		*/
+		void deleteChannels();
+
+	private:
+		/// object sending the datagram to the peer
+		DatagramSenderInterface *m_sender;
+		/// maximum byte size of the datagram
+		unsigned int m_maxDatagramByteSize;
+
+		/// sending state of the channels (NULL until used)
+		SendChannel *m_sendChannelList[UDP_CHANNEL_COUNT];
+		/// receiving state of the channels (NULL until used)
+		ReceiveChannel *m_receiveChannelList[UDP_CHANNEL_COUNT];
+		/// packets to deliver
+		queue<Packet*> m_receivedList;
+
+		/// flag whether the round trip time is measured
+		bool m_isRttMeasured;
+		/// smoothed round trip time
+		unsigned int m_smoothedRtt;
+		/// variation of the round trip time
+		unsigned int m_rttVariance;
+		/// retransmission time-out
+		unsigned int m_rto;
+
+		/// session lock
+		epl::BaseLock *m_sessionLock;
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+	};
+}
+#endif //__EP_RELIABLE_UDP_SESSION_H__
\ No newline at end of file
@@ -0,0 +1,181 @@
+/*! 
+@file epSendBuffer.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Send Buffer Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Send Buffer.
+
+*/
+#ifndef __EP_SEND_BUFFER_H__
+#define __EP_SEND_BUFFER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epFrameCodec.h"
+#include <winsock2.h>
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class SendBuffer epSendBuffer.h
+	@brief A class for Send Buffer.
+
+	The packets are held in the buffer with their size fields, and written
+	together with the given packet in a single gather write.
+	@remark Push is thread-safe, but Flush must be serialized by the owner.
+	*/
+	class EP_SERVER_ENGINE SendBuffer{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Buffer
+		@param[in] lockPolicyType The lock policy
+		*/
+		SendBuffer(epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Buffer
+		@param[in] b the second object
+		*/
+		SendBuffer(const SendBuffer& b);
+
+		/*!
+		Default Destructor
+
+		Destroy the Buffer
+		*/
+		virtual ~SendBuffer();
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		*/
+		SendBuffer & operator=(const SendBuffer&b);
+
+		/*!
+		Set the Frame Codec to write the frame headers with
+		@param[in] frameCodec the Frame Codec of the connection
+		@remark the legacy frame is written if not set.
+		@remark the Frame Codec is owned by the connection, so it is not copied with the buffer.
+		*/
+		void SetFrameCodec(FrameCodec *frameCodec);
+
+		/*!
+		Hold the packet to be sent by the next flush
+		@param[in] packet the packet to hold
+		@return the ticket to check if the packet is flushed
+		*/
+		unsigned int Push(const Packet &packet);
+
+		/*!
+		Check if the packet with the given ticket is flushed
+		@param[in] ticket the ticket returned from Push
+		@return true if flushed otherwise false
+		*/
+		bool IsFlushed(unsigned int ticket) const;
+
+		/*!
+		Write all the packets held, and then the given packet in a single gather write
+		@param[in] sendSocket the socket to write to
+		@param[in] packet the packet to write after the packets held
+		@return true if successfully written otherwise false
+		@remark the socket must be in blocking mode.
+		@remark the frame header is written in the headroom of the packet if the packet is not retained by others.
+		*/
+		bool Flush(SOCKET sendSocket,const Packet *packet=NULL);
+
+		/*!
+		Get the byte size of the packets held
+		@return the byte size of the packets held including the frame headers
+		*/
+		unsigned int GetPendingByteSize() const;
+
+		/*!
+		Check if the flush has ever failed since the last Clear
+		@return true if failed otherwise false
+		*/
+		bool IsFlushFailed() const;
+
+		/*!
+		Discard all the packets held and reset the failure
+		*/
+		void Clear();
+
+	private:
+		/*!
+		Write the frame header of the given packet, and compress the packet if negotiated
+		@param[in] packet the packet to write the header of
+		@param[out] retHeader the buffer of FRAME_HEADER_BYTE_SIZE_MAX to write into
+		@param[out] retCompressedPacket the packet compressed to send instead, or NULL to send the packet given
+		@return the byte size written
+		@remark m_lock must be held, so the headers are written in the order of the frames.
+		*/
+		unsigned int encodeFrame(const Packet &packet,char *retHeader,Packet *&retCompressedPacket);
+
+		/*!
+		Write all the data of the given buffers
+		@param[in] sendSocket the socket to write to
+		@param[in] wsaBufs the buffers to write
+		@param[in] wsaBufCount the number of the buffers
+		@return true if successfully written otherwise false
+		*/
+		static bool sendAll(SOCKET sendSocket,WSABUF *wsaBufs,unsigned int wsaBufCount);
+
+	private:
+		/// lock
+		epl::BaseLock *m_lock;
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+		/// packets held with their frame headers
+		vector<char> m_pendingBuffer;
+		/// buffer being written
+		vector<char> m_flushingBuffer;
+		/// ticket of the last packet pushed
+		unsigned int m_pushedTicket;
+		/// ticket of the last packet flushed
+		volatile unsigned int m_flushedTicket;
+		/// flag for the failure
+		volatile bool m_isFlushFailed;
+		/// Frame Codec of the connection
+		FrameCodec *m_frameCodec;
+	};
+}
+#endif //__EP_SEND_BUFFER_H__
\ No newline at end of file
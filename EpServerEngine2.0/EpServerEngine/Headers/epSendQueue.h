@@ -0,0 +1,205 @@
+/*! 
+@file epSendQueue.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Send Queue Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Send Queue.
+
+*/
+#ifndef __EP_SEND_QUEUE_H__
+#define __EP_SEND_QUEUE_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epFrameCodec.h"
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class SendQueue epSendQueue.h
+	@brief A class for Send Queue.
+
+	The lock-free queue of the outbound packets with many producers and a single consumer.
+	The packets are pushed from any thread, and drained by the I/O thread of the socket.
+	The queued byte size is accounted until the data is actually written,
+	and checked against the high/low watermarks and the limit.
+	The frame headers are written by the consumer when drained, so they are
+	in the order of the frames written even while the framing is switched.
+	*/
+	class EP_SERVER_ENGINE SendQueue{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Queue
+		*/
+		SendQueue();
+
+		/*!
+		Default Destructor
+
+		Destroy the Queue
+		*/
+		virtual ~SendQueue();
+
+		/*!
+		Set the watermarks and the limit of the queue
+		@param[in] highWatermark the byte size to notify that the queue is full
+		@param[in] lowWatermark the byte size to notify that the full queue is drained
+		@param[in] limit the byte size not to exceed
+		@remark 0 for the limit means there is no limit
+		*/
+		void SetWatermark(unsigned int highWatermark,unsigned int lowWatermark,unsigned int limit=SEND_QUEUE_LIMIT_INFINITE);
+
+		/*!
+		Set the Frame Codec to write the frame headers with
+		@param[in] frameCodec the Frame Codec of the connection
+		@remark the legacy frame is written if not set.
+		*/
+		void SetFrameCodec(FrameCodec *frameCodec);
+
+		/*!
+		Push the packet to the queue to be written with its frame header
+		@param[in] packet the packet to push
+		@param[out] retIsFull set to true if the queue just reached the high watermark
+		@return true if pushed otherwise false when the limit is exceeded
+		@remark thread-safe for any number of producers
+		*/
+		bool Push(const Packet &packet,bool &retIsFull);
+
+		/*!
+		Account the given byte size as queued without pushing the data
+		@param[in] byteSize the byte size to account
+		@param[out] retIsFull set to true if the queue just reached the high watermark
+		@return true if accounted otherwise false when the limit is exceeded
+		*/
+		bool Reserve(unsigned int byteSize,bool &retIsFull);
+
+		/*!
+		Stop accounting the given byte size as it is written
+		@param[in] byteSize the byte size written
+		@return true if the full queue just dropped to the low watermark otherwise false
+		*/
+		bool Release(unsigned int byteSize);
+
+		/*!
+		Move all the data pushed to the end of the given buffer in order with their frame headers
+		@param[out] retBuffer the buffer to append the data
+		@return the byte size moved
+		@remark must be called only by the single consumer
+		@remark the data is compressed if negotiated by the frame codec.
+		*/
+		unsigned int PopTo(vector<char> &retBuffer);
+
+		/*!
+		Get the byte size queued and not written yet
+		@return the byte size queued
+		*/
+		unsigned int GetQueuedByteSize() const;
+
+		/*!
+		Discard all the data pushed and the accounting
+		@remark must be called only by the single consumer
+		*/
+		void Clear();
+
+	private:
+		/// Node of the queue with the data right after it
+		struct Node{
+			/// next node
+			Node * volatile m_next;
+			/// byte size of the data
+			unsigned int m_byteSize;
+			/// message type of the packet
+			unsigned short m_messageType;
+			/// flags of the packet
+			unsigned char m_flags;
+		};
+
+		/*!
+		Link the node at the head
+		@param[in] node the node to link
+		*/
+		void pushNode(Node *node);
+
+		/*!
+		Unlink the node at the tail
+		@return the node unlinked or NULL if the queue is empty
+		*/
+		Node *popNode();
+
+		/*!
+		Default Copy Constructor
+
+		Initializes the Queue
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		SendQueue(const SendQueue& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		SendQueue & operator=(const SendQueue&b){return *this;}
+
+	private:
+		/// the node the producers link after
+		Node * volatile m_head;
+		/// the node the consumer unlinks
+		Node *m_tail;
+		/// the placeholder node
+		Node m_stub;
+
+		/// byte size queued
+		volatile LONG m_queuedByteSize;
+		/// flag whether the queue reached the high watermark
+		volatile LONG m_isFull;
+
+		/// high watermark
+		unsigned int m_highWatermark;
+		/// low watermark
+		unsigned int m_lowWatermark;
+		/// limit
+		unsigned int m_limit;
+		/// Frame Codec of the connection
+		FrameCodec *m_frameCodec;
+	};
+}
+#endif //__EP_SEND_QUEUE_H__
\ No newline at end of file
@@ -74,6 +74,415 @@ namespace epse{
 	*/
 	#define PROCESSOR_LIMIT_INFINITE 0
 
+	/*!
+	@def PACKET_INLINE_BYTE_SIZE
+	@brief byte size of the packet stored inline
+
+	Macro for the maximum byte size of the packet stored in the Packet object itself without the heap allocation.
+	@remark the headroom and the tailroom reserved are included.
+	*/
+	#define PACKET_INLINE_BYTE_SIZE 64
+
+	/*!
+	@def PACKET_HEADROOM_BYTE_SIZE_DEFAULT
+	@brief default byte size of the headroom of the packet
+
+	Macro for the default byte size reserved in front of the packet allocated to prepend the headers without copying.
+	*/
+	#define PACKET_HEADROOM_BYTE_SIZE_DEFAULT 16
+
+	/*!
+	@def BUFFER_POOL_CLASS_BYTE_SIZE_MIN
+	@brief byte size of the smallest size class of the Buffer Pool
+
+	Macro for the byte size of the smallest size class of the Buffer Pool.
+	@remark must be the power of 2.
+	*/
+	#define BUFFER_POOL_CLASS_BYTE_SIZE_MIN 64
+
+	/*!
+	@def BUFFER_POOL_CLASS_COUNT
+	@brief number of the size classes of the Buffer Pool
+
+	Macro for the number of the size classes of the Buffer Pool, each of which is double the previous.
+	@remark the larger buffer is allocated from the heap directly.
+	*/
+	#define BUFFER_POOL_CLASS_COUNT 11
+
+	/*!
+	@def BUFFER_POOL_BATCH_COUNT
+	@brief number of the buffers moved between the thread cache and the depot at once
+
+	Macro for the number of the buffers of a size class moved between the cache of a thread and the global depot at once.
+	*/
+	#define BUFFER_POOL_BATCH_COUNT 32
+
+	/*!
+	@def BUFFER_POOL_CHUNK_BYTE_SIZE
+	@brief byte size of the chunk the Buffer Pool carves the buffers from
+
+	Macro for the byte size of the memory reserved at once to carve the buffers of a size class from.
+	*/
+	#define BUFFER_POOL_CHUNK_BYTE_SIZE (256*1024)
+
+	/*!
+	@def RECEIVE_BUFFER_BYTE_SIZE_DEFAULT
+	@brief default byte size of the receive buffer
+
+	Macro for the default byte size of the receive buffer for each connection.
+	*/
+	#define RECEIVE_BUFFER_BYTE_SIZE_DEFAULT 8192
+
+	/*!
+	@def SEND_COALESCE_BYTE_SIZE_MAX
+	@brief maximum byte size of the packets coalesced
+
+	Macro for the maximum byte size of the packets held to be sent together in a single write.
+	*/
+	#define SEND_COALESCE_BYTE_SIZE_MAX 65536
+
+	/*!
+	@def FRAME_VERSION_LEGACY
+	@brief version of the legacy frame
+
+	Macro for the version of the frame with the 4-byte size field only.
+	*/
+	#define FRAME_VERSION_LEGACY 0
+
+	/*!
+	@def FRAME_VERSION_COMPACT
+	@brief version of the compact frame
+
+	Macro for the version of the frame with the varint size, the message type and the flags.
+	*/
+	#define FRAME_VERSION_COMPACT 1
+
+	/*!
+	@def FRAME_HEADER_BYTE_SIZE_MAX
+	@brief maximum byte size of the frame header
+
+	Macro for the maximum byte size of the frame header including the control frames sent in front of it.
+	*/
+	#define FRAME_HEADER_BYTE_SIZE_MAX 32
+
+	/*!
+	@def FRAME_FLAGS_MAX
+	@brief maximum value of the frame flags
+
+	Macro for the maximum value of the flags carried by the compact frame.
+	@remark the highest bit of the flags field is reserved for the compression.
+	*/
+	#define FRAME_FLAGS_MAX 0x07
+
+	/*!
+	@def FRAME_PAYLOAD_BYTE_SIZE_MAX
+	@brief maximum byte size of the packet carried by a frame
+
+	Macro for the maximum byte size of the packet a frame received may announce.
+	@remark the frame announcing the larger packet is treated as the corrupted stream.
+	*/
+	#define FRAME_PAYLOAD_BYTE_SIZE_MAX 0x7FFFFFFF
+
+	/*!
+	@def SEND_QUEUE_HIGH_WATERMARK_DEFAULT
+	@brief default high watermark of the send queue
+
+	Macro for the default byte size of the send queue to notify that the queue is full.
+	*/
+	#define SEND_QUEUE_HIGH_WATERMARK_DEFAULT 1048576
+
+	/*!
+	@def SEND_QUEUE_LOW_WATERMARK_DEFAULT
+	@brief default low watermark of the send queue
+
+	Macro for the default byte size of the send queue to notify that the full queue is drained.
+	*/
+	#define SEND_QUEUE_LOW_WATERMARK_DEFAULT 262144
+
+	/*!
+	@def SEND_QUEUE_LIMIT_INFINITE
+	@brief send queue limit infinite
+
+	Macro for the send queue with no limit.
+	*/
+	#define SEND_QUEUE_LIMIT_INFINITE 0
+
+	/*!
+	@def SHARD_CHANNEL_CAPACITY_DEFAULT
+	@brief default capacity of the shard channel
+
+	Macro for the default number of the messages the channel between the shards can hold.
+	*/
+	#define SHARD_CHANNEL_CAPACITY_DEFAULT 1024
+
+	/*!
+	@def TIMING_WHEEL_TICK_MILLISEC
+	@brief resolution of the timing wheel
+
+	Macro for the time in millisecond of a tick of the timing wheel.
+	*/
+	#define TIMING_WHEEL_TICK_MILLISEC 10
+
+	/*!
+	@def IDLE_TIMEOUT_INFINITE
+	@brief infinite idle timeout
+
+	Macro for the idle timeout that never disconnects the idle socket.
+	*/
+	#define IDLE_TIMEOUT_INFINITE 0
+
+	/*!
+	@def TIMER_ID_NONE
+	@brief invalid timer id
+
+	Macro for the timer id which is not valid.
+	*/
+	#define TIMER_ID_NONE 0
+
+	/*!
+	@def SOCKET_POOL_CAPACITY_DEFAULT
+	@brief default capacity of the socket pool
+
+	Macro for the default number of the disconnected socket objects kept to be recycled.
+	*/
+	#define SOCKET_POOL_CAPACITY_DEFAULT 1024
+
+	/*!
+	@def SERVER_OBJECT_LIST_SHARD_COUNT
+	@brief number of the shards of the server object list
+
+	Macro for the number of the shards, each with its own lock, the server object list is split into.
+	*/
+	#define SERVER_OBJECT_LIST_SHARD_COUNT 16
+
+	/*!
+	@def OBJECT_ID_NONE
+	@brief id for the object not in any list
+
+	Macro for the object id which is not valid.
+	*/
+	#define OBJECT_ID_NONE 0
+
+	/*!
+	@def EVENT_LOOP_COMPLETION_BATCH_COUNT
+	@brief maximum number of the completions dequeued at once
+
+	Macro for the maximum number of the completions the Event Loop dequeues with a single call.
+	*/
+	#define EVENT_LOOP_COMPLETION_BATCH_COUNT 64
+
+	/*!
+	@def UDP_RECEIVE_BATCH_COUNT_DEFAULT
+	@brief default number of the receives of the UDP server in progress
+
+	Macro for the default number of the overlapped receives, each with its own buffer, kept in progress on the UDP listen socket.
+	*/
+	#define UDP_RECEIVE_BATCH_COUNT_DEFAULT 32
+
+	/*!
+	@def UDP_RECEIVE_SLAB_SLOT_COUNT_DEFAULT
+	@brief default number of the slots of the UDP receive slab
+
+	Macro for the default number of the preallocated buffers, which the UDP server receives the datagrams into.
+	*/
+	#define UDP_RECEIVE_SLAB_SLOT_COUNT_DEFAULT 128
+
+	/*!
+	@def UDP_PEER_DISPATCH_BATCH_COUNT
+	@brief maximum number of the datagrams of a client dispatched at once
+
+	Macro for the maximum number of the datagrams of a client dispatched in a row before the worker thread is given to the other clients.
+	*/
+	#define UDP_PEER_DISPATCH_BATCH_COUNT 16
+
+	/*!
+	@def UDP_SEND_BATCH_COUNT_MAX
+	@brief maximum number of the datagrams held to be sent together
+
+	Macro for the maximum number of the datagrams the UDP server holds to send together with a single wait for the listen socket.
+	*/
+	#define UDP_SEND_BATCH_COUNT_MAX 64
+
+	/*!
+	@def RELIABLE_UDP_WINDOW_SIZE
+	@brief window size of the reliable UDP channel
+
+	Macro for the maximum number of the datagrams of a reliable UDP channel in flight, or waiting to be delivered in order.
+	@remark must be the power of 2.
+	*/
+	#define RELIABLE_UDP_WINDOW_SIZE 128
+
+	/*!
+	@def RELIABLE_UDP_TICK_MILLISEC
+	@brief interval of the reliable UDP retransmission check
+
+	Macro for the interval in millisecond of the check for the reliable UDP datagrams to retransmit.
+	*/
+	#define RELIABLE_UDP_TICK_MILLISEC 10
+
+	/*!
+	@def RELIABLE_UDP_RTO_DEFAULT
+	@brief initial retransmission time-out of the reliable UDP channel
+
+	Macro for the retransmission time-out in millisecond used until the round trip time is measured.
+	*/
+	#define RELIABLE_UDP_RTO_DEFAULT 200
+
+	/*!
+	@def RELIABLE_UDP_RTO_MIN
+	@brief minimum retransmission time-out of the reliable UDP channel
+
+	Macro for the minimum retransmission time-out in millisecond.
+	*/
+	#define RELIABLE_UDP_RTO_MIN 20
+
+	/*!
+	@def RELIABLE_UDP_RTO_MAX
+	@brief maximum retransmission time-out of the reliable UDP channel
+
+	Macro for the maximum retransmission time-out in millisecond including the back-off.
+	*/
+	#define RELIABLE_UDP_RTO_MAX 3000
+
+	/*!
+	@def RELIABLE_UDP_RETRANSMIT_LIMIT
+	@brief maximum number of the retransmissions of the reliable UDP datagram
+
+	Macro for the number of the retransmissions of a datagram, after which the peer is regarded as disconnected.
+	*/
+	#define RELIABLE_UDP_RETRANSMIT_LIMIT 10
+
+	/*!
+	@def UDP_FRAGMENT_MESSAGE_BYTE_SIZE_MAX
+	@brief maximum byte size of the UDP packet fragmented
+
+	Macro for the maximum byte size of a packet sent in the fragments over UDP.
+	@remark the larger packet is refused by the sender and dropped by the receiver.
+	*/
+	#define UDP_FRAGMENT_MESSAGE_BYTE_SIZE_MAX (1024*1024)
+
+	/*!
+	@def UDP_REASSEMBLY_BYTE_SIZE_MAX
+	@brief maximum byte size of the UDP packets being reassembled per peer
+
+	Macro for the byte size of the packets being reassembled from the fragments of a peer at once.
+	@remark the oldest packet incomplete is dropped to reassemble the new packet over the limit.
+	*/
+	#define UDP_REASSEMBLY_BYTE_SIZE_MAX (4*1024*1024)
+
+	/*!
+	@def UDP_REASSEMBLY_TIMEOUT_MILLISEC
+	@brief time-out of the UDP packet being reassembled
+
+	Macro for the time in millisecond to wait for the rest of the fragments of a packet, after which the packet is dropped.
+	*/
+	#define UDP_REASSEMBLY_TIMEOUT_MILLISEC 3000
+
+	/*!
+	@def COMPRESSION_THRESHOLD_NONE
+	@brief compression disabled
+
+	Macro for the compression threshold not compressing any packet.
+	*/
+	#define COMPRESSION_THRESHOLD_NONE 0
+
+	/*!
+	@def COMPRESSION_DICTIONARY_BYTE_SIZE_MAX
+	@brief maximum byte size of the compression dictionary
+
+	Macro for the maximum byte size of the dictionary the packets are compressed with.
+	@remark only the last bytes of the larger dictionary are used, since the matches cannot reach further.
+	*/
+	#define COMPRESSION_DICTIONARY_BYTE_SIZE_MAX 65535
+
+	/*!
+	@def UDP_COMPRESSION_HEADER_BYTE_SIZE
+	@brief byte size of the UDP compression header
+
+	Macro for the byte size of the header marking every datagram compressed or not, when the UDP compression is enabled.
+	*/
+	#define UDP_COMPRESSION_HEADER_BYTE_SIZE 1
+
+	/*!
+	@def PACKET_WRITER_BYTE_SIZE_DEFAULT
+	@brief default byte size reserved by the Packet Writer
+
+	Macro for the default byte size reserved for the packet when the Packet Writer starts writing.
+	@remark the packet grows geometrically when more is written.
+	*/
+	#define PACKET_WRITER_BYTE_SIZE_DEFAULT 256
+
+	/*!
+	@def FRAME_BYTE_SIZE_UNLIMITED
+	@brief No limit for the frame byte size
+
+	Macro for no limit for the byte size of the packet framed, received from the peer.
+	*/
+	#define FRAME_BYTE_SIZE_UNLIMITED 0
+
+	/*!
+	@def FRAME_BYTE_SIZE_MAX_DEFAULT
+	@brief default maximum byte size of the packet framed
+
+	Macro for the default maximum byte size of the packet framed, received from the peer.
+	@remark the peer can not make the connection buffer more than this by announcing the large packet.
+	@remark set maxFrameByteSize to FRAME_BYTE_SIZE_UNLIMITED, or to the larger size, to receive the larger packets.
+	*/
+	#define FRAME_BYTE_SIZE_MAX_DEFAULT (4*1024*1024)
+
+	/*!
+	@def RECEIVE_CHUNK_BYTE_SIZE_NONE
+	@brief chunked delivery disabled
+
+	Macro for the chunk byte size delivering every packet received as a whole.
+	*/
+	#define RECEIVE_CHUNK_BYTE_SIZE_NONE 0
+
+	/*!
+	@def JOB_QUEUE_CAPACITY_DEFAULT
+	@brief default capacity of the job queues of a worker
+
+	Macro for the default number of the jobs each queue of the scheduler worker can hold.
+	*/
+	#define JOB_QUEUE_CAPACITY_DEFAULT 1024
+
+	/*!
+	@def JOB_SCHEDULER_INBOX_CHECK_INTERVAL
+	@brief interval to check the inbox of the scheduler worker
+
+	Macro for the number of the jobs a worker processes from its own deque before it checks its inbox first.
+	*/
+	#define JOB_SCHEDULER_INBOX_CHECK_INTERVAL 16
+
+	/*!
+	@def JOB_PRIORITY_BUCKET_COUNT
+	@brief number of the priority buckets of the job queue
+
+	Macro for the number of the priority buckets, the lowest for the priorities below normal,
+	the next for the normal priority, and the rest for each priority above.
+	*/
+	#define JOB_PRIORITY_BUCKET_COUNT 4
+
+	/// Byte Order of the values serialized
+	typedef enum _byteOrder{
+		/// Little Endian (as the host of Windows)
+		BYTE_ORDER_LITTLE_ENDIAN=0,
+		/// Big Endian (as the network byte order)
+		BYTE_ORDER_BIG_ENDIAN,
+	}ByteOrder;
+
+	/// UDP Channel
+	typedef enum _udpChannel{
+		/// Unreliable (as raw datagram)
+		UDP_CHANNEL_UNRELIABLE=0,
+		/// Reliable but delivered as arrived
+		UDP_CHANNEL_RELIABLE_UNORDERED,
+		/// Reliable and delivered in the order sent
+		UDP_CHANNEL_RELIABLE_ORDERED,
+		/// Number of the channels
+		UDP_CHANNEL_COUNT,
+	}UdpChannel;
+
 	/// Receive Status
 	typedef enum _receiveStatus{
 		/// Success
@@ -105,6 +514,10 @@ namespace epse{
 		SEND_STATUS_FAIL_SEND_FAILED,
 		/// Not connected
 		SEND_STATUS_FAIL_NOT_CONNECTED,
+		/// Send queue exceeded the limit
+		SEND_STATUS_FAIL_SEND_QUEUE_FULL,
+		/// Send not supported
+		SEND_STATUS_FAIL_NOT_SUPPORTED,
 
 	}SendStatus;
 	
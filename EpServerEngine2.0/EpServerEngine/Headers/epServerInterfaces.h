@@ -44,6 +44,11 @@ An Interface for Server Interfaces.
 #include "epBaseServerObject.h"
 namespace epse{
 	class ServerCallbackInterface;
+	class SocketInterface;
+	template<typename SourceInterface> class MessageDispatcher;
+
+	/// Message Dispatcher for the packets received by the sockets
+	typedef MessageDispatcher<SocketInterface> ServerMessageDispatcher;
 
 	/*! 
 	@struct ServerOps epServerInterfaces.h
@@ -66,10 +71,136 @@ namespace epse{
 
 		/*!
 		The number of worker thread.
-		@remark For IOCP Use Only!
+		@remark For IOCP and Asynchronous UDP Server Use Only!
 		*/
 		unsigned int workerThreadCount;
 
+		/*!
+		The byte size of the send queue to call OnSendQueueFull.
+		@remark For Event and IOCP TCP Server Use Only!
+		*/
+		unsigned int sendQueueHighWatermark;
+
+		/*!
+		The byte size of the send queue to call OnSendQueueDrained after OnSendQueueFull.
+		@remark For Event and IOCP TCP Server Use Only!
+		*/
+		unsigned int sendQueueLowWatermark;
+
+		/*!
+		The byte size of the send queue to disconnect the slow client.
+		@remark 0 means there is no limit
+		@remark For Event and IOCP TCP Server Use Only!
+		*/
+		unsigned int sendQueueLimit;
+
+		/*!
+		The flag for the shard-per-core mode.
+		@remark the number of the shards is workerThreadCount. (0 for the number of cores)
+		@remark For Event TCP Server Use Only!
+		*/
+		bool isShardPerCore;
+
+		/*!
+		The maximum number of the disconnected socket objects kept to be recycled.
+		@remark 0 means the socket objects are not recycled
+		@remark For Event and IOCP Server Use Only!
+		*/
+		unsigned int socketPoolCapacity;
+
+		/*!
+		The number of the overlapped receives kept in progress on the listen socket.
+		@remark 0 means UDP_RECEIVE_BATCH_COUNT_DEFAULT
+		@remark For IOCP UDP Server Use Only!
+		*/
+		unsigned int receiveBatchCount;
+
+		/*!
+		The number of the preallocated buffers, which the datagrams are received into without copying.
+		@remark the buffers are in use until the packets received are released.
+		@remark the datagram is copied into the heap buffer if all the buffers are in use.
+		@remark 0 to always receive into the heap buffers.
+		@remark For UDP Server Use Only!
+		*/
+		unsigned int receiveSlabSlotCount;
+
+		/*!
+		The flag for the UDP segmentation offload.
+		@remark SendSegments hands all the segments to the kernel in a single send.
+		@remark the IOCP UDP Server also receives the datagrams coalesced by the kernel in a single receive.
+		@remark it falls back to a datagram per call if the network stack does not support it.
+		@remark For UDP Server Use Only!
+		*/
+		bool isSegmentationOffload;
+
+		/*!
+		The flag for the reliable UDP.
+		@remark every datagram carries the header of the channel, so the clients must use the reliable UDP as well.
+		@remark For UDP Server Use Only!
+		*/
+		bool isReliableUdp;
+
+		/*!
+		The flag for the UDP fragmentation.
+		@remark the packet larger than the maximum datagram is sent in the fragments, and reassembled by the receiver.
+		@remark every datagram carries the header of the fragment, so the clients must use the UDP fragmentation as well.
+		@remark For UDP Server Use Only!
+		*/
+		bool isFragmentedUdp;
+
+		/*!
+		The highest version of the frame to accept from the clients.
+		@remark the compact frame is used only with the clients offering it, and the other clients keep the legacy frame.
+		@remark For TCP Server Use Only!
+		*/
+		unsigned int frameVersion;
+
+		/*!
+		The dispatcher calling the handler registered for the message type of the packet received.
+		@remark the packet of the message type with no handler is delivered to OnReceived.
+		@remark the message type is carried only by the compact frame, so every other packet has the message type 0.
+		@remark For Asynchronous, Event and IOCP Server Use Only!
+		*/
+		ServerMessageDispatcher *messageDispatcher;
+
+		/*!
+		The minimum byte size of the packet to compress.
+		@remark COMPRESSION_THRESHOLD_NONE disables the compression.
+		@remark TCP compresses only with the clients offering the compression.
+		@remark every datagram of UDP carries the byte marking the compression, so the clients must use the compression as well.
+		*/
+		unsigned int compressionThreshold;
+
+		/*!
+		The dictionary of the bytes typical for the packets, shared with the clients.
+		@remark TCP uses the dictionary only with the clients of the same dictionary, and UDP clients must have the same dictionary.
+		@remark the dictionary is copied when the server starts.
+		*/
+		const void *compressionDictionary;
+
+		/*!
+		The byte size of the dictionary.
+		@remark only the last COMPRESSION_DICTIONARY_BYTE_SIZE_MAX bytes are used.
+		*/
+		unsigned int compressionDictionaryByteSize;
+
+		/*!
+		The maximum byte size of the packet to receive from the clients.
+		@remark the client sending the larger packet is disconnected before the packet is buffered.
+		@remark FRAME_BYTE_SIZE_MAX_DEFAULT by default, and FRAME_BYTE_SIZE_UNLIMITED for no limit.
+		@remark the packet delivered in the chunks is limited as well, so raise it to stream the larger packets.
+		@remark For TCP Server Use Only!
+		*/
+		unsigned int maxFrameByteSize;
+
+		/*!
+		The byte size of the chunks to deliver the larger packet in, through OnReceiveChunk.
+		@remark the packet is not buffered as a whole, so the memory per connection is bounded by the chunk.
+		@remark RECEIVE_CHUNK_BYTE_SIZE_NONE to deliver every packet as a whole.
+		@remark For Synchronous, Asynchronous and Event TCP Server Use Only!
+		*/
+		unsigned int receiveChunkByteSize;
+
 		/*!
 		Default Constructor
 
@@ -83,7 +214,23 @@ namespace epse{
 			waitTimeMilliSec=WAITTIME_INIFINITE;
 			maximumConnectionCount=CONNECTION_LIMIT_INFINITE;
 			workerThreadCount=0;
-
+			sendQueueHighWatermark=SEND_QUEUE_HIGH_WATERMARK_DEFAULT;
+			sendQueueLowWatermark=SEND_QUEUE_LOW_WATERMARK_DEFAULT;
+			sendQueueLimit=SEND_QUEUE_LIMIT_INFINITE;
+			isShardPerCore=false;
+			socketPoolCapacity=SOCKET_POOL_CAPACITY_DEFAULT;
+			receiveBatchCount=UDP_RECEIVE_BATCH_COUNT_DEFAULT;
+			receiveSlabSlotCount=UDP_RECEIVE_SLAB_SLOT_COUNT_DEFAULT;
+			isSegmentationOffload=false;
+			isReliableUdp=false;
+			isFragmentedUdp=false;
+			frameVersion=FRAME_VERSION_LEGACY;
+			messageDispatcher=NULL;
+			compressionThreshold=COMPRESSION_THRESHOLD_NONE;
+			compressionDictionary=NULL;
+			compressionDictionaryByteSize=0;
+			maxFrameByteSize=FRAME_BYTE_SIZE_MAX_DEFAULT;
+			receiveChunkByteSize=RECEIVE_CHUNK_BYTE_SIZE_NONE;
 		}
 
 		static ServerOps defaultServerOps;
@@ -200,10 +347,46 @@ namespace epse{
 		@param[in] packet the packet to be sent
 		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
 		@param[in] sendStatus the status of Send
+		@param[in] isMoreComing the flag whether more packets are sent right after this packet
 		@return sent byte size
 		@remark return -1 if error occurred
+		@remark for TCP, the packet with isMoreComing is held and written together with the next packet sent without it.
 		*/
-		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL)=0;
+		virtual int Send(const Packet &packet, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL,bool isMoreComing=false)=0;
+
+		/*!
+		Send the packet to the client on the given channel
+		@param[in] packet the packet to be sent
+		@param[in] channel the channel to send the packet on
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark the reliable packet is retransmitted until acknowledged.
+		@remark for UDP Socket with the reliable UDP Use Only!
+		*/
+		virtual int Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus=NULL)
+		{
+			if(sendStatus)
+				*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+			return -1;
+		}
+
+		/*!
+		Send the packet to the client split into the datagrams of the given byte size
+		@param[in] packet the packet to be split and sent
+		@param[in] segmentByteSize the byte size of each datagram (the last one can be smaller)
+		@param[in] waitTimeInMilliSec wait time for sending the packet in millisecond
+		@param[in] sendStatus the status of Send
+		@return sent byte size
+		@remark return -1 if error occurred
+		@remark for UDP Socket Use Only!
+		*/
+		virtual int SendSegments(const Packet &packet,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec=WAITTIME_INIFINITE,SendStatus *sendStatus=NULL)
+		{
+			if(sendStatus)
+				*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+			return -1;
+		}
 
 		/*!
 		Receive the packet from the client
@@ -316,6 +499,48 @@ namespace epse{
 		*/
 		virtual unsigned int GetMaxPacketByteSize() const{return 0;}
 
+		/*!
+		Get the send coalescing flag for the Socket.
+		@return The flag whether to coalesce the packets sent concurrently.
+		@remark for TCP Socket Use Only!
+		*/
+		virtual bool GetIsSendCoalescing() const
+		{
+			return false;
+		}
+
+		/*!
+		Set the send coalescing flag for the Socket.
+		@param[in] isSendCoalescing The flag whether to coalesce the packets sent concurrently.
+		@remark the packets sent while another Send is writing are written together in a single write.
+		@remark for TCP Socket Use Only!
+		*/
+		virtual void SetIsSendCoalescing(bool isSendCoalescing)
+		{
+			return;
+		}
+
+		/*!
+		Get the idle timeout for the Socket.
+		@return the time in millisecond to disconnect the socket receiving nothing.
+		@remark for Event and IOCP Server Use Only!
+		*/
+		virtual unsigned int GetIdleTimeout() const
+		{
+			return IDLE_TIMEOUT_INFINITE;
+		}
+
+		/*!
+		Set the idle timeout for the Socket.
+		@param[in] milliSec the time in millisecond to disconnect the socket receiving nothing. (IDLE_TIMEOUT_INFINITE to disable)
+		@remark the socket is checked by the timer of its Event Loop, so receiving costs nothing more.
+		@remark for Event and IOCP Server Use Only!
+		*/
+		virtual void SetIdleTimeout(unsigned int milliSec)
+		{
+			return;
+		}
+
 		
 
 	};
@@ -350,6 +575,18 @@ namespace epse{
 		*/
 		virtual void OnReceived(SocketInterface *socket,const Packet*receivedPacket,ReceiveStatus status)=0;
 
+		/*!
+		Received the chunk of the packet larger than the chunk byte size from the client.
+		@param[in] socket the client socket which received the chunk
+		@param[in] offset the offset of the chunk in the packet
+		@param[in] data the data of the chunk
+		@param[in] byteSize the byte size of the chunk
+		@param[in] isLast the flag whether the chunk is the last of the packet
+		@remark data is valid only until returned, and called on the receiving thread in order.
+		@remark for Synchronous, Asynchronous and Event TCP Server with receiveChunkByteSize set Use Only!
+		*/
+		virtual void OnReceiveChunk(SocketInterface *socket,unsigned int offset,const char *data,unsigned int byteSize,bool isLast){}
+
 		/*!
 		Sent the packet from the client.
 		@param[in] socket the client socket which sent the packet
@@ -358,6 +595,38 @@ namespace epse{
 		*/
 		virtual void OnSent(SocketInterface *socket,SendStatus status){}
 
+		/*!
+		The data queued to send to the client reached the high watermark.
+		@param[in] socket the client socket whose send queue is full
+		@remark for Event and IOCP TCP Server Use Only!
+		*/
+		virtual void OnSendQueueFull(SocketInterface *socket){}
+
+		/*!
+		The data queued to send to the client dropped to the low watermark after full.
+		@param[in] socket the client socket whose send queue is drained
+		@remark for Event and IOCP TCP Server Use Only!
+		*/
+		virtual void OnSendQueueDrained(SocketInterface *socket){}
+
+		/*!
+		Received the message from the other shard.
+		@param[in] shardIndex the index of the shard receiving the message
+		@param[in] fromShardIndex the index of the shard which sent the message
+		@param[in] message the message received
+		@remark called on the Event Loop thread of the receiving shard.
+		@remark for Event TCP Server in the shard-per-core mode Use Only!
+		*/
+		virtual void OnShardMessage(unsigned int shardIndex,unsigned int fromShardIndex,const Packet *message){}
+
+		/*!
+		The timer scheduled by the server is expired.
+		@param[in] timerId the id of the expired timer
+		@remark called on the Event Loop thread of the timer.
+		@remark for Event and IOCP Server Use Only!
+		*/
+		virtual void OnTimer(unsigned int timerId){}
+
 		/*!
 		The client is disconnected.
 		@param[in] socket the client socket, disconnected.
@@ -42,6 +42,7 @@ An Interface for Server Object List.
 #include "epBaseServerObject.h"
 #include "epServerObjectRemover.h"
 #include <vector>
+#include <map>
 #include "epPacket.h"
 
 using namespace std;
@@ -69,6 +70,7 @@ namespace epse{
 		friend class AsyncTcpSocket;
 		friend class SyncTcpServer;
 
+		friend class BaseUdpServer;
 		friend class AsyncUdpServer;
 		friend class AsyncUdpSocket;
 		friend class SyncUdpServer;
@@ -77,6 +79,8 @@ namespace epse{
 
 		friend class IocpTcpServer;
 		friend class IocpUdpServer;
+		friend class EventTcpServer;
+		friend class EventTcpShard;
 		/*!
 		Default Constructor
 
@@ -173,22 +177,42 @@ namespace epse{
 		@param[in] key the key to find
 		@param[in] EqualFunc the Compare Function
 		@return the found BaseServerObject
+		@remark this scans all the objects, so use the indexed Find if possible.
 		*/
 		template <typename T>
 		BaseServerObject  *Find(T const & key, bool (__cdecl *EqualFunc)(T const &, const BaseServerObject *))
 		{
-			epl::LockObj lock(m_listLock);
-			vector<BaseServerObject*>::iterator iter;
-			for(iter=m_objectList.begin();iter!=m_objectList.end();iter++)
+			for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
 			{
-				if(EqualFunc(key,*iter))
+				ObjectShard &shard=m_shardList[shardIdx];
+				epl::LockObj lock(shard.m_lock);
+				map<unsigned int,ObjectEntry>::iterator iter;
+				for(iter=shard.m_objectMap.begin();iter!=shard.m_objectMap.end();iter++)
 				{
-					return *iter;
+					if(EqualFunc(key,iter->second.m_object))
+					{
+						return iter->second.m_object;
+					}
 				}
 			}
 			return NULL;
 		}
 
+		/*!
+		Find the object with given address
+		@param[in] sockAddr the address of the object to find
+		@return the found BaseServerObject
+		@remark only the objects which have the address when pushed are indexed.
+		*/
+		BaseServerObject *Find(const sockaddr &sockAddr);
+
+		/*!
+		Find the object with given object id
+		@param[in] objectId the id of the object to find
+		@return the found BaseServerObject
+		*/
+		BaseServerObject *Find(unsigned int objectId);
+
 		/*!
 		Wait infinitely for the list size to be decreased
 		*/
@@ -199,12 +223,83 @@ namespace epse{
 		Reset the list
 		*/
 		void resetList();
+
+		/*!
+		Create the locks of the shards
+		*/
+		void createShards();
+
+		/*!
+		Copy all the objects of the given list to this list
+		@param[in] b the list to copy from
+		*/
+		void copyShards(const ServerObjectList &b);
+
+		/*!
+		Get the index of the shard for the given object id
+		@param[in] objectId the object id
+		@return the index of the shard
+		*/
+		static unsigned int getShardIndex(unsigned int objectId);
+
+		/*!
+		Get the index of the shard for the given address
+		@param[in] sockAddr the address
+		@return the index of the shard
+		*/
+		static unsigned int getShardIndex(const sockaddr &sockAddr);
+
+		/*!
+		@struct SockAddrLess epServerObjectList.h
+		@brief A functor to order the addresses in the address index.
+		*/
+		struct SockAddrLess{
+			/*!
+			Compare the given addresses
+			@param[in] a the first address
+			@param[in] b the second address
+			@return true if a is ordered before b otherwise false
+			*/
+			bool operator()(const sockaddr &a,const sockaddr &b) const
+			{
+				if(a.sa_family!=b.sa_family)
+					return a.sa_family<b.sa_family;
+				return epl::System::Memcmp((void*)a.sa_data,(void*)b.sa_data,sizeof(a.sa_data))<0;
+			}
+		};
+
+		/*!
+		@struct ObjectEntry epServerObjectList.h
+		@brief A struct for the object and the address it is indexed by.
+		*/
+		struct ObjectEntry{
+			/// the object
+			BaseServerObject *m_object;
+			/// flag whether the object is indexed by the address
+			bool m_hasAddress;
+			/// the address the object is indexed by
+			sockaddr m_sockAddr;
+		};
+
+		/*!
+		@struct ObjectShard epServerObjectList.h
+		@brief A struct for a part of the list with its own lock.
+		@remark an object lives in the shard of its id, and is indexed in the shard of its address.
+		*/
+		struct ObjectShard{
+			/// shard lock
+			epl::BaseLock *m_lock;
+			/// objects by the object id
+			map<unsigned int,ObjectEntry> m_objectMap;
+			/// objects by the address
+			map<sockaddr,BaseServerObject*,SockAddrLess> m_addressMap;
+		};
 	
 		/// list lock
 		epl::BaseLock *m_listLock;
 
-		/// parser thread list
-		vector<BaseServerObject*> m_objectList;
+		/// shards of the list
+		ObjectShard m_shardList[SERVER_OBJECT_LIST_SHARD_COUNT];
 
 		/// wait time in millisecond for terminating thread
 		/// @remark for ParserList and ServerObjectRemover
@@ -218,6 +313,9 @@ namespace epse{
 
 		epl::EventEx m_sizeEvent;
 
+		/// last object id given
+		static volatile LONG m_lastObjectId;
+
 	};
 	
 }
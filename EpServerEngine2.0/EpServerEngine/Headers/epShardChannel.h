@@ -0,0 +1,125 @@
+/*! 
+@file epShardChannel.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Shard Channel Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Shard Channel.
+
+*/
+#ifndef __EP_SHARD_CHANNEL_H__
+#define __EP_SHARD_CHANNEL_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+
+namespace epse{
+
+	/*! 
+	@class ShardChannel epShardChannel.h
+	@brief A class for Shard Channel.
+
+	The lock-free bounded ring of the messages from a single producer shard
+	to a single consumer shard.
+	@remark Push must be called only from the producer thread, and Pop only from the consumer thread.
+	*/
+	class EP_SERVER_ENGINE ShardChannel{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Channel
+		@param[in] capacity the number of the messages the channel can hold
+		@remark the capacity is rounded up to the power of two.
+		*/
+		ShardChannel(unsigned int capacity=SHARD_CHANNEL_CAPACITY_DEFAULT);
+
+		/*!
+		Default Destructor
+
+		Destroy the Channel
+		@remark the messages not popped are released.
+		*/
+		virtual ~ShardChannel();
+
+		/*!
+		Push the message to the channel
+		@param[in] message the message to push
+		@return true if pushed otherwise false when the channel is full
+		@remark the channel holds the reference of the message until popped.
+		*/
+		bool Push(Packet *message);
+
+		/*!
+		Pop the first message from the channel
+		@return the message or NULL if the channel is empty
+		@remark the caller must call ReleaseObj() for the message to avoid the memory leak.
+		*/
+		Packet *Pop();
+
+		/*!
+		Check if the channel is empty
+		@return true if empty otherwise false
+		*/
+		bool IsEmpty() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Channel
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		ShardChannel(const ShardChannel& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		ShardChannel & operator=(const ShardChannel&b){return *this;}
+
+	private:
+		/// ring of the messages
+		Packet **m_ring;
+		/// capacity of the ring
+		unsigned int m_capacity;
+		/// position to pop, written only by the consumer
+		volatile unsigned int m_readIdx;
+		/// position to push, written only by the producer
+		volatile unsigned int m_writeIdx;
+	};
+}
+#endif //__EP_SHARD_CHANNEL_H__
\ No newline at end of file
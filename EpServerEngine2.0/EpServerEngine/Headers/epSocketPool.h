@@ -0,0 +1,152 @@
+/*! 
+@file epSocketPool.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Socket Pool Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Socket Pool.
+
+*/
+#ifndef __EP_SOCKET_POOL_H__
+#define __EP_SOCKET_POOL_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include <deque>
+
+using namespace std;
+
+namespace epse{
+
+	class BaseSocket;
+
+	/*! 
+	@class SocketPool epSocketPool.h
+	@brief A class for Socket Pool.
+
+	The pool keeps the disconnected socket objects with their locks and
+	buffers, and hands them out again for the new connections, so the
+	accept does not allocate them again.
+	@remark the socket is recycled only after all the other references are released.
+	*/
+	class EP_SERVER_ENGINE SocketPool{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Pool
+		@param[in] capacity the maximum number of the sockets kept
+		@param[in] lockPolicyType The lock policy
+		*/
+		SocketPool(unsigned int capacity=SOCKET_POOL_CAPACITY_DEFAULT,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Pool
+		*/
+		virtual ~SocketPool();
+
+		/*!
+		Set the maximum number of the sockets kept
+		@param[in] capacity the maximum number of the sockets kept (0 to disable)
+		*/
+		void SetCapacity(unsigned int capacity);
+
+		/*!
+		Get the maximum number of the sockets kept
+		@return the maximum number of the sockets kept
+		*/
+		unsigned int GetCapacity() const;
+
+		/*!
+		Take a socket no longer referenced from the pool
+		@return the socket reset for a new connection, or NULL if none is available
+		@remark the caller owns the reference of the socket returned.
+		*/
+		BaseSocket *Acquire();
+
+		/*!
+		Keep the disconnected socket to recycle
+		@param[in] socket the disconnected socket
+		@remark ignored if the pool is full.
+		*/
+		void Retire(BaseSocket *socket);
+
+		/*!
+		Release all the sockets kept
+		*/
+		void Clear();
+
+		/*!
+		Get the number of the sockets kept
+		@return the number of the sockets kept
+		*/
+		size_t Count() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Pool
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		SocketPool(const SocketPool& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		SocketPool & operator=(const SocketPool&b){return *this;}
+
+	private:
+		/*!
+		Enumerator for the search of the socket to recycle
+		*/
+		enum SocketPoolSearch{
+			/// Number of the sockets checked at most in a single Acquire
+			SOCKET_POOL_SEARCH_COUNT=8,
+		};
+
+		/// Sockets in the order retired
+		deque<BaseSocket*> m_socketList;
+		/// Maximum number of the sockets kept
+		unsigned int m_capacity;
+
+		/// list lock
+		epl::BaseLock *m_listLock;
+	};
+}
+#endif //__EP_SOCKET_POOL_H__
\ No newline at end of file
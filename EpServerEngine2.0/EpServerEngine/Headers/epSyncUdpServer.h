@@ -88,6 +88,15 @@ namespace epse{
 		Listening Loop Function
 		*/
 		virtual void execute() ;
+
+		/*!
+		Deliver the datagram received to the socket of the sender, or accept the sender as new socket
+		@param[in] clientSockAddr the address of the sender
+		@param[in] slot the slot the datagram is received into, or NULL if received into the heap buffer
+		@param[in] packetData the datagram received
+		@param[in] recvLength the byte size of the datagram, or less than or equal to 0 if the receive failed
+		*/
+		void processDatagram(const sockaddr &clientSockAddr,PacketSlot *slot,const char *packetData,int recvLength);
 		
 	};
 }
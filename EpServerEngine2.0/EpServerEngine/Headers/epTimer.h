@@ -0,0 +1,219 @@
+/*! 
+@file epTimer.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Timer Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Timer.
+
+*/
+#ifndef __EP_TIMER_H__
+#define __EP_TIMER_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epEventLoop.h"
+
+namespace epse{
+
+	class Timer;
+
+	/*! 
+	@class TimerCallbackInterface epTimer.h
+	@brief A class for Timer Callback Interface.
+	*/
+	class EP_SERVER_ENGINE TimerCallbackInterface{
+	public:
+		/*!
+		Default Destructor
+
+		Destroy the Interface
+		*/
+		virtual ~TimerCallbackInterface(){}
+
+		/*!
+		Called when the timer is expired.
+		@param[in] timer the expired timer
+		@remark called from the Event Loop thread of the timer
+		*/
+		virtual void OnTimer(Timer *timer)=0;
+	};
+
+	/*! 
+	@class Timer epTimer.h
+	@brief A class for Timer.
+
+	The timer lives in the Timing Wheel of its Event Loop. Schedule and Cancel
+	can be called from any thread, and are applied on the Event Loop thread.
+	@remark the timer holds the references of itself and its owner while scheduled.
+	*/
+	class EP_SERVER_ENGINE Timer:public epl::SmartObject, public EventLoopCallbackInterface{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Timer
+		@param[in] callBackObj the object to callback when expired
+		@param[in] eventLoop the Event Loop to drive this timer
+		@param[in] owner the object to keep alive while scheduled
+		@param[in] lockPolicyType The lock policy
+		*/
+		Timer(TimerCallbackInterface *callBackObj,EventLoop *eventLoop,epl::SmartObject *owner=NULL,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Timer
+		*/
+		virtual ~Timer();
+
+		/*!
+		Get the id of the timer
+		@return the id of the timer
+		*/
+		unsigned int GetTimerId() const;
+
+		/*!
+		Get the period of the timer
+		@return the period in millisecond, or 0 if the timer expires once
+		*/
+		unsigned int GetPeriod() const;
+
+		/*!
+		Schedule the timer
+		@param[in] delayMilliSec the delay in millisecond to expire
+		@param[in] periodMilliSec the period in millisecond to expire again after the first (0 to expire once)
+		@return true if successfully scheduled otherwise false
+		@remark the timer scheduled already is rescheduled.
+		*/
+		bool Schedule(unsigned int delayMilliSec,unsigned int periodMilliSec=0);
+
+		/*!
+		Cancel the timer
+		@remark the callback can be called once more if the timer is expiring concurrently.
+		*/
+		void Cancel();
+
+		/*!
+		Check if the timer is scheduled
+		@return true if scheduled otherwise false
+		*/
+		bool IsScheduled() const;
+
+		/*!
+		Called when the request to schedule or cancel is posted.
+		@param[in] context the context of the request
+		@param[in] transferredByte the number of bytes transferred
+		@param[in] isSucceeded the flag whether the operation succeeded
+		*/
+		virtual void OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded);
+
+		/*!
+		Called when the timer is expired.
+		@param[in] context the context of the expired timer
+		@param[in] isSucceeded the flag whether the timer is expired, or false if the Event Loop is stopped
+		*/
+		virtual void OnTimerExpired(TimerContext *context,bool isSucceeded);
+
+	private:
+		/*!
+		Post the request to apply the schedule on the Event Loop thread
+		@return true if successfully posted otherwise false
+		@remark nothing is posted if the request is already pending.
+		*/
+		bool postRequest();
+
+		/*!
+		Retain the references of the timer and its owner
+		*/
+		void retain();
+
+		/*!
+		Release the references of the timer and its owner
+		@remark the timer can be deleted.
+		*/
+		void release();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Timer
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		Timer(const Timer& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		Timer & operator=(const Timer&b){return *this;}
+
+	private:
+		/// Callback object
+		TimerCallbackInterface *m_callBackObj;
+		/// Event Loop driving this timer
+		EventLoop *m_eventLoop;
+		/// Owner to keep alive while scheduled
+		epl::SmartObject *m_owner;
+		/// Id of the timer
+		unsigned int m_timerId;
+
+		/// Delay in millisecond
+		unsigned int m_delayMilliSec;
+		/// Period in millisecond
+		unsigned int m_periodMilliSec;
+		/// Flag whether the timer is scheduled
+		bool m_isScheduled;
+		/// Generation of the schedule, increased on every Schedule and Cancel
+		unsigned int m_generation;
+		/// Generation of the schedule linked in the Timing Wheel
+		unsigned int m_linkedGeneration;
+
+		/// Context in the Timing Wheel
+		TimerContext m_timerContext;
+		/// Context for the request to apply the schedule
+		IoContext m_requestContext;
+		/// Flag whether the request is pending
+		volatile LONG m_isRequestPending;
+
+		/// timer lock
+		epl::BaseLock *m_timerLock;
+
+		/// Last id given to the timer
+		static volatile LONG m_lastTimerId;
+	};
+}
+#endif //__EP_TIMER_H__
\ No newline at end of file
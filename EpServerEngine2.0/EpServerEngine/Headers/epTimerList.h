@@ -0,0 +1,131 @@
+/*! 
+@file epTimerList.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Timer List Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Timer List.
+
+*/
+#ifndef __EP_TIMER_LIST_H__
+#define __EP_TIMER_LIST_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epTimer.h"
+#include <map>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class TimerList epTimerList.h
+	@brief A class for Timer List.
+
+	The list of the timers scheduled by the id for the server.
+	*/
+	class EP_SERVER_ENGINE TimerList{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the List
+		@param[in] lockPolicyType The lock policy
+		*/
+		TimerList(epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the List
+		*/
+		virtual ~TimerList();
+
+		/*!
+		Schedule a new timer
+		@param[in] callBackObj the object to callback when expired
+		@param[in] eventLoop the Event Loop to drive the timer
+		@param[in] delayMilliSec the delay in millisecond to expire
+		@param[in] periodMilliSec the period in millisecond to expire again after the first (0 to expire once)
+		@return the id of the timer, or TIMER_ID_NONE if failed
+		*/
+		unsigned int Schedule(TimerCallbackInterface *callBackObj,EventLoop *eventLoop,unsigned int delayMilliSec,unsigned int periodMilliSec=0);
+
+		/*!
+		Cancel the timer with the given id
+		@param[in] timerId the id of the timer
+		@return true if the timer was in the list otherwise false
+		*/
+		bool Cancel(unsigned int timerId);
+
+		/*!
+		Cancel all the timers
+		*/
+		void Clear();
+
+		/*!
+		Get the number of the timers
+		@return the number of the timers
+		*/
+		size_t Count() const;
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the List
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		TimerList(const TimerList& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		TimerList & operator=(const TimerList&b){return *this;}
+
+	private:
+		/// Timers by the id
+		map<unsigned int,Timer*> m_timerMap;
+
+		/// list lock
+		epl::BaseLock *m_listLock;
+
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+	};
+}
+#endif //__EP_TIMER_LIST_H__
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*! 
+@file epTimingWheel.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief Timing Wheel Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for Timing Wheel.
+
+*/
+#ifndef __EP_TIMING_WHEEL_H__
+#define __EP_TIMING_WHEEL_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+
+namespace epse{
+
+	class EventLoopCallbackInterface;
+
+	/*! 
+	@struct TimerContext epTimingWheel.h
+	@brief A structure for the timer linked in the Timing Wheel.
+	*/
+	struct TimerContext{
+		/// Previous timer in the slot
+		TimerContext *m_prev;
+		/// Next timer in the slot
+		TimerContext *m_next;
+		/// Tick to expire
+		unsigned int m_expireTick;
+		/// Object to callback when expired
+		EventLoopCallbackInterface *m_callBackObj;
+
+		/*!
+		Default Constructor
+
+		Initializes the Context
+		*/
+		TimerContext()
+		{
+			m_prev=NULL;
+			m_next=NULL;
+			m_expireTick=0;
+			m_callBackObj=NULL;
+		}
+
+		/*!
+		Check if the timer is linked in the Timing Wheel
+		@return true if linked otherwise false
+		*/
+		bool IsLinked() const
+		{
+			return (m_next!=NULL);
+		}
+	};
+
+	/*! 
+	@class TimingWheel epTimingWheel.h
+	@brief A class for Timing Wheel.
+
+	The hierarchical timing wheel of four levels with 256 slots each.
+	Adding and removing the timer cost O(1), and the timers far from
+	expiring are cascaded down to the lower level only once per level.
+	@remark the Timing Wheel is not thread-safe, and is driven by a single Event Loop thread.
+	*/
+	class EP_SERVER_ENGINE TimingWheel{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Timing Wheel
+		*/
+		TimingWheel();
+
+		/*!
+		Default Destructor
+
+		Destroy the Timing Wheel
+		@remark the timers linked are unlinked without expiring.
+		*/
+		virtual ~TimingWheel();
+
+		/*!
+		Add the timer to expire after the given delay
+		@param[in] context the timer to add
+		@param[in] delayMilliSec the delay in millisecond
+		@remark the timer must not be linked.
+		*/
+		void Add(TimerContext *context,unsigned int delayMilliSec);
+
+		/*!
+		Remove the timer
+		@param[in] context the timer to remove
+		@return true if the timer was linked otherwise false
+		*/
+		bool Remove(TimerContext *context);
+
+		/*!
+		Advance the Timing Wheel by the given ticks, and move the timers expired to the list
+		@param[in] tickCount the number of the ticks to advance
+		@param[in] expiredList the sentinel of the list to link the timers expired
+		*/
+		void Advance(unsigned int tickCount,TimerContext &expiredList);
+
+		/*!
+		Move all the timers to the list
+		@param[in] expiredList the sentinel of the list to link the timers
+		*/
+		void Clear(TimerContext &expiredList);
+
+		/*!
+		Check if the Timing Wheel is empty
+		@return true if empty otherwise false
+		*/
+		bool IsEmpty() const;
+
+		/*!
+		Initialize the list with the given sentinel
+		@param[in] list the sentinel of the list
+		*/
+		static void InitList(TimerContext &list);
+
+		/*!
+		Pop the first timer from the list
+		@param[in] list the sentinel of the list
+		@return the first timer or NULL if the list is empty
+		*/
+		static TimerContext *PopList(TimerContext &list);
+
+	private:
+		/*!
+		Link the timer to the slot of its expire tick
+		@param[in] context the timer to link
+		*/
+		void link(TimerContext *context);
+
+		/*!
+		Move all the timers in the slot to the given list
+		@param[in] slot the sentinel of the slot
+		@param[in] list the sentinel of the list to link the timers
+		*/
+		static void spliceList(TimerContext &slot,TimerContext &list);
+
+		/*!
+		Re-link all the timers in the slot of the given level to the lower levels
+		@param[in] level the level of the slot
+		@param[in] slotIdx the index of the slot
+		*/
+		void cascade(unsigned int level,unsigned int slotIdx);
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Timing Wheel
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		TimingWheel(const TimingWheel& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		TimingWheel & operator=(const TimingWheel&b){return *this;}
+
+	private:
+		/*!
+		Enumerator for the layout of the Timing Wheel
+		*/
+		enum TimingWheelLayout{
+			/// Number of the levels
+			TIMING_WHEEL_LEVEL_COUNT=4,
+			/// Number of the bits of the slot index
+			TIMING_WHEEL_SLOT_BITS=8,
+			/// Number of the slots in a level
+			TIMING_WHEEL_SLOT_COUNT=256,
+			/// Mask of the slot index
+			TIMING_WHEEL_SLOT_MASK=255,
+		};
+
+		/// Sentinels of the slots
+		TimerContext m_slotList[TIMING_WHEEL_LEVEL_COUNT][TIMING_WHEEL_SLOT_COUNT];
+		/// Current tick
+		unsigned int m_currentTick;
+		/// Number of the timers linked
+		unsigned int m_timerCount;
+	};
+}
+#endif //__EP_TIMING_WHEEL_H__
\ No newline at end of file
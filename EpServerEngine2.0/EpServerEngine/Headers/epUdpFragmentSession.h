@@ -0,0 +1,222 @@
+/*! 
+@file epUdpFragmentSession.h
+@author Woong Gyu La a.k.a Chris. <juhgiyo@gmail.com>
+		<http://github.com/juhgiyo/epserverengine>
+@date October 18, 2026
+@brief UDP Fragment Session Interface
+@version 1.0
+
+@section LICENSE
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+@section DESCRIPTION
+
+An Interface for UDP Fragment Session.
+
+*/
+#ifndef __EP_UDP_FRAGMENT_SESSION_H__
+#define __EP_UDP_FRAGMENT_SESSION_H__
+
+#include "epServerEngine.h"
+#include "epServerConf.h"
+#include "epPacket.h"
+#include "epReliableUdpSession.h"
+#include <winsock2.h>
+#include <map>
+#include <list>
+#include <vector>
+
+using namespace std;
+
+namespace epse{
+
+	/*! 
+	@class UdpFragmentSession epUdpFragmentSession.h
+	@brief A class for UDP Fragment Session.
+
+	The session splits the packet larger than the maximum datagram into the
+	fragments, and puts the header of the fragment in front of every datagram
+	sent to a peer. The fragments received are copied straight into their
+	offsets of the packet reassembled, which is delivered when all of them
+	arrive. The packets incomplete are dropped after the time-out, or when the
+	packets being reassembled exceed UDP_REASSEMBLY_BYTE_SIZE_MAX.
+	*/
+	class EP_SERVER_ENGINE UdpFragmentSession:public DatagramSenderInterface{
+
+	public:
+		/*!
+		Default Constructor
+
+		Initializes the Session
+		@param[in] sender the object sending the datagram to the peer
+		@param[in] maxDatagramByteSize the maximum byte size of the datagram
+		@param[in] lockPolicyType The lock policy
+		*/
+		UdpFragmentSession(DatagramSenderInterface *sender,unsigned int maxDatagramByteSize,epl::LockPolicy lockPolicyType=epl::EP_LOCK_POLICY);
+
+		/*!
+		Default Destructor
+
+		Destroy the Session
+		*/
+		virtual ~UdpFragmentSession();
+
+		/*!
+		Send the packet to the peer in the fragments if it is larger than the maximum datagram
+		@param[in] packet the packet to be sent
+		@param[in] sendStatus the status of Send
+		@return sent byte size of the packet
+		@remark return -1 if error occurred
+		*/
+		virtual int SendDatagram(const Packet &packet,SendStatus *sendStatus=NULL);
+
+		/*!
+		Process the datagram received from the peer
+		@param[in] datagram the datagram received
+		@return the packet complete, or NULL if the packet is not complete yet
+		@remark the caller must call ReleaseObj() for Packet to avoid the memory leak.
+		*/
+		Packet *Receive(const Packet &datagram);
+
+		/*!
+		Get the byte size of the packets being reassembled
+		@return the byte size of the packets being reassembled
+		*/
+		unsigned int GetReassemblyByteSize() const;
+
+		/*!
+		Set the maximum byte size of the datagram
+		@param[in] maxDatagramByteSize the maximum byte size of the datagram
+		*/
+		void SetMaxDatagramByteSize(unsigned int maxDatagramByteSize);
+
+		/*!
+		Discard all the packets being reassembled
+		*/
+		void Reset();
+
+	private:
+		/*!
+		Default Copy Constructor
+
+		Initializes the Session
+		@param[in] b the second object
+		@remark Copy Constructor prohibited
+		*/
+		UdpFragmentSession(const UdpFragmentSession& b){}
+
+		/*!
+		Assignment operator overloading
+		@param[in] b the second object
+		@return the new copied object
+		@remark Copy Operator prohibited
+		*/
+		UdpFragmentSession & operator=(const UdpFragmentSession&b){return *this;}
+
+		/*!
+		Enumerator for the header of the datagram
+		*/
+		enum UdpFragmentHeader{
+			/// Type of the datagram carrying the whole packet
+			UDP_FRAGMENT_HEADER_TYPE_WHOLE=1,
+			/// Type of the datagram carrying a fragment of the packet
+			UDP_FRAGMENT_HEADER_TYPE_FRAGMENT,
+			/// Byte size of the header carrying the whole packet (type)
+			UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE=1,
+			/// Byte size of the header carrying a fragment (type, reserved, index, fragment byte size, message id and packet byte size)
+			UDP_FRAGMENT_HEADER_BYTE_SIZE=14,
+			/// Maximum number of the fragments of a packet
+			UDP_FRAGMENT_COUNT_MAX=0xffff,
+		};
+
+		/*! 
+		@struct Reassembly epUdpFragmentSession.h
+		@brief A struct for the packet being reassembled.
+		*/
+		struct Reassembly{
+			/// message id of the packet
+			unsigned int m_messageId;
+			/// packet being reassembled
+			Packet *m_packet;
+			/// byte size of every fragment but the last
+			unsigned int m_fragmentByteSize;
+			/// number of the fragments of the packet
+			unsigned int m_fragmentCount;
+			/// number of the fragments received
+			unsigned int m_receivedCount;
+			/// flags for the fragments received
+			vector<bool> m_isReceivedList;
+			/// time the first fragment is received
+			unsigned int m_startTime;
+		};
+
+		/*!
+		Drop the packets being reassembled longer than the time-out
+		@param[in] currentTime the current time
+		*/
+		void expireReassemblies(unsigned int currentTime);
+
+		/*!
+		Drop the oldest packets being reassembled until the given byte size fits in the limit
+		@param[in] byteSize the byte size of the new packet
+		@return true if the new packet fits in the limit otherwise false
+		*/
+		bool reserveReassembly(unsigned int byteSize);
+
+		/*!
+		Drop the packet being reassembled
+		@param[in] iter the position of the packet being reassembled
+		*/
+		void dropReassembly(list<Reassembly*>::iterator iter);
+
+		/*!
+		Drop all the packets being reassembled
+		*/
+		void deleteReassemblies();
+
+	private:
+		/// object sending the datagram to the peer
+		DatagramSenderInterface *m_sender;
+		/// maximum byte size of the datagram
+		unsigned int m_maxDatagramByteSize;
+		/// id of the next packet sent in the fragments
+		unsigned int m_nextMessageId;
+
+		/// packets being reassembled in the order of the first fragment received
+		list<Reassembly*> m_reassemblyList;
+		/// positions of the packets being reassembled by the message id
+		map<unsigned int,list<Reassembly*>::iterator> m_reassemblyMap;
+		/// byte size of the packets being reassembled
+		unsigned int m_reassemblyByteSize;
+
+		/// buffer of the datagram being sent
+		char *m_sendBuffer;
+
+		/// session lock
+		epl::BaseLock *m_sessionLock;
+		/// Lock Policy
+		epl::LockPolicy m_lockPolicy;
+	};
+}
+#endif //__EP_UDP_FRAGMENT_SESSION_H__
\ No newline at end of file
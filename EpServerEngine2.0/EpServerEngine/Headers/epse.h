@@ -39,9 +39,25 @@ An Interface for EP Server Engine
 
 // General
 #include "epServerConf.h"
+#include "epBufferPool.h"
 #include "epPacket.h"
+#include "epPacketSlab.h"
+#include "epReliableUdpSession.h"
+#include "epUdpFragmentSession.h"
 #include "epBaseServerObject.h"
 #include "epPacketContainer.h"
+#include "epByteSwapper.h"
+#include "epPacketWriter.h"
+#include "epPacketReader.h"
+#include "epLzCodec.h"
+#include "epCompressor.h"
+#include "epFrameCodec.h"
+#include "epMessageDispatcher.h"
+#include "epReceiveBuffer.h"
+#include "epSendBuffer.h"
+#include "epSendQueue.h"
+#include "epSocketPool.h"
+#include "epShardChannel.h"
 #include "epBasePacketProcessor.h"
 #include "epServerObjectList.h"
 #include "epServerObjectRemover.h"
@@ -80,6 +96,8 @@ An Interface for EP Server Engine
 #include "epServerPacketProcessor.h"
 #include "epAsyncTcpServer.h"
 #include "epAsyncTcpSocket.h"
+#include "epAsyncUdpJob.h"
+#include "epAsyncUdpProcessor.h"
 #include "epAsyncUdpServer.h"
 #include "epAsyncUdpSocket.h"
 
@@ -95,6 +113,19 @@ An Interface for EP Server Engine
 #include "epIocpUdpServer.h"
 #include "epIocpUdpSocket.h"
 
+#include "epEventLoop.h"
+#include "epEventLoopGroup.h"
+#include "epJobRing.h"
+#include "epJobDeque.h"
+#include "epJobPriorityQueue.h"
+#include "epJobScheduler.h"
+#include "epTimingWheel.h"
+#include "epTimer.h"
+#include "epTimerList.h"
+#include "epEventTcpServer.h"
+#include "epEventTcpSocket.h"
+#include "epEventTcpShard.h"
+
 #include "epProxyServerInterfaces.h"
 #include "epBaseProxyHandler.h"
 #include "epBaseProxyServer.h"
@@ -99,56 +99,48 @@ void AsyncTcpClient::execute()
 	int iResult;
 	// Receive until the peer shuts down the connection
 	do {
-		int size =receive(m_recvSizePacket);
-		if(size>0)
+		Packet *recvPacket=NULL;
+		iResult =receive(recvPacket);
+		if(iResult>0)
 		{
-			unsigned int shouldReceive=(reinterpret_cast<unsigned int*>(const_cast<char*>(m_recvSizePacket.GetPacket())))[0];
-			Packet *recvPacket=EP_NEW Packet(NULL,shouldReceive);
-			iResult = receive(*recvPacket);
-
-			if (iResult == shouldReceive) {
-				if(m_isAsynchronousReceive)
+			if(dispatchReceived(recvPacket))
+			{
+				recvPacket->ReleaseObj();
+			}
+			else if(m_isAsynchronousReceive)
+			{
+				ClientPacketProcessor::PacketPassUnit passUnit;
+				passUnit.m_packet=recvPacket;
+				passUnit.m_owner=this;
+				ClientPacketProcessor *parser =EP_NEW ClientPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
+				EP_ASSERT(parser);
+				parser->setPacketPassUnit(passUnit);
+				m_processorList.Push(parser);
+				parser->Start();
+				parser->ReleaseObj();
+				recvPacket->ReleaseObj();
+				unsigned int maximumProcessorCount=GetMaximumProcessorCount();
+				if(maximumProcessorCount!=PROCESSOR_LIMIT_INFINITE)
 				{
-					ClientPacketProcessor::PacketPassUnit passUnit;
-					passUnit.m_packet=recvPacket;
-					passUnit.m_owner=this;
-					ClientPacketProcessor *parser =EP_NEW ClientPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
-					EP_ASSERT(parser);
-					parser->setPacketPassUnit(passUnit);
-					m_processorList.Push(parser);
-					parser->Start();
-					parser->ReleaseObj();
-					recvPacket->ReleaseObj();
-					unsigned int maximumProcessorCount=GetMaximumProcessorCount();
-					if(maximumProcessorCount!=PROCESSOR_LIMIT_INFINITE)
+					while(m_processorList.Count()>=maximumProcessorCount)
 					{
-						while(m_processorList.Count()>=maximumProcessorCount)
-						{
-							m_processorList.WaitForListSizeDecrease();
-						}
+						m_processorList.WaitForListSizeDecrease();
 					}
 				}
-				else
-				{
-					m_callBackObj->OnReceived(reinterpret_cast<ClientInterface*>(this),recvPacket,RECEIVE_STATUS_SUCCESS);
-					recvPacket->ReleaseObj();
-				}
-				
 			}
-			else if (iResult == 0)
+			else
 			{
-				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-				recvPacket->ReleaseObj();
-				break;
-			}
-			else  {
-				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+				m_callBackObj->OnReceived(reinterpret_cast<ClientInterface*>(this),recvPacket,RECEIVE_STATUS_SUCCESS);
 				recvPacket->ReleaseObj();
-				break;
 			}
 		}
-		else
+		else if (iResult == 0)
 		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			break;
+		}
+		else  {
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 			break;
 		}
 
@@ -166,6 +158,9 @@ bool AsyncTcpClient::Connect(const ClientOps &ops)
 
 	if(ops.callBackObj)
 		m_callBackObj=ops.callBackObj;
+	m_messageDispatcher=ops.messageDispatcher;
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
+	setReceiveLimit(ops.maxFrameByteSize,ops.receiveChunkByteSize);
 	EP_ASSERT(m_callBackObj);
 
 	if(ops.hostName)
@@ -187,6 +182,7 @@ bool AsyncTcpClient::Connect(const ClientOps &ops)
 		m_hostName=DEFAULT_HOSTNAME;
 	}
 	SetWaitTime(ops.waitTimeMilliSec);
+	m_frameCodec.Reset(ops.frameVersion,true);
 	m_maxProcessorCount=ops.maximumProcessorCount;
 	m_isAsynchronousReceive=ops.isAsynchronousReceive;
 
@@ -243,6 +239,9 @@ bool AsyncTcpClient::Connect(const ClientOps &ops)
 		cleanUpClient();
 		return false;
 	}
+	// discard the data left from the previous connection
+	m_recvBuffer.Clear();
+	m_pendingSendBuffer.Clear();
 	if(Start())
 	{
 		return true;
@@ -102,7 +102,11 @@ void AsyncTcpServer::execute()
 				continue;
 			}
 			accWorker->setClientSocket(clientSocket);
+			accWorker->setCompressor(&m_compressor);
+			accWorker->setFrameVersion(m_frameVersion);
+			accWorker->setReceiveLimit(m_maxFrameByteSize,m_receiveChunkByteSize);
 			accWorker->setOwner(this);
+			accWorker->setMessageDispatcher(m_messageDispatcher);
 			accWorker->setSockAddr(sockAddr);
 			m_socketList.Push(accWorker);	
 			accWorker->Start();
@@ -133,59 +133,51 @@ void AsyncTcpSocket::execute()
 	int iResult=0;
 	// Receive until the peer shuts down the connection
 	do {
-		iResult =receive(m_recvSizePacket);
+		Packet *recvPacket=NULL;
+		iResult =receive(recvPacket);
 		if(iResult>0)
 		{
-			unsigned int shouldReceive=(reinterpret_cast<unsigned int*>(const_cast<char*>(m_recvSizePacket.GetPacket())))[0];
-			Packet *recvPacket=EP_NEW Packet(NULL,shouldReceive);
-			iResult = receive(*recvPacket);
-
-			if (iResult == shouldReceive) {
-				if(m_isAsynchronousReceive)
+			if(dispatchReceived(recvPacket))
+			{
+				recvPacket->ReleaseObj();
+			}
+			else if(m_isAsynchronousReceive)
+			{
+				ServerPacketProcessor::PacketPassUnit passUnit;
+				passUnit.m_packet=recvPacket;
+				passUnit.m_owner=this;
+				ServerPacketProcessor *parser =EP_NEW ServerPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
+				if(!parser)
 				{
-					ServerPacketProcessor::PacketPassUnit passUnit;
-					passUnit.m_packet=recvPacket;
-					passUnit.m_owner=this;
-					ServerPacketProcessor *parser =EP_NEW ServerPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
-					if(!parser)
-					{
-						recvPacket->ReleaseObj();
-						continue;
-					}
-					parser->setPacketPassUnit(passUnit);
-					m_processorList.Push(parser);
-					parser->Start();
-					parser->ReleaseObj();
 					recvPacket->ReleaseObj();
-					if(GetMaximumProcessorCount()!=PROCESSOR_LIMIT_INFINITE)
-					{
-						while(m_processorList.Count()>=GetMaximumProcessorCount())
-						{
-							m_processorList.WaitForListSizeDecrease();
-						}
-					}
+					continue;
 				}
-				else
+				parser->setPacketPassUnit(passUnit);
+				m_processorList.Push(parser);
+				parser->Start();
+				parser->ReleaseObj();
+				recvPacket->ReleaseObj();
+				if(GetMaximumProcessorCount()!=PROCESSOR_LIMIT_INFINITE)
 				{
-					m_callBackObj->OnReceived(this,recvPacket,RECEIVE_STATUS_SUCCESS);
-					recvPacket->ReleaseObj();
+					while(m_processorList.Count()>=GetMaximumProcessorCount())
+					{
+						m_processorList.WaitForListSizeDecrease();
+					}
 				}
-				
 			}
-			else if (iResult == 0)
+			else
 			{
-				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+				m_callBackObj->OnReceived(this,recvPacket,RECEIVE_STATUS_SUCCESS);
 				recvPacket->ReleaseObj();
-				break;
-			}
-			else  {
-				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-				recvPacket->ReleaseObj();
-				break;
 			}
 		}
-		else
+		else if (iResult == 0)
 		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			break;
+		}
+		else  {
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 			break;
 		}
 
@@ -105,50 +105,73 @@ void AsyncUdpClient::execute()
 		iResult = receive(recvPacket);
 
 		if (iResult > 0) {
-			Packet *passPacket=EP_NEW Packet(recvPacket.GetPacket(),iResult);
-			if(m_isAsynchronousReceive)
+			Packet *passPacket=createReceivedPacket(recvPacket.GetPacket(),iResult);
+			while(passPacket)
 			{
-				ClientPacketProcessor::PacketPassUnit passUnit;
-
-				passUnit.m_packet=passPacket;
-				passUnit.m_owner=this;
-				ClientPacketProcessor *parser=EP_NEW ClientPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
-				parser->setPacketPassUnit(passUnit);
-				m_processorList.Push(parser);
-				parser->Start();
-				parser->ReleaseObj();
-				passPacket->ReleaseObj();
-				unsigned int maximumProcessorCount=GetMaximumProcessorCount();
-				if(maximumProcessorCount!=PROCESSOR_LIMIT_INFINITE)
-				{
-					while(m_processorList.Count()>=maximumProcessorCount)
-					{
-						m_processorList.WaitForListSizeDecrease();
-					}
-				}
+				deliverPacket(passPacket);
+				passPacket=popReceivedPacket();
 			}
-			else
-			{
-				m_callBackObj->OnReceived(reinterpret_cast<ClientInterface*>(this),passPacket,RECEIVE_STATUS_SUCCESS);
-				passPacket->ReleaseObj();
-			}
-
 		}
 		else if (iResult == 0)
 		{
 			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 			break;
 		}
+		else if(m_reliableSession && WSAGetLastError()==WSAETIMEDOUT)
+		{
+			// receive time-out only wakes up to retransmit
+			iResult=1;
+		}
 		else  {
 			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 			break;
 		}
 
+		if(!updateReliable())
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Server not responding...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			break;
+		}
+
 	} while (iResult > 0);
 
 	disconnect();
 }
 
+void AsyncUdpClient::deliverPacket(Packet *passPacket)
+{
+	if(dispatchReceived(passPacket))
+	{
+		passPacket->ReleaseObj();
+	}
+	else if(m_isAsynchronousReceive)
+	{
+		ClientPacketProcessor::PacketPassUnit passUnit;
+
+		passUnit.m_packet=passPacket;
+		passUnit.m_owner=this;
+		ClientPacketProcessor *parser=EP_NEW ClientPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
+		parser->setPacketPassUnit(passUnit);
+		m_processorList.Push(parser);
+		parser->Start();
+		parser->ReleaseObj();
+		passPacket->ReleaseObj();
+		unsigned int maximumProcessorCount=GetMaximumProcessorCount();
+		if(maximumProcessorCount!=PROCESSOR_LIMIT_INFINITE)
+		{
+			while(m_processorList.Count()>=maximumProcessorCount)
+			{
+				m_processorList.WaitForListSizeDecrease();
+			}
+		}
+	}
+	else
+	{
+		m_callBackObj->OnReceived(reinterpret_cast<ClientInterface*>(this),passPacket,RECEIVE_STATUS_SUCCESS);
+		passPacket->ReleaseObj();
+	}
+}
+
 bool AsyncUdpClient::Connect(const ClientOps &ops)
 {
 	epl::LockObj lock(m_generalLock);
@@ -157,6 +180,8 @@ bool AsyncUdpClient::Connect(const ClientOps &ops)
 
 	if(ops.callBackObj)
 		m_callBackObj=ops.callBackObj;
+	m_messageDispatcher=ops.messageDispatcher;
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
 	EP_ASSERT(m_callBackObj);
 
 	if(ops.hostName)
@@ -229,6 +254,7 @@ bool AsyncUdpClient::Connect(const ClientOps &ops)
 
 	int nTmp = sizeof(int);
 	getsockopt(m_connectSocket, SOL_SOCKET,SO_MAX_MSG_SIZE, (char *)&m_maxPacketSize,&nTmp);
+	setUpSessions(ops.isReliableUdp,ops.isFragmentedUdp);
 
 	if(Start())
 	{
@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 #include "epAsyncUdpServer.h"
+#include "epAsyncUdpProcessor.h"
 #include "epAsyncUdpSocket.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
@@ -34,19 +35,20 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-AsyncUdpServer::AsyncUdpServer(epl::LockPolicy lockPolicyType): BaseUdpServer(lockPolicyType)
+AsyncUdpServer::AsyncUdpServer(epl::LockPolicy lockPolicyType): BaseUdpServer(lockPolicyType),m_jobScheduler(WAITTIME_INIFINITE,lockPolicyType)
 {
 	m_isAsynchronousReceive=true;
 }
 
 
-AsyncUdpServer::AsyncUdpServer(const AsyncUdpServer& b):BaseUdpServer(b)
+AsyncUdpServer::AsyncUdpServer(const AsyncUdpServer& b):BaseUdpServer(b),m_jobScheduler(WAITTIME_INIFINITE,b.m_lockPolicy)
 {
 	LockObj lock(b.m_baseServerLock);
 	m_isAsynchronousReceive=b.m_isAsynchronousReceive;
 }
 AsyncUdpServer::~AsyncUdpServer()
 {
+	m_jobScheduler.StopWorkers();
 }
 AsyncUdpServer & AsyncUdpServer::operator=(const AsyncUdpServer&b)
 {
@@ -69,72 +71,107 @@ void AsyncUdpServer::SetIsAsynchronousReceive(bool isASynchronousReceive)
 	m_isAsynchronousReceive=isASynchronousReceive;
 }
 
+void AsyncUdpServer::pushJob(BaseJob * job)
+{
+	m_jobScheduler.Push(job);
+}
+
 bool AsyncUdpServer::StartServer(const ServerOps &ops)
 {
+	if(IsServerStarted())
+		return true;
+
 	m_isAsynchronousReceive=ops.isAsynchronousReceive;
+
+	AsyncUdpProcessor *jobProcessor=EP_NEW AsyncUdpProcessor();
+	m_jobScheduler.SetWaitTime(ops.waitTimeMilliSec);
+	m_jobScheduler.StartWorkers(ops.workerThreadCount,jobProcessor);
+	jobProcessor->ReleaseObj();
+
 	return BaseUdpServer::StartServer(ops);
 }
 
+void AsyncUdpServer::StopServer()
+{
+	BaseUdpServer::StopServer();
+	m_jobScheduler.StopWorkers();
+}
+
 void AsyncUdpServer::execute()
 {
 	Packet recvPacket(NULL,m_maxPacketSize);
-	char *packetData=const_cast<char*>(recvPacket.GetPacket());
+	char *recvBuffer=const_cast<char*>(recvPacket.GetPacket());
 	int length=recvPacket.GetPacketByteSize();
 	sockaddr clientSockAddr;
 	int sockAddrSize=sizeof(sockaddr);
 	while(m_listenSocket!=INVALID_SOCKET)
 	{
+		// receive straight into a slot of the slab, or into the heap buffer if all the slots are in use
+		PacketSlot *slot=NULL;
+		if(m_receiveSlab)
+			slot=m_receiveSlab->Acquire();
+		char *packetData=slot?slot->m_buffer:recvBuffer;
 		int recvLength=recvfrom(m_listenSocket,packetData,length, 0,&clientSockAddr,&sockAddrSize);
+		// the receive time-out only wakes up the loop to retransmit the reliable datagrams
+		if(recvLength!=SOCKET_ERROR || WSAGetLastError()!=WSAETIMEDOUT)
+			processDatagram(clientSockAddr,slot,packetData,recvLength);
+		// the packets delivered keep their own references
+		if(slot)
+			PacketSlab::ReleaseSlot(slot);
+		updateReliableSockets();
+	}
+
+	stopServer();
+}
 
-		AsyncUdpSocket *workerObj=(AsyncUdpSocket*)m_socketList.Find(clientSockAddr,socketCompare);
-		if(workerObj)
+void AsyncUdpServer::processDatagram(const sockaddr &clientSockAddr,PacketSlot *slot,const char *packetData,int recvLength)
+{
+	AsyncUdpSocket *workerObj=(AsyncUdpSocket*)m_socketList.Find(clientSockAddr);
+	if(workerObj)
+	{
+		if(recvLength<=0)
 		{
-			if(recvLength<=0)
-			{
-				Packet *passPacket=EP_NEW Packet(packetData,0);
-				workerObj->addPacket(passPacket);
-				passPacket->ReleaseObj();
-				continue;
-			}	
-			Packet *passPacket=EP_NEW Packet(packetData,recvLength);
-			workerObj->addPacket(passPacket);
+			Packet *passPacket=EP_NEW Packet(packetData,0);
+			deliverPacket(workerObj,passPacket);
 			passPacket->ReleaseObj();
-		}
-		else
+			return;
+		}	
+		Packet *passPacket=createReceivedPacket(slot,packetData,recvLength);
+		deliverPacket(workerObj,passPacket);
+		passPacket->ReleaseObj();
+	}
+	else
+	{
+		if(recvLength<=0)
+			return;
+		if(GetMaximumConnectionCount()!=CONNECTION_LIMIT_INFINITE)
 		{
-			if(recvLength<=0)
-				continue;
-			if(GetMaximumConnectionCount()!=CONNECTION_LIMIT_INFINITE)
-			{
-				if(m_socketList.Count()>=GetMaximumConnectionCount())
-				{
-					continue;
-				}
-			}
-			if(!m_callBackObj->OnAccept(clientSockAddr))
-			{
-				continue;
-			}
-			/// Create Worker Thread
-			AsyncUdpSocket *accWorker=EP_NEW AsyncUdpSocket(m_callBackObj,m_isAsynchronousReceive,m_waitTime,PROCESSOR_LIMIT_INFINITE,m_lockPolicy);
-			if(!accWorker)
+			if(m_socketList.Count()>=GetMaximumConnectionCount())
 			{
-				continue;
+				return;
 			}
-			Packet *passPacket=EP_NEW Packet(packetData,recvLength);
-			accWorker->setSockAddr(clientSockAddr);
-			accWorker->setOwner(this);
-			accWorker->setMaxPacketByteSize(m_maxPacketSize);
-			m_socketList.Push(accWorker);
-			accWorker->Start();
-			accWorker->addPacket(passPacket);
-			accWorker->ReleaseObj();
-			passPacket->ReleaseObj();
-
 		}
-
+		if(!m_callBackObj->OnAccept(clientSockAddr))
+		{
+			return;
+		}
+		/// Create Socket
+		AsyncUdpSocket *accWorker=EP_NEW AsyncUdpSocket(m_callBackObj,m_isAsynchronousReceive,m_waitTime,PROCESSOR_LIMIT_INFINITE,m_lockPolicy);
+		if(!accWorker)
+		{
+			return;
+		}
+		Packet *passPacket=createReceivedPacket(slot,packetData,recvLength);
+		accWorker->setSockAddr(clientSockAddr);
+		accWorker->setOwner(this);
+		accWorker->setMessageDispatcher(m_messageDispatcher);
+		accWorker->setMaxPacketByteSize(GetMaxPacketByteSize());
+		accWorker->setUpSessions(m_isReliableUdp,m_isFragmentedUdp);
+		m_socketList.Push(accWorker);
+		// OnNewConnection is called right before the first datagram is dispatched
+		deliverPacket(accWorker,passPacket);
+		accWorker->ReleaseObj();
+		passPacket->ReleaseObj();
 	}
-
-	stopServer();
 } 
 
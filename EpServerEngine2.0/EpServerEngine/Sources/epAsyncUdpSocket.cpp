@@ -24,6 +24,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 #include "epAsyncUdpSocket.h"
+#include "epAsyncUdpJob.h"
 #include "epAsyncUdpServer.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
@@ -35,16 +36,23 @@ static char THIS_FILE[] = __FILE__;
 using namespace epse;
 AsyncUdpSocket::AsyncUdpSocket(ServerCallbackInterface *callBackObj,bool isAsynchronousReceive,unsigned int waitTimeMilliSec,unsigned int maximumProcessorCount,epl::LockPolicy lockPolicyType): BaseUdpSocket(callBackObj,waitTimeMilliSec,lockPolicyType)
 {
-	m_processorList=ServerObjectList(waitTimeMilliSec,lockPolicyType);
-	m_threadStopEvent=EventEx(false,false);
 	m_maxProcessorCount=maximumProcessorCount;
 	m_isAsynchronousReceive=isAsynchronousReceive;
+	m_isConnected=true;
+	m_isScheduled=false;
+	m_isNewConnectionNotified=false;
 }
 
 AsyncUdpSocket::~AsyncUdpSocket()
 {
 	KillConnection();
 }
+
+bool AsyncUdpSocket::IsConnectionAlive() const
+{
+	return m_isConnected;
+}
+
 void AsyncUdpSocket::SetMaximumProcessorCount(unsigned int maxProcessorCount)
 {
 	epl::LockObj lock(m_baseSocketLock);
@@ -69,44 +77,20 @@ void AsyncUdpSocket::SetIsAsynchronousReceive(bool isASynchronousReceive)
 void AsyncUdpSocket::SetWaitTime(unsigned int milliSec)
 {
 	m_waitTime=milliSec;
-	m_processorList.SetWaitTime(milliSec);
 }
 
 void AsyncUdpSocket::KillConnection()
 {
 	epl::LockObj lock(m_baseSocketLock);
-	if(!IsConnectionAlive())
-	{
-		return;
-	}
-	m_threadStopEvent.SetEvent();
-	if(GetStatus()==Thread::THREAD_STATUS_SUSPENDED)
-		Resume();
-	if(TerminateAfter(m_waitTime)==Thread::TERMINATE_RESULT_GRACEFULLY_TERMINATED)
-		return;
-	m_processorList.Clear();
-
-	m_listLock->Lock();
-	Packet *removeElem=NULL;
-	while(!m_packetList.empty())
-	{
-		removeElem=m_packetList.front();
-		if(removeElem)
-			removeElem->ReleaseObj();
-		m_packetList.pop();
-	}
-	m_listLock->Unlock();
-
-	removeSelfFromContainer();
-	m_callBackObj->OnDisconnect(this);
+	killConnection();
 }
 
 void AsyncUdpSocket::killConnection()
 {
 	if(IsConnectionAlive())
 	{
+		m_isConnected=false;
 
-		m_processorList.Clear();
 		m_listLock->Lock();
 		Packet *removeElem=NULL;
 		while(!m_packetList.empty())
@@ -126,76 +110,86 @@ void AsyncUdpSocket::killConnection()
 
 void AsyncUdpSocket::addPacket(Packet *packet)
 {
+	if(!m_isAsynchronousReceive)
+	{
+		// dispatch right on the listening thread, which is already in order
+		processPacket(packet);
+		return;
+	}
+
 	if(packet)
 		packet->RetainObj();
-	epl::LockObj lock(m_listLock);
+	m_listLock->Lock();
 	m_packetList.push(packet);
-	if(GetStatus()==THREAD_STATUS_SUSPENDED)
-		Resume();
+	// only one job is pushed at a time to keep the datagrams in order
+	bool isToSchedule=!m_isScheduled;
+	m_isScheduled=true;
+	m_listLock->Unlock();
+
+	if(isToSchedule)
+		scheduleDispatch();
 }
 
-void AsyncUdpSocket::execute()
+void AsyncUdpSocket::scheduleDispatch()
 {
-	m_callBackObj->OnNewConnection(this);
+	AsyncUdpJob *job=EP_NEW AsyncUdpJob(this,PRIORITY_NORMAL,m_lockPolicy);
+	((AsyncUdpServer*)m_owner)->pushJob(job);
+	job->ReleaseObj();
+}
 
-	unsigned int packetSize=0;
-	while(1)
+void AsyncUdpSocket::dispatchPackets()
+{
+	for(unsigned int trav=0;trav<UDP_PEER_DISPATCH_BATCH_COUNT;trav++)
 	{
-		if(m_threadStopEvent.WaitForEvent(WAITTIME_IGNORE))
-		{
-			break;
-		}
 		m_listLock->Lock();
-		if(m_packetList.size()==0)
-		{
-			m_listLock->Unlock();
-			Suspend();
-			continue;
-		}
-		Packet *packet= m_packetList.front();
-		packetSize=packet->GetPacketByteSize();
-		if(packetSize==0)
+		if(m_packetList.empty())
 		{
+			m_isScheduled=false;
 			m_listLock->Unlock();
-			break;
+			return;
 		}
-
+		Packet *packet=m_packetList.front();
 		m_packetList.pop();
 		m_listLock->Unlock();
 
-		if(m_isAsynchronousReceive)
-		{
-			ServerPacketProcessor::PacketPassUnit passUnit;
-			passUnit.m_owner=this;
-			passUnit.m_packet=packet;
-			ServerPacketProcessor *parser =EP_NEW ServerPacketProcessor(m_callBackObj,m_waitTime,m_lockPolicy);
-			if(!parser)
-			{
-				packet->ReleaseObj();
-				continue;
-			}
-			parser->setPacketPassUnit(passUnit);
-			m_processorList.Push(parser);
-			parser->Start();
+		bool isAlive=processPacket(packet);
+		if(packet)
 			packet->ReleaseObj();
-			parser->ReleaseObj();
-			if(GetMaximumProcessorCount()!=PROCESSOR_LIMIT_INFINITE)
-			{
-				while(m_processorList.Count()>=GetMaximumProcessorCount())
-				{
-					m_processorList.WaitForListSizeDecrease();
-				}
-			}
-		}
-		else
+		if(!isAlive)
 		{
-			m_callBackObj->OnReceived(this,packet,RECEIVE_STATUS_SUCCESS);
-			packet->ReleaseObj();
+			m_listLock->Lock();
+			m_isScheduled=false;
+			m_listLock->Unlock();
+			return;
 		}
+	}
 
-	}	
+	// give the worker thread to the other sockets, and continue with the next job.
+	scheduleDispatch();
+}
 
-	killConnection();
+bool AsyncUdpSocket::processPacket(Packet *packet)
+{
+	if(!IsConnectionAlive())
+		return false;
+
+	if(!m_isNewConnectionNotified)
+	{
+		m_isNewConnectionNotified=true;
+		m_callBackObj->OnNewConnection(this);
+	}
 
+	if(!packet || packet->GetPacketByteSize()==0)
+	{
+		killConnection();
+		return false;
+	}
+	if(!dispatchReceived(packet))
+		m_callBackObj->OnReceived(this,packet,RECEIVE_STATUS_SUCCESS);
+	return IsConnectionAlive();
 }
 
+void AsyncUdpSocket::execute()
+{
+	dispatchPackets();
+}
\ No newline at end of file
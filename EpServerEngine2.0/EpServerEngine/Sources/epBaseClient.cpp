@@ -33,7 +33,7 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-BaseClient::BaseClient( epl::LockPolicy lockPolicyType) :BaseServerObject(WAITTIME_INIFINITE,lockPolicyType)
+BaseClient::BaseClient( epl::LockPolicy lockPolicyType) :BaseServerObject(WAITTIME_INIFINITE,lockPolicyType),m_compressor(lockPolicyType)
 {
 
 	m_lockPolicy=lockPolicyType;
@@ -62,9 +62,10 @@ BaseClient::BaseClient( epl::LockPolicy lockPolicyType) :BaseServerObject(WAITTI
 	setHostName(_T(DEFAULT_HOSTNAME));
 	setPort(_T(DEFAULT_PORT));
 	m_callBackObj=NULL;
+	m_messageDispatcher=NULL;
 }
 
-BaseClient::BaseClient(const BaseClient& b) :BaseServerObject(b)
+BaseClient::BaseClient(const BaseClient& b) :BaseServerObject(b),m_compressor(b.m_compressor)
 {
 
 
@@ -95,6 +96,8 @@ BaseClient::BaseClient(const BaseClient& b) :BaseServerObject(b)
 	m_hostName=b.m_hostName;
 	m_port=b.m_port;
 	m_callBackObj=b.m_callBackObj;
+	m_messageDispatcher=b.m_messageDispatcher;
+	m_compressor=b.m_compressor;
 
 }
 BaseClient::~BaseClient()
@@ -137,6 +140,8 @@ BaseClient & BaseClient::operator=(const BaseClient&b)
 		m_hostName=b.m_hostName;
 		m_port=b.m_port;
 		m_callBackObj=b.m_callBackObj;
+		m_messageDispatcher=b.m_messageDispatcher;
+		m_compressor=b.m_compressor;
 	}
 	return *this;
 }
@@ -239,6 +244,13 @@ ClientCallbackInterface *BaseClient::GetCallbackObject()
 	return m_callBackObj;
 }
 
+bool BaseClient::dispatchReceived(const Packet *packet)
+{
+	if(!m_messageDispatcher)
+		return false;
+	return m_messageDispatcher->Dispatch(this,this,packet);
+}
+
 
 void BaseClient::SetWaitTime(unsigned int milliSec)
 {
@@ -255,6 +267,11 @@ bool BaseClient::IsConnectionAlive() const
 	return (GetStatus()==Thread::THREAD_STATUS_STARTED);
 }
 
+Compressor::Statistics BaseClient::GetCompressionStatistics() const
+{
+	return m_compressor.GetStatistics();
+}
+
 void BaseClient::cleanUpClient()
 {
 	if(m_connectSocket!=INVALID_SOCKET)
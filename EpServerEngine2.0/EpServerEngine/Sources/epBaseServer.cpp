@@ -33,7 +33,7 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-BaseServer::BaseServer(epl::LockPolicy lockPolicyType):BaseServerObject(WAITTIME_INIFINITE,lockPolicyType)
+BaseServer::BaseServer(epl::LockPolicy lockPolicyType):BaseServerObject(WAITTIME_INIFINITE,lockPolicyType),m_compressor(lockPolicyType)
 {
 	m_socketList=ServerObjectList(WAITTIME_INIFINITE,lockPolicyType);
 	m_lockPolicy=lockPolicyType;
@@ -57,9 +57,10 @@ BaseServer::BaseServer(epl::LockPolicy lockPolicyType):BaseServerObject(WAITTIME
 	m_maxConnectionCount=CONNECTION_LIMIT_INFINITE;
 	SetPort(_T(DEFAULT_PORT));
 	m_callBackObj=NULL;
+	m_messageDispatcher=NULL;
 }
 
-BaseServer::BaseServer(const BaseServer& b):BaseServerObject(b)
+BaseServer::BaseServer(const BaseServer& b):BaseServerObject(b),m_compressor(b.m_compressor)
 {
 	m_listenSocket=INVALID_SOCKET;
 	m_result=0;
@@ -86,6 +87,8 @@ BaseServer::BaseServer(const BaseServer& b):BaseServerObject(b)
 	m_maxConnectionCount=b.m_maxConnectionCount;
 	m_socketList=b.m_socketList;
 	m_callBackObj=b.m_callBackObj;
+	m_messageDispatcher=b.m_messageDispatcher;
+	m_compressor=b.m_compressor;
 }
 BaseServer::~BaseServer()
 {
@@ -125,6 +128,8 @@ BaseServer & BaseServer::operator=(const BaseServer&b)
 		m_maxConnectionCount=b.m_maxConnectionCount;
 		m_socketList=b.m_socketList;
 		m_callBackObj=b.m_callBackObj;
+		m_messageDispatcher=b.m_messageDispatcher;
+		m_compressor=b.m_compressor;
 	}
 	return *this;
 }
@@ -217,6 +222,11 @@ void BaseServer::ShutdownAllClient()
 	shutdownAllClient();
 }
 
+Compressor::Statistics BaseServer::GetCompressionStatistics() const
+{
+	return m_compressor.GetStatistics();
+}
+
 void BaseServer::shutdownAllClient()
 {
 	m_socketList.Do(killConnection,0);
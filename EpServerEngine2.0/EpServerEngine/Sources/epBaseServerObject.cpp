@@ -25,6 +25,7 @@ THE SOFTWARE.
 */
 #include "epBaseServerObject.h"
 #include "epServerObjectList.h"
+#include "epBufferPool.h"
 
 #if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 #define new DEBUG_NEW
@@ -39,6 +40,7 @@ BaseServerObject::BaseServerObject(unsigned int waitTimeMilliSec,epl::LockPolicy
 	m_waitTime=waitTimeMilliSec;
 	m_lockPolicy=lockPolicyType;
 	m_container=NULL;
+	m_objectId=OBJECT_ID_NONE;
 	switch(lockPolicyType)
 	{
 	case epl::LOCK_POLICY_CRITICALSECTION:
@@ -60,6 +62,7 @@ BaseServerObject::BaseServerObject(const BaseServerObject& b):SmartObject(b),Thr
 {
 	m_waitTime=b.m_waitTime;
 	m_container=b.m_container;
+	m_objectId=b.m_objectId;
 	m_lockPolicy=b.m_lockPolicy;
 	switch(m_lockPolicy)
 	{
@@ -97,6 +100,7 @@ BaseServerObject & BaseServerObject::operator=(const BaseServerObject&b)
 		
 		m_waitTime=b.m_waitTime;
 		m_container=b.m_container;
+		m_objectId=b.m_objectId;
 		m_lockPolicy=b.m_lockPolicy;
 		switch(m_lockPolicy)
 		{
@@ -126,6 +130,11 @@ unsigned int BaseServerObject::GetWaitTime() const
 	return m_waitTime;
 }
 
+unsigned int BaseServerObject::GetObjectId() const
+{
+	return m_objectId;
+}
+
 void BaseServerObject::setContainer(ServerObjectList *container)
 {
 	LockObj lock(m_containerLock);
@@ -141,3 +150,15 @@ bool BaseServerObject::removeSelfFromContainer()
 	return ret;
 }
 
+bool BaseServerObject::getIndexAddress(sockaddr &retSockAddr) const
+{
+	return false;
+}
+
+void BaseServerObject::onTerminated(unsigned long exitCode,bool isInDeletion)
+{
+	// only the normal termination runs on the thread exiting itself
+	if(exitCode==0 && !isInDeletion)
+		BufferPool::defaultBufferPool.FlushThreadCache();
+	epl::Thread::onTerminated(exitCode,isInDeletion);
+}
\ No newline at end of file
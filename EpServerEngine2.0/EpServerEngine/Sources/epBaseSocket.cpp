@@ -54,6 +54,12 @@ BaseSocket::BaseSocket(ServerCallbackInterface *callBackObj,unsigned int waitTim
 	}
 	m_callBackObj=callBackObj;
 	m_owner=NULL;
+	m_timerEventLoop=NULL;
+	m_idleTimer=NULL;
+	m_idleTimeout=IDLE_TIMEOUT_INFINITE;
+	m_lastActiveTime=0;
+	m_socketPool=NULL;
+	m_messageDispatcher=NULL;
 }
 
 BaseSocket::~BaseSocket()
@@ -63,6 +69,9 @@ BaseSocket::~BaseSocket()
 	m_baseSocketLock=NULL;
 
 	m_owner=NULL;
+	if(m_idleTimer)
+		m_idleTimer->ReleaseObj();
+	m_idleTimer=NULL;
 }
 
 
@@ -81,11 +90,29 @@ void BaseSocket::setOwner(BaseServerObject * owner )
 	epl::LockObj lock(m_baseSocketLock);
 	m_owner=owner;
 }
+void BaseSocket::setMessageDispatcher(ServerMessageDispatcher *messageDispatcher)
+{
+	epl::LockObj lock(m_baseSocketLock);
+	m_messageDispatcher=messageDispatcher;
+}
+
+bool BaseSocket::dispatchReceived(const Packet *packet)
+{
+	if(!m_messageDispatcher)
+		return false;
+	return m_messageDispatcher->Dispatch(this,this,packet);
+}
+
 void BaseSocket::setSockAddr(sockaddr sockAddr)
 {
 	epl::LockObj lock(m_baseSocketLock);
 	m_sockAddr=sockAddr;
 }
+bool BaseSocket::getIndexAddress(sockaddr &retSockAddr) const
+{
+	retSockAddr=m_sockAddr;
+	return true;
+}
 bool BaseSocket::IsConnectionAlive() const
 {
 	return (GetStatus()!=Thread::THREAD_STATUS_TERMINATED);
@@ -132,3 +159,92 @@ ServerCallbackInterface *BaseSocket::GetCallbackObject()
 {
 	return m_callBackObj;
 }
+
+void BaseSocket::setTimerEventLoop(EventLoop *eventLoop)
+{
+	epl::LockObj lock(m_baseSocketLock);
+	if(m_timerEventLoop==eventLoop)
+		return;
+	// the idle timer is bound to the previous Event Loop
+	if(m_idleTimer)
+		m_idleTimer->ReleaseObj();
+	m_idleTimer=NULL;
+	m_timerEventLoop=eventLoop;
+}
+
+unsigned int BaseSocket::GetIdleTimeout() const
+{
+	return m_idleTimeout;
+}
+
+void BaseSocket::SetIdleTimeout(unsigned int milliSec)
+{
+	m_baseSocketLock->Lock();
+	if(!m_timerEventLoop || !IsConnectionAlive())
+	{
+		m_baseSocketLock->Unlock();
+		return;
+	}
+	m_idleTimeout=milliSec;
+	if(!m_idleTimer)
+		m_idleTimer=EP_NEW Timer(this,m_timerEventLoop,this,m_lockPolicy);
+	m_lastActiveTime=m_timerEventLoop->GetCachedTime();
+	m_baseSocketLock->Unlock();
+
+	if(milliSec==IDLE_TIMEOUT_INFINITE)
+		m_idleTimer->Cancel();
+	else
+		m_idleTimer->Schedule(milliSec);
+}
+
+void BaseSocket::updateLastActiveTime()
+{
+	if(m_timerEventLoop)
+		m_lastActiveTime=m_timerEventLoop->GetCachedTime();
+}
+
+void BaseSocket::cancelIdleTimer()
+{
+	if(m_idleTimer)
+		m_idleTimer->Cancel();
+}
+
+void BaseSocket::setSocketPool(SocketPool *socketPool)
+{
+	epl::LockObj lock(m_baseSocketLock);
+	m_socketPool=socketPool;
+}
+
+void BaseSocket::retireToPool()
+{
+	if(m_socketPool)
+		m_socketPool->Retire(this);
+}
+
+bool BaseSocket::isRecyclable()
+{
+	return (!IsConnectionAlive() && GetReferenceCount()==1 && GetStatus()==Thread::THREAD_STATUS_TERMINATED);
+}
+
+void BaseSocket::resetConnection()
+{
+	m_idleTimeout=IDLE_TIMEOUT_INFINITE;
+	m_lastActiveTime=0;
+}
+
+void BaseSocket::OnTimer(Timer *timer)
+{
+	unsigned int idleTimeout=m_idleTimeout;
+	if(!IsConnectionAlive() || idleTimeout==IDLE_TIMEOUT_INFINITE)
+		return;
+
+	// the receive only updates the time, and the timer is pushed back lazily here
+	unsigned int idleTime=m_timerEventLoop->GetCachedTime()-m_lastActiveTime;
+	if(idleTime<idleTimeout)
+	{
+		timer->Schedule(idleTimeout-idleTime);
+		return;
+	}
+	epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Idle timeout...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+	KillConnection();
+}
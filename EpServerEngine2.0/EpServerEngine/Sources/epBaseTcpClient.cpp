@@ -33,15 +33,21 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-BaseTcpClient::BaseTcpClient(epl::LockPolicy lockPolicyType) :BaseClient(lockPolicyType)
+BaseTcpClient::BaseTcpClient(epl::LockPolicy lockPolicyType) :BaseClient(lockPolicyType),m_frameCodec(),m_recvBuffer(),m_pendingSendBuffer(lockPolicyType)
 {
-	m_recvSizePacket=Packet(NULL,4);
+	m_isSendCoalescing=false;
+	m_frameCodec.SetCompressor(&m_compressor);
+	m_recvBuffer.SetFrameCodec(&m_frameCodec);
+	m_pendingSendBuffer.SetFrameCodec(&m_frameCodec);
 }
 
 
-BaseTcpClient::BaseTcpClient(const BaseTcpClient& b) :BaseClient(b)
+BaseTcpClient::BaseTcpClient(const BaseTcpClient& b) :BaseClient(b),m_frameCodec(b.m_frameCodec),m_recvBuffer(b.m_recvBuffer),m_pendingSendBuffer(b.m_pendingSendBuffer)
 {
-	m_recvSizePacket=b.m_recvSizePacket;
+	m_isSendCoalescing=b.m_isSendCoalescing;
+	m_frameCodec.SetCompressor(&m_compressor);
+	m_recvBuffer.SetFrameCodec(&m_frameCodec);
+	m_pendingSendBuffer.SetFrameCodec(&m_frameCodec);
 
 }
 BaseTcpClient::~BaseTcpClient()
@@ -54,15 +60,35 @@ BaseTcpClient & BaseTcpClient::operator=(const BaseTcpClient&b)
 	{
 
 		BaseClient::operator =(b);
-		m_recvSizePacket=b.m_recvSizePacket;
+		m_frameCodec=b.m_frameCodec;
+		m_frameCodec.SetCompressor(&m_compressor);
+		m_recvBuffer=b.m_recvBuffer;
+		m_pendingSendBuffer=b.m_pendingSendBuffer;
+		m_isSendCoalescing=b.m_isSendCoalescing;
 	}
 	return *this;
 }
 
 
-int BaseTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int BaseTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
-	epl::LockObj lock(m_sendLock);
+	int length=packet.GetPacketByteSize();
+	if(length<=0)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return 0;
+	}
+
+	// the packet is held to be written with the next packet while the batch is small
+	if(isMoreComing && m_pendingSendBuffer.GetPendingByteSize()+length<SEND_COALESCE_BYTE_SIZE_MAX)
+	{
+		m_pendingSendBuffer.Push(packet);
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return length;
+	}
+
 	if(!IsConnectionAlive())
 	{
 		if(sendStatus)
@@ -70,6 +96,7 @@ int BaseTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,Se
 		return 0;
 	}
 	// select routine
+	// the wait comes before the packet is queued, so the packet failed here is never written by the next flush
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
 	int		retfdNum = 0;
@@ -102,52 +129,97 @@ int BaseTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,Se
 		return retfdNum;
 	}
 
-	// send routine
-	int writeLength=0;
-	const char *packetData=packet.GetPacket();
-	int length=packet.GetPacketByteSize();
+	// the packet is queued to be written together with the others
+	bool isQueued=(isMoreComing || m_isSendCoalescing);
+	unsigned int ticket=0;
+	if(isQueued)
+		ticket=m_pendingSendBuffer.Push(packet);
 
-	if(length>0)
-	{
-		int sentLength=send(m_connectSocket,reinterpret_cast<char*>(&length),4,0);
-		if(sentLength<=0)
-			return sentLength;
-	}
-	while(length>0)
+	epl::LockObj lock(m_sendLock);
+	if(isQueued && m_pendingSendBuffer.IsFlushed(ticket))
 	{
-		int sentLength=send(m_connectSocket,packetData,length,0);
-		writeLength+=sentLength;
-		if(sentLength<=0)
+		// already written by the other Send while waiting for the lock
+		if(m_pendingSendBuffer.IsFlushFailed())
 		{
 			if(sendStatus)
 				*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
-			return sentLength;
+			return -1;
 		}
-		length-=sentLength;
-		packetData+=sentLength;
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return length;
+	}
+
+	// the packet queued is discarded with the others before the next connection
+	if(!IsConnectionAlive())
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_CONNECTED;
+		return 0;
+	}
+
+	// send routine
+	if(!m_pendingSendBuffer.Flush(m_connectSocket,isQueued?NULL:&packet))
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
 	}
 	if(sendStatus)
 		*sendStatus=SEND_STATUS_SUCCESS;
-	return writeLength;
+	return length;
 }
 
-int BaseTcpClient::receive(Packet &packet)
+bool BaseTcpClient::GetIsSendCoalescing() const
 {
-	int readLength=0;
-	int length=packet.GetPacketByteSize();
-	char *packetData=const_cast<char*>(packet.GetPacket());
-	while(length>0)
+	return m_isSendCoalescing;
+}
+
+void BaseTcpClient::SetIsSendCoalescing(bool isSendCoalescing)
+{
+	m_isSendCoalescing=isSendCoalescing;
+}
+
+void BaseTcpClient::setReceiveLimit(unsigned int maxFrameByteSize,unsigned int chunkByteSize)
+{
+	m_recvBuffer.SetMaxFrameByteSize(maxFrameByteSize);
+	m_recvBuffer.SetChunkByteSize(chunkByteSize);
+}
+
+Packet *BaseTcpClient::popPacket()
+{
+	ReceiveBuffer::Chunk chunk;
+	for(;;)
 	{
-		int recvLength=recv(m_connectSocket,packetData, length, 0);
-		readLength+=recvLength;
+		Packet *retPacket=m_recvBuffer.PopPacket();
+		if(retPacket || !m_recvBuffer.PopChunk(chunk))
+			return retPacket;
+		m_callBackObj->OnReceiveChunk(this,chunk.m_offset,chunk.m_data,chunk.m_byteSize,chunk.m_isLast);
+	}
+}
+
+int BaseTcpClient::receive(Packet *&retPacket)
+{
+	retPacket=popPacket();
+	while(!retPacket)
+	{
+		// the rest of the corrupted stream can not be parsed
+		if(m_recvBuffer.IsCorrupted())
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Received the corrupted frame or the packet exceeding the maximum byte size\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			return SOCKET_ERROR;
+		}
+		unsigned int writableByteSize=0;
+		char *writeBuffer=m_recvBuffer.GetWriteBuffer(writableByteSize);
+		int recvLength=recv(m_connectSocket,writeBuffer, writableByteSize, 0);
 		if(recvLength<=0)
 		{
 			return recvLength;
 		}
-		length-=recvLength;
-		packetData+=recvLength;
+		m_recvBuffer.CommitWrite(recvLength);
+		retPacket=popPacket();
 	}
-	return readLength;
+	return retPacket->GetPacketByteSize()+sizeof(unsigned int);
 }
 
 
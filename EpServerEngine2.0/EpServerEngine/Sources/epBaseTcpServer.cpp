@@ -36,11 +36,24 @@ using namespace epse;
 
 BaseTcpServer::BaseTcpServer(epl::LockPolicy lockPolicyType):BaseServer(lockPolicyType)
 {
+	m_sendQueueHighWatermark=SEND_QUEUE_HIGH_WATERMARK_DEFAULT;
+	m_sendQueueLowWatermark=SEND_QUEUE_LOW_WATERMARK_DEFAULT;
+	m_sendQueueLimit=SEND_QUEUE_LIMIT_INFINITE;
+	m_frameVersion=FRAME_VERSION_LEGACY;
+	m_maxFrameByteSize=FRAME_BYTE_SIZE_MAX_DEFAULT;
+	m_receiveChunkByteSize=RECEIVE_CHUNK_BYTE_SIZE_NONE;
 }
 
 
 BaseTcpServer::BaseTcpServer(const BaseTcpServer& b):BaseServer(b)
-{}
+{
+	m_sendQueueHighWatermark=b.m_sendQueueHighWatermark;
+	m_sendQueueLowWatermark=b.m_sendQueueLowWatermark;
+	m_sendQueueLimit=b.m_sendQueueLimit;
+	m_frameVersion=b.m_frameVersion;
+	m_maxFrameByteSize=b.m_maxFrameByteSize;
+	m_receiveChunkByteSize=b.m_receiveChunkByteSize;
+}
 
 BaseTcpServer::~BaseTcpServer()
 {
@@ -51,6 +64,12 @@ BaseTcpServer & BaseTcpServer::operator=(const BaseTcpServer&b)
 	if(this!=&b)
 	{
 		BaseServer::operator =(b);
+		m_sendQueueHighWatermark=b.m_sendQueueHighWatermark;
+		m_sendQueueLowWatermark=b.m_sendQueueLowWatermark;
+		m_sendQueueLimit=b.m_sendQueueLimit;
+		m_frameVersion=b.m_frameVersion;
+		m_maxFrameByteSize=b.m_maxFrameByteSize;
+		m_receiveChunkByteSize=b.m_receiveChunkByteSize;
 	}
 	return *this;
 }
@@ -65,6 +84,7 @@ bool BaseTcpServer::StartServer(const ServerOps &ops)
 
 	if(ops.callBackObj)
 		m_callBackObj=ops.callBackObj;
+	m_messageDispatcher=ops.messageDispatcher;
 	EP_ASSERT(m_callBackObj);
 
 	if(ops.port)
@@ -79,6 +99,13 @@ bool BaseTcpServer::StartServer(const ServerOps &ops)
 
 	SetWaitTime(ops.waitTimeMilliSec);
 	m_maxConnectionCount=ops.maximumConnectionCount;
+	m_sendQueueHighWatermark=ops.sendQueueHighWatermark;
+	m_sendQueueLowWatermark=ops.sendQueueLowWatermark;
+	m_sendQueueLimit=ops.sendQueueLimit;
+	m_frameVersion=ops.frameVersion;
+	m_maxFrameByteSize=ops.maxFrameByteSize;
+	m_receiveChunkByteSize=ops.receiveChunkByteSize;
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
 	
 	WSADATA wsaData;
 	int iResult;
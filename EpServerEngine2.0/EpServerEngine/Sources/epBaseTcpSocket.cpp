@@ -33,7 +33,7 @@ static char THIS_FILE[] = __FILE__;
 #endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
 
 using namespace epse;
-BaseTcpSocket::BaseTcpSocket(ServerCallbackInterface *callBackObj,unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType): BaseSocket(callBackObj,waitTimeMilliSec,lockPolicyType)
+BaseTcpSocket::BaseTcpSocket(ServerCallbackInterface *callBackObj,unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType): BaseSocket(callBackObj,waitTimeMilliSec,lockPolicyType),m_pendingSendBuffer(lockPolicyType)
 {
 	switch(lockPolicyType)
 	{
@@ -50,8 +50,11 @@ BaseTcpSocket::BaseTcpSocket(ServerCallbackInterface *callBackObj,unsigned int w
 		m_sendLock=NULL;
 		break;
 	}
-	m_recvSizePacket=Packet(NULL,4);
 	m_clientSocket=INVALID_SOCKET;
+	m_isSendCoalescing=false;
+	m_recvBuffer.SetFrameCodec(&m_frameCodec);
+	m_pendingSendBuffer.SetFrameCodec(&m_frameCodec);
+	m_sendQueue.SetFrameCodec(&m_frameCodec);
 }
 
 BaseTcpSocket::~BaseTcpSocket()
@@ -67,10 +70,56 @@ void BaseTcpSocket::setClientSocket(const SOCKET& clientSocket )
 	m_clientSocket=clientSocket;
 }
 
+void BaseTcpSocket::setSendQueueWatermark(unsigned int highWatermark,unsigned int lowWatermark,unsigned int limit)
+{
+	m_sendQueue.SetWatermark(highWatermark,lowWatermark,limit);
+}
+
+void BaseTcpSocket::setFrameVersion(unsigned int frameVersion)
+{
+	m_frameCodec.Reset(frameVersion,false);
+}
+
+void BaseTcpSocket::setCompressor(Compressor *compressor)
+{
+	m_frameCodec.SetCompressor(compressor);
+}
+
+void BaseTcpSocket::setReceiveLimit(unsigned int maxFrameByteSize,unsigned int chunkByteSize)
+{
+	m_recvBuffer.SetMaxFrameByteSize(maxFrameByteSize);
+	m_recvBuffer.SetChunkByteSize(chunkByteSize);
+}
+
+void BaseTcpSocket::resetConnection()
+{
+	BaseSocket::resetConnection();
+	m_frameCodec.Reset(FRAME_VERSION_LEGACY,false);
+	m_recvBuffer.Clear();
+	m_pendingSendBuffer.Clear();
+	m_sendQueue.Clear();
+	m_isSendCoalescing=false;
+}
 
-int BaseTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
-{	
-	epl::LockObj lock(m_sendLock);
+
+int BaseTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
+{
+	int length=packet.GetPacketByteSize();
+	if(length<=0)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return 0;
+	}
+
+	// the packet is held to be written with the next packet while the batch is small
+	if(isMoreComing && m_pendingSendBuffer.GetPendingByteSize()+length<SEND_COALESCE_BYTE_SIZE_MAX)
+	{
+		m_pendingSendBuffer.Push(packet);
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return length;
+	}
 
 	if(m_clientSocket==INVALID_SOCKET)
 	{
@@ -78,7 +127,8 @@ int BaseTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,Se
 			*sendStatus=SEND_STATUS_FAIL_NOT_CONNECTED;
 		return 0;
 	}
-
+	// select routine
+	// the wait comes before the packet is queued, so the packet failed here is never written by the next flush
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
 	int		retfdNum = 0;
@@ -111,57 +161,92 @@ int BaseTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,Se
 		return retfdNum;
 	}
 
-	// send routine
-	int writeLength=0;
-	const char *packetData=packet.GetPacket();
-	int length=packet.GetPacketByteSize();
+	// the packet is queued to be written together with the others
+	bool isQueued=(isMoreComing || m_isSendCoalescing);
+	unsigned int ticket=0;
+	if(isQueued)
+		ticket=m_pendingSendBuffer.Push(packet);
 
-	if(length>0)
+	epl::LockObj lock(m_sendLock);
+	if(isQueued && m_pendingSendBuffer.IsFlushed(ticket))
 	{
-		int sentLength=send(m_clientSocket,reinterpret_cast<char*>(&length),4,0);
-		if(sentLength<=0)
+		// already written by the other Send while waiting for the lock
+		if(m_pendingSendBuffer.IsFlushFailed())
 		{
 			if(sendStatus)
-				*sendStatus=SEND_STATUS_SUCCESS;
-			return sentLength;
+				*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+			return -1;
 		}
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return length;
 	}
-	while(length>0)
+
+	// the packet queued is discarded with the others before the next connection
+	if(m_clientSocket==INVALID_SOCKET)
 	{
-		int sentLength=send(m_clientSocket,packetData,length,0);
-		writeLength+=sentLength;
-		if(sentLength<=0)
-		{
-			if(sendStatus)
-				*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
-			return sentLength;
-		}
-		length-=sentLength;
-		packetData+=sentLength;
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_CONNECTED;
+		return 0;
+	}
+
+	// send routine
+	if(!m_pendingSendBuffer.Flush(m_clientSocket,isQueued?NULL:&packet))
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
 	}
 	if(sendStatus)
 		*sendStatus=SEND_STATUS_SUCCESS;
-	return writeLength;
+	return length;
 }
 
+bool BaseTcpSocket::GetIsSendCoalescing() const
+{
+	return m_isSendCoalescing;
+}
 
-int BaseTcpSocket::receive(Packet &packet)
+void BaseTcpSocket::SetIsSendCoalescing(bool isSendCoalescing)
 {
-	int readLength=0;
-	int length=packet.GetPacketByteSize();
-	char *packetData=const_cast<char*>(packet.GetPacket());
-	while(length>0)
+	m_isSendCoalescing=isSendCoalescing;
+}
+
+
+Packet *BaseTcpSocket::popPacket()
+{
+	ReceiveBuffer::Chunk chunk;
+	for(;;)
 	{
-		int recvLength=recv(m_clientSocket,packetData, length, 0);
-		readLength+=recvLength;
+		Packet *retPacket=m_recvBuffer.PopPacket();
+		if(retPacket || !m_recvBuffer.PopChunk(chunk))
+			return retPacket;
+		m_callBackObj->OnReceiveChunk(this,chunk.m_offset,chunk.m_data,chunk.m_byteSize,chunk.m_isLast);
+	}
+}
+
+int BaseTcpSocket::receive(Packet *&retPacket)
+{
+	retPacket=popPacket();
+	while(!retPacket)
+	{
+		// the rest of the corrupted stream can not be parsed
+		if(m_recvBuffer.IsCorrupted())
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Received the corrupted frame or the packet exceeding the maximum byte size\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			return SOCKET_ERROR;
+		}
+		unsigned int writableByteSize=0;
+		char *writeBuffer=m_recvBuffer.GetWriteBuffer(writableByteSize);
+		int recvLength=recv(m_clientSocket,writeBuffer, writableByteSize, 0);
 		if(recvLength<=0)
 		{
 			return recvLength;
 		}
-		length-=recvLength;
-		packetData+=recvLength;
+		m_recvBuffer.CommitWrite(recvLength);
+		retPacket=popPacket();
 	}
-	return readLength;
+	return retPacket->GetPacketByteSize()+sizeof(unsigned int);
 }
 
 
@@ -39,18 +39,25 @@ BaseUdpClient::BaseUdpClient(epl::LockPolicy lockPolicyType): BaseClient(lockPol
 
 	m_ptr=0;
 	m_maxPacketSize=0;
+	m_reliableSession=NULL;
+	m_fragmentSession=NULL;
 }
 
 BaseUdpClient::BaseUdpClient(const BaseUdpClient& b):BaseClient(b)
 {
 	m_ptr=0;
 	m_maxPacketSize=b.m_maxPacketSize;
-
-
+	m_reliableSession=NULL;
+	m_fragmentSession=NULL;
 }
 BaseUdpClient::~BaseUdpClient()
 {
-
+	if(m_reliableSession)
+		EP_DELETE m_reliableSession;
+	m_reliableSession=NULL;
+	if(m_fragmentSession)
+		EP_DELETE m_fragmentSession;
+	m_fragmentSession=NULL;
 }
 
 BaseUdpClient & BaseUdpClient::operator=(const BaseUdpClient&b)
@@ -62,6 +69,12 @@ BaseUdpClient & BaseUdpClient::operator=(const BaseUdpClient&b)
 
 		m_ptr=0;
 		m_maxPacketSize=b.m_maxPacketSize;
+		if(m_reliableSession)
+			EP_DELETE m_reliableSession;
+		m_reliableSession=NULL;
+		if(m_fragmentSession)
+			EP_DELETE m_fragmentSession;
+		m_fragmentSession=NULL;
 
 
 	}
@@ -70,10 +83,45 @@ BaseUdpClient & BaseUdpClient::operator=(const BaseUdpClient&b)
 
 unsigned int BaseUdpClient::GetMaxPacketByteSize() const
 {
+	// the marker of the compression takes a byte of every datagram
+	if(m_compressor.IsEnabled() && m_maxPacketSize)
+		return m_maxPacketSize-UDP_COMPRESSION_HEADER_BYTE_SIZE;
 	return m_maxPacketSize;
 }
 
-int BaseUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int BaseUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
+{
+	// every datagram carries the header of the channel with the reliable UDP
+	if(m_reliableSession)
+		return Send(packet,UDP_CHANNEL_UNRELIABLE,sendStatus);
+	if(m_fragmentSession)
+		return m_fragmentSession->SendDatagram(packet,sendStatus);
+	return sendTo(packet,waitTimeInMilliSec,sendStatus);
+}
+
+int BaseUdpClient::Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus)
+{
+	if(!IsConnectionAlive())
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_CONNECTED;
+		return 0;
+	}
+	if(!m_reliableSession)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+		return -1;
+	}
+	return m_reliableSession->Send(packet,channel,sendStatus);
+}
+
+int BaseUdpClient::SendDatagram(const Packet &datagram,SendStatus *sendStatus)
+{
+	return sendTo(datagram,WAITTIME_INIFINITE,sendStatus);
+}
+
+int BaseUdpClient::sendTo(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
 {
 	epl::LockObj lock(m_sendLock);
 	if(!IsConnectionAlive())
@@ -121,7 +169,14 @@ int BaseUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,Se
 	int writeLength=0;
 	const char *packetData=packet.GetPacket();
 	int length=packet.GetPacketByteSize();
-	EP_ASSERT(length<=m_maxPacketSize);
+	if(length>GetMaxPacketByteSize())
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+	if(length>0 && m_compressor.IsEnabled())
+		return sendCompressedTo(packet,sendStatus);
 	int sockAddrSize=sizeof(sockaddr);
 	while(length>0)
 	{
@@ -141,6 +196,33 @@ int BaseUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,Se
 	return sentLength;
 }
 
+int BaseUdpClient::sendCompressedTo(const Packet &datagram,SendStatus *sendStatus)
+{
+	char marker;
+	Packet *compressedPacket=m_compressor.CompressDatagram(datagram,marker);
+	const Packet *sendPacket=(compressedPacket)?compressedPacket:&datagram;
+
+	// send the marker and the datagram together
+	WSABUF wsaBuf[2];
+	wsaBuf[0].buf=&marker;
+	wsaBuf[0].len=UDP_COMPRESSION_HEADER_BYTE_SIZE;
+	wsaBuf[1].buf=const_cast<char*>(sendPacket->GetPacket());
+	wsaBuf[1].len=sendPacket->GetPacketByteSize();
+	DWORD sentLength=0;
+	int iResult=WSASendTo(m_connectSocket,wsaBuf,2,&sentLength,0,m_ptr->ai_addr,sizeof(sockaddr),NULL,NULL);
+	if(compressedPacket)
+		compressedPacket->ReleaseObj();
+	if(iResult==SOCKET_ERROR)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return datagram.GetPacketByteSize();
+}
+
 
 
 int BaseUdpClient::receive(Packet &packet)
@@ -154,6 +236,88 @@ int BaseUdpClient::receive(Packet &packet)
 }
 
 
+void BaseUdpClient::setUpSessions(bool isReliable,bool isFragmented)
+{
+	// the sessions of the previous connection are discarded
+	if(m_reliableSession)
+		EP_DELETE m_reliableSession;
+	m_reliableSession=NULL;
+	if(m_fragmentSession)
+		EP_DELETE m_fragmentSession;
+	m_fragmentSession=NULL;
+
+	if(isFragmented)
+		m_fragmentSession=EP_NEW UdpFragmentSession(this,GetMaxPacketByteSize(),m_lockPolicy);
+	if(!isReliable)
+		return;
+	if(m_fragmentSession)
+		m_reliableSession=EP_NEW ReliableUdpSession(m_fragmentSession,UDP_FRAGMENT_MESSAGE_BYTE_SIZE_MAX,m_lockPolicy);
+	else
+		m_reliableSession=EP_NEW ReliableUdpSession(this,GetMaxPacketByteSize(),m_lockPolicy);
+	// the blocking receive wakes up periodically to retransmit
+	DWORD receiveTimeout=RELIABLE_UDP_TICK_MILLISEC;
+	setsockopt(m_connectSocket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<char*>(&receiveTimeout), sizeof(DWORD));
+}
+
+bool BaseUdpClient::updateReliable()
+{
+	if(!m_reliableSession)
+		return true;
+	return m_reliableSession->Update();
+}
+
+Packet *BaseUdpClient::createReceivedPacket(const char *packetData,unsigned int byteSize)
+{
+	if(!m_compressor.IsEnabled())
+		return createSessionPacket(packetData,byteSize);
+
+	// the marker of the compression is taken off before the sessions
+	Packet datagram(packetData,byteSize,false);
+	Packet *packet;
+	if(!m_compressor.DecompressDatagram(datagram,GetMaxPacketByteSize(),packet))
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Dropped the datagram failed to decompress\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return NULL;
+	}
+	if(!m_fragmentSession && !m_reliableSession)
+		return packet;
+	Packet *retPacket=createSessionPacket(packet->GetPacket(),packet->GetPacketByteSize());
+	packet->ReleaseObj();
+	return retPacket;
+}
+
+Packet *BaseUdpClient::createSessionPacket(const char *packetData,unsigned int byteSize)
+{
+	if(m_fragmentSession)
+	{
+		Packet datagram(packetData,byteSize,false);
+		Packet *packet=m_fragmentSession->Receive(datagram);
+		if(!packet || !m_reliableSession)
+			return packet;
+		m_reliableSession->Receive(packet->GetPacket(),packet->GetPacketByteSize());
+		packet->ReleaseObj();
+		return m_reliableSession->PopPacket();
+	}
+	if(!m_reliableSession)
+		return EP_NEW Packet(packetData,byteSize);
+	m_reliableSession->Receive(packetData,byteSize);
+	return m_reliableSession->PopPacket();
+}
+
+Packet *BaseUdpClient::popReceivedPacket()
+{
+	if(!m_reliableSession)
+		return NULL;
+	return m_reliableSession->PopPacket();
+}
+
+unsigned int BaseUdpClient::GetRoundTripTime() const
+{
+	if(!m_reliableSession)
+		return 0;
+	return m_reliableSession->GetRoundTripTime();
+}
+
 void BaseUdpClient::cleanUpClient()
 {
 	BaseClient::cleanUpClient();
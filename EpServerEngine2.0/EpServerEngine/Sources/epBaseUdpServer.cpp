@@ -51,6 +51,12 @@ BaseUdpServer::BaseUdpServer(epl::LockPolicy lockPolicyType): BaseServer(lockPol
 		break;
 	}
 	m_maxPacketSize=0;
+	m_isSegmentationOffload=false;
+	m_isSendOffloaded=false;
+	m_receiveSlab=NULL;
+	m_isReliableUdp=false;
+	m_isFragmentedUdp=false;
+	m_lastReliableUpdateTime=0;
 }
 
 BaseUdpServer::BaseUdpServer(const BaseUdpServer& b):BaseServer(b)
@@ -73,6 +79,12 @@ BaseUdpServer::BaseUdpServer(const BaseUdpServer& b):BaseServer(b)
 
 	LockObj lock(b.m_baseServerLock);
 	m_maxPacketSize=b.m_maxPacketSize;
+	m_isSegmentationOffload=b.m_isSegmentationOffload;
+	m_isSendOffloaded=false;
+	m_receiveSlab=NULL;
+	m_isReliableUdp=b.m_isReliableUdp;
+	m_isFragmentedUdp=b.m_isFragmentedUdp;
+	m_lastReliableUpdateTime=0;
 }
 BaseUdpServer::~BaseUdpServer()
 {
@@ -102,6 +114,12 @@ BaseUdpServer & BaseUdpServer::operator=(const BaseUdpServer&b)
 
 		LockObj lock(b.m_baseServerLock);
 		m_maxPacketSize=b.m_maxPacketSize;
+		m_isSegmentationOffload=b.m_isSegmentationOffload;
+		m_isSendOffloaded=false;
+		m_receiveSlab=NULL;
+		m_isReliableUdp=b.m_isReliableUdp;
+		m_isFragmentedUdp=b.m_isFragmentedUdp;
+		m_lastReliableUpdateTime=0;
 	}
 	return *this;
 }
@@ -110,14 +128,23 @@ void BaseUdpServer::resetServer()
 {
 	BaseServer::resetServer();
 
+	clearPendingSend();
+
 	if(m_sendLock)
 		EP_DELETE m_sendLock;
 	m_sendLock=NULL;
+
+	if(m_receiveSlab)
+		m_receiveSlab->ReleaseObj();
+	m_receiveSlab=NULL;
 }
 
 
 unsigned int BaseUdpServer::GetMaxPacketByteSize() const
 {
+	// the marker of the compression takes a byte of every datagram
+	if(m_compressor.IsEnabled() && m_maxPacketSize)
+		return m_maxPacketSize-UDP_COMPRESSION_HEADER_BYTE_SIZE;
 	return m_maxPacketSize;
 }
 
@@ -127,45 +154,74 @@ int BaseUdpServer::send(const Packet &packet,const sockaddr &clientSockAddr, uns
 	epl::LockObj lock(m_sendLock);
 
 	// select routine
-	TIMEVAL	timeOutVal;
-	fd_set	fdSet;
-	int		retfdNum = 0;
+	int retfdNum=waitForSend(waitTimeInMilliSec,sendStatus);
+	if(retfdNum<=0)
+		return retfdNum;
 
-	FD_ZERO(&fdSet);
-	FD_SET(m_listenSocket, &fdSet);
-	if(waitTimeInMilliSec!=WAITTIME_INIFINITE)
+	// the datagrams held go out first in order, with no more wait or lock
+	flushPendingSend();
+	return sendDatagram(packet,clientSockAddr,sendStatus);
+}
+
+int BaseUdpServer::queueSend(const Packet &packet,const sockaddr &clientSockAddr, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+{
+	int length=packet.GetPacketByteSize();
+	if(length<=0)
 	{
-		// socket select time out setting
-		timeOutVal.tv_sec = (long)(waitTimeInMilliSec/1000); // Convert to seconds
-		timeOutVal.tv_usec = (long)(waitTimeInMilliSec%1000)*1000; // Convert remainders to micro-seconds
-		// socket select
-		// socket read select
-		retfdNum = select(0, NULL, &fdSet, NULL, &timeOutVal);
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return 0;
 	}
-	else
 	{
-		retfdNum = select(0, NULL, &fdSet, NULL, NULL);
+		epl::LockObj lock(m_sendLock);
+		if(m_pendingSendList.size()<UDP_SEND_BATCH_COUNT_MAX-1)
+		{
+			// the packet may be released by the caller right after
+			PendingDatagram datagram;
+			datagram.m_packet=EP_NEW Packet(packet.GetPacket(),length);
+			datagram.m_sockAddr=clientSockAddr;
+			m_pendingSendList.push_back(datagram);
+			if(sendStatus)
+				*sendStatus=SEND_STATUS_SUCCESS;
+			return length;
+		}
 	}
-	if (retfdNum == SOCKET_ERROR)	// select failed
+	// the batch is full, so flush it with the packet
+	return send(packet,clientSockAddr,waitTimeInMilliSec,sendStatus);
+}
+
+void BaseUdpServer::flushPendingSend()
+{
+	vector<PendingDatagram>::iterator iter;
+	for(iter=m_pendingSendList.begin();iter!=m_pendingSendList.end();iter++)
 	{
-		if(sendStatus)
-			*sendStatus=SEND_STATUS_FAIL_SOCKET_ERROR;
-		return retfdNum;
+		if(sendDatagram(*(iter->m_packet),iter->m_sockAddr,NULL)<0)
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Dropped the datagram failed to send\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		iter->m_packet->ReleaseObj();
 	}
-	else if (retfdNum == 0)		    // select time-out
+	m_pendingSendList.clear();
+}
+
+void BaseUdpServer::clearPendingSend()
+{
+	epl::LockObj lock(m_sendLock);
+	vector<PendingDatagram>::iterator iter;
+	for(iter=m_pendingSendList.begin();iter!=m_pendingSendList.end();iter++)
 	{
-		if(sendStatus)
-			*sendStatus=SEND_STATUS_FAIL_TIME_OUT;
-		return retfdNum;
+		iter->m_packet->ReleaseObj();
 	}
+	m_pendingSendList.clear();
+}
 
-	// send routine
-
+int BaseUdpServer::sendDatagram(const Packet &packet,const sockaddr &clientSockAddr,SendStatus *sendStatus)
+{
 	int sentLength=0;
 	int writeLength=0;
 	const char *packetData=packet.GetPacket();
 	int length=packet.GetPacketByteSize();
-	EP_ASSERT(length<=m_maxPacketSize);
+	EP_ASSERT(length<=GetMaxPacketByteSize());
+	if(length>0 && m_compressor.IsEnabled())
+		return sendCompressed(packet,clientSockAddr,sendStatus);
 
 	int sockAddrSize=sizeof(sockaddr);
 	while(length>0)
@@ -186,6 +242,255 @@ int BaseUdpServer::send(const Packet &packet,const sockaddr &clientSockAddr, uns
 	return sentLength;
 }
 
+int BaseUdpServer::sendCompressed(const Packet &packet,const sockaddr &clientSockAddr,SendStatus *sendStatus)
+{
+	char marker;
+	Packet *compressedPacket=m_compressor.CompressDatagram(packet,marker);
+	const Packet *sendPacket=(compressedPacket)?compressedPacket:&packet;
+
+	// send the marker and the packet together
+	WSABUF wsaBuf[2];
+	wsaBuf[0].buf=&marker;
+	wsaBuf[0].len=UDP_COMPRESSION_HEADER_BYTE_SIZE;
+	wsaBuf[1].buf=const_cast<char*>(sendPacket->GetPacket());
+	wsaBuf[1].len=sendPacket->GetPacketByteSize();
+	DWORD sentLength=0;
+	int iResult=WSASendTo(m_listenSocket,wsaBuf,2,&sentLength,0,&clientSockAddr,sizeof(sockaddr),NULL,NULL);
+	if(compressedPacket)
+		compressedPacket->ReleaseObj();
+	if(iResult==SOCKET_ERROR)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return packet.GetPacketByteSize();
+}
+
+Packet *BaseUdpServer::createReceivedPacket(PacketSlot *slot,const char *packetData,unsigned int byteSize)
+{
+	if(slot)
+		return EP_NEW Packet(slot,static_cast<unsigned int>(packetData-slot->m_buffer),byteSize,m_lockPolicy);
+	return EP_NEW Packet(packetData,byteSize);
+}
+
+int BaseUdpServer::waitForSend(unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+{
+	// sendto on the blocking socket already waits for the buffer infinitely, so select is only for the time-out.
+	if(waitTimeInMilliSec==WAITTIME_INIFINITE)
+		return 1;
+
+	TIMEVAL	timeOutVal;
+	fd_set	fdSet;
+	int		retfdNum = 0;
+
+	FD_ZERO(&fdSet);
+	FD_SET(m_listenSocket, &fdSet);
+	// socket select time out setting
+	timeOutVal.tv_sec = (long)(waitTimeInMilliSec/1000); // Convert to seconds
+	timeOutVal.tv_usec = (long)(waitTimeInMilliSec%1000)*1000; // Convert remainders to micro-seconds
+	// socket select
+	retfdNum = select(0, NULL, &fdSet, NULL, &timeOutVal);
+	if (retfdNum == SOCKET_ERROR)	// select failed
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SOCKET_ERROR;
+		return retfdNum;
+	}
+	else if (retfdNum == 0)		    // select time-out
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_TIME_OUT;
+		return retfdNum;
+	}
+	return retfdNum;
+}
+
+int BaseUdpServer::sendSegments(const Packet &packet,const sockaddr &clientSockAddr,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+{
+	if(segmentByteSize==0 || segmentByteSize>GetMaxPacketByteSize())
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+
+	// as many whole segments as fit in a single datagram of the maximum size are handed at once
+	// the segments split by the network stack cannot carry the marker of the compression
+	unsigned int chunkByteSize=segmentByteSize;
+	if(m_isSendOffloaded && !m_compressor.IsEnabled())
+		chunkByteSize=(m_maxPacketSize/segmentByteSize)*segmentByteSize;
+
+	const char *packetData=packet.GetPacket();
+	unsigned int length=packet.GetPacketByteSize();
+	int writeLength=0;
+	while(length>0)
+	{
+		unsigned int byteSize=length;
+		if(byteSize>chunkByteSize)
+			byteSize=chunkByteSize;
+
+		int sentLength;
+		if(byteSize>segmentByteSize)
+		{
+			sentLength=sendOffloaded(packetData,byteSize,clientSockAddr,segmentByteSize,waitTimeInMilliSec,sendStatus);
+		}
+		else
+		{
+			Packet segment(packetData,byteSize,false);
+			sentLength=send(segment,clientSockAddr,waitTimeInMilliSec,sendStatus);
+		}
+		if(sentLength<=0)
+			return sentLength;
+		writeLength+=sentLength;
+		length-=byteSize;
+		packetData+=byteSize;
+	}
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return writeLength;
+}
+
+int BaseUdpServer::sendOffloaded(const char *packetData,unsigned int byteSize,const sockaddr &clientSockAddr,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+{
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	epl::LockObj lock(m_sendLock);
+
+	// select routine
+	int retfdNum=waitForSend(waitTimeInMilliSec,sendStatus);
+	if(retfdNum<=0)
+		return retfdNum;
+
+	// the segment size goes along with the datagram, and the network stack splits it.
+	ULONG_PTR controlBuffer[(WSA_CMSG_SPACE(sizeof(DWORD))+sizeof(ULONG_PTR)-1)/sizeof(ULONG_PTR)];
+	System::Memset(controlBuffer,0,sizeof(controlBuffer));
+
+	WSABUF wsaBuf;
+	wsaBuf.buf=const_cast<char*>(packetData);
+	wsaBuf.len=byteSize;
+
+	WSAMSG msg;
+	System::Memset(&msg,0,sizeof(WSAMSG));
+	msg.name=const_cast<sockaddr*>(&clientSockAddr);
+	msg.namelen=sizeof(sockaddr);
+	msg.lpBuffers=&wsaBuf;
+	msg.dwBufferCount=1;
+	msg.Control.buf=(char*)controlBuffer;
+	msg.Control.len=WSA_CMSG_SPACE(sizeof(DWORD));
+
+	WSACMSGHDR *cmsg=WSA_CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level=IPPROTO_UDP;
+	cmsg->cmsg_type=UDP_SEND_MSG_SIZE;
+	cmsg->cmsg_len=WSA_CMSG_LEN(sizeof(DWORD));
+	*(DWORD*)WSA_CMSG_DATA(cmsg)=segmentByteSize;
+
+	DWORD sentLength=0;
+	if(WSASendMsg(m_listenSocket,&msg,0,&sentLength,NULL,NULL)==SOCKET_ERROR)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return (int)sentLength;
+#else //defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+	return -1;
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
+}
+
+void BaseUdpServer::deliverPacket(BaseUdpSocket *socket,Packet *packet)
+{
+	// the packet of 0 byte tells the socket the receive failed
+	if(!m_compressor.IsEnabled() || packet->GetPacketByteSize()==0)
+	{
+		deliverDatagram(socket,packet);
+		return;
+	}
+
+	// the marker of the compression is taken off before the sessions
+	Packet *datagram;
+	if(!m_compressor.DecompressDatagram(*packet,GetMaxPacketByteSize(),datagram))
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Dropped the datagram failed to decompress\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return;
+	}
+	deliverDatagram(socket,datagram);
+	datagram->ReleaseObj();
+}
+
+void BaseUdpServer::deliverDatagram(BaseUdpSocket *socket,Packet *packet)
+{
+	ReliableUdpSession *session=socket->m_reliableSession;
+	UdpFragmentSession *fragmentSession=socket->m_fragmentSession;
+	// the packet of 0 byte tells the socket the receive failed
+	if((!session && !fragmentSession) || packet->GetPacketByteSize()==0)
+	{
+		socket->addPacket(packet);
+		return;
+	}
+	if(fragmentSession)
+	{
+		packet=fragmentSession->Receive(*packet);
+		if(!packet)
+			return;
+		if(!session)
+		{
+			socket->addPacket(packet);
+			packet->ReleaseObj();
+			return;
+		}
+		session->Receive(packet->GetPacket(),packet->GetPacketByteSize());
+		packet->ReleaseObj();
+	}
+	else
+	{
+		session->Receive(packet->GetPacket(),packet->GetPacketByteSize());
+	}
+	Packet *receivedPacket;
+	while((receivedPacket=session->PopPacket())!=NULL)
+	{
+		socket->addPacket(receivedPacket);
+		receivedPacket->ReleaseObj();
+	}
+}
+
+void BaseUdpServer::collectSocket(BaseServerObject *obj,unsigned int argCount,va_list args)
+{
+	vector<BaseServerObject*> *socketList=va_arg(args,vector<BaseServerObject*>*);
+	obj->RetainObj();
+	socketList->push_back(obj);
+}
+
+void BaseUdpServer::updateReliableSockets()
+{
+	if(!m_isReliableUdp)
+		return;
+	unsigned int currentTime=GetTickCount();
+	if(currentTime-m_lastReliableUpdateTime<RELIABLE_UDP_TICK_MILLISEC)
+		return;
+	m_lastReliableUpdateTime=currentTime;
+
+	// updated out of the list lock, since the socket not responding removes itself from the list
+	vector<BaseServerObject*> socketList;
+	m_socketList.Do(collectSocket,1,&socketList);
+	vector<BaseServerObject*>::iterator iter;
+	for(iter=socketList.begin();iter!=socketList.end();iter++)
+	{
+		BaseUdpSocket *socket=(BaseUdpSocket*)(*iter);
+		if(!socket->updateReliable())
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Reliable UDP peer not responding...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			socket->KillConnection();
+		}
+		socket->ReleaseObj();
+	}
+}
+
 bool BaseUdpServer::socketCompare(sockaddr const & clientSocket, const BaseServerObject*obj )
 {
 	SocketInterface *workerObj=(SocketInterface*)const_cast<BaseServerObject*>(obj);
@@ -207,6 +512,8 @@ bool BaseUdpServer::StartServer(const ServerOps &ops)
 
 	if(ops.callBackObj)
 		m_callBackObj=ops.callBackObj;
+	m_messageDispatcher=ops.messageDispatcher;
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
 	EP_ASSERT(m_callBackObj);
 
 	if(ops.port)
@@ -221,6 +528,10 @@ bool BaseUdpServer::StartServer(const ServerOps &ops)
 
 	SetWaitTime(ops.waitTimeMilliSec);
 	m_maxConnectionCount=ops.maximumConnectionCount;
+	m_isSegmentationOffload=ops.isSegmentationOffload;
+	m_isReliableUdp=ops.isReliableUdp;
+	m_isFragmentedUdp=ops.isFragmentedUdp;
+	m_lastReliableUpdateTime=GetTickCount();
 
 	WSADATA wsaData;
 	int iResult;
@@ -279,6 +590,33 @@ bool BaseUdpServer::StartServer(const ServerOps &ops)
 	int nTmp = sizeof(int);
 	getsockopt(m_listenSocket, SOL_SOCKET,SO_MAX_MSG_SIZE, (char *)&m_maxPacketSize,&nTmp);
 
+	m_isSendOffloaded=false;
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	if(m_isSegmentationOffload)
+	{
+		// the option is only known to the network stack supporting UDP Send Offload
+		DWORD segmentByteSize=0;
+		nTmp = sizeof(DWORD);
+		if(getsockopt(m_listenSocket, IPPROTO_UDP,UDP_SEND_MSG_SIZE, (char *)&segmentByteSize,&nTmp)!=SOCKET_ERROR)
+			m_isSendOffloaded=true;
+		else
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) UDP Send Offload not supported\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+	}
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
+
+	if(m_isReliableUdp)
+	{
+		// the blocking receive wakes up periodically to retransmit
+		DWORD receiveTimeout=RELIABLE_UDP_TICK_MILLISEC;
+		setsockopt(m_listenSocket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<char*>(&receiveTimeout), sizeof(DWORD));
+	}
+
+	if(m_receiveSlab)
+		m_receiveSlab->ReleaseObj();
+	m_receiveSlab=NULL;
+	if(ops.receiveSlabSlotCount>0)
+		m_receiveSlab=EP_NEW PacketSlab(ops.receiveSlabSlotCount,m_maxPacketSize,m_lockPolicy);
+
 	// Create thread 1.
 	if(Start())
 	{
@@ -316,6 +654,12 @@ void BaseUdpServer::StopServer()
 void BaseUdpServer::cleanUpServer()
 {
 	BaseServer::cleanUpServer();
+	clearPendingSend();
 	m_maxPacketSize=0;
+	m_isSendOffloaded=false;
+	// the slab is deleted when the last packet received is released
+	if(m_receiveSlab)
+		m_receiveSlab->ReleaseObj();
+	m_receiveSlab=NULL;
 }
 
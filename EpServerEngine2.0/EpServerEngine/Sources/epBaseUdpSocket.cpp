@@ -52,7 +52,8 @@ BaseUdpSocket::BaseUdpSocket(ServerCallbackInterface *callBackObj,unsigned int w
 		break;
 	}
 	m_maxPacketSize=0;
-
+	m_reliableSession=NULL;
+	m_fragmentSession=NULL;
 }
 
 BaseUdpSocket::~BaseUdpSocket()
@@ -72,19 +73,128 @@ BaseUdpSocket::~BaseUdpSocket()
 	if(m_listLock)
 		EP_DELETE m_listLock;
 	m_listLock=NULL;
+
+	if(m_reliableSession)
+		EP_DELETE m_reliableSession;
+	m_reliableSession=NULL;
+	if(m_fragmentSession)
+		EP_DELETE m_fragmentSession;
+	m_fragmentSession=NULL;
 }
 
 void BaseUdpSocket::setMaxPacketByteSize(unsigned int maxPacketSize)
 {
 	m_maxPacketSize=maxPacketSize;
+	if(m_fragmentSession)
+		m_fragmentSession->SetMaxDatagramByteSize(maxPacketSize);
+	else if(m_reliableSession)
+		m_reliableSession->SetMaxDatagramByteSize(maxPacketSize);
+}
+
+void BaseUdpSocket::setUpSessions(bool isReliable,bool isFragmented)
+{
+	epl::LockObj lock(m_baseSocketLock);
+	// the Reliable UDP Session is bound to the sender below it
+	if(m_reliableSession && (!isReliable || isFragmented!=(m_fragmentSession!=NULL)))
+	{
+		EP_DELETE m_reliableSession;
+		m_reliableSession=NULL;
+	}
+	if(isFragmented && !m_fragmentSession)
+	{
+		m_fragmentSession=EP_NEW UdpFragmentSession(this,m_maxPacketSize,m_lockPolicy);
+	}
+	else if(!isFragmented && m_fragmentSession)
+	{
+		EP_DELETE m_fragmentSession;
+		m_fragmentSession=NULL;
+	}
+	if(isReliable && !m_reliableSession)
+	{
+		if(m_fragmentSession)
+			m_reliableSession=EP_NEW ReliableUdpSession(m_fragmentSession,UDP_FRAGMENT_MESSAGE_BYTE_SIZE_MAX,m_lockPolicy);
+		else
+			m_reliableSession=EP_NEW ReliableUdpSession(this,m_maxPacketSize,m_lockPolicy);
+	}
+}
+
+bool BaseUdpSocket::updateReliable()
+{
+	if(!m_reliableSession)
+		return true;
+	return m_reliableSession->Update();
+}
+
+void BaseUdpSocket::resetConnection()
+{
+	BaseSocket::resetConnection();
+	if(m_reliableSession)
+		m_reliableSession->Reset();
+	if(m_fragmentSession)
+		m_fragmentSession->Reset();
+}
+
+unsigned int BaseUdpSocket::GetRoundTripTime() const
+{
+	if(!m_reliableSession)
+		return 0;
+	return m_reliableSession->GetRoundTripTime();
 }
 
-int BaseUdpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int BaseUdpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_baseSocketLock);
-	EP_ASSERT(packet.GetPacketByteSize()<=m_maxPacketSize);
+	// every datagram carries the header of the channel with the reliable UDP
+	if(m_reliableSession)
+		return m_reliableSession->Send(packet,UDP_CHANNEL_UNRELIABLE,sendStatus);
+	if(m_fragmentSession)
+		return m_fragmentSession->SendDatagram(packet,sendStatus);
+	if(packet.GetPacketByteSize()>m_maxPacketSize)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
 	if(m_owner)
+	{
+		if(isMoreComing)
+			return ((BaseUdpServer*)m_owner)->queueSend(packet,m_sockAddr,waitTimeInMilliSec,sendStatus);
 		return ((BaseUdpServer*)m_owner)->send(packet,m_sockAddr,waitTimeInMilliSec,sendStatus);
+	}
+	return 0;
+}
+
+int BaseUdpSocket::Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus)
+{
+	epl::LockObj lock(m_baseSocketLock);
+	if(!m_reliableSession)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+		return -1;
+	}
+	return m_reliableSession->Send(packet,channel,sendStatus);
+}
+
+int BaseUdpSocket::SendDatagram(const Packet &datagram,SendStatus *sendStatus)
+{
+	if(m_owner)
+		return ((BaseUdpServer*)m_owner)->send(datagram,m_sockAddr,WAITTIME_INIFINITE,sendStatus);
+	return 0;
+}
+
+int BaseUdpSocket::SendSegments(const Packet &packet,unsigned int segmentByteSize, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+{
+	epl::LockObj lock(m_baseSocketLock);
+	// the segments cannot carry the header of the channel or the fragment
+	if(m_reliableSession || m_fragmentSession)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_SUPPORTED;
+		return -1;
+	}
+	if(m_owner)
+		return ((BaseUdpServer*)m_owner)->sendSegments(packet,m_sockAddr,segmentByteSize,waitTimeInMilliSec,sendStatus);
 	return 0;
 }
 
@@ -0,0 +1,368 @@
+/*! 
+BufferPool for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epBufferPool.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+BufferPool BufferPool::defaultBufferPool;
+
+BufferPool::BufferPool()
+{
+	switch(epl::EP_LOCK_POLICY)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_depotLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_depotLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_depotLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_depotLock=NULL;
+		break;
+	}
+#if (WINVER>=WINDOWS_VISTA)
+	// the fiber local storage calls back as the thread exits, so the cache is never left behind
+	m_tlsIdx=FlsAlloc(onThreadExit);
+	EP_ASSERT(m_tlsIdx!=FLS_OUT_OF_INDEXES);
+#else //(WINVER>=WINDOWS_VISTA)
+	m_tlsIdx=TlsAlloc();
+	EP_ASSERT(m_tlsIdx!=TLS_OUT_OF_INDEXES);
+#endif //(WINVER>=WINDOWS_VISTA)
+	for(unsigned int classIdx=0;classIdx<BUFFER_POOL_CLASS_COUNT;classIdx++)
+	{
+		m_depotList[classIdx]=NULL;
+		m_depotCount[classIdx]=0;
+	}
+	m_reservedByteSize=0;
+	m_releasedHitCount=0;
+	m_releasedMissCount=0;
+	m_releasedOutstandingByteSize=0;
+	m_isLargePage=false;
+}
+
+BufferPool::~BufferPool()
+{
+#if (WINVER>=WINDOWS_VISTA)
+	// the caches still attached are released by the callback, so the lock is not held yet
+	FlsFree(m_tlsIdx);
+#endif //(WINVER>=WINDOWS_VISTA)
+	m_depotLock->Lock();
+	vector<ThreadCache*>::iterator cacheIter;
+	for(cacheIter=m_cacheList.begin();cacheIter!=m_cacheList.end();cacheIter++)
+	{
+		EP_DELETE *cacheIter;
+	}
+	m_cacheList.clear();
+	vector<void*>::iterator chunkIter;
+	for(chunkIter=m_chunkList.begin();chunkIter!=m_chunkList.end();chunkIter++)
+	{
+		VirtualFree(*chunkIter,0,MEM_RELEASE);
+	}
+	m_chunkList.clear();
+	m_depotLock->Unlock();
+#if !(WINVER>=WINDOWS_VISTA)
+	TlsFree(m_tlsIdx);
+#endif //!(WINVER>=WINDOWS_VISTA)
+
+	if(m_depotLock)
+		EP_DELETE m_depotLock;
+	m_depotLock=NULL;
+}
+
+unsigned int BufferPool::getClassIdx(unsigned int byteSize)
+{
+	unsigned int classIdx=0;
+	unsigned int classByteSize=BUFFER_POOL_CLASS_BYTE_SIZE_MIN;
+	while(classByteSize<byteSize)
+	{
+		if(++classIdx==BUFFER_POOL_CLASS_COUNT)
+			return BUFFER_POOL_CLASS_HEAP;
+		classByteSize<<=1;
+	}
+	return classIdx;
+}
+
+unsigned int BufferPool::getClassByteSize(unsigned int classIdx)
+{
+	return BUFFER_POOL_CLASS_BYTE_SIZE_MIN<<classIdx;
+}
+
+BufferPool::ThreadCache *BufferPool::getThreadCache()
+{
+#if (WINVER>=WINDOWS_VISTA)
+	ThreadCache *cache=reinterpret_cast<ThreadCache*>(FlsGetValue(m_tlsIdx));
+#else //(WINVER>=WINDOWS_VISTA)
+	ThreadCache *cache=reinterpret_cast<ThreadCache*>(TlsGetValue(m_tlsIdx));
+#endif //(WINVER>=WINDOWS_VISTA)
+	if(cache)
+		return cache;
+	cache=EP_NEW ThreadCache();
+	epl::System::Memset(cache,0,sizeof(ThreadCache));
+	cache->m_pool=this;
+#if (WINVER>=WINDOWS_VISTA)
+	FlsSetValue(m_tlsIdx,cache);
+#else //(WINVER>=WINDOWS_VISTA)
+	TlsSetValue(m_tlsIdx,cache);
+#endif //(WINVER>=WINDOWS_VISTA)
+	epl::LockObj lock(m_depotLock);
+	m_cacheList.push_back(cache);
+	return cache;
+}
+
+void *BufferPool::Allocate(unsigned int byteSize)
+{
+	ThreadCache *cache=getThreadCache();
+	unsigned int classIdx=getClassIdx(byteSize);
+	BufferHeader *header;
+	if(classIdx==BUFFER_POOL_CLASS_HEAP)
+	{
+		header=reinterpret_cast<BufferHeader*>(EP_Malloc(BUFFER_POOL_HEADER_BYTE_SIZE+byteSize));
+		EP_ASSERT(header);
+		header->m_classIdx=BUFFER_POOL_CLASS_HEAP;
+		header->m_byteSize=byteSize;
+		cache->m_missCount++;
+		cache->m_outstandingByteSize+=byteSize;
+		return reinterpret_cast<char*>(header)+BUFFER_POOL_HEADER_BYTE_SIZE;
+	}
+
+	if(cache->m_freeList[classIdx])
+		cache->m_hitCount++;
+	else if(refillCache(cache,classIdx))
+		cache->m_hitCount++;
+	else
+		cache->m_missCount++;
+	header=cache->m_freeList[classIdx];
+	cache->m_freeList[classIdx]=header->m_next;
+	cache->m_freeCount[classIdx]--;
+	cache->m_outstandingByteSize+=getClassByteSize(classIdx);
+	return reinterpret_cast<char*>(header)+BUFFER_POOL_HEADER_BYTE_SIZE;
+}
+
+void BufferPool::Free(void *buffer)
+{
+	if(!buffer)
+		return;
+	ThreadCache *cache=getThreadCache();
+	BufferHeader *header=reinterpret_cast<BufferHeader*>(reinterpret_cast<char*>(buffer)-BUFFER_POOL_HEADER_BYTE_SIZE);
+	unsigned int classIdx=header->m_classIdx;
+	if(classIdx==BUFFER_POOL_CLASS_HEAP)
+	{
+		cache->m_outstandingByteSize-=header->m_byteSize;
+		EP_Free(header);
+		return;
+	}
+
+	header->m_next=cache->m_freeList[classIdx];
+	cache->m_freeList[classIdx]=header;
+	cache->m_freeCount[classIdx]++;
+	cache->m_outstandingByteSize-=getClassByteSize(classIdx);
+	// keeps a batch to serve the next allocations
+	if(cache->m_freeCount[classIdx]>=BUFFER_POOL_BATCH_COUNT*2)
+		returnCache(cache,classIdx,BUFFER_POOL_BATCH_COUNT);
+}
+
+void *BufferPool::Reallocate(void *buffer,unsigned int byteSize)
+{
+	if(!buffer)
+		return Allocate(byteSize);
+	BufferHeader *header=reinterpret_cast<BufferHeader*>(reinterpret_cast<char*>(buffer)-BUFFER_POOL_HEADER_BYTE_SIZE);
+	unsigned int prevByteSize;
+	if(header->m_classIdx==BUFFER_POOL_CLASS_HEAP)
+		prevByteSize=header->m_byteSize;
+	else
+		prevByteSize=getClassByteSize(header->m_classIdx);
+	// still fits in the size class
+	if(header->m_classIdx!=BUFFER_POOL_CLASS_HEAP && byteSize<=prevByteSize)
+		return buffer;
+
+	void *newBuffer=Allocate(byteSize);
+	epl::System::Memcpy(newBuffer,buffer,(prevByteSize<byteSize)?prevByteSize:byteSize);
+	Free(buffer);
+	return newBuffer;
+}
+
+bool BufferPool::refillCache(ThreadCache *cache,unsigned int classIdx)
+{
+	epl::LockObj lock(m_depotLock);
+	bool isReused=(m_depotList[classIdx]!=NULL);
+	if(!isReused)
+		carveChunk(classIdx);
+	unsigned int count=0;
+	while(m_depotList[classIdx] && count<BUFFER_POOL_BATCH_COUNT)
+	{
+		BufferHeader *header=m_depotList[classIdx];
+		m_depotList[classIdx]=header->m_next;
+		header->m_next=cache->m_freeList[classIdx];
+		cache->m_freeList[classIdx]=header;
+		count++;
+	}
+	m_depotCount[classIdx]-=count;
+	cache->m_freeCount[classIdx]+=count;
+	return isReused;
+}
+
+void BufferPool::returnCache(ThreadCache *cache,unsigned int classIdx,unsigned int count)
+{
+	// detached from the cache first to hold the lock only for the splice
+	BufferHeader *first=cache->m_freeList[classIdx];
+	BufferHeader *last=first;
+	unsigned int returnCount=1;
+	while(returnCount<count && last->m_next)
+	{
+		last=last->m_next;
+		returnCount++;
+	}
+	cache->m_freeList[classIdx]=last->m_next;
+	cache->m_freeCount[classIdx]-=returnCount;
+
+	epl::LockObj lock(m_depotLock);
+	last->m_next=m_depotList[classIdx];
+	m_depotList[classIdx]=first;
+	m_depotCount[classIdx]+=returnCount;
+}
+
+void BufferPool::FlushThreadCache()
+{
+#if (WINVER>=WINDOWS_VISTA)
+	ThreadCache *cache=reinterpret_cast<ThreadCache*>(FlsGetValue(m_tlsIdx));
+	if(!cache)
+		return;
+	// cleared first, so the callback is not called again as the thread exits
+	FlsSetValue(m_tlsIdx,NULL);
+#else //(WINVER>=WINDOWS_VISTA)
+	ThreadCache *cache=reinterpret_cast<ThreadCache*>(TlsGetValue(m_tlsIdx));
+	if(!cache)
+		return;
+	TlsSetValue(m_tlsIdx,NULL);
+#endif //(WINVER>=WINDOWS_VISTA)
+	releaseCache(cache);
+}
+
+#if (WINVER>=WINDOWS_VISTA)
+void WINAPI BufferPool::onThreadExit(void *cache)
+{
+	ThreadCache *threadCache=reinterpret_cast<ThreadCache*>(cache);
+	threadCache->m_pool->releaseCache(threadCache);
+}
+#endif //(WINVER>=WINDOWS_VISTA)
+
+void BufferPool::releaseCache(ThreadCache *cache)
+{
+	for(unsigned int classIdx=0;classIdx<BUFFER_POOL_CLASS_COUNT;classIdx++)
+	{
+		if(cache->m_freeCount[classIdx])
+			returnCache(cache,classIdx,cache->m_freeCount[classIdx]);
+	}
+
+	// the statistics of the thread are kept in the pool
+	epl::LockObj lock(m_depotLock);
+	m_releasedHitCount+=cache->m_hitCount;
+	m_releasedMissCount+=cache->m_missCount;
+	m_releasedOutstandingByteSize+=cache->m_outstandingByteSize;
+	vector<ThreadCache*>::iterator iter;
+	for(iter=m_cacheList.begin();iter!=m_cacheList.end();iter++)
+	{
+		if(*iter==cache)
+		{
+			m_cacheList.erase(iter);
+			break;
+		}
+	}
+	EP_DELETE cache;
+}
+
+void BufferPool::carveChunk(unsigned int classIdx)
+{
+	unsigned int strideByteSize=BUFFER_POOL_HEADER_BYTE_SIZE+getClassByteSize(classIdx);
+	SIZE_T chunkByteSize=BUFFER_POOL_CHUNK_BYTE_SIZE;
+	if(chunkByteSize<strideByteSize)
+		chunkByteSize=strideByteSize;
+
+	char *chunk=NULL;
+#if (WINVER>=WINDOWS_VISTA)
+	if(m_isLargePage)
+	{
+		SIZE_T largePageByteSize=GetLargePageMinimum();
+		if(largePageByteSize)
+		{
+			SIZE_T largeChunkByteSize=(chunkByteSize+largePageByteSize-1)/largePageByteSize*largePageByteSize;
+			chunk=reinterpret_cast<char*>(VirtualAlloc(NULL,largeChunkByteSize,MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES,PAGE_READWRITE));
+			if(chunk)
+				chunkByteSize=largeChunkByteSize;
+		}
+	}
+#endif //(WINVER>=WINDOWS_VISTA)
+	if(!chunk)
+		chunk=reinterpret_cast<char*>(VirtualAlloc(NULL,chunkByteSize,MEM_RESERVE|MEM_COMMIT,PAGE_READWRITE));
+	EP_ASSERT(chunk);
+	m_chunkList.push_back(chunk);
+	m_reservedByteSize+=chunkByteSize;
+
+	unsigned int bufferCount=static_cast<unsigned int>(chunkByteSize/strideByteSize);
+	for(unsigned int bufferIdx=0;bufferIdx<bufferCount;bufferIdx++)
+	{
+		BufferHeader *header=reinterpret_cast<BufferHeader*>(chunk+bufferIdx*strideByteSize);
+		header->m_classIdx=classIdx;
+		header->m_byteSize=0;
+		header->m_next=m_depotList[classIdx];
+		m_depotList[classIdx]=header;
+	}
+	m_depotCount[classIdx]+=bufferCount;
+}
+
+void BufferPool::SetLargePage(bool isLargePage)
+{
+	epl::LockObj lock(m_depotLock);
+	m_isLargePage=isLargePage;
+}
+
+BufferPool::Statistics BufferPool::GetStatistics() const
+{
+	Statistics statistics;
+	epl::LockObj lock(m_depotLock);
+	statistics.hitCount=m_releasedHitCount;
+	statistics.missCount=m_releasedMissCount;
+	statistics.outstandingByteSize=m_releasedOutstandingByteSize;
+	vector<ThreadCache*>::const_iterator iter;
+	for(iter=m_cacheList.begin();iter!=m_cacheList.end();iter++)
+	{
+		statistics.hitCount+=(*iter)->m_hitCount;
+		statistics.missCount+=(*iter)->m_missCount;
+		statistics.outstandingByteSize+=(*iter)->m_outstandingByteSize;
+	}
+	statistics.reservedByteSize=m_reservedByteSize;
+	return statistics;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*! 
+ByteSwapper for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epByteSwapper.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#define EP_BYTE_SWAPPER_SSE2
+#include <emmintrin.h>
+#endif //defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+#if defined(EP_BYTE_SWAPPER_SSE2)
+/*!
+Reverse the bytes of each 16-bit lane
+@param[in] value the lanes to reverse
+@return the lanes reversed
+*/
+static __m128i swapLane16(__m128i value)
+{
+	return _mm_or_si128(_mm_slli_epi16(value,8),_mm_srli_epi16(value,8));
+}
+#endif //defined(EP_BYTE_SWAPPER_SSE2)
+
+bool ByteSwapper::IsHostByteOrder(ByteOrder byteOrder)
+{
+	const unsigned short probe=1;
+	bool isHostLittleEndian=(*reinterpret_cast<const unsigned char*>(&probe)==1);
+	return isHostLittleEndian==(byteOrder==BYTE_ORDER_LITTLE_ENDIAN);
+}
+
+void ByteSwapper::SwapCopy16(void *retDst,const void *src,size_t count)
+{
+	unsigned char *dst=reinterpret_cast<unsigned char*>(retDst);
+	const unsigned char *from=reinterpret_cast<const unsigned char*>(src);
+	size_t idx=0;
+#if defined(EP_BYTE_SWAPPER_SSE2)
+	for(;idx+8<=count;idx+=8)
+	{
+		__m128i value=_mm_loadu_si128(reinterpret_cast<const __m128i*>(from+idx*2));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst+idx*2),swapLane16(value));
+	}
+#endif //defined(EP_BYTE_SWAPPER_SSE2)
+	for(;idx<count;idx++)
+	{
+		dst[idx*2]=from[idx*2+1];
+		dst[idx*2+1]=from[idx*2];
+	}
+}
+
+void ByteSwapper::SwapCopy32(void *retDst,const void *src,size_t count)
+{
+	unsigned char *dst=reinterpret_cast<unsigned char*>(retDst);
+	const unsigned char *from=reinterpret_cast<const unsigned char*>(src);
+	size_t idx=0;
+#if defined(EP_BYTE_SWAPPER_SSE2)
+	for(;idx+4<=count;idx+=4)
+	{
+		__m128i value=_mm_loadu_si128(reinterpret_cast<const __m128i*>(from+idx*4));
+		// swap the 16-bit halves, then the bytes in each half
+		value=_mm_shufflelo_epi16(value,_MM_SHUFFLE(2,3,0,1));
+		value=_mm_shufflehi_epi16(value,_MM_SHUFFLE(2,3,0,1));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst+idx*4),swapLane16(value));
+	}
+#endif //defined(EP_BYTE_SWAPPER_SSE2)
+	for(;idx<count;idx++)
+	{
+		for(size_t byteIdx=0;byteIdx<4;byteIdx++)
+			dst[idx*4+byteIdx]=from[idx*4+3-byteIdx];
+	}
+}
+
+void ByteSwapper::SwapCopy64(void *retDst,const void *src,size_t count)
+{
+	unsigned char *dst=reinterpret_cast<unsigned char*>(retDst);
+	const unsigned char *from=reinterpret_cast<const unsigned char*>(src);
+	size_t idx=0;
+#if defined(EP_BYTE_SWAPPER_SSE2)
+	for(;idx+2<=count;idx+=2)
+	{
+		__m128i value=_mm_loadu_si128(reinterpret_cast<const __m128i*>(from+idx*8));
+		// reverse the 16-bit quarters, then the bytes in each quarter
+		value=_mm_shufflelo_epi16(value,_MM_SHUFFLE(0,1,2,3));
+		value=_mm_shufflehi_epi16(value,_MM_SHUFFLE(0,1,2,3));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst+idx*8),swapLane16(value));
+	}
+#endif //defined(EP_BYTE_SWAPPER_SSE2)
+	for(;idx<count;idx++)
+	{
+		for(size_t byteIdx=0;byteIdx<8;byteIdx++)
+			dst[idx*8+byteIdx]=from[idx*8+7-byteIdx];
+	}
+}
+
+void ByteSwapper::Copy(void *retDst,const void *src,size_t elementByteSize,size_t count,bool shouldSwap)
+{
+	if(count==0)
+		return;
+	if(!shouldSwap || elementByteSize==1)
+	{
+		epl::System::Memcpy(retDst,src,elementByteSize*count);
+		return;
+	}
+	switch(elementByteSize)
+	{
+	case 2:
+		SwapCopy16(retDst,src,count);
+		break;
+	case 4:
+		SwapCopy32(retDst,src,count);
+		break;
+	case 8:
+		SwapCopy64(retDst,src,count);
+		break;
+	default:
+		EP_ASSERT_EXPR(0,_T("Byte size of the value not supported: %d"),static_cast<int>(elementByteSize));
+		break;
+	}
+}
\ No newline at end of file
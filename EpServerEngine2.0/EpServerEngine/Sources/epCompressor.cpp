@@ -0,0 +1,258 @@
+/*! 
+Compressor for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epCompressor.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+/*!
+Convert the ticks of the performance counter into microseconds
+@param[in] tick the ticks to convert
+@param[in] frequency the frequency of the performance counter
+@return the microseconds
+*/
+static unsigned __int64 convertTickToMicroSec(LONGLONG tick,LONGLONG frequency)
+{
+	unsigned __int64 tickCount=static_cast<unsigned __int64>(tick);
+	unsigned __int64 tickPerSec=static_cast<unsigned __int64>(frequency);
+	// divided first not to overflow
+	return (tickCount/tickPerSec)*1000000+(tickCount%tickPerSec)*1000000/tickPerSec;
+}
+
+Compressor::Compressor(epl::LockPolicy lockPolicyType)
+{
+	m_lockPolicy=lockPolicyType;
+	switch(m_lockPolicy)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_lock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_lock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_lock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_lock=NULL;
+		break;
+	}
+	m_threshold=COMPRESSION_THRESHOLD_NONE;
+	ResetStatistics();
+}
+
+Compressor::Compressor(const Compressor& b)
+{
+	m_lockPolicy=b.m_lockPolicy;
+	switch(m_lockPolicy)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_lock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_lock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_lock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_lock=NULL;
+		break;
+	}
+	m_codec=b.m_codec;
+	m_threshold=b.m_threshold;
+	ResetStatistics();
+}
+
+Compressor::~Compressor()
+{
+	if(m_lock)
+		EP_DELETE m_lock;
+	m_lock=NULL;
+}
+
+Compressor & Compressor::operator=(const Compressor&b)
+{
+	if(this!=&b)
+	{
+		m_codec=b.m_codec;
+		m_threshold=b.m_threshold;
+		ResetStatistics();
+	}
+	return *this;
+}
+
+void Compressor::Configure(unsigned int threshold,const void *dictionary,unsigned int dictionaryByteSize)
+{
+	m_threshold=threshold;
+	m_codec.SetDictionary(dictionary,dictionaryByteSize);
+}
+
+bool Compressor::IsEnabled() const
+{
+	return (m_threshold!=COMPRESSION_THRESHOLD_NONE);
+}
+
+unsigned int Compressor::GetDictionaryId() const
+{
+	return m_codec.GetDictionaryId();
+}
+
+LONGLONG Compressor::getTick()
+{
+	LARGE_INTEGER tick;
+	QueryPerformanceCounter(&tick);
+	return tick.QuadPart;
+}
+
+Packet *Compressor::Compress(const char *data,unsigned int byteSize,bool useDictionary)
+{
+	if(m_threshold==COMPRESSION_THRESHOLD_NONE || byteSize<m_threshold || byteSize<=COMPRESSED_HEADER_BYTE_SIZE+1)
+		return NULL;
+
+	LONGLONG startTick=getTick();
+	// only the result smaller than the data is worth sending
+	unsigned int blockByteSizeMax=byteSize-1-COMPRESSED_HEADER_BYTE_SIZE;
+	Packet *compressedPacket=EP_NEW Packet(NULL,byteSize-1);
+	char *compressed=const_cast<char*>(compressedPacket->GetPacket());
+	epl::System::Memcpy(compressed,&byteSize,sizeof(unsigned int));
+	unsigned int blockByteSize=m_codec.Compress(data,byteSize,compressed+COMPRESSED_HEADER_BYTE_SIZE,blockByteSizeMax,useDictionary);
+	if(!blockByteSize)
+	{
+		compressedPacket->ReleaseObj();
+		epl::LockObj lock(m_lock);
+		m_compressTick+=getTick()-startTick;
+		return NULL;
+	}
+	compressedPacket->PullTrailer(blockByteSizeMax-blockByteSize);
+
+	LONGLONG compressTick=getTick()-startTick;
+	epl::LockObj lock(m_lock);
+	m_compressTick+=compressTick;
+	m_compressedPacketCount++;
+	m_rawByteSize+=byteSize;
+	m_compressedByteSize+=compressedPacket->GetPacketByteSize();
+	return compressedPacket;
+}
+
+Packet *Compressor::Decompress(const char *data,unsigned int byteSize,bool useDictionary,unsigned int maxByteSize)
+{
+	if(byteSize<=COMPRESSED_HEADER_BYTE_SIZE)
+		return NULL;
+	unsigned int originalByteSize;
+	epl::System::Memcpy(&originalByteSize,data,sizeof(unsigned int));
+	// the block cannot expand beyond the ratio, so the size corrupted is not allocated
+	unsigned int blockByteSize=byteSize-COMPRESSED_HEADER_BYTE_SIZE;
+	if(originalByteSize==0 || originalByteSize/COMPRESSED_RATIO_MAX>blockByteSize)
+		return NULL;
+	if(maxByteSize!=FRAME_BYTE_SIZE_UNLIMITED && originalByteSize>maxByteSize)
+		return NULL;
+
+	LONGLONG startTick=getTick();
+	Packet *packet=EP_NEW Packet(NULL,originalByteSize);
+	bool isDecompressed=m_codec.Decompress(data+COMPRESSED_HEADER_BYTE_SIZE,blockByteSize,const_cast<char*>(packet->GetPacket()),originalByteSize,useDictionary);
+	LONGLONG decompressTick=getTick()-startTick;
+	epl::LockObj lock(m_lock);
+	m_decompressTick+=decompressTick;
+	if(!isDecompressed)
+	{
+		packet->ReleaseObj();
+		return NULL;
+	}
+	m_decompressedPacketCount++;
+	return packet;
+}
+
+Packet *Compressor::CompressDatagram(const Packet &packet,char &retMarker)
+{
+	// the datagram refers to the dictionary whenever there is one, since both ends are configured the same
+	bool useDictionary=(m_codec.GetDictionaryId()!=0);
+	Packet *compressedPacket=Compress(packet.GetPacket(),packet.GetPacketByteSize(),useDictionary);
+	if(!compressedPacket)
+		retMarker=DATAGRAM_MARKER_RAW;
+	else if(useDictionary)
+		retMarker=DATAGRAM_MARKER_DICTIONARY;
+	else
+		retMarker=DATAGRAM_MARKER_COMPRESSED;
+	return compressedPacket;
+}
+
+bool Compressor::DecompressDatagram(const Packet &datagram,unsigned int maxByteSize,Packet *&retPacket)
+{
+	retPacket=NULL;
+	unsigned int byteSize=datagram.GetPacketByteSize();
+	if(byteSize<=UDP_COMPRESSION_HEADER_BYTE_SIZE)
+		return false;
+	const char *data=datagram.GetPacket();
+	switch(data[0])
+	{
+	case DATAGRAM_MARKER_RAW:
+		retPacket=EP_NEW Packet(datagram,UDP_COMPRESSION_HEADER_BYTE_SIZE,byteSize-UDP_COMPRESSION_HEADER_BYTE_SIZE);
+		break;
+	case DATAGRAM_MARKER_COMPRESSED:
+		retPacket=Decompress(data+UDP_COMPRESSION_HEADER_BYTE_SIZE,byteSize-UDP_COMPRESSION_HEADER_BYTE_SIZE,false,maxByteSize);
+		break;
+	case DATAGRAM_MARKER_DICTIONARY:
+		retPacket=Decompress(data+UDP_COMPRESSION_HEADER_BYTE_SIZE,byteSize-UDP_COMPRESSION_HEADER_BYTE_SIZE,true,maxByteSize);
+		break;
+	default:
+		break;
+	}
+	return (retPacket!=NULL);
+}
+
+Compressor::Statistics Compressor::GetStatistics() const
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	Statistics statistics;
+	epl::LockObj lock(m_lock);
+	statistics.compressedPacketCount=m_compressedPacketCount;
+	statistics.rawByteSize=m_rawByteSize;
+	statistics.compressedByteSize=m_compressedByteSize;
+	statistics.compressMicroSec=convertTickToMicroSec(m_compressTick,frequency.QuadPart);
+	statistics.decompressedPacketCount=m_decompressedPacketCount;
+	statistics.decompressMicroSec=convertTickToMicroSec(m_decompressTick,frequency.QuadPart);
+	return statistics;
+}
+
+void Compressor::ResetStatistics()
+{
+	epl::LockObj lock(m_lock);
+	m_compressedPacketCount=0;
+	m_rawByteSize=0;
+	m_compressedByteSize=0;
+	m_compressTick=0;
+	m_decompressedPacketCount=0;
+	m_decompressTick=0;
+}
\ No newline at end of file
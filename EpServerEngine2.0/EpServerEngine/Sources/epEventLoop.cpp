@@ -0,0 +1,337 @@
+/*! 
+EventLoop for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epEventLoop.h"
+#include "epBufferPool.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+EventLoop::EventLoop(unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType):epl::Thread(EP_THREAD_PRIORITY_NORMAL,lockPolicyType)
+{
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_loopLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_loopLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_loopLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_loopLock=NULL;
+		break;
+	}
+	m_waitTime=waitTimeMilliSec;
+	m_completionPort=NULL;
+	m_isStopping=false;
+	m_pendingIoCount=0;
+	m_cachedTime=GetTickCount();
+	m_elapsedMilliSec=0;
+}
+
+EventLoop::~EventLoop()
+{
+	StopLoop();
+	if(m_loopLock)
+		EP_DELETE m_loopLock;
+	m_loopLock=NULL;
+}
+
+void EventLoop::SetWaitTime(unsigned int milliSec)
+{
+	epl::LockObj lock(m_loopLock);
+	m_waitTime=milliSec;
+}
+
+unsigned int EventLoop::GetWaitTime() const
+{
+	epl::LockObj lock(m_loopLock);
+	return m_waitTime;
+}
+
+bool EventLoop::IsLoopStarted() const
+{
+	epl::LockObj lock(m_loopLock);
+	return (m_completionPort!=NULL);
+}
+
+unsigned int EventLoop::GetLoopThreadId() const
+{
+	return GetID();
+}
+
+bool EventLoop::StartLoop()
+{
+	epl::LockObj lock(m_loopLock);
+	if(m_completionPort)
+		return true;
+
+	m_completionPort=CreateIoCompletionPort(INVALID_HANDLE_VALUE,NULL,0,1);
+	if(!m_completionPort)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) CreateIoCompletionPort failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return false;
+	}
+	m_cachedTime=GetTickCount();
+	m_elapsedMilliSec=0;
+	if(Start())
+	{
+		return true;
+	}
+	CloseHandle(m_completionPort);
+	m_completionPort=NULL;
+	return false;
+}
+
+void EventLoop::StopLoop()
+{
+	m_loopLock->Lock();
+	if(!m_completionPort || m_isStopping)
+	{
+		m_loopLock->Unlock();
+		return;
+	}
+	m_isStopping=true;
+	HANDLE completionPort=m_completionPort;
+	unsigned int waitTime=m_waitTime;
+	bool isPosted=(PostQueuedCompletionStatus(completionPort,0,EVENT_LOOP_KEY_STOP,NULL)!=FALSE);
+	// the callbacks may post while the thread terminates
+	m_loopLock->Unlock();
+
+	if(isPosted)
+		TerminateAfter(waitTime);
+	else
+		TerminateAfter(0);
+
+	m_loopLock->Lock();
+	CloseHandle(completionPort);
+	m_completionPort=NULL;
+	m_isStopping=false;
+	m_loopLock->Unlock();
+}
+
+bool EventLoop::Register(SOCKET socket)
+{
+	epl::LockObj lock(m_loopLock);
+	if(!m_completionPort || m_isStopping || socket==INVALID_SOCKET)
+		return false;
+	if(CreateIoCompletionPort(reinterpret_cast<HANDLE>(socket),m_completionPort,EVENT_LOOP_KEY_DEFAULT,0)!=m_completionPort)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) CreateIoCompletionPort failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return false;
+	}
+	return true;
+}
+
+bool EventLoop::Post(IoContext *context,unsigned int transferredByte)
+{
+	EP_ASSERT(context);
+	epl::LockObj lock(m_loopLock);
+	if(!m_completionPort || m_isStopping)
+		return false;
+	BeginIo();
+	if(!PostQueuedCompletionStatus(m_completionPort,transferredByte,EVENT_LOOP_KEY_DEFAULT,&context->m_overlapped))
+	{
+		AbortIo();
+		return false;
+	}
+	return true;
+}
+
+void EventLoop::BeginIo()
+{
+	InterlockedIncrement(&m_pendingIoCount);
+}
+
+void EventLoop::AbortIo()
+{
+	InterlockedDecrement(&m_pendingIoCount);
+}
+
+void EventLoop::AddTimer(TimerContext *context,unsigned int delayMilliSec)
+{
+	EP_ASSERT(context && context->m_callBackObj);
+	m_timingWheel.Add(context,delayMilliSec);
+}
+
+bool EventLoop::RemoveTimer(TimerContext *context)
+{
+	EP_ASSERT(context);
+	return m_timingWheel.Remove(context);
+}
+
+unsigned int EventLoop::GetCachedTime() const
+{
+	return m_cachedTime;
+}
+
+void EventLoop::updateTime()
+{
+	unsigned int currentTime=GetTickCount();
+	// the wheel is advanced after the dispatch, so the idle wait must not be applied to the timers added by it
+	if(m_timingWheel.IsEmpty())
+		m_elapsedMilliSec=0;
+	else
+		m_elapsedMilliSec+=currentTime-m_cachedTime;
+	m_cachedTime=currentTime;
+}
+
+void EventLoop::expireTimers()
+{
+	unsigned int tickCount=m_elapsedMilliSec/TIMING_WHEEL_TICK_MILLISEC;
+	if(tickCount==0)
+		return;
+	m_elapsedMilliSec-=tickCount*TIMING_WHEEL_TICK_MILLISEC;
+
+	TimerContext expiredList;
+	TimingWheel::InitList(expiredList);
+	m_timingWheel.Advance(tickCount,expiredList);
+	TimerContext *context;
+	while((context=TimingWheel::PopList(expiredList))!=NULL)
+		context->m_callBackObj->OnTimerExpired(context,true);
+}
+
+void EventLoop::clearTimers()
+{
+	TimerContext expiredList;
+	TimingWheel::InitList(expiredList);
+	m_timingWheel.Clear(expiredList);
+	TimerContext *context;
+	while((context=TimingWheel::PopList(expiredList))!=NULL)
+		context->m_callBackObj->OnTimerExpired(context,false);
+}
+
+void EventLoop::dispatch(OVERLAPPED *overlapped,unsigned int transferredByte,bool isSucceeded)
+{
+	IoContext *context=reinterpret_cast<IoContext*>(overlapped);
+	InterlockedDecrement(&m_pendingIoCount);
+	if(context->m_callBackObj)
+		context->m_callBackObj->OnIoCompleted(context,transferredByte,isSucceeded);
+}
+
+void EventLoop::onTerminated(unsigned long exitCode,bool isInDeletion)
+{
+	// only the normal termination runs on the thread exiting itself
+	if(exitCode==0 && !isInDeletion)
+		BufferPool::defaultBufferPool.FlushThreadCache();
+	epl::Thread::onTerminated(exitCode,isInDeletion);
+}
+
+bool EventLoop::dequeue(CompletionEntry *entryList,unsigned int &retEntryCount,DWORD waitTime)
+{
+	retEntryCount=0;
+#if (WINVER>=WINDOWS_VISTA)
+	OVERLAPPED_ENTRY overlappedEntryList[EVENT_LOOP_COMPLETION_BATCH_COUNT];
+	ULONG overlappedEntryCount=0;
+	if(!GetQueuedCompletionStatusEx(m_completionPort,overlappedEntryList,EVENT_LOOP_COMPLETION_BATCH_COUNT,&overlappedEntryCount,waitTime,FALSE))
+	{
+		return (GetLastError()==WAIT_TIMEOUT);
+	}
+	for(ULONG entryIdx=0;entryIdx<overlappedEntryCount;entryIdx++)
+	{
+		OVERLAPPED *overlapped=overlappedEntryList[entryIdx].lpOverlapped;
+		entryList[entryIdx].m_overlapped=overlapped;
+		entryList[entryIdx].m_completionKey=overlappedEntryList[entryIdx].lpCompletionKey;
+		entryList[entryIdx].m_transferredByte=overlappedEntryList[entryIdx].dwNumberOfBytesTransferred;
+		// the status of the operation is left as NTSTATUS, where the failures are negative.
+		entryList[entryIdx].m_isSucceeded=(overlapped && static_cast<LONG>(overlapped->Internal)>=0);
+	}
+	retEntryCount=overlappedEntryCount;
+	return true;
+#else //(WINVER>=WINDOWS_VISTA)
+	// GetQueuedCompletionStatusEx is not available, so drain the completions queued one by one.
+	while(retEntryCount<EVENT_LOOP_COMPLETION_BATCH_COUNT)
+	{
+		DWORD transferredByte=0;
+		ULONG_PTR completionKey=EVENT_LOOP_KEY_DEFAULT;
+		OVERLAPPED *overlapped=NULL;
+		BOOL isSucceeded=GetQueuedCompletionStatus(m_completionPort,&transferredByte,&completionKey,&overlapped,retEntryCount?0:waitTime);
+		if(!isSucceeded && !overlapped)
+		{
+			return (retEntryCount>0 || GetLastError()==WAIT_TIMEOUT);
+		}
+		entryList[retEntryCount].m_overlapped=overlapped;
+		entryList[retEntryCount].m_completionKey=completionKey;
+		entryList[retEntryCount].m_transferredByte=transferredByte;
+		entryList[retEntryCount].m_isSucceeded=(isSucceeded!=FALSE);
+		retEntryCount++;
+	}
+	return true;
+#endif //(WINVER>=WINDOWS_VISTA)
+}
+
+void EventLoop::execute()
+{
+	CompletionEntry entryList[EVENT_LOOP_COMPLETION_BATCH_COUNT];
+	unsigned int entryCount;
+	bool isStopped=false;
+	while(!isStopped)
+	{
+		// wake up every tick only while any timer is pending
+		DWORD waitTime=m_timingWheel.IsEmpty()?INFINITE:TIMING_WHEEL_TICK_MILLISEC;
+		bool isOpened=dequeue(entryList,entryCount,waitTime);
+		updateTime();
+		if(!isOpened)
+		{
+			break;
+		}
+		for(unsigned int entryIdx=0;entryIdx<entryCount;entryIdx++)
+		{
+			if(entryList[entryIdx].m_overlapped)
+			{
+				dispatch(entryList[entryIdx].m_overlapped,entryList[entryIdx].m_transferredByte,entryList[entryIdx].m_isSucceeded);
+			}
+			else if(entryList[entryIdx].m_completionKey==EVENT_LOOP_KEY_STOP)
+			{
+				isStopped=true;
+			}
+		}
+		expireTimers();
+	}
+
+	// dispatch the completions of the operations pending so their contexts are released.
+	// @remark the sockets are closed before, so their operations are completed with failure.
+	while(m_pendingIoCount>0 && dequeue(entryList,entryCount,INFINITE))
+	{
+		for(unsigned int entryIdx=0;entryIdx<entryCount;entryIdx++)
+		{
+			if(entryList[entryIdx].m_overlapped)
+				dispatch(entryList[entryIdx].m_overlapped,entryList[entryIdx].m_transferredByte,entryList[entryIdx].m_isSucceeded);
+		}
+	}
+
+	// release the timers still pending
+	clearTimers();
+}
\ No newline at end of file
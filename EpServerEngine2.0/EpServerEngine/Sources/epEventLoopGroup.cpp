@@ -0,0 +1,131 @@
+/*! 
+EventLoopGroup for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epEventLoopGroup.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+EventLoopGroup::EventLoopGroup(unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType)
+{
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_listLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_listLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_listLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_listLock=NULL;
+		break;
+	}
+	m_waitTime=waitTimeMilliSec;
+	m_nextEventLoopIdx=0;
+}
+
+EventLoopGroup::~EventLoopGroup()
+{
+	StopLoops();
+	if(m_listLock)
+		EP_DELETE m_listLock;
+	m_listLock=NULL;
+}
+
+void EventLoopGroup::SetWaitTime(unsigned int milliSec)
+{
+	epl::LockObj lock(m_listLock);
+	m_waitTime=milliSec;
+	for(int trav=0;trav<m_eventLoopList.size();trav++)
+	{
+		m_eventLoopList.at(trav)->SetWaitTime(milliSec);
+	}
+}
+
+unsigned int EventLoopGroup::GetWaitTime() const
+{
+	epl::LockObj lock(m_listLock);
+	return m_waitTime;
+}
+
+bool EventLoopGroup::StartLoops(unsigned int eventLoopCount)
+{
+	StopLoops();
+
+	epl::LockObj lock(m_listLock);
+	if(eventLoopCount==0)
+	{
+		eventLoopCount=System::GetNumberOfCores();
+	}
+	for(unsigned int trav=0;trav<eventLoopCount;trav++)
+	{
+		EventLoop *eventLoop=EP_NEW EventLoop(m_waitTime,m_lockPolicy);
+		if(!eventLoop->StartLoop())
+		{
+			EP_DELETE eventLoop;
+			continue;
+		}
+		m_eventLoopList.push_back(eventLoop);
+	}
+	return (m_eventLoopList.size()>0);
+}
+
+void EventLoopGroup::StopLoops()
+{
+	epl::LockObj lock(m_listLock);
+	for(int trav=0;trav<m_eventLoopList.size();trav++)
+	{
+		m_eventLoopList.at(trav)->StopLoop();
+		EP_DELETE m_eventLoopList.at(trav);
+	}
+	m_eventLoopList.clear();
+	m_nextEventLoopIdx=0;
+}
+
+EventLoop *EventLoopGroup::GetEventLoop()
+{
+	epl::LockObj lock(m_listLock);
+	if(!m_eventLoopList.size())
+		return NULL;
+	EventLoop *eventLoop=m_eventLoopList.at(m_nextEventLoopIdx%m_eventLoopList.size());
+	m_nextEventLoopIdx++;
+	return eventLoop;
+}
+
+size_t EventLoopGroup::Count() const
+{
+	epl::LockObj lock(m_listLock);
+	return m_eventLoopList.size();
+}
\ No newline at end of file
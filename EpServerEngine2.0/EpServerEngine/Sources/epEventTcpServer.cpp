@@ -0,0 +1,270 @@
+/*! 
+EventTcpServer for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epEventTcpServer.h"
+#include "epEventTcpSocket.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+EventTcpServer::EventTcpServer(epl::LockPolicy lockPolicyType):BaseTcpServer(lockPolicyType),m_eventLoopGroup(WAITTIME_INIFINITE,lockPolicyType),m_timerList(lockPolicyType),m_socketPool(SOCKET_POOL_CAPACITY_DEFAULT,lockPolicyType)
+{
+	m_isShardPerCore=false;
+}
+
+
+EventTcpServer::EventTcpServer(const EventTcpServer& b):BaseTcpServer(b),m_eventLoopGroup(WAITTIME_INIFINITE,b.m_lockPolicy),m_timerList(b.m_lockPolicy),m_socketPool(SOCKET_POOL_CAPACITY_DEFAULT,b.m_lockPolicy)
+{
+	m_isShardPerCore=false;
+}
+
+EventTcpServer::~EventTcpServer()
+{
+	StopServer();
+}
+
+EventTcpServer & EventTcpServer::operator=(const EventTcpServer&b)
+{
+	if(this!=&b)
+	{
+		BaseTcpServer::operator =(b);
+	}
+	return *this;
+}
+
+void EventTcpServer::StopServer()
+{
+	BaseTcpServer::StopServer();
+	m_timerList.Clear();
+	m_eventLoopGroup.StopLoops();
+	deleteShards();
+	m_socketPool.Clear();
+}
+
+bool EventTcpServer::StartServer(const ServerOps &ops)
+{
+	if(IsServerStarted())
+		return true;
+
+	m_socketPool.SetCapacity(ops.socketPoolCapacity);
+	m_isShardPerCore=ops.isShardPerCore;
+	if(m_isShardPerCore)
+	{
+		unsigned int shardCount=ops.workerThreadCount;
+		if(shardCount==0)
+			shardCount=epl::System::GetNumberOfCores();
+		for(unsigned int trav=0;trav<shardCount;trav++)
+		{
+			m_shardList.push_back(EP_NEW EventTcpShard(this,trav,shardCount,ops.waitTimeMilliSec,m_lockPolicy));
+		}
+		// the shards are started by the listening thread
+		if(BaseTcpServer::StartServer(ops))
+			return true;
+
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the server\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		deleteShards();
+		return false;
+	}
+
+	m_eventLoopGroup.SetWaitTime(ops.waitTimeMilliSec);
+	if(m_eventLoopGroup.StartLoops(ops.workerThreadCount) && BaseTcpServer::StartServer(ops))
+		return true;
+
+	epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the server\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+	m_eventLoopGroup.StopLoops();
+	return false;
+}
+
+unsigned int EventTcpServer::GetShardCount() const
+{
+	return m_shardList.size();
+}
+
+bool EventTcpServer::PostToShard(unsigned int fromShardIndex,unsigned int toShardIndex,Packet *message)
+{
+	EP_ASSERT(message);
+	if(fromShardIndex>=m_shardList.size() || toShardIndex>=m_shardList.size())
+		return false;
+	// the channel from the sending shard has only one producer, its Event Loop thread
+	EP_ASSERT(GetCurrentThreadId()==m_shardList[fromShardIndex]->GetLoopThreadId());
+	return m_shardList[toShardIndex]->PostMessage(fromShardIndex,message);
+}
+
+unsigned int EventTcpServer::ScheduleTimer(unsigned int delayMilliSec,unsigned int periodMilliSec,unsigned int shardIndex)
+{
+	EventLoop *eventLoop;
+	if(m_isShardPerCore)
+	{
+		if(shardIndex>=m_shardList.size())
+			return TIMER_ID_NONE;
+		eventLoop=&m_shardList[shardIndex]->m_eventLoop;
+	}
+	else
+	{
+		eventLoop=m_eventLoopGroup.GetEventLoop();
+	}
+	return m_timerList.Schedule(this,eventLoop,delayMilliSec,periodMilliSec);
+}
+
+bool EventTcpServer::CancelTimer(unsigned int timerId)
+{
+	return m_timerList.Cancel(timerId);
+}
+
+void EventTcpServer::OnTimer(Timer *timer)
+{
+	unsigned int timerId=timer->GetTimerId();
+	m_callBackObj->OnTimer(timerId);
+	// the timer expiring once is done
+	if(timer->GetPeriod()==0)
+		m_timerList.Cancel(timerId);
+}
+
+void EventTcpServer::deleteShards()
+{
+	for(unsigned int trav=0;trav<m_shardList.size();trav++)
+	{
+		m_shardList[trav]->StopShard();
+	}
+	for(unsigned int trav=0;trav<m_shardList.size();trav++)
+	{
+		EP_DELETE m_shardList[trav];
+	}
+	m_shardList.clear();
+}
+
+void EventTcpServer::execute()
+{
+	if(m_isShardPerCore)
+	{
+		// each shard accepts from the listening socket by itself
+		for(unsigned int trav=0;trav<m_shardList.size();trav++)
+		{
+			if(!m_shardList[trav]->StartShard())
+				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the shard\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		}
+		// the acceptors stop when the listening socket is closed
+		for(unsigned int trav=0;trav<m_shardList.size();trav++)
+		{
+			m_shardList[trav]->WaitForAcceptor();
+		}
+		for(unsigned int trav=0;trav<m_shardList.size();trav++)
+		{
+			m_shardList[trav]->StopShard();
+		}
+	}
+	else
+	{
+		acceptLoop(NULL);
+	}
+
+	stopServer();
+}
+
+void EventTcpServer::acceptLoop(EventTcpShard *shard)
+{
+	ServerObjectList &socketList=shard?shard->m_socketList:m_socketList;
+	SOCKET clientSocket;
+	sockaddr sockAddr;
+	int sizeOfSockAddr=sizeof(sockaddr);
+	while(1)
+	{
+		clientSocket=accept(m_listenSocket,&sockAddr,&sizeOfSockAddr);
+		if(clientSocket == INVALID_SOCKET || m_listenSocket== INVALID_SOCKET)
+		{
+			break;			
+		}
+		else
+		{
+			if(!m_callBackObj->OnAccept(sockAddr))
+			{
+				closesocket(clientSocket);
+				continue;
+			}
+
+			// the Event Loop never blocks on the socket
+			u_long nonBlocking=1;
+			EventLoop *eventLoop=shard?&shard->m_eventLoop:m_eventLoopGroup.GetEventLoop();
+			if(!eventLoop || ioctlsocket(clientSocket,FIONBIO,&nonBlocking)==SOCKET_ERROR)
+			{
+				closesocket(clientSocket);
+				continue;
+			}
+
+			EventTcpSocket *accWorker=(EventTcpSocket*)m_socketPool.Acquire();
+			if(accWorker)
+			{
+				accWorker->setEventLoop(eventLoop);
+				accWorker->SetCallbackObject(m_callBackObj);
+				accWorker->SetWaitTime(m_waitTime);
+			}
+			else
+			{
+				accWorker=EP_NEW EventTcpSocket(m_callBackObj,eventLoop,m_waitTime,m_lockPolicy);
+			}
+			if(!accWorker)
+			{
+				closesocket(clientSocket);
+				continue;
+			}
+			accWorker->setSocketPool(&m_socketPool);
+			accWorker->setClientSocket(clientSocket);
+			accWorker->setCompressor(&m_compressor);
+			accWorker->setFrameVersion(m_frameVersion);
+			accWorker->setReceiveLimit(m_maxFrameByteSize,m_receiveChunkByteSize);
+			accWorker->setSendQueueWatermark(m_sendQueueHighWatermark,m_sendQueueLowWatermark,m_sendQueueLimit);
+			accWorker->setOwner(this);
+			accWorker->setMessageDispatcher(m_messageDispatcher);
+			accWorker->setSockAddr(sockAddr);
+			if(shard)
+				accWorker->m_shardIndex=shard->m_shardIndex;
+			socketList.Push(accWorker);
+			accWorker->startConnection();
+			accWorker->ReleaseObj();
+			unsigned int maximumConnectionCount=GetMaximumConnectionCount();
+			if(maximumConnectionCount!=CONNECTION_LIMIT_INFINITE)
+			{
+				// the limit is divided among the shards
+				if(shard)
+				{
+					maximumConnectionCount/=m_shardList.size();
+					if(maximumConnectionCount==0)
+						maximumConnectionCount=1;
+				}
+				while(socketList.Count()>=maximumConnectionCount)
+				{
+					socketList.WaitForListSizeDecrease();
+				}
+			}
+
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*! 
+EventTcpShard for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epEventTcpShard.h"
+#include "epEventTcpServer.h"
+#include "epEventTcpSocket.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+EventTcpShard::EventTcpShard(EventTcpServer *server,unsigned int shardIndex,unsigned int shardCount,unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType):epl::Thread(EP_THREAD_PRIORITY_NORMAL,lockPolicyType),EventLoopCallbackInterface(),m_eventLoop(waitTimeMilliSec,lockPolicyType),m_socketList(waitTimeMilliSec,lockPolicyType)
+{
+	EP_ASSERT(server);
+	m_server=server;
+	m_shardIndex=shardIndex;
+	m_waitTime=waitTimeMilliSec;
+	for(unsigned int trav=0;trav<shardCount;trav++)
+	{
+		m_channelList.push_back(EP_NEW ShardChannel());
+	}
+	m_messageContext.m_callBackObj=this;
+	m_isMessageScheduled=0;
+}
+
+EventTcpShard::~EventTcpShard()
+{
+	StopShard();
+	for(unsigned int trav=0;trav<m_channelList.size();trav++)
+	{
+		EP_DELETE m_channelList[trav];
+	}
+	m_channelList.clear();
+}
+
+bool EventTcpShard::StartShard()
+{
+	if(!m_eventLoop.StartLoop())
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the Event Loop\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return false;
+	}
+	if(Start())
+		return true;
+	epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the acceptor\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+	m_eventLoop.StopLoop();
+	return false;
+}
+
+void EventTcpShard::StopShard()
+{
+	TerminateAfter(m_waitTime);
+	m_socketList.Do(killConnection,0);
+	m_socketList.Clear();
+	m_eventLoop.StopLoop();
+}
+
+void EventTcpShard::WaitForAcceptor(unsigned int waitTimeInMilliSec)
+{
+	WaitFor(waitTimeInMilliSec);
+}
+
+unsigned int EventTcpShard::GetShardIndex() const
+{
+	return m_shardIndex;
+}
+
+unsigned int EventTcpShard::GetLoopThreadId() const
+{
+	return m_eventLoop.GetLoopThreadId();
+}
+
+bool EventTcpShard::PostMessage(unsigned int fromShardIndex,Packet *message)
+{
+	EP_ASSERT(fromShardIndex<m_channelList.size());
+	if(!m_channelList[fromShardIndex]->Push(message))
+		return false;
+
+	// a single request delivers all the messages pushed before it is handled
+	if(InterlockedCompareExchange(&m_isMessageScheduled,1,0)!=0)
+		return true;
+	m_messageContext.Reset();
+	if(m_eventLoop.Post(&m_messageContext))
+		return true;
+	InterlockedExchange(&m_isMessageScheduled,0);
+	epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to post the message request\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+	// the message stays in the channel until the next request
+	return true;
+}
+
+void EventTcpShard::OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)
+{
+	EP_ASSERT(context==&m_messageContext);
+	drainMessages();
+}
+
+void EventTcpShard::drainMessages()
+{
+	// clear the flag first, so the message pushed while draining posts a new request
+	InterlockedExchange(&m_isMessageScheduled,0);
+	ServerCallbackInterface *callBackObj=m_server->GetCallbackObject();
+	for(unsigned int trav=0;trav<m_channelList.size();trav++)
+	{
+		Packet *message;
+		while((message=m_channelList[trav]->Pop())!=NULL)
+		{
+			if(callBackObj)
+				callBackObj->OnShardMessage(m_shardIndex,trav,message);
+			message->ReleaseObj();
+		}
+	}
+}
+
+void EventTcpShard::killConnection(BaseServerObject *socketObj,unsigned int argCount,va_list args)
+{
+	((EventTcpSocket*)(socketObj))->KillConnection();
+}
+
+void EventTcpShard::execute()
+{
+	m_server->acceptLoop(this);
+}
\ No newline at end of file
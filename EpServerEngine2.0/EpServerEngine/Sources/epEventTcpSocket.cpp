@@ -0,0 +1,435 @@
+/*! 
+EventTcpSocket for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epEventTcpSocket.h"
+#include "epEventTcpServer.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+EventTcpSocket::EventTcpSocket(ServerCallbackInterface *callBackObj,EventLoop *eventLoop,unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType): BaseTcpSocket(callBackObj,waitTimeMilliSec,lockPolicyType)
+{
+	EP_ASSERT(eventLoop);
+	m_eventLoop=eventLoop;
+	m_timerEventLoop=eventLoop;
+	m_shardIndex=0;
+	m_isConnected=true;
+
+	m_startContext.m_callBackObj=this;
+	m_startContext.m_operation=EVENT_TCP_OPERATION_START;
+	m_readContext.m_callBackObj=this;
+	m_readContext.m_operation=EVENT_TCP_OPERATION_READ;
+	m_writeContext.m_callBackObj=this;
+	m_writeContext.m_operation=EVENT_TCP_OPERATION_WRITE;
+	m_flushContext.m_callBackObj=this;
+	m_flushContext.m_operation=EVENT_TCP_OPERATION_FLUSH;
+	m_isFlushScheduled=0;
+
+	m_isSending=false;
+}
+
+EventTcpSocket::~EventTcpSocket()
+{
+	m_socketPool=NULL;
+	killConnection();
+}
+
+bool EventTcpSocket::IsConnectionAlive() const
+{
+	return m_isConnected;
+}
+
+unsigned int EventTcpSocket::GetShardIndex() const
+{
+	return m_shardIndex;
+}
+
+void EventTcpSocket::KillConnection()
+{
+	killConnection();
+}
+
+void EventTcpSocket::killConnection()
+{
+	m_baseSocketLock->Lock();
+	bool isKilled=IsConnectionAlive();
+	if(isKilled)
+		killConnectionNoCallBack();
+	m_baseSocketLock->Unlock();
+
+	// the callback is called without the lock
+	if(isKilled)
+		m_callBackObj->OnDisconnect(this);
+}
+
+void EventTcpSocket::killConnectionNoCallBack()
+{
+	epl::LockObj lock(m_baseSocketLock);
+	if(IsConnectionAlive())
+	{
+		m_isConnected=false;
+		m_sendLock->Lock();
+		// No longer need client socket
+		// @remark the pending operations are completed with failure and release their references.
+		if(m_clientSocket!=INVALID_SOCKET)
+		{
+			closesocket(m_clientSocket);
+			m_clientSocket = INVALID_SOCKET;
+		}
+		m_sendBuffer.clear();
+		m_sendLock->Unlock();
+		cancelIdleTimer();
+
+		removeSelfFromContainer();
+		retireToPool();
+	}
+}
+
+void EventTcpSocket::setEventLoop(EventLoop *eventLoop)
+{
+	EP_ASSERT(eventLoop);
+	m_eventLoop=eventLoop;
+	setTimerEventLoop(eventLoop);
+}
+
+void EventTcpSocket::resetConnection()
+{
+	BaseTcpSocket::resetConnection();
+	m_shardIndex=0;
+	m_isConnected=true;
+	m_isFlushScheduled=0;
+	m_sendBuffer.clear();
+	m_sendingBuffer.clear();
+	m_isSending=false;
+}
+
+bool EventTcpSocket::startConnection()
+{
+	if(!m_eventLoop->Register(m_clientSocket))
+	{
+		killConnectionNoCallBack();
+		return false;
+	}
+
+	// the reference is released when the operation is completed.
+	RetainObj();
+	m_startContext.Reset();
+	if(!m_eventLoop->Post(&m_startContext))
+	{
+		ReleaseObj();
+		killConnectionNoCallBack();
+		return false;
+	}
+	return true;
+}
+
+void EventTcpSocket::execute()
+{
+}
+
+bool EventTcpSocket::armRead()
+{
+	if(m_clientSocket==INVALID_SOCKET)
+		return false;
+
+	WSABUF wsaBuf;
+	wsaBuf.buf=NULL;
+	wsaBuf.len=0;
+	DWORD flags=0;
+
+	// the reference is released when the operation is completed.
+	RetainObj();
+	m_readContext.Reset();
+	m_eventLoop->BeginIo();
+	if(WSARecv(m_clientSocket,&wsaBuf,1,NULL,&flags,&m_readContext.m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) WSARecv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_eventLoop->AbortIo();
+		ReleaseObj();
+		return false;
+	}
+	return true;
+}
+
+bool EventTcpSocket::readAvailable(vector<ReceivedItem> &itemList)
+{
+	while(IsConnectionAlive())
+	{
+		unsigned int writableByteSize=0;
+		char *writeBuffer=m_recvBuffer.GetWriteBuffer(writableByteSize);
+		int recvLength=recv(m_clientSocket,writeBuffer,writableByteSize,0);
+		if(recvLength==0)
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			return false;
+		}
+		else if(recvLength==SOCKET_ERROR)
+		{
+			if(WSAGetLastError()==WSAEWOULDBLOCK)
+				return true;
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			return false;
+		}
+		m_recvBuffer.CommitWrite(recvLength);
+		updateLastActiveTime();
+
+		// collect every complete packet and chunk received in order
+		for(;;)
+		{
+			ReceivedItem item;
+			ReceiveBuffer::Chunk chunk;
+			item.m_packet=m_recvBuffer.PopPacket();
+			item.m_isChunk=false;
+			if(!item.m_packet)
+			{
+				// the chunk points into the buffer written again by the next recv, so it is copied
+				if(!m_recvBuffer.PopChunk(chunk))
+					break;
+				item.m_packet=EP_NEW Packet(chunk.m_data,chunk.m_byteSize);
+				item.m_isChunk=true;
+				item.m_chunkOffset=chunk.m_offset;
+				item.m_isLastChunk=chunk.m_isLast;
+			}
+			itemList.push_back(item);
+		}
+		if(m_recvBuffer.IsCorrupted())
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Received the corrupted frame or the packet exceeding the maximum byte size\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			return false;
+		}
+	}
+	return false;
+}
+
+void EventTcpSocket::deliverReceived(vector<ReceivedItem> &itemList)
+{
+	vector<ReceivedItem>::iterator iter;
+	for(iter=itemList.begin();iter!=itemList.end();iter++)
+	{
+		// the packets after the connection is killed by the callback are dropped
+		if(IsConnectionAlive())
+		{
+			if(iter->m_isChunk)
+				m_callBackObj->OnReceiveChunk(this,iter->m_chunkOffset,iter->m_packet->GetPacket(),iter->m_packet->GetPacketByteSize(),iter->m_isLastChunk);
+			else if(!dispatchReceived(iter->m_packet))
+				m_callBackObj->OnReceived(this,iter->m_packet,RECEIVE_STATUS_SUCCESS);
+		}
+		iter->m_packet->ReleaseObj();
+	}
+	itemList.clear();
+}
+
+int EventTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
+{
+	if(!IsConnectionAlive())
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_NOT_CONNECTED;
+		return 0;
+	}
+
+	int length=packet.GetPacketByteSize();
+	if(length<=0)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_SUCCESS;
+		return 0;
+	}
+
+	bool isFull=false;
+	if(!m_sendQueue.Push(packet,isFull))
+	{
+		// the slow client is disconnected rather than growing the memory
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Send queue exceeded the limit\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		killConnection();
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_QUEUE_FULL;
+		return -1;
+	}
+	if(isFull)
+		m_callBackObj->OnSendQueueFull(this);
+
+	if(!isMoreComing || m_sendQueue.GetQueuedByteSize()>=SEND_COALESCE_BYTE_SIZE_MAX)
+	{
+		if(!scheduleFlush())
+		{
+			if(sendStatus)
+				*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+			return -1;
+		}
+	}
+
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return length;
+}
+
+bool EventTcpSocket::scheduleFlush()
+{
+	if(InterlockedCompareExchange(&m_isFlushScheduled,1,0)!=0)
+		return true;
+
+	// the reference is released when the operation is completed.
+	RetainObj();
+	m_flushContext.Reset();
+	if(!m_eventLoop->Post(&m_flushContext))
+	{
+		InterlockedExchange(&m_isFlushScheduled,0);
+		ReleaseObj();
+		return false;
+	}
+	return true;
+}
+
+void EventTcpSocket::onFlushRequested()
+{
+	// the packets pushed after this point request another flush
+	InterlockedExchange(&m_isFlushScheduled,0);
+
+	bool isFailed=false;
+	m_sendLock->Lock();
+	if(!m_isSending)
+	{
+		m_sendQueue.PopTo(m_sendBuffer);
+		if(m_sendBuffer.size())
+			isFailed=!flushSend();
+	}
+	m_sendLock->Unlock();
+
+	if(isFailed)
+		killConnection();
+}
+
+bool EventTcpSocket::flushSend()
+{
+	if(m_clientSocket==INVALID_SOCKET)
+		return false;
+
+	m_sendingBuffer.swap(m_sendBuffer);
+	WSABUF wsaBuf;
+	wsaBuf.buf=&m_sendingBuffer.at(0);
+	wsaBuf.len=static_cast<ULONG>(m_sendingBuffer.size());
+
+	// the reference is released when the operation is completed.
+	RetainObj();
+	m_isSending=true;
+	m_writeContext.Reset();
+	m_eventLoop->BeginIo();
+	if(WSASend(m_clientSocket,&wsaBuf,1,NULL,0,&m_writeContext.m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) WSASend failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_eventLoop->AbortIo();
+		m_isSending=false;
+		m_sendingBuffer.clear();
+		ReleaseObj();
+		return false;
+	}
+	return true;
+}
+
+bool EventTcpSocket::onWriteCompleted(unsigned int transferredByte,bool isSucceeded)
+{
+	bool isFailed=false;
+	bool isDrained=false;
+	m_sendLock->Lock();
+	if(!isSucceeded || m_clientSocket==INVALID_SOCKET)
+	{
+		m_sendingBuffer.clear();
+		m_sendBuffer.clear();
+		m_isSending=false;
+		isFailed=true;
+	}
+	else
+	{
+		isDrained=m_sendQueue.Release(transferredByte);
+		// put back what is not sent in front of the queued data
+		if(transferredByte<m_sendingBuffer.size())
+			m_sendBuffer.insert(m_sendBuffer.begin(),m_sendingBuffer.begin()+transferredByte,m_sendingBuffer.end());
+		m_sendingBuffer.clear();
+		m_isSending=false;
+		m_sendQueue.PopTo(m_sendBuffer);
+		if(m_sendBuffer.size())
+			isFailed=!flushSend();
+	}
+	m_sendLock->Unlock();
+
+	if(isDrained)
+		m_callBackObj->OnSendQueueDrained(this);
+
+	if(isFailed)
+	{
+		killConnection();
+		return false;
+	}
+	return true;
+}
+
+void EventTcpSocket::OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)
+{
+	switch(context->m_operation)
+	{
+	case EVENT_TCP_OPERATION_START:
+		if(IsConnectionAlive())
+		{
+			// the callbacks are called without the lock
+			m_callBackObj->OnNewConnection(this);
+			m_baseSocketLock->Lock();
+			bool isArmed=IsConnectionAlive() && armRead();
+			m_baseSocketLock->Unlock();
+			if(!isArmed)
+				killConnection();
+		}
+		break;
+	case EVENT_TCP_OPERATION_READ:
+		{
+			vector<ReceivedItem> itemList;
+			m_baseSocketLock->Lock();
+			bool isOpen=isSucceeded && IsConnectionAlive() && readAvailable(itemList) && armRead();
+			m_baseSocketLock->Unlock();
+
+			// the callbacks are called without the lock
+			deliverReceived(itemList);
+			if(!isOpen)
+				killConnection();
+		}
+		break;
+	case EVENT_TCP_OPERATION_WRITE:
+		onWriteCompleted(transferredByte,isSucceeded);
+		break;
+	case EVENT_TCP_OPERATION_FLUSH:
+		onFlushRequested();
+		break;
+	default:
+		break;
+	}
+
+	// release the reference held by the completed operation
+	ReleaseObj();
+}
\ No newline at end of file
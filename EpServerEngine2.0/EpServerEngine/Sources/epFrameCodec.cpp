@@ -0,0 +1,397 @@
+/*! 
+FrameCodec for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epFrameCodec.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+/// size field of the legacy frame marking the control frame
+static const unsigned int FRAME_CONTROL_SIZE_FIELD=0xffffffff;
+/// bit of the legacy size field marking the packet compressed
+static const unsigned int FRAME_LEGACY_COMPRESSED_BIT=0x80000000;
+
+/*!
+Write the value in the varint
+@param[in] value the value to write
+@param[out] buffer the buffer to write into
+@return the byte size written
+*/
+static unsigned int writeVarint(unsigned int value,char *buffer)
+{
+	unsigned int byteSize=0;
+	while(value>=0x80)
+	{
+		buffer[byteSize++]=static_cast<char>((value&0x7f)|0x80);
+		value>>=7;
+	}
+	buffer[byteSize++]=static_cast<char>(value);
+	return byteSize;
+}
+
+/*!
+Read the value in the varint
+@param[in] buffer the buffer to read from
+@param[in] byteSize the byte size of the buffer
+@param[in] maxByteSize the maximum byte size of the varint
+@param[out] retValue the value read, or 0xffffffff if the value does not fit in 32 bits
+@return the byte size read or 0 if the varint is not complete
+*/
+static unsigned int readVarint(const char *buffer,unsigned int byteSize,unsigned int maxByteSize,unsigned int &retValue)
+{
+	retValue=0;
+	for(unsigned int byteIdx=0;byteIdx<byteSize && byteIdx<maxByteSize;byteIdx++)
+	{
+		unsigned char byte=static_cast<unsigned char>(buffer[byteIdx]);
+		// the bits shifted out of 32 bits are not dropped silently
+		if(byteIdx==4 && (byte&0x7f)>0x0f)
+		{
+			retValue=0xffffffff;
+			return byteIdx+1;
+		}
+		retValue|=static_cast<unsigned int>(byte&0x7f)<<(7*byteIdx);
+		// the last byte possible ends the varint regardless of its continuation bit
+		if(!(byte&0x80) || byteIdx+1==maxByteSize)
+			return byteIdx+1;
+	}
+	return 0;
+}
+
+FrameCodec::FrameCodec()
+{
+	m_frameVersion=FRAME_VERSION_LEGACY;
+	m_isOffering=false;
+	m_isOfferPending=0;
+	m_pendingSendVersion=FRAME_VERSION_LEGACY;
+	m_sendVersion=FRAME_VERSION_LEGACY;
+	m_receiveVersion=FRAME_VERSION_LEGACY;
+	m_compressor=NULL;
+	m_isCompressionOfferPending=0;
+	m_isCompressionAcceptPending=0;
+	m_acceptedDictionaryId=0;
+	m_isCompressing=0;
+	m_isDictionaryAgreed=0;
+}
+
+FrameCodec::FrameCodec(const FrameCodec& b)
+{
+	m_frameVersion=b.m_frameVersion;
+	m_isOffering=b.m_isOffering;
+	m_isOfferPending=b.m_isOfferPending;
+	m_pendingSendVersion=b.m_pendingSendVersion;
+	m_sendVersion=b.m_sendVersion;
+	m_receiveVersion=b.m_receiveVersion;
+	m_compressor=b.m_compressor;
+	m_isCompressionOfferPending=b.m_isCompressionOfferPending;
+	m_isCompressionAcceptPending=b.m_isCompressionAcceptPending;
+	m_acceptedDictionaryId=b.m_acceptedDictionaryId;
+	m_isCompressing=b.m_isCompressing;
+	m_isDictionaryAgreed=b.m_isDictionaryAgreed;
+}
+
+FrameCodec::~FrameCodec()
+{
+}
+
+FrameCodec & FrameCodec::operator=(const FrameCodec&b)
+{
+	if(this!=&b)
+	{
+		m_frameVersion=b.m_frameVersion;
+		m_isOffering=b.m_isOffering;
+		m_isOfferPending=b.m_isOfferPending;
+		m_pendingSendVersion=b.m_pendingSendVersion;
+		m_sendVersion=b.m_sendVersion;
+		m_receiveVersion=b.m_receiveVersion;
+		m_compressor=b.m_compressor;
+		m_isCompressionOfferPending=b.m_isCompressionOfferPending;
+		m_isCompressionAcceptPending=b.m_isCompressionAcceptPending;
+		m_acceptedDictionaryId=b.m_acceptedDictionaryId;
+		m_isCompressing=b.m_isCompressing;
+		m_isDictionaryAgreed=b.m_isDictionaryAgreed;
+	}
+	return *this;
+}
+
+void FrameCodec::Reset(unsigned int frameVersion,bool isOffering)
+{
+	if(frameVersion>FRAME_VERSION_COMPACT)
+		frameVersion=FRAME_VERSION_COMPACT;
+	m_frameVersion=frameVersion;
+	m_isOffering=isOffering;
+	InterlockedExchange(&m_isOfferPending,(isOffering && frameVersion!=FRAME_VERSION_LEGACY)?1:0);
+	InterlockedExchange(&m_pendingSendVersion,FRAME_VERSION_LEGACY);
+	m_sendVersion=FRAME_VERSION_LEGACY;
+	m_receiveVersion=FRAME_VERSION_LEGACY;
+
+	InterlockedExchange(&m_isCompressionOfferPending,(isOffering && m_compressor && m_compressor->IsEnabled())?1:0);
+	InterlockedExchange(&m_isCompressionAcceptPending,0);
+	m_acceptedDictionaryId=0;
+	InterlockedExchange(&m_isCompressing,0);
+	InterlockedExchange(&m_isDictionaryAgreed,0);
+}
+
+void FrameCodec::SetCompressor(Compressor *compressor)
+{
+	m_compressor=compressor;
+}
+
+bool FrameCodec::IsCompressing() const
+{
+	return (m_isCompressing!=0);
+}
+
+bool FrameCodec::IsDecompressible() const
+{
+	// the peer compresses only after the control frames setting the flag are received
+	return (m_compressor && m_isCompressing!=0);
+}
+
+unsigned int FrameCodec::GetSendVersion() const
+{
+	return m_sendVersion;
+}
+
+unsigned int FrameCodec::GetReceiveVersion() const
+{
+	return m_receiveVersion;
+}
+
+unsigned int FrameCodec::EncodeHeader(const Packet &packet,char *retHeader)
+{
+	return EncodeHeader(packet.GetPacketByteSize(),packet.GetMessageType(),packet.GetFrameFlags(),retHeader);
+}
+
+unsigned int FrameCodec::EncodeHeader(unsigned int payloadByteSize,unsigned short messageType,unsigned char flags,char *retHeader)
+{
+	return encodeHeader(payloadByteSize,messageType,flags,false,retHeader);
+}
+
+unsigned int FrameCodec::EncodeFrame(const Packet &packet,char *retHeader,Packet *&retCompressedPacket)
+{
+	return EncodeFrame(packet.GetPacket(),packet.GetPacketByteSize(),packet.GetMessageType(),packet.GetFrameFlags(),retHeader,retCompressedPacket);
+}
+
+unsigned int FrameCodec::EncodeFrame(const char *data,unsigned int byteSize,unsigned short messageType,unsigned char flags,char *retHeader,Packet *&retCompressedPacket)
+{
+	retCompressedPacket=NULL;
+	// checked before the acceptance is taken, since the acceptance is set before the flag
+	if(m_isCompressing && m_compressor)
+		retCompressedPacket=m_compressor->Compress(data,byteSize,m_isDictionaryAgreed!=0);
+	if(retCompressedPacket)
+		return encodeHeader(retCompressedPacket->GetPacketByteSize(),messageType,flags,true,retHeader);
+	return encodeHeader(byteSize,messageType,flags,false,retHeader);
+}
+
+Packet *FrameCodec::DecompressPayload(const char *data,unsigned int byteSize,unsigned int maxByteSize)
+{
+	if(!m_compressor)
+		return NULL;
+	return m_compressor->Decompress(data,byteSize,m_isDictionaryAgreed!=0,maxByteSize);
+}
+
+unsigned int FrameCodec::encodeHeader(unsigned int payloadByteSize,unsigned short messageType,unsigned char flags,bool isCompressed,char *retHeader)
+{
+	unsigned int headerByteSize=0;
+	// the switch is taken first, so the acceptance set before it is never sent behind it
+	unsigned int sendVersion=FRAME_VERSION_LEGACY;
+	if(m_pendingSendVersion)
+		sendVersion=static_cast<unsigned int>(InterlockedExchange(&m_pendingSendVersion,FRAME_VERSION_LEGACY));
+
+	// the control frames are sent in the frame before the switch
+	if(m_isCompressionOfferPending && InterlockedExchange(&m_isCompressionOfferPending,0))
+		headerByteSize+=encodeControl(FRAME_CONTROL_COMPRESSION,FRAME_COMPRESSION_METHOD_LZ,m_compressor->GetDictionaryId(),retHeader+headerByteSize);
+	if(m_isOfferPending && InterlockedExchange(&m_isOfferPending,0))
+		headerByteSize+=encodeControl(FRAME_CONTROL_OFFER,m_frameVersion,retHeader+headerByteSize);
+	if(m_isCompressionAcceptPending && InterlockedExchange(&m_isCompressionAcceptPending,0))
+		headerByteSize+=encodeControl(FRAME_CONTROL_COMPRESSION,FRAME_COMPRESSION_METHOD_LZ,m_acceptedDictionaryId,retHeader+headerByteSize);
+	if(sendVersion!=FRAME_VERSION_LEGACY)
+	{
+		headerByteSize+=encodeControl(FRAME_CONTROL_SWITCH,sendVersion,retHeader+headerByteSize);
+		m_sendVersion=sendVersion;
+	}
+
+	if(m_sendVersion==FRAME_VERSION_LEGACY)
+		return headerByteSize+EncodeLegacyHeader(isCompressed?(payloadByteSize|FRAME_LEGACY_COMPRESSED_BIT):payloadByteSize,retHeader+headerByteSize);
+
+	retHeader[headerByteSize++]=static_cast<char>((m_sendVersion<<4)|(flags&FRAME_FLAGS_MAX)|(isCompressed?FRAME_FLAG_COMPRESSED:0));
+	headerByteSize+=writeVarint(messageType,retHeader+headerByteSize);
+	headerByteSize+=writeVarint(payloadByteSize,retHeader+headerByteSize);
+	return headerByteSize;
+}
+
+bool FrameCodec::DecodeHeader(const char *data,unsigned int byteSize,FrameHeader &retHeader) const
+{
+	return DecodeHeader(m_receiveVersion,data,byteSize,retHeader);
+}
+
+bool FrameCodec::ProcessControl(const FrameHeader &header)
+{
+	EP_ASSERT(header.m_isControl);
+	unsigned int kind=header.m_controlCode>>4;
+	unsigned int frameVersion=header.m_controlCode&0x0f;
+
+	switch(kind)
+	{
+	case FRAME_CONTROL_OFFER:
+		// the peer may offer the version newer than known, so answer with the highest common one
+		if(frameVersion>m_frameVersion)
+			frameVersion=m_frameVersion;
+		// accept the offer by switching in front of the next packet sent
+		if(!m_isOffering && frameVersion!=FRAME_VERSION_LEGACY && m_sendVersion==FRAME_VERSION_LEGACY)
+			InterlockedExchange(&m_pendingSendVersion,static_cast<LONG>(frameVersion));
+		return true;
+	case FRAME_CONTROL_SWITCH:
+		// the peer can only switch to the version both sides know
+		if(frameVersion>m_frameVersion)
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Unknown frame version %d\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this,frameVersion);
+			return false;
+		}
+		// the peer sends in the new version from the next frame
+		m_receiveVersion=frameVersion;
+		if(m_isOffering && frameVersion!=FRAME_VERSION_LEGACY && m_sendVersion==FRAME_VERSION_LEGACY)
+			InterlockedExchange(&m_pendingSendVersion,static_cast<LONG>(frameVersion));
+		return true;
+	case FRAME_CONTROL_COMPRESSION:
+		if(!m_compressor || !m_compressor->IsEnabled() || (header.m_controlCode&0x0f)!=FRAME_COMPRESSION_METHOD_LZ)
+			return true;
+		if(!m_isOffering)
+		{
+			// the offer must come before the switch, so the acceptance is sent in the legacy frame
+			if(m_isCompressing || m_sendVersion!=FRAME_VERSION_LEGACY || m_pendingSendVersion!=FRAME_VERSION_LEGACY)
+				return true;
+			unsigned int dictionaryId=m_compressor->GetDictionaryId();
+			bool isDictionaryAgreed=(header.m_controlValue!=0 && header.m_controlValue==dictionaryId);
+			m_acceptedDictionaryId=isDictionaryAgreed?dictionaryId:0;
+			InterlockedExchange(&m_isDictionaryAgreed,isDictionaryAgreed?1:0);
+			// the acceptance is sent in front of the first frame compressed
+			InterlockedExchange(&m_isCompressionAcceptPending,1);
+			InterlockedExchange(&m_isCompressing,1);
+		}
+		else
+		{
+			// the peer compresses from the next frame with the dictionary id accepted
+			bool isDictionaryAgreed=(header.m_controlValue!=0 && header.m_controlValue==m_compressor->GetDictionaryId());
+			InterlockedExchange(&m_isDictionaryAgreed,isDictionaryAgreed?1:0);
+			InterlockedExchange(&m_isCompressing,1);
+		}
+		return true;
+	default:
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Unknown control frame %d\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this,kind);
+		return false;
+	}
+}
+
+unsigned int FrameCodec::EncodeLegacyHeader(unsigned int payloadByteSize,char *retHeader)
+{
+	epl::System::Memcpy(retHeader,&payloadByteSize,sizeof(unsigned int));
+	return FRAME_LEGACY_HEADER_BYTE_SIZE;
+}
+
+bool FrameCodec::DecodeHeader(unsigned int frameVersion,const char *data,unsigned int byteSize,FrameHeader &retHeader)
+{
+	retHeader.m_messageType=0;
+	retHeader.m_flags=0;
+	retHeader.m_isControl=false;
+	retHeader.m_controlCode=0;
+	retHeader.m_isCorrupted=false;
+	retHeader.m_controlValue=0;
+	retHeader.m_isCompressed=false;
+
+	if(frameVersion==FRAME_VERSION_LEGACY)
+	{
+		if(byteSize<FRAME_LEGACY_HEADER_BYTE_SIZE)
+			return false;
+		unsigned int payloadByteSize;
+		epl::System::Memcpy(&payloadByteSize,data,sizeof(unsigned int));
+		if(payloadByteSize==FRAME_CONTROL_SIZE_FIELD)
+		{
+			if(byteSize<FRAME_CONTROL_BYTE_SIZE)
+				return false;
+			retHeader.m_headerByteSize=FRAME_CONTROL_BYTE_SIZE;
+			retHeader.m_payloadByteSize=0;
+			retHeader.m_isControl=true;
+			retHeader.m_controlCode=static_cast<unsigned char>(data[FRAME_LEGACY_HEADER_BYTE_SIZE]);
+			if((retHeader.m_controlCode>>4)==FRAME_CONTROL_COMPRESSION)
+			{
+				if(byteSize<FRAME_CONTROL_VALUE_BYTE_SIZE)
+					return false;
+				retHeader.m_headerByteSize=FRAME_CONTROL_VALUE_BYTE_SIZE;
+				epl::System::Memcpy(&retHeader.m_controlValue,data+FRAME_CONTROL_BYTE_SIZE,sizeof(unsigned int));
+			}
+			return true;
+		}
+		retHeader.m_headerByteSize=FRAME_LEGACY_HEADER_BYTE_SIZE;
+		retHeader.m_payloadByteSize=payloadByteSize&~FRAME_LEGACY_COMPRESSED_BIT;
+		retHeader.m_isCompressed=((payloadByteSize&FRAME_LEGACY_COMPRESSED_BIT)!=0);
+		retHeader.m_isCorrupted=(retHeader.m_payloadByteSize>FRAME_PAYLOAD_BYTE_SIZE_MAX);
+		return true;
+	}
+
+	if(byteSize<1)
+		return false;
+	unsigned int headerByteSize=1;
+	unsigned int messageType=0;
+	unsigned int varintByteSize=readVarint(data+headerByteSize,byteSize-headerByteSize,3,messageType);
+	if(!varintByteSize)
+		return false;
+	headerByteSize+=varintByteSize;
+	unsigned int payloadByteSize=0;
+	varintByteSize=readVarint(data+headerByteSize,byteSize-headerByteSize,5,payloadByteSize);
+	if(!varintByteSize)
+		return false;
+	headerByteSize+=varintByteSize;
+
+	retHeader.m_headerByteSize=headerByteSize;
+	retHeader.m_payloadByteSize=payloadByteSize;
+	retHeader.m_messageType=static_cast<unsigned short>(messageType);
+	retHeader.m_flags=static_cast<unsigned char>(static_cast<unsigned char>(data[0])&FRAME_FLAGS_MAX);
+	retHeader.m_isCompressed=((static_cast<unsigned char>(data[0])&FRAME_FLAG_COMPRESSED)!=0);
+	// the frame must be in the version switched to, and the sizes must be in range
+	if(static_cast<unsigned int>(static_cast<unsigned char>(data[0])>>4)!=frameVersion || messageType>0xffff || payloadByteSize>FRAME_PAYLOAD_BYTE_SIZE_MAX)
+		retHeader.m_isCorrupted=true;
+	return true;
+}
+
+unsigned int FrameCodec::encodeControl(unsigned int kind,unsigned int frameVersion,char *retHeader)
+{
+	epl::System::Memcpy(retHeader,&FRAME_CONTROL_SIZE_FIELD,sizeof(unsigned int));
+	retHeader[FRAME_LEGACY_HEADER_BYTE_SIZE]=static_cast<char>((kind<<4)|(frameVersion&0x0f));
+	return FRAME_CONTROL_BYTE_SIZE;
+}
+
+unsigned int FrameCodec::encodeControl(unsigned int kind,unsigned int code,unsigned int value,char *retHeader)
+{
+	encodeControl(kind,code,retHeader);
+	epl::System::Memcpy(retHeader+FRAME_CONTROL_BYTE_SIZE,&value,sizeof(unsigned int));
+	return FRAME_CONTROL_VALUE_BYTE_SIZE;
+}
\ No newline at end of file
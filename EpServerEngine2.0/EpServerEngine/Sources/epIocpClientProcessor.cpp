@@ -73,7 +73,7 @@ void IocpClientProcessor::DoJob(BaseWorkerThread *workerThread,  BaseJob* const
 			{
 				job->GetCallBackObject()->OnReceived(job->GetClient(),receivedPacket,receiveStatus);
 			}
-			else
+			else if(receiveStatus!=RECEIVE_STATUS_SUCCESS || !job->GetClient()->dispatchReceived(receivedPacket))
 				job->GetClient()->GetCallbackObject()->OnReceived(job->GetClient(),receivedPacket,receiveStatus);
 			
 			if(receivedPacket)
@@ -45,12 +45,20 @@ IocpServerJob::IocpServerJob(BaseSocket *socket,IocpServerJobType jobType,Packet
 
 	m_completeEvent=completionEvent;
 	m_callBackObj=callBackObj;
+	m_ioContext.m_callBackObj=this;
+	m_packetByteSize=0;
+	m_frameHeaderByteSize=0;
+	m_compressedPacket=NULL;
+	if(m_packet)
+		m_packetByteSize=m_packet->GetPacketByteSize();
 }
 
 IocpServerJob::~IocpServerJob()
 {
 	if(m_packet)
 		m_packet->ReleaseObj();
+	if(m_compressedPacket)
+		m_compressedPacket->ReleaseObj();
 	if(m_socket)
 		m_socket->ReleaseObj();
 }
@@ -68,6 +76,13 @@ void IocpServerJob::SetJob(BaseSocket *socket,IocpServerJobType jobType, Packet
 	m_packet=packet;
 	if(m_packet)
 		m_packet->RetainObj();
+	m_packetByteSize=0;
+	m_frameHeaderByteSize=0;
+	if(m_compressedPacket)
+		m_compressedPacket->ReleaseObj();
+	m_compressedPacket=NULL;
+	if(m_packet)
+		m_packetByteSize=m_packet->GetPacketByteSize();
 
 	m_completeEvent=completionEvent;
 	m_callBackObj=callBackObj;
@@ -96,4 +111,36 @@ EventEx *IocpServerJob::GetCompletionEvent()
 ServerCallbackInterface *IocpServerJob::GetCallBackObject()
 {
 	return m_callBackObj;
+}
+
+IoContext *IocpServerJob::GetIoContext()
+{
+	return &m_ioContext;
+}
+
+void IocpServerJob::CompleteSend(SendStatus status)
+{
+	if(m_completeEvent)
+		m_completeEvent->SetEvent();
+	if(m_callBackObj)
+		m_callBackObj->OnSent(m_socket,status);
+	else
+		m_socket->GetCallbackObject()->OnSent(m_socket,status);
+}
+
+void IocpServerJob::CompleteReceive(const Packet *receivedPacket,ReceiveStatus status)
+{
+	if(m_completeEvent)
+		m_completeEvent->SetEvent();
+	if(m_callBackObj)
+		m_callBackObj->OnReceived(m_socket,receivedPacket,status);
+	else if(status!=RECEIVE_STATUS_SUCCESS || !m_socket->dispatchReceived(receivedPacket))
+		m_socket->GetCallbackObject()->OnReceived(m_socket,receivedPacket,status);
+}
+
+void IocpServerJob::OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)
+{
+	m_socket->completeJob(this,transferredByte,isSucceeded);
+	// release the reference held by the operation
+	ReleaseObj();
 }
\ No newline at end of file
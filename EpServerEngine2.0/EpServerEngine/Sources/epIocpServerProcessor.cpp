@@ -31,53 +31,14 @@ using namespace epse;
 void IocpServerProcessor::DoJob(BaseWorkerThread *workerThread,  BaseJob* const data)
 {
 	IocpServerJob * job=reinterpret_cast<IocpServerJob*>(data);
-	Packet *receivedPacket=NULL;
-	SendStatus sendStatus;
-	ReceiveStatus receiveStatus;
 	switch(job->GetJobType())
 	{
 	case IocpServerJob::IOCP_SERVER_JOB_TYPE_NULL:
 		break;
 	case IocpServerJob::IOCP_SERVER_JOB_TYPE_SEND:
-		job->GetSocket()->Send(*job->GetPacket(),0,&sendStatus);
-		
-		if(sendStatus==SEND_STATUS_FAIL_TIME_OUT)
-		{
-			workerThread->Push(data);
-		}
-		else
-		{
-			if(job->GetCompletionEvent())
-				job->GetCompletionEvent()->SetEvent();
-			if(job->GetCallBackObject())
-			{
-				job->GetCallBackObject()->OnSent(job->GetSocket(),sendStatus);
-			}
-			else
-				job->GetSocket()->GetCallbackObject()->OnSent(job->GetSocket(),sendStatus);
-		}
-		break;
 	case IocpServerJob::IOCP_SERVER_JOB_TYPE_RECEIVE:
-		receivedPacket=job->GetSocket()->Receive(0,&receiveStatus);
-		
-		if(receiveStatus==RECEIVE_STATUS_FAIL_TIME_OUT)
-		{
-			workerThread->Push(data);
-		}
-		else
-		{
-			if(job->GetCompletionEvent())
-				job->GetCompletionEvent()->SetEvent();
-			if(job->GetCallBackObject())
-			{
-				job->GetCallBackObject()->OnReceived(job->GetSocket(),receivedPacket,receiveStatus);
-			}
-			else
-				job->GetSocket()->GetCallbackObject()->OnReceived(job->GetSocket(),receivedPacket,receiveStatus);
-			
-			if(receivedPacket)
-				receivedPacket->ReleaseObj();
-		}
+		// the callbacks are called from the Event Loop when the operation is completed.
+		job->GetSocket()->submitJob(job);
 		break;
 	case IocpServerJob::IOCP_SERVER_JOB_TYPE_DISCONNECT:
 		job->GetSocket()->killConnectionNoCallBack();
@@ -34,52 +34,19 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-IocpTcpClient::IocpTcpClient(epl::LockPolicy lockPolicyType) :BaseTcpClient(lockPolicyType)
+IocpTcpClient::IocpTcpClient(epl::LockPolicy lockPolicyType) :BaseTcpClient(lockPolicyType),m_jobScheduler(WAITTIME_INIFINITE,lockPolicyType)
 {
-	switch(lockPolicyType)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
-
 	m_isConnected=false;
 }
 
 
-IocpTcpClient::IocpTcpClient(const IocpTcpClient& b) :BaseTcpClient(b)
+IocpTcpClient::IocpTcpClient(const IocpTcpClient& b) :BaseTcpClient(b),m_jobScheduler(WAITTIME_INIFINITE,b.m_lockPolicy)
 {
-	switch(m_lockPolicy)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
 	m_isConnected=false;
 }
 
 IocpTcpClient::~IocpTcpClient()
 {
-	if(m_workerLock)
-		EP_DELETE m_workerLock;
 }
 
 IocpTcpClient & IocpTcpClient::operator=(const IocpTcpClient&b)
@@ -89,21 +56,6 @@ IocpTcpClient & IocpTcpClient::operator=(const IocpTcpClient&b)
 
 		BaseTcpClient::operator =(b);
 		
-		switch(m_lockPolicy)
-		{
-		case epl::LOCK_POLICY_CRITICALSECTION:
-			m_workerLock=EP_NEW epl::CriticalSectionEx();
-			break;
-		case epl::LOCK_POLICY_MUTEX:
-			m_workerLock=EP_NEW epl::Mutex();
-			break;
-		case epl::LOCK_POLICY_NONE:
-			m_workerLock=EP_NEW epl::NoLock();
-			break;
-		default:
-			m_workerLock=NULL;
-			break;
-		}
 
 		m_isConnected=false;
 	}
@@ -116,34 +68,10 @@ void IocpTcpClient::execute()
 
 bool IocpTcpClient::Connect(const ClientOps &ops)
 {
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
-
-	for(int trav=0;trav<m_workerList.size();trav++)
-	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
-	}
-	m_workerList.clear();
-
-	int workerCount=ops.workerThreadCount;
-	if(workerCount==0)
-	{
-		workerCount=System::GetNumberOfCores()*2;
-	}
-	for(int trav=0;trav<workerCount;trav++)
-	{
-		BaseWorkerThread *workerThread=WorkerThreadFactory::GetWorkerThread(BaseWorkerThread::THREAD_LIFE_SUSPEND_AFTER_WORK);
-
-		workerThread->SetCallBackClass(this);
-
-		m_workerList.push_back(workerThread);
-		m_emptyWorkerList.push(workerThread);
-		workerThread->SetJobProcessor(EP_NEW IocpClientProcessor());
-		workerThread->Start();
-	}
-	m_workerLock->Unlock();
+	IocpClientProcessor *jobProcessor=EP_NEW IocpClientProcessor();
+	m_jobScheduler.SetWaitTime(ops.waitTimeMilliSec);
+	m_jobScheduler.StartWorkers(ops.workerThreadCount,jobProcessor);
+	jobProcessor->ReleaseObj();
 
 	epl::LockObj lock(m_generalLock);
 	if(IsConnectionAlive())
@@ -151,6 +79,9 @@ bool IocpTcpClient::Connect(const ClientOps &ops)
 
 	if(ops.callBackObj)
 		m_callBackObj=ops.callBackObj;
+	m_messageDispatcher=ops.messageDispatcher;
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
+	setReceiveLimit(ops.maxFrameByteSize,ops.receiveChunkByteSize);
 	EP_ASSERT(m_callBackObj);
 
 	if(ops.hostName)
@@ -172,6 +103,7 @@ bool IocpTcpClient::Connect(const ClientOps &ops)
 		m_hostName=DEFAULT_HOSTNAME;
 	}
 	SetWaitTime(ops.waitTimeMilliSec);
+	m_frameCodec.Reset(ops.frameVersion,true);
 
 
 	WSADATA wsaData;
@@ -226,6 +158,9 @@ bool IocpTcpClient::Connect(const ClientOps &ops)
 		cleanUpClient();
 		return false;
 	}
+	// discard the data left from the previous connection
+	m_recvBuffer.Clear();
+	m_pendingSendBuffer.Clear();
 	m_isConnected=true;
 	return true;
 
@@ -262,17 +197,7 @@ void IocpTcpClient::Disconnect()
 
 	cleanUpClient();
 
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
-
-	for(int trav=0;trav<m_workerList.size();trav++)
-	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
-	}
-	m_workerList.clear();
-	m_workerLock->Unlock();
+	m_jobScheduler.StopWorkers();
 
 	m_callBackObj->OnDisconnect(this);
 	
@@ -286,17 +211,7 @@ void IocpTcpClient::disconnect()
 		m_isConnected=false;	
 		cleanUpClient();
 
-		m_workerLock->Lock();
-		while(!m_emptyWorkerList.empty())
-			m_emptyWorkerList.pop();
-
-		for(int trav=0;trav<m_workerList.size();trav++)
-		{
-			m_workerList.at(trav)->TerminateWorker(m_waitTime);
-			EP_DELETE m_workerList.at(trav);
-		}
-		m_workerList.clear();
-		m_workerLock->Unlock();
+		m_jobScheduler.StopWorkers();
 
 		m_callBackObj->OnDisconnect(this);
 	}
@@ -320,10 +235,10 @@ void IocpTcpClient::Receive(EventEx *completionEvent,ClientCallbackInterface *ca
 	newJob->ReleaseObj();
 }
 
-int IocpTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int IocpTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_generalLock);
-	return BaseTcpClient::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseTcpClient::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 Packet *IocpTcpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *retStatus)
@@ -336,6 +251,15 @@ Packet *IocpTcpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 		return NULL;
 	}
 
+	// packet already in the receive buffer
+	Packet *recvPacket=popPacket();
+	if(recvPacket)
+	{
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
+	}
+
 	// select routine
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
@@ -371,77 +295,32 @@ Packet *IocpTcpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 	}
 
 	// receive routine
-	int iResult;
-	int size =receive(m_recvSizePacket);
-	if(size>0)
-	{
-		unsigned int shouldReceive=(reinterpret_cast<unsigned int*>(const_cast<char*>(m_recvSizePacket.GetPacket())))[0];
-		Packet *recvPacket=EP_NEW Packet(NULL,shouldReceive);
-		iResult = receive(*recvPacket);
-
-		if (iResult == shouldReceive) {
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_SUCCESS;
-			return recvPacket;
-		}
-		else if (iResult == 0)
-		{
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			disconnect();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
-			return NULL;
-		}
-		else  {
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			disconnect();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
-			return NULL;
-		}
+	int iResult =receive(recvPacket);
+	if (iResult > 0) {
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
 	}
-	else
+	else if (iResult == 0)
 	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		disconnect();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
+		return NULL;
+	}
+	else  {
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 		disconnect();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
 		return NULL;
 	}
 }
 
 
-void IocpTcpClient::CallBackFunc(BaseWorkerThread *p)
-{
-	epl::LockObj lock(m_workerLock);
-	m_emptyWorkerList.push(p);
-}
 
 void IocpTcpClient::pushJob(BaseJob * job)
 {
-	epl::LockObj lock(m_workerLock);
-	if(m_emptyWorkerList.size())
-	{
-		m_emptyWorkerList.front()->Push(job);
-		m_emptyWorkerList.pop();
-	}
-	else
-	{
-		if(!m_workerList.size())
-		{
-			return;
-		}
-
-		size_t jobCount=m_workerList.at(0)->GetJobCount();
-		int workerIdx=0;	
-
-		for(int trav=1;trav<m_workerList.size();trav++)
-		{
-			if(m_workerList.at(trav)->GetJobCount()<jobCount)
-			{
-				jobCount=m_workerList.at(trav)->GetJobCount();
-				workerIdx=trav;
-			}
-		}
-		m_workerList.at(workerIdx)->Push(job);
-	}
+	m_jobScheduler.Push(job);
 }
@@ -35,50 +35,18 @@ static char THIS_FILE[] = __FILE__;
 using namespace epse;
 
 
-IocpTcpServer::IocpTcpServer(epl::LockPolicy lockPolicyType):BaseTcpServer(lockPolicyType)
+IocpTcpServer::IocpTcpServer(epl::LockPolicy lockPolicyType):BaseTcpServer(lockPolicyType),m_jobScheduler(WAITTIME_INIFINITE,lockPolicyType),m_eventLoopGroup(WAITTIME_INIFINITE,lockPolicyType),m_timerList(lockPolicyType),m_socketPool(SOCKET_POOL_CAPACITY_DEFAULT,lockPolicyType)
 {
-	switch(lockPolicyType)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
 }
 
 
-IocpTcpServer::IocpTcpServer(const IocpTcpServer& b):BaseTcpServer(b)
+IocpTcpServer::IocpTcpServer(const IocpTcpServer& b):BaseTcpServer(b),m_jobScheduler(WAITTIME_INIFINITE,b.m_lockPolicy),m_eventLoopGroup(WAITTIME_INIFINITE,b.m_lockPolicy),m_timerList(b.m_lockPolicy),m_socketPool(SOCKET_POOL_CAPACITY_DEFAULT,b.m_lockPolicy)
 {
-	switch(m_lockPolicy)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
 	LockObj lock(b.m_baseServerLock);
 }
 
 IocpTcpServer::~IocpTcpServer()
 {
-	if(m_workerLock)
-		EP_DELETE m_workerLock;
 }
 
 IocpTcpServer & IocpTcpServer::operator=(const IocpTcpServer&b)
@@ -86,111 +54,80 @@ IocpTcpServer & IocpTcpServer::operator=(const IocpTcpServer&b)
 	if(this!=&b)
 	{
 		BaseTcpServer::operator =(b);
-		switch(m_lockPolicy)
-		{
-		case epl::LOCK_POLICY_CRITICALSECTION:
-			m_workerLock=EP_NEW epl::CriticalSectionEx();
-			break;
-		case epl::LOCK_POLICY_MUTEX:
-			m_workerLock=EP_NEW epl::Mutex();
-			break;
-		case epl::LOCK_POLICY_NONE:
-			m_workerLock=EP_NEW epl::NoLock();
-			break;
-		default:
-			m_workerLock=NULL;
-			break;
-		}
 		LockObj lock(b.m_baseServerLock);
 
 	}
 	return *this;
 }
 
-void IocpTcpServer::CallBackFunc(BaseWorkerThread *p)
-{
-	epl::LockObj lock(m_workerLock);
-	m_emptyWorkerList.push(p);
-}
 void IocpTcpServer::pushJob(BaseJob * job)
 {
-	epl::LockObj lock(m_workerLock);
-	if(m_emptyWorkerList.size())
-	{
-		m_emptyWorkerList.front()->Push(job);
-		m_emptyWorkerList.pop();
-	}
-	else
-	{
-		if(!m_workerList.size())
-		{
-			return;
-		}
-
-		size_t jobCount=m_workerList.at(0)->GetJobCount();
-		int workerIdx=0;	
-		
-		for(int trav=1;trav<m_workerList.size();trav++)
-		{
-			if(m_workerList.at(trav)->GetJobCount()<jobCount)
-			{
-				jobCount=m_workerList.at(trav)->GetJobCount();
-				workerIdx=trav;
-			}
-		}
-		m_workerList.at(workerIdx)->Push(job);
-	}
+	m_jobScheduler.Push(job);
 }
 
 void IocpTcpServer::StopServer()
 {
 	BaseTcpServer::StopServer();
 
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
+	m_jobScheduler.StopWorkers();
 
-	for(int trav=0;trav<m_workerList.size();trav++)
-	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
-	}
-	m_workerList.clear();
-	m_workerLock->Unlock();
+	m_timerList.Clear();
+	m_eventLoopGroup.StopLoops();
+	m_socketPool.Clear();
 }
 
-bool IocpTcpServer::StartServer(const ServerOps &ops)
+unsigned int IocpTcpServer::ScheduleTimer(unsigned int delayMilliSec,unsigned int periodMilliSec)
+{
+	return m_timerList.Schedule(this,m_eventLoopGroup.GetEventLoop(),delayMilliSec,periodMilliSec);
+}
+
+bool IocpTcpServer::CancelTimer(unsigned int timerId)
 {
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
+	return m_timerList.Cancel(timerId);
+}
 
-	for(int trav=0;trav<m_workerList.size();trav++)
+void IocpTcpServer::OnTimer(Timer *timer)
+{
+	unsigned int timerId=timer->GetTimerId();
+	m_callBackObj->OnTimer(timerId);
+	// the timer expiring once is done
+	if(timer->GetPeriod()==0)
+		m_timerList.Cancel(timerId);
+}
+
+bool IocpTcpServer::StartServer(const ServerOps &ops)
+{
+	if(IsServerStarted())
+		return true;
+
+	m_socketPool.SetCapacity(ops.socketPoolCapacity);
+	// the workers left by the previous failed start are stopped first
+	IocpServerProcessor *jobProcessor=EP_NEW IocpServerProcessor();
+	m_jobScheduler.SetWaitTime(ops.waitTimeMilliSec);
+	bool isStarted=m_jobScheduler.StartWorkers(ops.workerThreadCount,jobProcessor);
+	jobProcessor->ReleaseObj();
+	if(!isStarted)
 	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the worker threads\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_jobScheduler.StopWorkers();
+		return false;
 	}
-	m_workerList.clear();
 
-	int workerCount=ops.workerThreadCount;
-	if(workerCount==0)
+	m_eventLoopGroup.SetWaitTime(ops.waitTimeMilliSec);
+	if(!m_eventLoopGroup.StartLoops())
 	{
-		workerCount=System::GetNumberOfCores()*2;
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the event loops\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_jobScheduler.StopWorkers();
+		m_eventLoopGroup.StopLoops();
+		return false;
 	}
-	for(int trav=0;trav<workerCount;trav++)
+	if(!BaseTcpServer::StartServer(ops))
 	{
-		BaseWorkerThread *workerThread=WorkerThreadFactory::GetWorkerThread(BaseWorkerThread::THREAD_LIFE_SUSPEND_AFTER_WORK);
-		
-		workerThread->SetCallBackClass(this);
-
-		m_workerList.push_back(workerThread);
-		m_emptyWorkerList.push(workerThread);
-		workerThread->SetJobProcessor(EP_NEW IocpServerProcessor());
-		workerThread->Start();
+		m_jobScheduler.StopWorkers();
+		m_eventLoopGroup.StopLoops();
+		return false;
 	}
-	m_workerLock->Unlock();
-	
-	return BaseTcpServer::StartServer(ops);
+	return true;
 }
 
 void IocpTcpServer::execute()
@@ -212,16 +149,40 @@ void IocpTcpServer::execute()
 				closesocket(clientSocket);
 				continue;
 			}
-			IocpTcpSocket *accWorker=EP_NEW IocpTcpSocket(m_callBackObj,m_waitTime,m_lockPolicy);
+			EventLoop *eventLoop=m_eventLoopGroup.GetEventLoop();
+			if(!eventLoop || !eventLoop->Register(clientSocket))
+			{
+				closesocket(clientSocket);
+				continue;
+			}
+			IocpTcpSocket *accWorker=(IocpTcpSocket*)m_socketPool.Acquire();
+			if(accWorker)
+			{
+				accWorker->SetCallbackObject(m_callBackObj);
+				accWorker->SetWaitTime(m_waitTime);
+			}
+			else
+			{
+				accWorker=EP_NEW IocpTcpSocket(m_callBackObj,m_waitTime,m_lockPolicy);
+			}
 			if(!accWorker)
 			{
 				closesocket(clientSocket);
 				continue;
 			}
+			accWorker->setSocketPool(&m_socketPool);
 			accWorker->setClientSocket(clientSocket);
+			accWorker->setCompressor(&m_compressor);
+			accWorker->setFrameVersion(m_frameVersion);
+			// the chunks are not delivered through the receive jobs
+			accWorker->setReceiveLimit(m_maxFrameByteSize,RECEIVE_CHUNK_BYTE_SIZE_NONE);
+			accWorker->setSendQueueWatermark(m_sendQueueHighWatermark,m_sendQueueLowWatermark,m_sendQueueLimit);
 			accWorker->setSockAddr(sockAddr);
+			accWorker->setEventLoop(eventLoop);
+			accWorker->setTimerEventLoop(eventLoop);
 
 			accWorker->setOwner(this);
+			accWorker->setMessageDispatcher(m_messageDispatcher);
 			m_socketList.Push(accWorker);	
 			accWorker->Start();
 			accWorker->ReleaseObj();
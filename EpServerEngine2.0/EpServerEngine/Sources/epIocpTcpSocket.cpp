@@ -36,11 +36,19 @@ using namespace epse;
 IocpTcpSocket::IocpTcpSocket(ServerCallbackInterface *callBackObj,unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType): BaseTcpSocket(callBackObj,waitTimeMilliSec,lockPolicyType)
 {
 	m_isConnected=true;
+	m_eventLoop=NULL;
+}
+
+void IocpTcpSocket::setEventLoop(EventLoop *eventLoop)
+{
+	m_eventLoop=eventLoop;
 }
 
 IocpTcpSocket::~IocpTcpSocket()
 {
+	m_socketPool=NULL;
 	killConnection();
+	failReceiveJobs(RECEIVE_STATUS_FAIL_NOT_CONNECTED);
 }
 
 bool IocpTcpSocket::IsConnectionAlive() const
@@ -61,24 +69,20 @@ void IocpTcpSocket::KillConnection()
 
 void IocpTcpSocket::killConnection()
 {
-	if(IsConnectionAlive())
-	{
-		m_isConnected=false;
-		// No longer need client socket
-		if(m_clientSocket!=INVALID_SOCKET)
-		{
-			closesocket(m_clientSocket);
-			m_clientSocket = INVALID_SOCKET;
-		}
+	m_baseSocketLock->Lock();
+	bool isKilled=IsConnectionAlive();
+	if(isKilled)
+		killConnectionNoCallBack();
+	m_baseSocketLock->Unlock();
 
-
-		removeSelfFromContainer();
+	// the callback is called without the lock
+	if(isKilled)
 		m_callBackObj->OnDisconnect(this);
-	}
 }
 
 void IocpTcpSocket::killConnectionNoCallBack()
 {
+	epl::LockObj lock(m_baseSocketLock);
 	if(IsConnectionAlive())
 	{
 		m_isConnected=false;
@@ -88,15 +92,29 @@ void IocpTcpSocket::killConnectionNoCallBack()
 			closesocket(m_clientSocket);
 			m_clientSocket = INVALID_SOCKET;
 		}
+		cancelIdleTimer();
 
 
 		removeSelfFromContainer();
+		retireToPool();
 	}
 }
 
 void IocpTcpSocket::Send(Packet &packet,EventEx *completionEvent,ServerCallbackInterface *callBackObj,Priority priority)
 {
 	IocpServerJob *newJob= EP_NEW IocpServerJob(this,IocpServerJob::IOCP_SERVER_JOB_TYPE_SEND,&packet,completionEvent,callBackObj,priority,m_lockPolicy);
+	bool isFull=false;
+	if(!m_sendQueue.Reserve(packet.GetPacketByteSize()+sizeof(unsigned int),isFull))
+	{
+		// the slow client is disconnected rather than growing the memory
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Send queue exceeded the limit\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		killConnection();
+		newJob->CompleteSend(SEND_STATUS_FAIL_SEND_QUEUE_FULL);
+		newJob->ReleaseObj();
+		return;
+	}
+	if(isFull)
+		m_callBackObj->OnSendQueueFull(this);
 	((IocpTcpServer*)m_owner)->pushJob(newJob);
 	newJob->ReleaseObj();
 }
@@ -107,10 +125,10 @@ void IocpTcpSocket::Receive(EventEx *completionEvent,ServerCallbackInterface *ca
 	((IocpTcpServer*)m_owner)->pushJob(newJob);
 	newJob->ReleaseObj();
 }
-int IocpTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int IocpTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_baseSocketLock);
-	return BaseTcpSocket::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseTcpSocket::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 Packet *IocpTcpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *retStatus)
@@ -123,6 +141,15 @@ Packet *IocpTcpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 		return NULL;
 	}
 
+	// packet already in the receive buffer
+	Packet *recvPacket=popPacket();
+	if(recvPacket)
+	{
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
+	}
+
 	// select routine
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
@@ -158,44 +185,33 @@ Packet *IocpTcpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 	}
 
 	// receive routine
-	int iResult =receive(m_recvSizePacket);
-	if(iResult>0)
-	{
-		unsigned int shouldReceive=(reinterpret_cast<unsigned int*>(const_cast<char*>(m_recvSizePacket.GetPacket())))[0];
-		Packet *recvPacket=EP_NEW Packet(NULL,shouldReceive);
-		iResult = receive(*recvPacket);
-
-		if (iResult == shouldReceive) {
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_SUCCESS;
-			return recvPacket;
-		}
-		else if (iResult == 0)
-		{
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			killConnection();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
-			return NULL;
-		}
-		else  {
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			killConnection();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
-			return NULL;
-		}
+	int iResult =receive(recvPacket);
+	if (iResult > 0) {
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
 	}
-	else
+	else if (iResult == 0)
 	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 		killConnection();
 		if(retStatus)
 			*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
 		return NULL;
 	}
+	else  {
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		killConnection();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
+		return NULL;
+	}
+}
 
+void IocpTcpSocket::resetConnection()
+{
+	BaseTcpSocket::resetConnection();
+	m_isConnected=true;
 }
 
 void IocpTcpSocket::execute()
@@ -204,3 +220,249 @@ void IocpTcpSocket::execute()
 }
 
 
+
+
+void IocpTcpSocket::submitJob(IocpServerJob *job)
+{
+	switch(job->GetJobType())
+	{
+	case IocpServerJob::IOCP_SERVER_JOB_TYPE_SEND:
+		postSend(job);
+		break;
+	case IocpServerJob::IOCP_SERVER_JOB_TYPE_RECEIVE:
+		{
+			m_baseSocketLock->Lock();
+			if(!IsConnectionAlive())
+			{
+				m_baseSocketLock->Unlock();
+				job->CompleteReceive(NULL,RECEIVE_STATUS_FAIL_NOT_CONNECTED);
+				return;
+			}
+			// complete right away if the packet is already in the receive buffer
+			if(m_receiveJobList.empty() && m_recvBuffer.IsPacketAvailable())
+			{
+				Packet *recvPacket=m_recvBuffer.PopPacket();
+				m_baseSocketLock->Unlock();
+				// the packet failed to decompress corrupts the rest of the stream
+				if(!recvPacket)
+				{
+					epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Received the corrupted frame\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+					killConnection();
+					job->CompleteReceive(NULL,RECEIVE_STATUS_FAIL_RECEIVE_FAILED);
+					return;
+				}
+				job->CompleteReceive(recvPacket,RECEIVE_STATUS_SUCCESS);
+				recvPacket->ReleaseObj();
+				return;
+			}
+			// the reference is released when the job is completed.
+			job->RetainObj();
+			m_receiveJobList.push(job);
+			bool isFailed=(m_receiveJobList.size()==1 && !postReceive());
+			m_baseSocketLock->Unlock();
+			if(isFailed)
+			{
+				killConnection();
+				failReceiveJobs(RECEIVE_STATUS_FAIL_RECEIVE_FAILED);
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void IocpTcpSocket::completeSend(IocpServerJob *job,SendStatus status)
+{
+	bool isDrained=m_sendQueue.Release(job->m_packetByteSize+sizeof(unsigned int));
+	job->CompleteSend(status);
+	if(isDrained)
+		m_callBackObj->OnSendQueueDrained(this);
+}
+
+void IocpTcpSocket::postSend(IocpServerJob *job)
+{
+	if(job->m_packetByteSize==0)
+	{
+		completeSend(job,SEND_STATUS_SUCCESS);
+		return;
+	}
+
+	m_baseSocketLock->Lock();
+	if(!IsConnectionAlive() || m_clientSocket==INVALID_SOCKET)
+	{
+		m_baseSocketLock->Unlock();
+		completeSend(job,SEND_STATUS_FAIL_NOT_CONNECTED);
+		return;
+	}
+
+	// the header is written in the order of the sends posted
+	const Packet *packet=job->GetPacket();
+	job->m_frameHeaderByteSize=m_frameCodec.EncodeFrame(*packet,job->m_frameHeader,job->m_compressedPacket);
+
+	// send the header and the packet together
+	// the header stays in the job since the packet may be in flight on other sockets as well
+	WSABUF wsaBuf[2];
+	DWORD wsaBufCount=2;
+	wsaBuf[0].buf=job->m_frameHeader;
+	wsaBuf[0].len=job->m_frameHeaderByteSize;
+	if(job->m_compressedPacket)
+	{
+		wsaBuf[1].buf=const_cast<char*>(job->m_compressedPacket->GetPacket());
+		wsaBuf[1].len=job->m_compressedPacket->GetPacketByteSize();
+	}
+	else
+	{
+		wsaBuf[1].buf=const_cast<char*>(packet->GetPacket());
+		wsaBuf[1].len=job->m_packetByteSize;
+	}
+	// the reference is released when the operation is completed.
+	job->RetainObj();
+	job->GetIoContext()->Reset();
+	m_eventLoop->BeginIo();
+	if(WSASend(m_clientSocket,wsaBuf,wsaBufCount,NULL,0,&job->GetIoContext()->m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
+	{
+		m_eventLoop->AbortIo();
+		m_baseSocketLock->Unlock();
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) WSASend failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		completeSend(job,SEND_STATUS_FAIL_SEND_FAILED);
+		job->ReleaseObj();
+		return;
+	}
+	m_baseSocketLock->Unlock();
+}
+
+bool IocpTcpSocket::postReceive()
+{
+	if(m_receiveJobList.empty() || m_clientSocket==INVALID_SOCKET)
+		return false;
+
+	IocpServerJob *job=m_receiveJobList.front();
+	WSABUF wsaBuf;
+	unsigned int writableByteSize=0;
+	wsaBuf.buf=m_recvBuffer.GetWriteBuffer(writableByteSize);
+	wsaBuf.len=writableByteSize;
+	DWORD flags=0;
+
+	// the reference is released when the operation is completed.
+	job->RetainObj();
+	job->GetIoContext()->Reset();
+	m_eventLoop->BeginIo();
+	if(WSARecv(m_clientSocket,&wsaBuf,1,NULL,&flags,&job->GetIoContext()->m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) WSARecv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_eventLoop->AbortIo();
+		job->ReleaseObj();
+		return false;
+	}
+	return true;
+}
+
+void IocpTcpSocket::failReceiveJobs(ReceiveStatus status)
+{
+	m_baseSocketLock->Lock();
+	queue<IocpServerJob*> jobList;
+	while(!m_receiveJobList.empty())
+	{
+		jobList.push(m_receiveJobList.front());
+		m_receiveJobList.pop();
+	}
+	m_recvBuffer.Clear();
+	m_baseSocketLock->Unlock();
+
+	while(!jobList.empty())
+	{
+		IocpServerJob *job=jobList.front();
+		jobList.pop();
+		job->CompleteReceive(NULL,status);
+		job->ReleaseObj();
+		status=RECEIVE_STATUS_FAIL_NOT_CONNECTED;
+	}
+}
+
+void IocpTcpSocket::completeJob(IocpServerJob *job,unsigned int transferredByte,bool isSucceeded)
+{
+	if(job->GetJobType()==IocpServerJob::IOCP_SERVER_JOB_TYPE_SEND)
+	{
+		unsigned int frameByteSize=job->m_frameHeaderByteSize+job->m_packetByteSize;
+		if(job->m_compressedPacket)
+		{
+			frameByteSize=job->m_frameHeaderByteSize+job->m_compressedPacket->GetPacketByteSize();
+			job->m_compressedPacket->ReleaseObj();
+			job->m_compressedPacket=NULL;
+		}
+		if(isSucceeded && transferredByte==frameByteSize)
+			completeSend(job,SEND_STATUS_SUCCESS);
+		else
+			completeSend(job,SEND_STATUS_FAIL_SEND_FAILED);
+		return;
+	}
+
+	m_baseSocketLock->Lock();
+	if(!IsConnectionAlive())
+	{
+		m_baseSocketLock->Unlock();
+		failReceiveJobs(RECEIVE_STATUS_FAIL_NOT_CONNECTED);
+		return;
+	}
+	if(!isSucceeded || transferredByte==0)
+	{
+		m_baseSocketLock->Unlock();
+		if(transferredByte==0 && isSucceeded)
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			killConnection();
+			failReceiveJobs(RECEIVE_STATUS_FAIL_CONNECTION_CLOSING);
+		}
+		else
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			killConnection();
+			failReceiveJobs(RECEIVE_STATUS_FAIL_RECEIVE_FAILED);
+		}
+		return;
+	}
+
+	m_recvBuffer.CommitWrite(transferredByte);
+	updateLastActiveTime();
+
+	// complete the waiting jobs in order with every packet received
+	queue<IocpServerJob*> completedJobList;
+	queue<Packet*> recvPacketList;
+	while(!m_receiveJobList.empty() && m_recvBuffer.IsPacketAvailable())
+	{
+		// NULL if the packet failed to decompress, which corrupts the stream
+		Packet *recvPacket=m_recvBuffer.PopPacket();
+		if(!recvPacket)
+			break;
+		completedJobList.push(m_receiveJobList.front());
+		m_receiveJobList.pop();
+		recvPacketList.push(recvPacket);
+	}
+	// the rest of the corrupted stream can not be parsed, and the packet exceeding the maximum byte size is never buffered
+	bool isCorrupted=m_recvBuffer.IsCorrupted();
+	bool isFailed=(!isCorrupted && !m_receiveJobList.empty() && !postReceive());
+	m_baseSocketLock->Unlock();
+
+	while(!completedJobList.empty())
+	{
+		IocpServerJob *completedJob=completedJobList.front();
+		Packet *recvPacket=recvPacketList.front();
+		completedJobList.pop();
+		recvPacketList.pop();
+		completedJob->CompleteReceive(recvPacket,RECEIVE_STATUS_SUCCESS);
+		recvPacket->ReleaseObj();
+		completedJob->ReleaseObj();
+	}
+	if(isCorrupted)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Received the corrupted frame or the packet exceeding the maximum byte size\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		killConnection();
+		failReceiveJobs(RECEIVE_STATUS_FAIL_RECEIVE_FAILED);
+	}
+	else if(isFailed)
+	{
+		killConnection();
+		failReceiveJobs(RECEIVE_STATUS_FAIL_RECEIVE_FAILED);
+	}
+}
\ No newline at end of file
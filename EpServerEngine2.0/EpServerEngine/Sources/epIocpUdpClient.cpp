@@ -36,53 +36,20 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-IocpUdpClient::IocpUdpClient(epl::LockPolicy lockPolicyType): BaseUdpClient(lockPolicyType)
+IocpUdpClient::IocpUdpClient(epl::LockPolicy lockPolicyType): BaseUdpClient(lockPolicyType),m_jobScheduler(WAITTIME_INIFINITE,lockPolicyType)
 {
-	switch(lockPolicyType)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
-
 	m_isConnected=false;
 
 }
 
 
-IocpUdpClient::IocpUdpClient(const IocpUdpClient& b):BaseUdpClient(b)
+IocpUdpClient::IocpUdpClient(const IocpUdpClient& b):BaseUdpClient(b),m_jobScheduler(WAITTIME_INIFINITE,b.m_lockPolicy)
 {
-	switch(m_lockPolicy)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
 
 	m_isConnected=false;
 }
 IocpUdpClient::~IocpUdpClient()
 {
-	if(m_workerLock)
-		EP_DELETE m_workerLock;
 }
 IocpUdpClient & IocpUdpClient::operator=(const IocpUdpClient&b)
 {
@@ -91,21 +58,6 @@ IocpUdpClient & IocpUdpClient::operator=(const IocpUdpClient&b)
 
 		BaseUdpClient::operator =(b);
 
-		switch(m_lockPolicy)
-		{
-		case epl::LOCK_POLICY_CRITICALSECTION:
-			m_workerLock=EP_NEW epl::CriticalSectionEx();
-			break;
-		case epl::LOCK_POLICY_MUTEX:
-			m_workerLock=EP_NEW epl::Mutex();
-			break;
-		case epl::LOCK_POLICY_NONE:
-			m_workerLock=EP_NEW epl::NoLock();
-			break;
-		default:
-			m_workerLock=NULL;
-			break;
-		}
 
 		m_isConnected=false;
 	}
@@ -117,34 +69,10 @@ IocpUdpClient & IocpUdpClient::operator=(const IocpUdpClient&b)
 
 bool IocpUdpClient::Connect(const ClientOps &ops)
 {
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
-
-	for(int trav=0;trav<m_workerList.size();trav++)
-	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
-	}
-	m_workerList.clear();
-
-	int workerCount=ops.workerThreadCount;
-	if(workerCount==0)
-	{
-		workerCount=System::GetNumberOfCores()*2;
-	}
-	for(int trav=0;trav<workerCount;trav++)
-	{
-		BaseWorkerThread *workerThread=WorkerThreadFactory::GetWorkerThread(BaseWorkerThread::THREAD_LIFE_SUSPEND_AFTER_WORK);
-
-		workerThread->SetCallBackClass(this);
-
-		m_workerList.push_back(workerThread);
-		m_emptyWorkerList.push(workerThread);
-		workerThread->SetJobProcessor(EP_NEW IocpClientProcessor());
-		workerThread->Start();
-	}
-	m_workerLock->Unlock();
+	IocpClientProcessor *jobProcessor=EP_NEW IocpClientProcessor();
+	m_jobScheduler.SetWaitTime(ops.waitTimeMilliSec);
+	m_jobScheduler.StartWorkers(ops.workerThreadCount,jobProcessor);
+	jobProcessor->ReleaseObj();
 
 	epl::LockObj lock(m_generalLock);
 	if(IsConnectionAlive())
@@ -152,6 +80,8 @@ bool IocpUdpClient::Connect(const ClientOps &ops)
 
 	if(ops.callBackObj)
 		m_callBackObj=ops.callBackObj;
+	m_messageDispatcher=ops.messageDispatcher;
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
 	EP_ASSERT(m_callBackObj);
 
 	if(ops.hostName)
@@ -220,6 +150,7 @@ bool IocpUdpClient::Connect(const ClientOps &ops)
 
 	int nTmp = sizeof(int);
 	getsockopt(m_connectSocket, SOL_SOCKET,SO_MAX_MSG_SIZE, (char *)&m_maxPacketSize,&nTmp);
+	setUpSessions(ops.isReliableUdp,ops.isFragmentedUdp);
 	m_isConnected=true;
 	return true;
 }
@@ -252,17 +183,7 @@ void IocpUdpClient::Disconnect()
 	}
 	cleanUpClient();
 	
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
-
-	for(int trav=0;trav<m_workerList.size();trav++)
-	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
-	}
-	m_workerList.clear();
-	m_workerLock->Unlock();
+	m_jobScheduler.StopWorkers();
 
 
 	m_callBackObj->OnDisconnect(this);
@@ -280,17 +201,7 @@ void IocpUdpClient::disconnect()
 		m_isConnected=false;
 		cleanUpClient();
 	
-		m_workerLock->Lock();
-		while(!m_emptyWorkerList.empty())
-			m_emptyWorkerList.pop();
-
-		for(int trav=0;trav<m_workerList.size();trav++)
-		{
-			m_workerList.at(trav)->TerminateWorker(m_waitTime);
-			EP_DELETE m_workerList.at(trav);
-		}
-		m_workerList.clear();
-		m_workerLock->Unlock();
+		m_jobScheduler.StopWorkers();
 
 		m_callBackObj->OnDisconnect(this);		
 	}
@@ -311,10 +222,10 @@ void IocpUdpClient::Receive(EventEx *completionEvent,ClientCallbackInterface *ca
 	newJob->ReleaseObj();
 }
 
-int IocpUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int IocpUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_generalLock);
-	return BaseUdpClient::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseUdpClient::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 
@@ -328,6 +239,26 @@ Packet *IocpUdpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 		return NULL;
 	}
 
+	if(!updateReliable())
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Server not responding...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		disconnect();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
+		return NULL;
+	}
+	Packet *readyPacket=popReceivedPacket();
+	if(readyPacket)
+	{
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return readyPacket;
+	}
+
+	// the caller's receive loop drives the retransmission with the reliable UDP
+	if(m_reliableSession && (waitTimeInMilliSec==WAITTIME_INIFINITE || waitTimeInMilliSec>RELIABLE_UDP_TICK_MILLISEC))
+		waitTimeInMilliSec=RELIABLE_UDP_TICK_MILLISEC;
+
 	// select routine
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
@@ -367,7 +298,14 @@ Packet *IocpUdpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 	iResult = receive(recvPacket);
 
 	if (iResult > 0) {
-		Packet *passPacket=EP_NEW Packet(recvPacket.GetPacket(),iResult);
+		Packet *passPacket=createReceivedPacket(recvPacket.GetPacket(),iResult);
+		if(!passPacket)
+		{
+			// the datagram only carried the acknowledgement or an out-of-order packet
+			if(retStatus)
+				*retStatus=RECEIVE_STATUS_FAIL_TIME_OUT;
+			return NULL;
+		}
 		if(retStatus)
 			*retStatus=RECEIVE_STATUS_SUCCESS;
 		return passPacket;
@@ -390,38 +328,8 @@ Packet *IocpUdpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 }
 
 
-void IocpUdpClient::CallBackFunc(BaseWorkerThread *p)
-{
-	epl::LockObj lock(m_workerLock);
-	m_emptyWorkerList.push(p);
-}
 
 void IocpUdpClient::pushJob(BaseJob * job)
 {
-	epl::LockObj lock(m_workerLock);
-	if(m_emptyWorkerList.size())
-	{
-		m_emptyWorkerList.front()->Push(job);
-		m_emptyWorkerList.pop();
-	}
-	else
-	{
-		if(!m_workerList.size())
-		{
-			return;
-		}
-
-		size_t jobCount=m_workerList.at(0)->GetJobCount();
-		int workerIdx=0;	
-
-		for(int trav=1;trav<m_workerList.size();trav++)
-		{
-			if(m_workerList.at(trav)->GetJobCount()<jobCount)
-			{
-				jobCount=m_workerList.at(trav)->GetJobCount();
-				workerIdx=trav;
-			}
-		}
-		m_workerList.at(workerIdx)->Push(job);
-	}
+	m_jobScheduler.Push(job);
 }
@@ -35,50 +35,32 @@ static char THIS_FILE[] = __FILE__;
 using namespace epse;
 
 
-IocpUdpServer::IocpUdpServer(epl::LockPolicy lockPolicyType):BaseUdpServer(lockPolicyType)
+IocpUdpServer::IocpUdpServer(epl::LockPolicy lockPolicyType):BaseUdpServer(lockPolicyType),m_jobScheduler(WAITTIME_INIFINITE,lockPolicyType),m_eventLoopGroup(WAITTIME_INIFINITE,lockPolicyType),m_timerList(lockPolicyType),m_socketPool(SOCKET_POOL_CAPACITY_DEFAULT,lockPolicyType)
 {
-	switch(lockPolicyType)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
+	m_pendingReceiveCount=0;
+	m_eventLoop=NULL;
+	m_receiveStoppedEvent=EventEx(false,false);
+	m_reliableTimerId=TIMER_ID_NONE;
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	m_recvMsgFunc=NULL;
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
 }
 
 
-IocpUdpServer::IocpUdpServer(const IocpUdpServer& b):BaseUdpServer(b)
+IocpUdpServer::IocpUdpServer(const IocpUdpServer& b):BaseUdpServer(b),m_jobScheduler(WAITTIME_INIFINITE,b.m_lockPolicy),m_eventLoopGroup(WAITTIME_INIFINITE,b.m_lockPolicy),m_timerList(b.m_lockPolicy),m_socketPool(SOCKET_POOL_CAPACITY_DEFAULT,b.m_lockPolicy)
 {
-	switch(m_lockPolicy)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_workerLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_workerLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_workerLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_workerLock=NULL;
-		break;
-	}
+	m_pendingReceiveCount=0;
+	m_eventLoop=NULL;
+	m_receiveStoppedEvent=EventEx(false,false);
+	m_reliableTimerId=TIMER_ID_NONE;
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	m_recvMsgFunc=NULL;
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
 	LockObj lock(b.m_baseServerLock);
 }
 
 IocpUdpServer::~IocpUdpServer()
 {
-	if(m_workerLock)
-		EP_DELETE m_workerLock;
 }
 
 IocpUdpServer & IocpUdpServer::operator=(const IocpUdpServer&b)
@@ -86,173 +68,341 @@ IocpUdpServer & IocpUdpServer::operator=(const IocpUdpServer&b)
 	if(this!=&b)
 	{
 		BaseUdpServer::operator =(b);
-		switch(m_lockPolicy)
-		{
-		case epl::LOCK_POLICY_CRITICALSECTION:
-			m_workerLock=EP_NEW epl::CriticalSectionEx();
-			break;
-		case epl::LOCK_POLICY_MUTEX:
-			m_workerLock=EP_NEW epl::Mutex();
-			break;
-		case epl::LOCK_POLICY_NONE:
-			m_workerLock=EP_NEW epl::NoLock();
-			break;
-		default:
-			m_workerLock=NULL;
-			break;
-		}
 		LockObj lock(b.m_baseServerLock);
 
 	}
 	return *this;
 }
 
-void IocpUdpServer::CallBackFunc(BaseWorkerThread *p)
+void IocpUdpServer::pushJob(BaseJob * job)
 {
-	epl::LockObj lock(m_workerLock);
-	m_emptyWorkerList.push(p);
+	m_jobScheduler.Push(job);
 }
-void IocpUdpServer::pushJob(BaseJob * job)
+
+void IocpUdpServer::StopServer()
 {
-	epl::LockObj lock(m_workerLock);
-	if(m_emptyWorkerList.size())
+	BaseUdpServer::StopServer();
+
+	m_jobScheduler.StopWorkers();
+
+	m_timerList.Clear();
+	m_reliableTimerId=TIMER_ID_NONE;
+	m_eventLoopGroup.StopLoops();
+	// the receives aborted are all dispatched when the Event Loops are stopped.
+	deleteReceiveContexts();
+	m_socketPool.Clear();
+}
+
+unsigned int IocpUdpServer::ScheduleTimer(unsigned int delayMilliSec,unsigned int periodMilliSec)
+{
+	return m_timerList.Schedule(this,m_eventLoopGroup.GetEventLoop(),delayMilliSec,periodMilliSec);
+}
+
+bool IocpUdpServer::CancelTimer(unsigned int timerId)
+{
+	return m_timerList.Cancel(timerId);
+}
+
+void IocpUdpServer::OnTimer(Timer *timer)
+{
+	unsigned int timerId=timer->GetTimerId();
+	if(timerId==m_reliableTimerId)
 	{
-		m_emptyWorkerList.front()->Push(job);
-		m_emptyWorkerList.pop();
+		updateReliableSockets();
+		return;
 	}
-	else
+	m_callBackObj->OnTimer(timerId);
+	// the timer expiring once is done
+	if(timer->GetPeriod()==0)
+		m_timerList.Cancel(timerId);
+}
+
+bool IocpUdpServer::StartServer(const ServerOps &ops)
+{
+	if(IsServerStarted())
+		return true;
+
+	m_socketPool.SetCapacity(ops.socketPoolCapacity);
+	// the workers left by the previous failed start are stopped first
+	IocpServerProcessor *jobProcessor=EP_NEW IocpServerProcessor();
+	m_jobScheduler.SetWaitTime(ops.waitTimeMilliSec);
+	bool isStarted=m_jobScheduler.StartWorkers(ops.workerThreadCount,jobProcessor);
+	jobProcessor->ReleaseObj();
+	if(!isStarted)
 	{
-		if(!m_workerList.size())
-		{
-			return;
-		}
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the worker threads\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_jobScheduler.StopWorkers();
+		return false;
+	}
+
+	// all the sends go through the listen socket, so one Event Loop is enough.
+	m_eventLoopGroup.SetWaitTime(ops.waitTimeMilliSec);
+	if(!m_eventLoopGroup.StartLoops(1))
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the event loops\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_jobScheduler.StopWorkers();
+		m_eventLoopGroup.StopLoops();
+		return false;
+	}
+	m_pendingReceiveCount=0;
+	m_receiveStoppedEvent.ResetEvent();
+	if(!BaseUdpServer::StartServer(ops))
+	{
+		m_jobScheduler.StopWorkers();
+		m_eventLoopGroup.StopLoops();
+		return false;
+	}
+	m_eventLoop=m_eventLoopGroup.GetEventLoop();
+	if(!m_eventLoop->Register(m_listenSocket))
+	{
+		m_receiveStoppedEvent.SetEvent();
+		StopServer();
+		return false;
+	}
+	enableReceiveOffload();
+
+	// keep the receives in progress, so the datagrams arrived together are completed together.
+	unsigned int receiveCount=ops.receiveBatchCount;
+	if(receiveCount==0)
+		receiveCount=UDP_RECEIVE_BATCH_COUNT_DEFAULT;
+	deleteReceiveContexts();
+	for(unsigned int trav=0;trav<receiveCount;trav++)
+	{
+		UdpReceiveContext *context=EP_NEW UdpReceiveContext();
+		context->m_callBackObj=this;
+		context->m_slot=NULL;
+		context->m_buffer=NULL;
+		epl::System::Memset(&context->m_sockAddr,0,sizeof(sockaddr));
+		m_receiveContextList.push_back(context);
+		postReceive(context);
+	}
+	if(m_pendingReceiveCount==0)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to post the receives\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_receiveStoppedEvent.SetEvent();
+		StopServer();
+		return false;
+	}
+
+	// the overlapped receives are not woken up by the time-out, so the timer retransmits instead.
+	if(m_isReliableUdp)
+		m_reliableTimerId=m_timerList.Schedule(this,m_eventLoopGroup.GetEventLoop(),RELIABLE_UDP_TICK_MILLISEC,RELIABLE_UDP_TICK_MILLISEC);
+	return true;
+}
 
-		size_t jobCount=m_workerList.at(0)->GetJobCount();
-		int workerIdx=0;	
-		
-		for(int trav=1;trav<m_workerList.size();trav++)
+bool IocpUdpServer::postReceive(UdpReceiveContext *context)
+{
+	InterlockedIncrement(&m_pendingReceiveCount);
+	context->Reset();
+	// receive straight into a slot of the slab, or into the heap buffer if all the slots are in use
+	if(!context->m_slot && m_receiveSlab)
+		context->m_slot=m_receiveSlab->Acquire();
+	if(context->m_slot)
+	{
+		context->m_wsaBuf.buf=context->m_slot->m_buffer;
+	}
+	else
+	{
+		if(!context->m_buffer)
+			context->m_buffer=EP_NEW char[m_maxPacketSize];
+		context->m_wsaBuf.buf=context->m_buffer;
+	}
+	context->m_wsaBuf.len=m_maxPacketSize;
+	context->m_sockAddrSize=sizeof(sockaddr);
+	context->m_flags=0;
+	m_eventLoop->BeginIo();
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	if(m_recvMsgFunc)
+	{
+		System::Memset(&context->m_msg,0,sizeof(WSAMSG));
+		context->m_msg.name=&context->m_sockAddr;
+		context->m_msg.namelen=context->m_sockAddrSize;
+		context->m_msg.lpBuffers=&context->m_wsaBuf;
+		context->m_msg.dwBufferCount=1;
+		context->m_msg.Control.buf=(char*)context->m_controlBuffer;
+		context->m_msg.Control.len=sizeof(context->m_controlBuffer);
+		if(m_recvMsgFunc(m_listenSocket,&context->m_msg,NULL,&context->m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
 		{
-			if(m_workerList.at(trav)->GetJobCount()<jobCount)
-			{
-				jobCount=m_workerList.at(trav)->GetJobCount();
-				workerIdx=trav;
-			}
+			m_eventLoop->AbortIo();
+			finishReceive();
+			return false;
 		}
-		m_workerList.at(workerIdx)->Push(job);
+		return true;
+	}
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	if(WSARecvFrom(m_listenSocket,&context->m_wsaBuf,1,NULL,&context->m_flags,&context->m_sockAddr,&context->m_sockAddrSize,&context->m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
+	{
+		m_eventLoop->AbortIo();
+		finishReceive();
+		return false;
 	}
+	return true;
 }
 
-void IocpUdpServer::StopServer()
+void IocpUdpServer::enableReceiveOffload()
 {
-	BaseUdpServer::StopServer();
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	m_recvMsgFunc=NULL;
+	if(!m_isSegmentationOffload)
+		return;
 
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
-
-	for(int trav=0;trav<m_workerList.size();trav++)
+	// the segment size of the coalesced datagrams only comes with WSARecvMsg
+	GUID recvMsgGuid=WSAID_WSARECVMSG;
+	LPFN_WSARECVMSG recvMsgFunc=NULL;
+	DWORD byteReturned=0;
+	if(WSAIoctl(m_listenSocket,SIO_GET_EXTENSION_FUNCTION_POINTER,&recvMsgGuid,sizeof(GUID),&recvMsgFunc,sizeof(LPFN_WSARECVMSG),&byteReturned,NULL,NULL)==SOCKET_ERROR)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) WSARecvMsg not available\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return;
+	}
+	DWORD maxCoalescedSize=m_maxPacketSize;
+	if(setsockopt(m_listenSocket,IPPROTO_UDP,UDP_RECV_MAX_COALESCED_SIZE,(char*)&maxCoalescedSize,sizeof(DWORD))==SOCKET_ERROR)
 	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) UDP Receive Offload not supported\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return;
 	}
-	m_workerList.clear();
-	m_workerLock->Unlock();
+	m_recvMsgFunc=recvMsgFunc;
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
 }
 
-bool IocpUdpServer::StartServer(const ServerOps &ops)
+void IocpUdpServer::finishReceive()
 {
-	m_workerLock->Lock();
-	while(!m_emptyWorkerList.empty())
-		m_emptyWorkerList.pop();
+	if(InterlockedDecrement(&m_pendingReceiveCount)==0)
+		m_receiveStoppedEvent.SetEvent();
+}
 
-	for(int trav=0;trav<m_workerList.size();trav++)
+void IocpUdpServer::deleteReceiveContexts()
+{
+	vector<UdpReceiveContext*>::iterator iter;
+	for(iter=m_receiveContextList.begin();iter!=m_receiveContextList.end();iter++)
 	{
-		m_workerList.at(trav)->TerminateWorker(m_waitTime);
-		EP_DELETE m_workerList.at(trav);
+		if((*iter)->m_slot)
+			PacketSlab::ReleaseSlot((*iter)->m_slot);
+		if((*iter)->m_buffer)
+			EP_DELETE[] (*iter)->m_buffer;
+		EP_DELETE (*iter);
 	}
-	m_workerList.clear();
+	m_receiveContextList.clear();
+}
 
-	int workerCount=ops.workerThreadCount;
-	if(workerCount==0)
+void IocpUdpServer::OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)
+{
+	UdpReceiveContext *receiveContext=static_cast<UdpReceiveContext*>(context);
+	if(m_listenSocket==INVALID_SOCKET)
 	{
-		workerCount=System::GetNumberOfCores()*2;
+		// aborted by closing the listen socket
+		finishReceive();
+		return;
 	}
-	for(int trav=0;trav<workerCount;trav++)
+	unsigned int segmentByteSize=transferredByte;
+#if defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	if(m_recvMsgFunc && isSucceeded)
 	{
-		BaseWorkerThread *workerThread=WorkerThreadFactory::GetWorkerThread(BaseWorkerThread::THREAD_LIFE_SUSPEND_AFTER_WORK);
-		
-		workerThread->SetCallBackClass(this);
-
-		m_workerList.push_back(workerThread);
-		m_emptyWorkerList.push(workerThread);
-		workerThread->SetJobProcessor(EP_NEW IocpServerProcessor());
-		workerThread->Start();
+		WSACMSGHDR *cmsg;
+		for(cmsg=WSA_CMSG_FIRSTHDR(&receiveContext->m_msg);cmsg;cmsg=WSA_CMSG_NXTHDR(&receiveContext->m_msg,cmsg))
+		{
+			if(cmsg->cmsg_level==IPPROTO_UDP && cmsg->cmsg_type==UDP_COALESCED_INFO)
+			{
+				segmentByteSize=*(DWORD*)WSA_CMSG_DATA(cmsg);
+				break;
+			}
+		}
 	}
-	m_workerLock->Unlock();
-	
-	return BaseUdpServer::StartServer(ops);
+#endif //defined(EP_UDP_SEGMENTATION_OFFLOAD)
+	if(!isSucceeded || segmentByteSize==0 || segmentByteSize>=transferredByte)
+	{
+		processDatagram(receiveContext->m_sockAddr,receiveContext->m_slot,receiveContext->m_wsaBuf.buf,isSucceeded?static_cast<int>(transferredByte):SOCKET_ERROR);
+	}
+	else
+	{
+		// the datagrams from the same sender coalesced by the network stack
+		unsigned int offset;
+		for(offset=0;offset<transferredByte;offset+=segmentByteSize)
+		{
+			unsigned int recvLength=transferredByte-offset;
+			if(recvLength>segmentByteSize)
+				recvLength=segmentByteSize;
+			processDatagram(receiveContext->m_sockAddr,receiveContext->m_slot,receiveContext->m_wsaBuf.buf+offset,static_cast<int>(recvLength));
+		}
+	}
+
+	// the packets delivered keep their own references to the slot
+	if(receiveContext->m_slot)
+		PacketSlab::ReleaseSlot(receiveContext->m_slot);
+	receiveContext->m_slot=NULL;
+
+	// post again before finishing this one, so the count does not hit 0 on the way.
+	postReceive(receiveContext);
+	finishReceive();
 }
 
 void IocpUdpServer::execute()
 {
-	Packet recvPacket(NULL,m_maxPacketSize);
-	char *packetData=const_cast<char*>(recvPacket.GetPacket());
-	int length=recvPacket.GetPacketByteSize();
-	sockaddr clientSockAddr;
-	int sockAddrSize=sizeof(sockaddr);
-	while(m_listenSocket!=INVALID_SOCKET)
-	{
-		int recvLength=recvfrom(m_listenSocket,packetData,length, 0,&clientSockAddr,&sockAddrSize);
+	// the datagrams are received by the Event Loop, so just wait for the receives to be stopped.
+	m_receiveStoppedEvent.WaitForEvent();
+	stopServer();
+} 
 
-		IocpUdpSocket *workerObj=(IocpUdpSocket*)m_socketList.Find(clientSockAddr,socketCompare);
-		if(workerObj)
+void IocpUdpServer::processDatagram(const sockaddr &clientSockAddr,PacketSlot *slot,const char *packetData,int recvLength)
+{
+	IocpUdpSocket *workerObj=(IocpUdpSocket*)m_socketList.Find(clientSockAddr);
+	if(workerObj)
+	{
+		if(recvLength<=0)
 		{
-			if(recvLength<=0)
-			{
-				Packet *passPacket=EP_NEW Packet(packetData,0);
-				workerObj->addPacket(passPacket);
-				passPacket->ReleaseObj();
-				continue;
-			}	
-			Packet *passPacket=EP_NEW Packet(packetData,recvLength);
-			workerObj->addPacket(passPacket);
+			Packet *passPacket=EP_NEW Packet(packetData,0);
+			deliverPacket(workerObj,passPacket);
 			passPacket->ReleaseObj();
-		}
-		else
+			return;
+		}	
+		Packet *passPacket=createReceivedPacket(slot,packetData,recvLength);
+		deliverPacket(workerObj,passPacket);
+		passPacket->ReleaseObj();
+	}
+	else
+	{
+		if(recvLength<=0)
+			return;
+		if(GetMaximumConnectionCount()!=CONNECTION_LIMIT_INFINITE)
 		{
-			if(recvLength<=0)
-				continue;
-			if(GetMaximumConnectionCount()!=CONNECTION_LIMIT_INFINITE)
+			if(m_socketList.Count()>=GetMaximumConnectionCount())
 			{
-				if(m_socketList.Count()>=GetMaximumConnectionCount())
-				{
-					continue;
-				}
+				return;
 			}
-			if(!m_callBackObj->OnAccept(clientSockAddr))
-			{
-				continue;
-			}
-			/// Create Worker Thread
-			IocpUdpSocket *accWorker=EP_NEW IocpUdpSocket(m_callBackObj,m_waitTime,m_lockPolicy);
-			if(!accWorker)
-			{
-				continue;
-			}
-			Packet *passPacket=EP_NEW Packet(packetData,recvLength);
-			accWorker->setSockAddr(clientSockAddr);
-			accWorker->setOwner(this);
-			accWorker->setMaxPacketByteSize(m_maxPacketSize);
-			m_socketList.Push(accWorker);
-			accWorker->Start();
-			accWorker->addPacket(passPacket);
-			accWorker->ReleaseObj();
-			passPacket->ReleaseObj();
-
 		}
+		if(!m_callBackObj->OnAccept(clientSockAddr))
+		{
+			return;
+		}
+		/// Create Worker Thread
+		IocpUdpSocket *accWorker=(IocpUdpSocket*)m_socketPool.Acquire();
+		if(accWorker)
+		{
+			accWorker->SetCallbackObject(m_callBackObj);
+			accWorker->SetWaitTime(m_waitTime);
+		}
+		else
+		{
+			accWorker=EP_NEW IocpUdpSocket(m_callBackObj,m_waitTime,m_lockPolicy);
+		}
+		if(!accWorker)
+		{
+			return;
+		}
+		accWorker->setSocketPool(&m_socketPool);
+		Packet *passPacket=createReceivedPacket(slot,packetData,recvLength);
+		accWorker->setSockAddr(clientSockAddr);
+		accWorker->setOwner(this);
+		accWorker->setMessageDispatcher(m_messageDispatcher);
+		accWorker->setMaxPacketByteSize(GetMaxPacketByteSize());
+		accWorker->setEventLoop(m_eventLoop);
+		accWorker->setUpSessions(m_isReliableUdp,m_isFragmentedUdp);
+		accWorker->setTimerEventLoop(m_eventLoopGroup.GetEventLoop());
+		m_socketList.Push(accWorker);
+		accWorker->Start();
+		deliverPacket(accWorker,passPacket);
+		accWorker->ReleaseObj();
+		passPacket->ReleaseObj();
 
 	}
-
-	stopServer();
-} 
-
+}
\ No newline at end of file
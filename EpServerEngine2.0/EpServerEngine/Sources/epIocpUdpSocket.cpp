@@ -37,10 +37,17 @@ IocpUdpSocket::IocpUdpSocket(ServerCallbackInterface *callBackObj,unsigned int w
 {
 	m_packetReceivedEvent=EventEx(false,false);
 	m_isConnected=true;
+	m_eventLoop=NULL;
+}
+
+void IocpUdpSocket::setEventLoop(EventLoop *eventLoop)
+{
+	m_eventLoop=eventLoop;
 }
 
 IocpUdpSocket::~IocpUdpSocket()
 {
+	m_socketPool=NULL;
 	killConnection();
 }
 
@@ -76,9 +83,12 @@ void IocpUdpSocket::killConnection()
 			m_packetList.pop();
 		}
 		m_listLock->Unlock();
+		failReceiveJobs();
+		cancelIdleTimer();
 
 
 		removeSelfFromContainer();
+		retireToPool();
 		m_callBackObj->OnDisconnect(this);
 
 	}
@@ -100,9 +110,12 @@ void IocpUdpSocket::killConnectionNoCallBack()
 			m_packetList.pop();
 		}
 		m_listLock->Unlock();
+		failReceiveJobs();
+		cancelIdleTimer();
 
 
 		removeSelfFromContainer();
+		retireToPool();
 
 	}
 }
@@ -120,10 +133,10 @@ void IocpUdpSocket::Receive(EventEx *completionEvent,ServerCallbackInterface *ca
 	((IocpUdpServer*)m_owner)->pushJob(newJob);
 	newJob->ReleaseObj();
 }
-int IocpUdpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int IocpUdpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_baseSocketLock);
-	return BaseUdpSocket::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseUdpSocket::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 Packet *IocpUdpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *retStatus)
@@ -171,11 +184,161 @@ Packet *IocpUdpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 
 void IocpUdpSocket::addPacket(Packet *packet)
 {
+	updateLastActiveTime();
+	m_listLock->Lock();
+	if(!m_receiveJobList.empty())
+	{
+		// hand the packet over to the receive job waiting
+		IocpServerJob *job=m_receiveJobList.front();
+		m_receiveJobList.pop();
+		m_listLock->Unlock();
+		deliverPacket(job,packet);
+		job->ReleaseObj();
+		return;
+	}
 	if(packet)
 		packet->RetainObj();
-	epl::LockObj lock(m_listLock);
 	m_packetList.push(packet);
 	m_packetReceivedEvent.SetEvent();
+	m_listLock->Unlock();
+}
+
+void IocpUdpSocket::deliverPacket(IocpServerJob *job,Packet *packet)
+{
+	if(!packet || packet->GetPacketByteSize()==0)
+	{
+		killConnection();
+		job->CompleteReceive(NULL,RECEIVE_STATUS_FAIL_CONNECTION_CLOSING);
+		return;
+	}
+	job->CompleteReceive(packet,RECEIVE_STATUS_SUCCESS);
+}
+
+void IocpUdpSocket::failReceiveJobs()
+{
+	m_listLock->Lock();
+	queue<IocpServerJob*> jobList;
+	while(!m_receiveJobList.empty())
+	{
+		jobList.push(m_receiveJobList.front());
+		m_receiveJobList.pop();
+	}
+	m_listLock->Unlock();
+
+	while(!jobList.empty())
+	{
+		IocpServerJob *job=jobList.front();
+		jobList.pop();
+		job->CompleteReceive(NULL,RECEIVE_STATUS_FAIL_NOT_CONNECTED);
+		job->ReleaseObj();
+	}
+}
+
+void IocpUdpSocket::submitJob(IocpServerJob *job)
+{
+	switch(job->GetJobType())
+	{
+	case IocpServerJob::IOCP_SERVER_JOB_TYPE_SEND:
+		{
+			const Packet *packet=job->GetPacket();
+			if(!IsConnectionAlive() || !m_owner)
+			{
+				job->CompleteSend(SEND_STATUS_FAIL_NOT_CONNECTED);
+				return;
+			}
+			if(packet->GetPacketByteSize()>m_maxPacketSize)
+			{
+				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Packet is larger than the maximum packet size\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+				job->CompleteSend(SEND_STATUS_FAIL_SEND_FAILED);
+				return;
+			}
+			if(packet->GetPacketByteSize()==0)
+			{
+				job->CompleteSend(SEND_STATUS_SUCCESS);
+				return;
+			}
+
+			IocpUdpServer *owner=(IocpUdpServer*)m_owner;
+			WSABUF wsaBuf[2];
+			DWORD wsaBufCount=0;
+			if(owner->m_compressor.IsEnabled())
+			{
+				// the marker of the compression is sent in front of the packet
+				job->m_compressedPacket=owner->m_compressor.CompressDatagram(*packet,job->m_frameHeader[0]);
+				job->m_frameHeaderByteSize=UDP_COMPRESSION_HEADER_BYTE_SIZE;
+				wsaBuf[wsaBufCount].buf=job->m_frameHeader;
+				wsaBuf[wsaBufCount].len=job->m_frameHeaderByteSize;
+				wsaBufCount++;
+				if(job->m_compressedPacket)
+					packet=job->m_compressedPacket;
+			}
+			wsaBuf[wsaBufCount].buf=const_cast<char*>(packet->GetPacket());
+			wsaBuf[wsaBufCount].len=packet->GetPacketByteSize();
+			wsaBufCount++;
+
+			// the reference is released when the operation is completed.
+			job->RetainObj();
+			job->GetIoContext()->Reset();
+			m_eventLoop->BeginIo();
+			if(WSASendTo(owner->m_listenSocket,wsaBuf,wsaBufCount,NULL,0,&m_sockAddr,sizeof(sockaddr),&job->GetIoContext()->m_overlapped,NULL)==SOCKET_ERROR && WSAGetLastError()!=WSA_IO_PENDING)
+			{
+				epl::System::OutputDebugString(_T("%s::%s(%d)(%x) WSASendTo failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+				m_eventLoop->AbortIo();
+				job->CompleteSend(SEND_STATUS_FAIL_SEND_FAILED);
+				job->ReleaseObj();
+			}
+		}
+		break;
+	case IocpServerJob::IOCP_SERVER_JOB_TYPE_RECEIVE:
+		{
+			m_listLock->Lock();
+			if(!IsConnectionAlive())
+			{
+				m_listLock->Unlock();
+				job->CompleteReceive(NULL,RECEIVE_STATUS_FAIL_NOT_CONNECTED);
+				return;
+			}
+			if(m_packetList.empty())
+			{
+				// the reference is released when the packet is added.
+				job->RetainObj();
+				m_receiveJobList.push(job);
+				m_listLock->Unlock();
+				return;
+			}
+			Packet *packet=m_packetList.front();
+			m_packetList.pop();
+			m_listLock->Unlock();
+			deliverPacket(job,packet);
+			if(packet)
+				packet->ReleaseObj();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void IocpUdpSocket::completeJob(IocpServerJob *job,unsigned int transferredByte,bool isSucceeded)
+{
+	unsigned int datagramByteSize=job->m_frameHeaderByteSize+job->GetPacket()->GetPacketByteSize();
+	if(job->m_compressedPacket)
+	{
+		datagramByteSize=job->m_frameHeaderByteSize+job->m_compressedPacket->GetPacketByteSize();
+		job->m_compressedPacket->ReleaseObj();
+		job->m_compressedPacket=NULL;
+	}
+	if(isSucceeded && transferredByte==datagramByteSize)
+		job->CompleteSend(SEND_STATUS_SUCCESS);
+	else
+		job->CompleteSend(SEND_STATUS_FAIL_SEND_FAILED);
+}
+
+void IocpUdpSocket::resetConnection()
+{
+	BaseUdpSocket::resetConnection();
+	m_packetReceivedEvent.ResetEvent();
+	m_isConnected=true;
 }
 
 void IocpUdpSocket::execute()
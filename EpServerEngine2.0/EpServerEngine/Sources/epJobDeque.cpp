@@ -0,0 +1,110 @@
+/*! 
+JobDeque for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epJobDeque.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+JobDeque::JobDeque(unsigned int capacity)
+{
+	m_capacity=2;
+	while(m_capacity<capacity)
+		m_capacity<<=1;
+	m_ring=EP_NEW BaseJob*[m_capacity];
+	m_top=0;
+	m_bottom=0;
+}
+
+JobDeque::~JobDeque()
+{
+	BaseJob *job;
+	while((job=Steal())!=NULL)
+		job->ReleaseObj();
+	if(m_ring)
+		EP_DELETE[] m_ring;
+	m_ring=NULL;
+}
+
+bool JobDeque::Push(BaseJob *job)
+{
+	EP_ASSERT(job);
+	LONG bottom=m_bottom;
+	if(bottom-m_top>=(LONG)m_capacity)
+		return false;
+	job->RetainObj();
+	m_ring[bottom&(m_capacity-1)]=job;
+	// publish the job before the position
+	MemoryBarrier();
+	m_bottom=bottom+1;
+	return true;
+}
+
+BaseJob *JobDeque::Pop()
+{
+	LONG bottom=m_bottom-1;
+	// the thieves must see the position taken before the top is read
+	InterlockedExchange(&m_bottom,bottom);
+	LONG top=m_top;
+	if(bottom-top<0)
+	{
+		m_bottom=top;
+		return NULL;
+	}
+	BaseJob *job=m_ring[bottom&(m_capacity-1)];
+	if(bottom!=top)
+		return job;
+
+	// the last job is raced with the thieves
+	if(InterlockedCompareExchange(&m_top,top+1,top)!=top)
+		job=NULL;
+	m_bottom=top+1;
+	return job;
+}
+
+BaseJob *JobDeque::Steal()
+{
+	LONG top=m_top;
+	// the top must be read before the bottom
+	MemoryBarrier();
+	LONG bottom=m_bottom;
+	if(bottom-top<=0)
+		return NULL;
+	BaseJob *job=m_ring[top&(m_capacity-1)];
+	if(InterlockedCompareExchange(&m_top,top+1,top)!=top)
+		return NULL;
+	return job;
+}
+
+bool JobDeque::IsEmpty() const
+{
+	return (m_bottom-m_top<=0);
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+/*! 
+JobPriorityQueue for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epJobPriorityQueue.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+JobPriorityQueue::JobPriorityQueue(unsigned int capacity)
+{
+	for(unsigned int trav=0;trav<JOB_PRIORITY_BUCKET_COUNT;trav++)
+	{
+		m_buckets[trav]=EP_NEW JobRing(capacity);
+	}
+}
+
+JobPriorityQueue::~JobPriorityQueue()
+{
+	for(unsigned int trav=0;trav<JOB_PRIORITY_BUCKET_COUNT;trav++)
+	{
+		if(m_buckets[trav])
+			EP_DELETE m_buckets[trav];
+		m_buckets[trav]=NULL;
+	}
+}
+
+unsigned int JobPriorityQueue::getBucketIdx(Priority priority)
+{
+	// the priorities below normal share the lowest bucket, and the priorities beyond the buckets share the highest
+	if(priority<PRIORITY_NORMAL)
+		return 0;
+	if(priority-PRIORITY_NORMAL>=JOB_PRIORITY_BUCKET_COUNT-1)
+		return JOB_PRIORITY_BUCKET_COUNT-1;
+	return (unsigned int)(priority-PRIORITY_NORMAL)+1;
+}
+
+bool JobPriorityQueue::Push(BaseJob *job)
+{
+	EP_ASSERT(job);
+	return m_buckets[getBucketIdx(job->GetPriority())]->Push(job);
+}
+
+BaseJob *JobPriorityQueue::Pop()
+{
+	for(unsigned int trav=JOB_PRIORITY_BUCKET_COUNT;trav>0;trav--)
+	{
+		BaseJob *job=m_buckets[trav-1]->Pop();
+		if(job)
+			return job;
+	}
+	return NULL;
+}
+
+BaseJob *JobPriorityQueue::Pop(Priority minPriority)
+{
+	unsigned int minBucketIdx=getBucketIdx(minPriority);
+	for(unsigned int trav=JOB_PRIORITY_BUCKET_COUNT;trav>minBucketIdx;trav--)
+	{
+		BaseJob *job=m_buckets[trav-1]->Pop();
+		if(job)
+			return job;
+	}
+	return NULL;
+}
+
+bool JobPriorityQueue::Erase(BaseJob *job)
+{
+	EP_ASSERT(job);
+	return m_buckets[getBucketIdx(job->GetPriority())]->Erase(job);
+}
+
+bool JobPriorityQueue::IsEmpty() const
+{
+	for(unsigned int trav=0;trav<JOB_PRIORITY_BUCKET_COUNT;trav++)
+	{
+		if(!m_buckets[trav]->IsEmpty())
+			return false;
+	}
+	return true;
+}
\ No newline at end of file
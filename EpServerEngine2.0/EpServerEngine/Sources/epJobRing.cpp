@@ -0,0 +1,153 @@
+/*! 
+JobRing for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epJobRing.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+JobRing::JobRing(unsigned int capacity)
+{
+	m_capacity=2;
+	while(m_capacity<capacity)
+		m_capacity<<=1;
+	m_slots=EP_NEW Slot[m_capacity];
+	for(unsigned int trav=0;trav<m_capacity;trav++)
+	{
+		m_slots[trav].m_sequence=(LONG)trav;
+		m_slots[trav].m_job=NULL;
+	}
+	m_pushIdx=0;
+	m_popIdx=0;
+}
+
+JobRing::~JobRing()
+{
+	BaseJob *job;
+	while((job=Pop())!=NULL)
+		job->ReleaseObj();
+	if(m_slots)
+		EP_DELETE[] m_slots;
+	m_slots=NULL;
+}
+
+bool JobRing::Push(BaseJob *job)
+{
+	EP_ASSERT(job);
+	LONG pushIdx=m_pushIdx;
+	while(1)
+	{
+		Slot &slot=m_slots[pushIdx&(m_capacity-1)];
+		LONG distance=slot.m_sequence-pushIdx;
+		if(distance==0)
+		{
+			LONG prevIdx=InterlockedCompareExchange(&m_pushIdx,pushIdx+1,pushIdx);
+			if(prevIdx==pushIdx)
+			{
+				job->RetainObj();
+				slot.m_job=job;
+				// publish the job before the sequence
+				MemoryBarrier();
+				slot.m_sequence=pushIdx+1;
+				return true;
+			}
+			pushIdx=prevIdx;
+		}
+		else if(distance<0)
+		{
+			// the slot is not popped yet since the last lap
+			return false;
+		}
+		else
+		{
+			pushIdx=m_pushIdx;
+		}
+	}
+}
+
+BaseJob *JobRing::Pop()
+{
+	LONG popIdx=m_popIdx;
+	while(1)
+	{
+		Slot &slot=m_slots[popIdx&(m_capacity-1)];
+		LONG distance=slot.m_sequence-(popIdx+1);
+		if(distance==0)
+		{
+			LONG prevIdx=InterlockedCompareExchange(&m_popIdx,popIdx+1,popIdx);
+			if(prevIdx==popIdx)
+			{
+				// take the job exclusively against Erase, then release the slot for the next lap
+				BaseJob *job=reinterpret_cast<BaseJob*>(InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&slot.m_job),NULL));
+				slot.m_sequence=popIdx+(LONG)m_capacity;
+				if(job)
+					return job;
+				// the job is erased
+				popIdx=m_popIdx;
+				continue;
+			}
+			popIdx=prevIdx;
+		}
+		else if(distance<0)
+		{
+			// the slot is not pushed yet
+			return NULL;
+		}
+		else
+		{
+			popIdx=m_popIdx;
+		}
+	}
+}
+
+bool JobRing::Erase(BaseJob *job)
+{
+	EP_ASSERT(job);
+	LONG pushIdx=m_pushIdx;
+	for(LONG idx=m_popIdx;idx-pushIdx<0;idx++)
+	{
+		Slot &slot=m_slots[idx&(m_capacity-1)];
+		// only the slot pushed but not popped yet
+		if(slot.m_sequence!=idx+1)
+			continue;
+		if(InterlockedCompareExchangePointer(reinterpret_cast<PVOID volatile*>(&slot.m_job),NULL,job)==job)
+		{
+			job->ReleaseObj();
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobRing::IsEmpty() const
+{
+	return (m_popIdx==m_pushIdx);
+}
\ No newline at end of file
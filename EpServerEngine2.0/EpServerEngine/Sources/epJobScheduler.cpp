@@ -0,0 +1,358 @@
+/*! 
+JobScheduler for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epJobScheduler.h"
+#include "epBufferPool.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+JobScheduler::Worker::Worker(JobScheduler *scheduler,unsigned int workerIdx,epl::LockPolicy lockPolicyType):BaseWorkerThread(BaseWorkerThread::THREAD_LIFE_INFINITE,lockPolicyType),m_wakeEvent(false,false)
+{
+	m_scheduler=scheduler;
+	m_workerIdx=workerIdx;
+	m_jobCount=0;
+	m_isSleeping=0;
+}
+
+void JobScheduler::Worker::execute()
+{
+	// the jobs pushed from this thread go to its own deque
+	TlsSetValue(m_scheduler->m_tlsIdx,this);
+	while(m_scheduler->m_isStarted)
+	{
+		BaseJob *job=m_scheduler->findJob(this);
+		if(!job)
+		{
+			m_scheduler->sleep(this);
+			continue;
+		}
+		m_scheduler->m_jobProcessor->DoJob(this,job);
+		job->ReleaseObj();
+	}
+	TlsSetValue(m_scheduler->m_tlsIdx,NULL);
+	// the packets sent and received by the jobs are cached by this thread
+	BufferPool::defaultBufferPool.FlushThreadCache();
+}
+
+JobScheduler::JobScheduler(unsigned int waitTimeMilliSec,epl::LockPolicy lockPolicyType)
+{
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_listLock=EP_NEW epl::CriticalSectionEx();
+		m_overflowLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_listLock=EP_NEW epl::Mutex();
+		m_overflowLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_listLock=EP_NEW epl::NoLock();
+		m_overflowLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_listLock=NULL;
+		m_overflowLock=NULL;
+		break;
+	}
+	m_waitTime=waitTimeMilliSec;
+	m_tlsIdx=TlsAlloc();
+	m_jobProcessor=NULL;
+	m_overflowCount=0;
+	m_sleepingCount=0;
+	m_isStarted=0;
+	m_pushingCount=0;
+}
+
+JobScheduler::~JobScheduler()
+{
+	StopWorkers();
+	m_listLock->Lock();
+	deleteWorkers();
+	m_listLock->Unlock();
+	if(m_tlsIdx!=TLS_OUT_OF_INDEXES)
+		TlsFree(m_tlsIdx);
+	if(m_listLock)
+		EP_DELETE m_listLock;
+	m_listLock=NULL;
+	if(m_overflowLock)
+		EP_DELETE m_overflowLock;
+	m_overflowLock=NULL;
+}
+
+void JobScheduler::SetWaitTime(unsigned int milliSec)
+{
+	epl::LockObj lock(m_listLock);
+	m_waitTime=milliSec;
+}
+
+unsigned int JobScheduler::GetWaitTime() const
+{
+	epl::LockObj lock(m_listLock);
+	return m_waitTime;
+}
+
+bool JobScheduler::StartWorkers(unsigned int workerCount,BaseJobProcessor *jobProcessor)
+{
+	StopWorkers();
+
+	epl::LockObj lock(m_listLock);
+	if(!jobProcessor || m_tlsIdx==TLS_OUT_OF_INDEXES)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the workers\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		return false;
+	}
+	deleteWorkers();
+	if(workerCount==0)
+	{
+		workerCount=System::GetNumberOfCores()*2;
+	}
+	jobProcessor->RetainObj();
+	m_jobProcessor=jobProcessor;
+
+	// the list is complete before any worker starts to steal from it
+	for(unsigned int trav=0;trav<workerCount;trav++)
+	{
+		m_workerList.push_back(EP_NEW Worker(this,trav,m_lockPolicy));
+	}
+	m_isStarted=1;
+	for(unsigned int trav=0;trav<workerCount;trav++)
+	{
+		// the jobs pushed to the worker not started are stolen by the others
+		if(!m_workerList.at(trav)->Start())
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to start the worker %d\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this,trav);
+	}
+	return true;
+}
+
+void JobScheduler::StopWorkers()
+{
+	epl::LockObj lock(m_listLock);
+	if(!m_isStarted)
+		return;
+	InterlockedExchange(&m_isStarted,0);
+	// the thread in Push, which saw the workers started, is done with the list and the queues after this
+	while(m_pushingCount)
+		Sleep(0);
+	for(int trav=0;trav<m_workerList.size();trav++)
+	{
+		m_workerList.at(trav)->m_wakeEvent.SetEvent();
+	}
+	for(int trav=0;trav<m_workerList.size();trav++)
+	{
+		m_workerList.at(trav)->TerminateWorker(m_waitTime);
+	}
+
+	BaseJob *job;
+	for(int trav=0;trav<m_workerList.size();trav++)
+	{
+		Worker *worker=m_workerList.at(trav);
+		while((job=worker->m_deque.Steal())!=NULL)
+			job->ReleaseObj();
+		while((job=worker->m_inbox.Pop())!=NULL)
+			job->ReleaseObj();
+	}
+	while((job=popOverflow())!=NULL)
+		job->ReleaseObj();
+
+	if(m_jobProcessor)
+		m_jobProcessor->ReleaseObj();
+	m_jobProcessor=NULL;
+}
+
+void JobScheduler::deleteWorkers()
+{
+	for(int trav=0;trav<m_workerList.size();trav++)
+	{
+		EP_DELETE m_workerList.at(trav);
+	}
+	m_workerList.clear();
+	BaseJob *job;
+	while((job=popOverflow())!=NULL)
+		job->ReleaseObj();
+	m_sleepingCount=0;
+}
+
+size_t JobScheduler::Count() const
+{
+	epl::LockObj lock(m_listLock);
+	if(!m_isStarted)
+		return 0;
+	return m_workerList.size();
+}
+
+bool JobScheduler::Push(BaseJob *job)
+{
+	EP_ASSERT(job);
+	// the count is raised before the flag is read, so StopWorkers either is seen here or waits for this
+	InterlockedIncrement(&m_pushingCount);
+	if(!m_isStarted)
+	{
+		InterlockedDecrement(&m_pushingCount);
+		return false;
+	}
+	pushJob(job);
+	InterlockedDecrement(&m_pushingCount);
+	return true;
+}
+
+void JobScheduler::pushJob(BaseJob *job)
+{
+	Worker *current=reinterpret_cast<Worker*>(TlsGetValue(m_tlsIdx));
+	// the deque has no order of the priority
+	if(current && job->GetPriority()<=PRIORITY_NORMAL && current->m_deque.Push(job))
+	{
+		// the idle worker steals it while the current worker is busy
+		wakeUp(current);
+		return;
+	}
+
+	size_t workerCount=m_workerList.size();
+	// the thread ids are multiples of four
+	size_t workerIdx=current?current->m_workerIdx:(GetCurrentThreadId()>>2);
+	for(size_t trav=0;trav<workerCount;trav++)
+	{
+		Worker *worker=m_workerList.at((workerIdx+trav)%workerCount);
+		if(worker->m_inbox.Push(job))
+		{
+			wakeUp(worker);
+			return;
+		}
+	}
+
+	// all the queues are full
+	m_overflowLock->Lock();
+	job->RetainObj();
+	m_overflowList.push(job);
+	InterlockedIncrement(&m_overflowCount);
+	m_overflowLock->Unlock();
+	wakeUp(NULL);
+}
+
+BaseJob *JobScheduler::findJob(Worker *worker)
+{
+	BaseJob *job=NULL;
+	worker->m_jobCount++;
+	// the jobs of the priority above normal are never behind the deque
+	job=worker->m_inbox.Pop(PRIORITY_NORMAL+1);
+	if(job)
+		return job;
+	// the inbox is checked first once in a while, so the jobs re-queuing themselves cannot starve it
+	if(worker->m_jobCount%JOB_SCHEDULER_INBOX_CHECK_INTERVAL==0)
+		job=worker->m_inbox.Pop();
+	if(!job)
+		job=worker->m_deque.Pop();
+	if(!job)
+		job=worker->m_inbox.Pop();
+	if(!job)
+		job=popOverflow();
+	if(!job)
+		job=stealJob(worker);
+	return job;
+}
+
+BaseJob *JobScheduler::stealJob(Worker *worker)
+{
+	size_t workerCount=m_workerList.size();
+	for(size_t trav=1;trav<workerCount;trav++)
+	{
+		Worker *victim=m_workerList.at((worker->m_workerIdx+trav)%workerCount);
+		BaseJob *job=victim->m_deque.Steal();
+		if(!job)
+			job=victim->m_inbox.Pop();
+		if(job)
+			return job;
+	}
+	return NULL;
+}
+
+BaseJob *JobScheduler::popOverflow()
+{
+	if(!m_overflowCount)
+		return NULL;
+	epl::LockObj lock(m_overflowLock);
+	if(m_overflowList.empty())
+		return NULL;
+	BaseJob *job=m_overflowList.front();
+	m_overflowList.pop();
+	InterlockedDecrement(&m_overflowCount);
+	return job;
+}
+
+bool JobScheduler::hasJob() const
+{
+	if(m_overflowCount)
+		return true;
+	for(int trav=0;trav<m_workerList.size();trav++)
+	{
+		Worker *worker=m_workerList.at(trav);
+		if(!worker->m_deque.IsEmpty() || !worker->m_inbox.IsEmpty())
+			return true;
+	}
+	return false;
+}
+
+void JobScheduler::sleep(Worker *worker)
+{
+	InterlockedExchange(&worker->m_isSleeping,1);
+	InterlockedIncrement(&m_sleepingCount);
+	// the job pushed before the flag was set is found here, otherwise its pusher wakes this worker
+	if(m_isStarted && !hasJob())
+		worker->m_wakeEvent.WaitForEvent();
+	InterlockedExchange(&worker->m_isSleeping,0);
+	InterlockedDecrement(&m_sleepingCount);
+}
+
+void JobScheduler::wakeUp(Worker *worker)
+{
+	if(worker && InterlockedCompareExchange(&worker->m_isSleeping,0,1)==1)
+	{
+		worker->m_wakeEvent.SetEvent();
+		return;
+	}
+	if(!m_sleepingCount)
+		return;
+
+	// wake up any worker sleeping to steal the job
+	size_t workerCount=m_workerList.size();
+	size_t workerIdx=worker?worker->m_workerIdx:0;
+	for(size_t trav=1;trav<=workerCount;trav++)
+	{
+		Worker *sleeper=m_workerList.at((workerIdx+trav)%workerCount);
+		if(InterlockedCompareExchange(&sleeper->m_isSleeping,0,1)==1)
+		{
+			sleeper->m_wakeEvent.SetEvent();
+			return;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,382 @@
+/*! 
+LzCodec for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epLzCodec.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+/// position in the hash table never written
+static const unsigned int LZ_POSITION_EMPTY=0xffffffff;
+
+/*!
+Read the 4 bytes at the given address regardless of the alignment
+@param[in] buffer the address to read from
+@return the 4 bytes read
+*/
+static inline unsigned int readQuad(const unsigned char *buffer)
+{
+	unsigned int value;
+	memcpy(&value,buffer,sizeof(unsigned int));
+	return value;
+}
+
+/*!
+Get the hash of the 4 bytes
+@param[in] quad the 4 bytes
+@param[in] hashBits the number of bits of the hash
+@return the hash
+*/
+static inline unsigned int hashQuad(unsigned int quad,unsigned int hashBits)
+{
+	return (quad*2654435761U)>>(32-hashBits);
+}
+
+/*!
+Get the byte at the given position of the dictionary followed by the data
+@param[in] dictionary the dictionary
+@param[in] dictionaryByteSize the byte size of the dictionary
+@param[in] src the data
+@param[in] position the position counted from the start of the dictionary
+@return the byte at the position
+*/
+static inline unsigned char getPrefixedByte(const unsigned char *dictionary,unsigned int dictionaryByteSize,const unsigned char *src,unsigned int position)
+{
+	if(position<dictionaryByteSize)
+		return dictionary[position];
+	return src[position-dictionaryByteSize];
+}
+
+/*!
+Get the number of the bytes following the token to write the given length
+@param[in] length the length over the token field
+@return the number of the bytes
+*/
+static inline unsigned int getLengthExtraByteSize(unsigned int length)
+{
+	return (length>=15)?(length-15)/255+1:0;
+}
+
+/*!
+Write the bytes following the token for the given length
+@param[in] length the length over the token field
+@param[out] retOutput the address to write into, which is advanced
+*/
+static inline void writeLengthExtra(unsigned int length,unsigned char *&retOutput)
+{
+	if(length<15)
+		return;
+	length-=15;
+	while(length>=255)
+	{
+		*retOutput++=255;
+		length-=255;
+	}
+	*retOutput++=static_cast<unsigned char>(length);
+}
+
+/*!
+Read the bytes following the token for the length
+@param[in,out] input the address to read from, which is advanced
+@param[in] inputEnd the end of the input
+@param[in,out] length the length read from the token field, which is added
+@param[in] lengthMax the maximum length allowed
+@return true if successfully read otherwise false
+*/
+static inline bool readLengthExtra(const unsigned char *&input,const unsigned char *inputEnd,unsigned int &length,unsigned int lengthMax)
+{
+	if(length!=15)
+		return true;
+	unsigned char byte;
+	do{
+		if(input>=inputEnd)
+			return false;
+		byte=*input++;
+		length+=byte;
+		if(length>lengthMax)
+			return false;
+	}while(byte==255);
+	return true;
+}
+
+LzCodec::LzCodec()
+{
+	m_dictionaryId=0;
+}
+
+LzCodec::LzCodec(const LzCodec& b)
+{
+	m_dictionary=b.m_dictionary;
+	m_dictionaryHashTable=b.m_dictionaryHashTable;
+	m_dictionaryId=b.m_dictionaryId;
+}
+
+LzCodec::~LzCodec()
+{
+}
+
+LzCodec & LzCodec::operator=(const LzCodec&b)
+{
+	if(this!=&b)
+	{
+		m_dictionary=b.m_dictionary;
+		m_dictionaryHashTable=b.m_dictionaryHashTable;
+		m_dictionaryId=b.m_dictionaryId;
+	}
+	return *this;
+}
+
+void LzCodec::SetDictionary(const void *dictionary,unsigned int byteSize)
+{
+	m_dictionary.clear();
+	m_dictionaryHashTable.clear();
+	m_dictionaryId=0;
+	if(!dictionary || !byteSize)
+		return;
+
+	const char *dictionaryBytes=reinterpret_cast<const char*>(dictionary);
+	if(byteSize>COMPRESSION_DICTIONARY_BYTE_SIZE_MAX)
+	{
+		dictionaryBytes+=byteSize-COMPRESSION_DICTIONARY_BYTE_SIZE_MAX;
+		byteSize=COMPRESSION_DICTIONARY_BYTE_SIZE_MAX;
+	}
+	m_dictionary.assign(dictionaryBytes,dictionaryBytes+byteSize);
+
+	// FNV-1a, and 0 is left for no dictionary
+	unsigned int dictionaryId=2166136261U;
+	for(unsigned int byteIdx=0;byteIdx<byteSize;byteIdx++)
+	{
+		dictionaryId^=static_cast<unsigned char>(m_dictionary[byteIdx]);
+		dictionaryId*=16777619U;
+	}
+	m_dictionaryId=(dictionaryId)?dictionaryId:1;
+	buildDictionaryHashTable();
+}
+
+unsigned int LzCodec::GetDictionaryId() const
+{
+	return m_dictionaryId;
+}
+
+void LzCodec::buildDictionaryHashTable()
+{
+	m_dictionaryHashTable.assign(LZ_HASH_ENTRY_COUNT,LZ_POSITION_EMPTY);
+	unsigned int dictionaryByteSize=static_cast<unsigned int>(m_dictionary.size());
+	if(dictionaryByteSize<LZ_MATCH_LENGTH_MIN)
+		return;
+	const unsigned char *dictionary=reinterpret_cast<const unsigned char*>(&m_dictionary.at(0));
+	for(unsigned int position=0;position+LZ_MATCH_LENGTH_MIN<=dictionaryByteSize;position++)
+		m_dictionaryHashTable[hashQuad(readQuad(dictionary+position),LZ_HASH_BITS)]=position;
+}
+
+unsigned int LzCodec::GetCompressBound(unsigned int byteSize)
+{
+	return byteSize+byteSize/255+16;
+}
+
+unsigned int LzCodec::Compress(const void *src,unsigned int srcByteSize,void *retDst,unsigned int dstByteSize,bool useDictionary) const
+{
+	const unsigned char *input=reinterpret_cast<const unsigned char*>(src);
+	unsigned char *output=reinterpret_cast<unsigned char*>(retDst);
+	unsigned char *outputEnd=output+dstByteSize;
+
+	const unsigned char *dictionary=NULL;
+	unsigned int dictionaryByteSize=0;
+	unsigned int hashTable[LZ_HASH_ENTRY_COUNT];
+	if(useDictionary && m_dictionaryHashTable.size())
+	{
+		dictionary=reinterpret_cast<const unsigned char*>(&m_dictionary.at(0));
+		dictionaryByteSize=static_cast<unsigned int>(m_dictionary.size());
+		memcpy(hashTable,&m_dictionaryHashTable.at(0),sizeof(hashTable));
+	}
+	else
+		memset(hashTable,0xff,sizeof(hashTable));
+
+	unsigned int anchor=0;
+	unsigned int inputIdx=0;
+	if(srcByteSize>LZ_MATCH_FIND_LIMIT)
+	{
+		unsigned int matchFindLimit=srcByteSize-LZ_MATCH_FIND_LIMIT;
+		unsigned int matchEndLimit=srcByteSize-LZ_LAST_LITERAL_COUNT;
+		while(inputIdx<matchFindLimit)
+		{
+			unsigned int quad=readQuad(input+inputIdx);
+			unsigned int hash=hashQuad(quad,LZ_HASH_BITS);
+			// positions are counted from the start of the dictionary
+			unsigned int position=dictionaryByteSize+inputIdx;
+			unsigned int refPosition=hashTable[hash];
+			hashTable[hash]=position;
+			if(refPosition==LZ_POSITION_EMPTY || position-refPosition>LZ_OFFSET_MAX)
+			{
+				inputIdx++;
+				continue;
+			}
+			unsigned int refQuad;
+			if(refPosition>=dictionaryByteSize)
+				refQuad=readQuad(input+refPosition-dictionaryByteSize);
+			else if(refPosition+LZ_MATCH_LENGTH_MIN<=dictionaryByteSize)
+				refQuad=readQuad(dictionary+refPosition);
+			else
+			{
+				unsigned char refBytes[LZ_MATCH_LENGTH_MIN];
+				for(unsigned int byteIdx=0;byteIdx<LZ_MATCH_LENGTH_MIN;byteIdx++)
+					refBytes[byteIdx]=getPrefixedByte(dictionary,dictionaryByteSize,input,refPosition+byteIdx);
+				refQuad=readQuad(refBytes);
+			}
+			if(refQuad!=quad)
+			{
+				inputIdx++;
+				continue;
+			}
+
+			// extend the match backward over the literals, and forward
+			while(inputIdx>anchor && refPosition>0 && getPrefixedByte(dictionary,dictionaryByteSize,input,refPosition-1)==input[inputIdx-1])
+			{
+				inputIdx--;
+				refPosition--;
+			}
+			unsigned int matchLength=LZ_MATCH_LENGTH_MIN;
+			while(inputIdx+matchLength<matchEndLimit && getPrefixedByte(dictionary,dictionaryByteSize,input,refPosition+matchLength)==input[inputIdx+matchLength])
+				matchLength++;
+
+			unsigned int literalLength=inputIdx-anchor;
+			unsigned int matchLengthField=matchLength-LZ_MATCH_LENGTH_MIN;
+			unsigned int sequenceByteSize=1+getLengthExtraByteSize(literalLength)+literalLength+2+getLengthExtraByteSize(matchLengthField);
+			if(static_cast<unsigned int>(outputEnd-output)<sequenceByteSize)
+				return 0;
+
+			unsigned int offset=dictionaryByteSize+inputIdx-refPosition;
+			*output++=static_cast<unsigned char>(((literalLength<15?literalLength:15)<<4)|(matchLengthField<15?matchLengthField:15));
+			writeLengthExtra(literalLength,output);
+			memcpy(output,input+anchor,literalLength);
+			output+=literalLength;
+			*output++=static_cast<unsigned char>(offset&0xff);
+			*output++=static_cast<unsigned char>(offset>>8);
+			writeLengthExtra(matchLengthField,output);
+
+			inputIdx+=matchLength;
+			anchor=inputIdx;
+			// the position right before the end is hashed to find the repetition
+			if(inputIdx<matchFindLimit)
+				hashTable[hashQuad(readQuad(input+inputIdx-2),LZ_HASH_BITS)]=dictionaryByteSize+inputIdx-2;
+		}
+	}
+
+	// the last sequence has the literals only
+	unsigned int literalLength=srcByteSize-anchor;
+	unsigned int sequenceByteSize=1+getLengthExtraByteSize(literalLength)+literalLength;
+	if(static_cast<unsigned int>(outputEnd-output)<sequenceByteSize)
+		return 0;
+	*output++=static_cast<unsigned char>((literalLength<15?literalLength:15)<<4);
+	writeLengthExtra(literalLength,output);
+	memcpy(output,input+anchor,literalLength);
+	output+=literalLength;
+
+	return static_cast<unsigned int>(output-reinterpret_cast<unsigned char*>(retDst));
+}
+
+bool LzCodec::Decompress(const void *src,unsigned int srcByteSize,void *retDst,unsigned int dstByteSize,bool useDictionary) const
+{
+	const unsigned char *input=reinterpret_cast<const unsigned char*>(src);
+	const unsigned char *inputEnd=input+srcByteSize;
+	unsigned char *outputStart=reinterpret_cast<unsigned char*>(retDst);
+	unsigned char *output=outputStart;
+	unsigned char *outputEnd=output+dstByteSize;
+
+	const unsigned char *dictionary=NULL;
+	unsigned int dictionaryByteSize=0;
+	if(useDictionary && m_dictionary.size())
+	{
+		dictionary=reinterpret_cast<const unsigned char*>(&m_dictionary.at(0));
+		dictionaryByteSize=static_cast<unsigned int>(m_dictionary.size());
+	}
+
+	while(true)
+	{
+		if(input>=inputEnd)
+			return false;
+		unsigned char token=*input++;
+
+		unsigned int literalLength=token>>4;
+		if(!readLengthExtra(input,inputEnd,literalLength,dstByteSize))
+			return false;
+		if(literalLength>static_cast<unsigned int>(inputEnd-input) || literalLength>static_cast<unsigned int>(outputEnd-output))
+			return false;
+		memcpy(output,input,literalLength);
+		input+=literalLength;
+		output+=literalLength;
+
+		// the last sequence has no match
+		if(input==inputEnd)
+			break;
+
+		if(inputEnd-input<2)
+			return false;
+		unsigned int offset=static_cast<unsigned int>(input[0])|(static_cast<unsigned int>(input[1])<<8);
+		input+=2;
+		unsigned int matchLength=token&LZ_LENGTH_MASK;
+		if(!readLengthExtra(input,inputEnd,matchLength,dstByteSize))
+			return false;
+		matchLength+=LZ_MATCH_LENGTH_MIN;
+		if(!offset || matchLength>static_cast<unsigned int>(outputEnd-output))
+			return false;
+
+		unsigned int writtenByteSize=static_cast<unsigned int>(output-outputStart);
+		if(offset>writtenByteSize)
+		{
+			// the match starts in the dictionary, and may run into the output
+			unsigned int dictionaryOffset=offset-writtenByteSize;
+			if(dictionaryOffset>dictionaryByteSize)
+				return false;
+			const unsigned char *match=dictionary+dictionaryByteSize-dictionaryOffset;
+			unsigned int copyLength=(matchLength<dictionaryOffset)?matchLength:dictionaryOffset;
+			memcpy(output,match,copyLength);
+			output+=copyLength;
+			matchLength-=copyLength;
+			match=outputStart;
+			while(matchLength--)
+				*output++=*match++;
+		}
+		else if(offset>=matchLength)
+		{
+			memcpy(output,output-offset,matchLength);
+			output+=matchLength;
+		}
+		else
+		{
+			// the match overlaps the bytes being written
+			const unsigned char *match=output-offset;
+			while(matchLength--)
+				*output++=*match++;
+		}
+	}
+	return output==outputEnd;
+}
\ No newline at end of file
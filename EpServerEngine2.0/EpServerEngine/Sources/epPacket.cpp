@@ -33,16 +33,21 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
-Packet::Packet(const void *packet, unsigned int byteSize, bool shouldAllocate, epl::LockPolicy lockPolicyType):SmartObject(lockPolicyType)
+Packet::Packet(const void *packet, unsigned int byteSize, bool shouldAllocate, epl::LockPolicy lockPolicyType)
 {
+	m_refCount=1;
 	m_packet=NULL;
 	m_packetSize=0;
 	m_isAllocated=shouldAllocate;
+	m_slot=NULL;
+	m_buffer=NULL;
+	m_messageType=0;
+	m_frameFlags=0;
 	if(shouldAllocate)
 	{
 		if(byteSize>0)
 		{
-			m_packet=EP_NEW char[byteSize];
+			allocatePacket(PACKET_HEADROOM_BYTE_SIZE_DEFAULT,byteSize,0);
 			if(packet)
 				epl::System::Memcpy(m_packet,packet,byteSize);
 			else
@@ -55,125 +60,227 @@ Packet::Packet(const void *packet, unsigned int byteSize, bool shouldAllocate, e
 		m_packet=reinterpret_cast<char*>(const_cast<void*>(packet));
 		m_packetSize=byteSize;
 	}
-	m_lockPolicy=lockPolicyType;
-	switch(lockPolicyType)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_packetLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_packetLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_packetLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_packetLock=NULL;
-		break;
-	}
 }
 
-Packet::Packet(const Packet& b):SmartObject(b)
+Packet::Packet(const void *packet, unsigned int byteSize, unsigned int headroomByteSize, unsigned int tailroomByteSize)
 {
-	m_lockPolicy=b.m_lockPolicy;
-	switch(m_lockPolicy)
-	{
-	case epl::LOCK_POLICY_CRITICALSECTION:
-		m_packetLock=EP_NEW epl::CriticalSectionEx();
-		break;
-	case epl::LOCK_POLICY_MUTEX:
-		m_packetLock=EP_NEW epl::Mutex();
-		break;
-	case epl::LOCK_POLICY_NONE:
-		m_packetLock=EP_NEW epl::NoLock();
-		break;
-	default:
-		m_packetLock=NULL;
-		break;
-	}
-
-	LockObj lock(b.m_packetLock);
+	m_refCount=1;
 	m_packet=NULL;
-	if(b.m_isAllocated)
-	{
-		if(b.m_packetSize>0)
-		{
-			m_packet=EP_NEW char[b.m_packetSize];
-			epl::System::Memcpy(m_packet,b.m_packet,b.m_packetSize);
-		}
-		m_packetSize=b.m_packetSize;
-	}
-	else
+	m_packetSize=0;
+	m_isAllocated=true;
+	m_slot=NULL;
+	m_buffer=NULL;
+	m_messageType=0;
+	m_frameFlags=0;
+	// allocated even if empty, so the headers can be pushed in place
+	if(headroomByteSize+byteSize+tailroomByteSize>0)
 	{
-		m_packet=b.m_packet;
-		m_packetSize=b.m_packetSize;
+		allocatePacket(headroomByteSize,byteSize,tailroomByteSize);
+		if(packet)
+			epl::System::Memcpy(m_packet,packet,byteSize);
+		else
+			epl::System::Memset(m_packet,0,byteSize);
+		m_packetSize=byteSize;
 	}
-	m_isAllocated=b.m_isAllocated;
-	
 }
+
+Packet::Packet(PacketSlot *slot, unsigned int offset, unsigned int byteSize, epl::LockPolicy lockPolicyType)
+{
+	EP_ASSERT(slot);
+	EP_ASSERT(offset+byteSize<=slot->m_slab->GetSlotByteSize());
+	PacketSlab::RetainSlot(slot);
+	m_refCount=1;
+	m_slot=slot;
+	m_buffer=NULL;
+	m_messageType=0;
+	m_frameFlags=0;
+	m_packet=slot->m_buffer+offset;
+	m_packetSize=byteSize;
+	m_isAllocated=false;
+}
+
+Packet::Packet(const Packet& b, unsigned int offset, unsigned int byteSize)
+{
+	EP_ASSERT(offset+byteSize<=b.m_packetSize);
+	m_refCount=1;
+	referencePacket(b,offset,byteSize);
+}
+
+Packet::Packet(const Packet& b)
+{
+	m_refCount=1;
+	copyPacket(b);
+}
+
 Packet & Packet::operator=(const Packet&b)
 {
 	if(this!=&b)
 	{
-		resetPacket();
+		releasePacket();
+		// the reference count belongs to the object, not the packet
+		copyPacket(b);
+	}
+	return *this;
+}
 
-		SmartObject::operator =(b);
+Packet::~Packet()
+{
+	releasePacket();
+}
 
-		m_lockPolicy=b.m_lockPolicy;
-		switch(m_lockPolicy)
-		{
-		case epl::LOCK_POLICY_CRITICALSECTION:
-			m_packetLock=EP_NEW epl::CriticalSectionEx();
-			break;
-		case epl::LOCK_POLICY_MUTEX:
-			m_packetLock=EP_NEW epl::Mutex();
-			break;
-		case epl::LOCK_POLICY_NONE:
-			m_packetLock=EP_NEW epl::NoLock();
-			break;
-		default:
-			m_packetLock=NULL;
-			break;
-		}
+#if !defined(_DEBUG)
+void Packet::RetainObj()
+{
+	InterlockedIncrement(&m_refCount);
+}
 
-		LockObj lock(b.m_packetLock);
-		m_packet=NULL;
-		if(b.m_isAllocated)
-		{
-			if(b.m_packetSize>0)
-			{
-				m_packet=EP_NEW char[b.m_packetSize];
-				epl::System::Memcpy(m_packet,b.m_packet,b.m_packetSize);
-			}
-			m_packetSize=b.m_packetSize;
-		}
-		else
-		{
-			m_packet=b.m_packet;
-			m_packetSize=b.m_packetSize;
-		}
-		m_isAllocated=b.m_isAllocated;
+void Packet::ReleaseObj()
+{
+	LONG refCount=InterlockedDecrement(&m_refCount);
+	EP_ASSERT(refCount>=0);
+	if(refCount==0)
+		EP_DELETE this;
+}
+#else //!defined(_DEBUG)
+void (Packet::RetainObj)(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum)
+{
+	LONG refCount=InterlockedIncrement(&m_refCount);
+	LOG_THIS_MSG(_T("%s::%s(%d) Retained Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this,refCount);
+}
+
+void (Packet::ReleaseObj)(TCHAR *fileName, TCHAR *funcName, unsigned int lineNum)
+{
+	LONG refCount=InterlockedDecrement(&m_refCount);
+	LOG_THIS_MSG(_T("%s::%s(%d) Released Object : %d (Current Reference Count = %d)"),fileName,funcName,lineNum,this,refCount);
+	EP_ASSERT_EXPR(refCount>=0, _T("Reference Count is negative Value! Reference Count : %d"),refCount);
+	if(refCount==0)
+		EP_DELETE this;
+}
+#endif //!defined(_DEBUG)
+
+int Packet::GetReferenceCount() const
+{
+	return static_cast<int>(m_refCount);
+}
 
+void Packet::allocatePacket(unsigned int headroomByteSize, unsigned int byteSize, unsigned int tailroomByteSize)
+{
+	unsigned int roomByteSize=headroomByteSize+byteSize+tailroomByteSize;
+	if(roomByteSize<=PACKET_INLINE_BYTE_SIZE)
+	{
+		m_packet=m_inlineBuffer+headroomByteSize;
+		return;
 	}
-	return *this;
+	// the payload follows the header in the same allocation
+	char *block=reinterpret_cast<char*>(BufferPool::defaultBufferPool.Allocate(sizeof(PacketBuffer)+roomByteSize));
+	m_buffer=reinterpret_cast<PacketBuffer*>(block);
+	m_buffer->m_refCount=1;
+	m_buffer->m_byteSize=roomByteSize;
+	m_packet=block+sizeof(PacketBuffer)+headroomByteSize;
 }
-void Packet::resetPacket()
+
+void Packet::reallocatePacket(unsigned int headroomByteSize, unsigned int tailroomByteSize)
+{
+	PacketSlot *prevSlot=m_slot;
+	PacketBuffer *prevBuffer=m_buffer;
+	char *prevPacket=m_packet;
+	m_slot=NULL;
+	m_buffer=NULL;
+	m_isAllocated=true;
+	allocatePacket(headroomByteSize,m_packetSize,tailroomByteSize);
+	// the inline packet may overlap itself
+	if(m_packetSize>0)
+		memmove(m_packet,prevPacket,m_packetSize);
+	if(prevSlot)
+		PacketSlab::ReleaseSlot(prevSlot);
+	if(prevBuffer && InterlockedDecrement(&prevBuffer->m_refCount)==0)
+		BufferPool::defaultBufferPool.Free(prevBuffer);
+}
+
+bool Packet::getExclusiveRoom(char *&retRoom, unsigned int &retRoomByteSize) const
 {
-	m_packetLock->Lock();
-	if(m_isAllocated && m_packet)
+	if(m_buffer)
+	{
+		// the other packets may be referencing the memory around this packet
+		if(m_buffer->m_refCount!=1)
+			return false;
+		retRoom=reinterpret_cast<char*>(m_buffer)+sizeof(PacketBuffer);
+		retRoomByteSize=m_buffer->m_byteSize;
+		return true;
+	}
+	if(m_isAllocated && !m_slot && m_packet)
+	{
+		retRoom=const_cast<char*>(m_inlineBuffer);
+		retRoomByteSize=PACKET_INLINE_BYTE_SIZE;
+		return true;
+	}
+	return false;
+}
+
+void Packet::copyPacket(const Packet& b)
+{
+	if(!b.m_isAllocated)
+	{
+		referencePacket(b,0,b.m_packetSize);
+		return;
+	}
+	m_packet=NULL;
+	m_packetSize=b.m_packetSize;
+	m_isAllocated=true;
+	m_slot=NULL;
+	m_buffer=NULL;
+	m_messageType=b.m_messageType;
+	m_frameFlags=b.m_frameFlags;
+	if(m_packetSize>0)
 	{
-		EP_DELETE[] m_packet;
+		allocatePacket(PACKET_HEADROOM_BYTE_SIZE_DEFAULT,m_packetSize,0);
+		epl::System::Memcpy(m_packet,b.m_packet,m_packetSize);
 	}
+}
+
+void Packet::referencePacket(const Packet& b, unsigned int offset, unsigned int byteSize)
+{
 	m_packet=NULL;
-	m_packetLock->Unlock();
-	if(m_packetLock)
-		EP_DELETE m_packetLock;
-	m_packetLock=NULL;
+	m_packetSize=byteSize;
+	m_isAllocated=b.m_isAllocated;
+	m_slot=b.m_slot;
+	m_buffer=b.m_buffer;
+	m_messageType=b.m_messageType;
+	m_frameFlags=b.m_frameFlags;
+	if(m_slot)
+	{
+		PacketSlab::RetainSlot(m_slot);
+		m_packet=b.m_packet+offset;
+	}
+	else if(m_buffer)
+	{
+		InterlockedIncrement(&m_buffer->m_refCount);
+		m_packet=b.m_packet+offset;
+	}
+	else if(b.m_isAllocated)
+	{
+		// only the inline packet is left to copy
+		if(byteSize>0)
+		{
+			allocatePacket(PACKET_HEADROOM_BYTE_SIZE_DEFAULT,byteSize,0);
+			epl::System::Memcpy(m_packet,b.m_packet+offset,byteSize);
+		}
+	}
+	else
+	{
+		m_packet=b.m_packet+offset;
+	}
 }
 
-Packet::~Packet()
+void Packet::releasePacket()
 {
-	resetPacket();
+	if(m_slot)
+		PacketSlab::ReleaseSlot(m_slot);
+	m_slot=NULL;
+	if(m_buffer && InterlockedDecrement(&m_buffer->m_refCount)==0)
+		BufferPool::defaultBufferPool.Free(m_buffer);
+	m_buffer=NULL;
+	m_packet=NULL;
 }
 
 unsigned int Packet::GetPacketByteSize() const
@@ -188,27 +295,147 @@ const char *Packet::GetPacket() const
 
 void Packet::SetPacket(const void* packet, unsigned int packetByteSize)
 {
-	epl::LockObj lock(m_packetLock);
+	// the data given may be in the memory referenced, so it is released after set
+	PacketSlot *prevSlot=m_slot;
+	PacketBuffer *prevBuffer=m_buffer;
+	m_slot=NULL;
+	m_buffer=NULL;
 	if(m_isAllocated)
 	{
-		if(m_packet)
-			EP_DELETE[] m_packet;
 		m_packet=NULL;
 		if(packetByteSize>0)
 		{
-			m_packet=EP_NEW char[packetByteSize];
-			EP_ASSERT(m_packet);
+			if(packetByteSize<=PACKET_INLINE_BYTE_SIZE && reinterpret_cast<const char*>(packet)>=m_inlineBuffer && reinterpret_cast<const char*>(packet)<m_inlineBuffer+PACKET_INLINE_BYTE_SIZE)
+			{
+				// moved within the inline buffer itself
+				unsigned int headroomByteSize=PACKET_INLINE_BYTE_SIZE-packetByteSize;
+				if(headroomByteSize>PACKET_HEADROOM_BYTE_SIZE_DEFAULT)
+					headroomByteSize=PACKET_HEADROOM_BYTE_SIZE_DEFAULT;
+				memmove(m_inlineBuffer+headroomByteSize,packet,packetByteSize);
+				m_packet=m_inlineBuffer+headroomByteSize;
+			}
+			else
+			{
+				allocatePacket(PACKET_HEADROOM_BYTE_SIZE_DEFAULT,packetByteSize,0);
+				if(packet)
+					epl::System::Memcpy(m_packet,packet,packetByteSize);
+				else
+					epl::System::Memset(m_packet,0,packetByteSize);
+			}
 		}
-		if(packet)
-			epl::System::Memcpy(m_packet,packet,packetByteSize);
-		else
-			epl::System::Memset(m_packet,0,packetByteSize);
 		m_packetSize=packetByteSize;
-
 	}
 	else
 	{
 		m_packet=reinterpret_cast<char*>(const_cast<void*>(packet));
 		m_packetSize=packetByteSize;
 	}
+	if(prevSlot)
+		PacketSlab::ReleaseSlot(prevSlot);
+	if(prevBuffer && InterlockedDecrement(&prevBuffer->m_refCount)==0)
+		BufferPool::defaultBufferPool.Free(prevBuffer);
+}
+
+unsigned int Packet::GetHeadroomByteSize() const
+{
+	char *room=NULL;
+	unsigned int roomByteSize=0;
+	if(!getExclusiveRoom(room,roomByteSize))
+		return 0;
+	return static_cast<unsigned int>(m_packet-room);
+}
+
+unsigned int Packet::GetTailroomByteSize() const
+{
+	char *room=NULL;
+	unsigned int roomByteSize=0;
+	if(!getExclusiveRoom(room,roomByteSize))
+		return 0;
+	return static_cast<unsigned int>(room+roomByteSize-(m_packet+m_packetSize));
+}
+
+void Packet::PushHeader(const void *header, unsigned int byteSize)
+{
+	if(byteSize==0)
+		return;
+	if(GetHeadroomByteSize()<byteSize)
+		reallocatePacket(byteSize+PACKET_HEADROOM_BYTE_SIZE_DEFAULT,GetTailroomByteSize());
+	m_packet-=byteSize;
+	m_packetSize+=byteSize;
+	epl::System::Memcpy(m_packet,header,byteSize);
+}
+
+void Packet::PushTrailer(const void *trailer, unsigned int byteSize)
+{
+	if(byteSize==0)
+		return;
+	if(GetTailroomByteSize()<byteSize)
+	{
+		unsigned int headroomByteSize=GetHeadroomByteSize();
+		if(headroomByteSize<PACKET_HEADROOM_BYTE_SIZE_DEFAULT)
+			headroomByteSize=PACKET_HEADROOM_BYTE_SIZE_DEFAULT;
+		reallocatePacket(headroomByteSize,byteSize);
+	}
+	epl::System::Memcpy(m_packet+m_packetSize,trailer,byteSize);
+	m_packetSize+=byteSize;
+}
+
+char *Packet::ExtendTrailer(unsigned int byteSize)
+{
+	if(GetTailroomByteSize()<byteSize)
+	{
+		unsigned int headroomByteSize=GetHeadroomByteSize();
+		if(headroomByteSize<PACKET_HEADROOM_BYTE_SIZE_DEFAULT)
+			headroomByteSize=PACKET_HEADROOM_BYTE_SIZE_DEFAULT;
+		// doubled at least, not to copy the packet every time appended
+		unsigned int tailroomByteSize=m_packetSize;
+		if(tailroomByteSize<byteSize)
+			tailroomByteSize=byteSize;
+		reallocatePacket(headroomByteSize,tailroomByteSize);
+	}
+	char *trailer=m_packet+m_packetSize;
+	m_packetSize+=byteSize;
+	return trailer;
+}
+
+void Packet::PullHeader(unsigned int byteSize)
+{
+	EP_ASSERT(byteSize<=m_packetSize);
+	m_packet+=byteSize;
+	m_packetSize-=byteSize;
+}
+
+void Packet::PullTrailer(unsigned int byteSize)
+{
+	EP_ASSERT(byteSize<=m_packetSize);
+	m_packetSize-=byteSize;
+}
+
+bool Packet::WriteHeadroom(const void *header, unsigned int byteSize)
+{
+	if(GetHeadroomByteSize()<byteSize)
+		return false;
+	epl::System::Memcpy(m_packet-byteSize,header,byteSize);
+	return true;
+}
+
+unsigned short Packet::GetMessageType() const
+{
+	return m_messageType;
+}
+
+void Packet::SetMessageType(unsigned short messageType)
+{
+	m_messageType=messageType;
+}
+
+unsigned char Packet::GetFrameFlags() const
+{
+	return m_frameFlags;
+}
+
+void Packet::SetFrameFlags(unsigned char flags)
+{
+	EP_ASSERT(flags<=FRAME_FLAGS_MAX);
+	m_frameFlags=flags;
 }
\ No newline at end of file
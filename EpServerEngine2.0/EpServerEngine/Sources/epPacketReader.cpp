@@ -0,0 +1,235 @@
+/*! 
+PacketReader for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epPacketReader.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+PacketReader::PacketReader(const Packet &packet,ByteOrder byteOrder):m_packet(packet)
+{
+	m_byteOrder=byteOrder;
+	m_shouldSwap=!ByteSwapper::IsHostByteOrder(byteOrder);
+	m_offset=0;
+}
+
+PacketReader::~PacketReader()
+{
+}
+
+ByteOrder PacketReader::GetByteOrder() const
+{
+	return m_byteOrder;
+}
+
+unsigned int PacketReader::GetStreamSize() const
+{
+	return m_packet.GetPacketByteSize();
+}
+
+const char *PacketReader::GetBuffer() const
+{
+	return m_packet.GetPacket();
+}
+
+bool PacketReader::SetSeek(unsigned int offset)
+{
+	if(offset>m_packet.GetPacketByteSize())
+		return false;
+	m_offset=offset;
+	return true;
+}
+
+unsigned int PacketReader::GetSeek() const
+{
+	return m_offset;
+}
+
+unsigned int PacketReader::GetRemainingByteSize() const
+{
+	return m_packet.GetPacketByteSize()-m_offset;
+}
+
+bool PacketReader::read(void *retValues,size_t elementByteSize,size_t count)
+{
+	if(count==0)
+		return true;
+	if(!retValues || count>GetRemainingByteSize()/elementByteSize)
+		return false;
+	ByteSwapper::Copy(retValues,m_packet.GetPacket()+m_offset,elementByteSize,count,m_shouldSwap);
+	m_offset+=static_cast<unsigned int>(elementByteSize*count);
+	return true;
+}
+
+bool PacketReader::ReadShort(short &retVal)
+{
+	return read(&retVal,sizeof(short),1);
+}
+
+bool PacketReader::ReadUShort(unsigned short &retVal)
+{
+	return read(&retVal,sizeof(unsigned short),1);
+}
+
+bool PacketReader::ReadInt(int &retVal)
+{
+	return read(&retVal,sizeof(int),1);
+}
+
+bool PacketReader::ReadUInt(unsigned int &retVal)
+{
+	return read(&retVal,sizeof(unsigned int),1);
+}
+
+bool PacketReader::ReadFloat(float &retVal)
+{
+	return read(&retVal,sizeof(float),1);
+}
+
+bool PacketReader::ReadDouble(double &retVal)
+{
+	return read(&retVal,sizeof(double),1);
+}
+
+bool PacketReader::ReadByte(unsigned char &retVal)
+{
+	return read(&retVal,sizeof(unsigned char),1);
+}
+
+bool PacketReader::ReadShorts(short *retShortList,size_t listSize)
+{
+	return read(retShortList,sizeof(short),listSize);
+}
+
+bool PacketReader::ReadUShorts(unsigned short *retUShortList,size_t listSize)
+{
+	return read(retUShortList,sizeof(unsigned short),listSize);
+}
+
+bool PacketReader::ReadInts(int *retIntList,size_t listSize)
+{
+	return read(retIntList,sizeof(int),listSize);
+}
+
+bool PacketReader::ReadUInts(unsigned int *retUIntList,size_t listSize)
+{
+	return read(retUIntList,sizeof(unsigned int),listSize);
+}
+
+bool PacketReader::ReadFloats(float *retFloatList,size_t listSize)
+{
+	return read(retFloatList,sizeof(float),listSize);
+}
+
+bool PacketReader::ReadDoubles(double *retDoubleList,size_t listSize)
+{
+	return read(retDoubleList,sizeof(double),listSize);
+}
+
+bool PacketReader::ReadBytes(unsigned char *retByteList,size_t listSize)
+{
+	return read(retByteList,sizeof(unsigned char),listSize);
+}
+
+bool PacketReader::ReadBytesInPlace(const unsigned char *&retByteList,size_t listSize)
+{
+	if(listSize>GetRemainingByteSize())
+		return false;
+	retByteList=reinterpret_cast<const unsigned char*>(m_packet.GetPacket()+m_offset);
+	m_offset+=static_cast<unsigned int>(listSize);
+	return true;
+}
+
+Packet *PacketReader::ReadPacket(unsigned int byteSize)
+{
+	if(byteSize>GetRemainingByteSize())
+		return NULL;
+	Packet *retPacket=EP_NEW Packet(m_packet,m_offset,byteSize);
+	m_offset+=byteSize;
+	return retPacket;
+}
+
+bool PacketReader::ReadStringInPlace(const char *&retString,unsigned int &retLength)
+{
+	unsigned int prevOffset=m_offset;
+	unsigned int length=0;
+	const unsigned char *characters=NULL;
+	if(!ReadUInt(length) || !ReadBytesInPlace(characters,length))
+	{
+		m_offset=prevOffset;
+		return false;
+	}
+	retString=reinterpret_cast<const char*>(characters);
+	retLength=length;
+	return true;
+}
+
+bool PacketReader::ReadString(epl::EpString &retString)
+{
+	const char *characters=NULL;
+	unsigned int length=0;
+	if(!ReadStringInPlace(characters,length))
+		return false;
+	retString.assign(characters,length);
+	return true;
+}
+
+bool PacketReader::ReadWString(epl::EpWString &retString)
+{
+	unsigned int prevOffset=m_offset;
+	unsigned int length=0;
+	if(!ReadUInt(length) || length>GetRemainingByteSize()/sizeof(unsigned short))
+	{
+		m_offset=prevOffset;
+		return false;
+	}
+	retString.resize(length);
+	if(length==0)
+		return true;
+	if(sizeof(wchar_t)==sizeof(unsigned short))
+		return read(&retString[0],sizeof(unsigned short),length);
+	for(unsigned int idx=0;idx<length;idx++)
+	{
+		unsigned short character=0;
+		ReadUShort(character);
+		retString[idx]=static_cast<wchar_t>(character);
+	}
+	return true;
+}
+
+bool PacketReader::ReadTString(epl::EpTString &retString)
+{
+#if defined(_UNICODE) || defined(UNICODE)
+	return ReadWString(retString);
+#else// defined(_UNICODE) || defined(UNICODE)
+	return ReadString(retString);
+#endif// defined(_UNICODE) || defined(UNICODE)
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+/*! 
+PacketSlab for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epPacketSlab.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+PacketSlab::PacketSlab(unsigned int slotCount,unsigned int slotByteSize,epl::LockPolicy lockPolicyType):SmartObject(lockPolicyType)
+{
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_slabLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_slabLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_slabLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_slabLock=NULL;
+		break;
+	}
+
+	// keep every slot aligned to the pointer size
+	m_slotByteSize=(slotByteSize+sizeof(ULONG_PTR)-1)&~(sizeof(ULONG_PTR)-1);
+	m_slotCount=slotCount;
+	m_buffer=NULL;
+	m_slotList=NULL;
+	if(m_slotCount==0 || m_slotByteSize==0)
+		return;
+
+	m_buffer=EP_NEW char[m_slotCount*m_slotByteSize];
+	m_slotList=EP_NEW PacketSlot[m_slotCount];
+	m_freeSlotList.reserve(m_slotCount);
+	// hand out the slots from the front of the buffer first
+	for(unsigned int trav=m_slotCount;trav>0;trav--)
+	{
+		PacketSlot *slot=&m_slotList[trav-1];
+		slot->m_slab=this;
+		slot->m_buffer=m_buffer+(trav-1)*m_slotByteSize;
+		slot->m_refCount=0;
+		m_freeSlotList.push_back(slot);
+	}
+}
+
+PacketSlab::~PacketSlab()
+{
+	EP_ASSERT(m_freeSlotList.size()==m_slotCount);
+	if(m_slotList)
+		EP_DELETE[] m_slotList;
+	m_slotList=NULL;
+	if(m_buffer)
+		EP_DELETE[] m_buffer;
+	m_buffer=NULL;
+	if(m_slabLock)
+		EP_DELETE m_slabLock;
+	m_slabLock=NULL;
+}
+
+PacketSlot *PacketSlab::Acquire()
+{
+	m_slabLock->Lock();
+	if(m_freeSlotList.empty())
+	{
+		m_slabLock->Unlock();
+		return NULL;
+	}
+	PacketSlot *slot=m_freeSlotList.back();
+	m_freeSlotList.pop_back();
+	m_slabLock->Unlock();
+
+	slot->m_refCount=1;
+	// the slab is kept alive while the slot is in use
+	RetainObj();
+	return slot;
+}
+
+void PacketSlab::RetainSlot(PacketSlot *slot)
+{
+	EP_ASSERT(slot);
+	InterlockedIncrement(&slot->m_refCount);
+}
+
+void PacketSlab::ReleaseSlot(PacketSlot *slot)
+{
+	EP_ASSERT(slot);
+	if(InterlockedDecrement(&slot->m_refCount)==0)
+		slot->m_slab->recycle(slot);
+}
+
+void PacketSlab::recycle(PacketSlot *slot)
+{
+	m_slabLock->Lock();
+	m_freeSlotList.push_back(slot);
+	m_slabLock->Unlock();
+	// may delete this slab if the owner already released it
+	ReleaseObj();
+}
+
+unsigned int PacketSlab::GetSlotByteSize() const
+{
+	return m_slotByteSize;
+}
+
+unsigned int PacketSlab::GetSlotCount() const
+{
+	return m_slotCount;
+}
+
+size_t PacketSlab::GetFreeSlotCount() const
+{
+	epl::LockObj lock(m_slabLock);
+	return m_freeSlotList.size();
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/*! 
+PacketWriter for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epPacketWriter.h"
+#include <limits.h>
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+PacketWriter::PacketWriter(ByteOrder byteOrder,unsigned int reserveByteSize)
+{
+	m_packet=NULL;
+	m_byteOrder=byteOrder;
+	m_shouldSwap=!ByteSwapper::IsHostByteOrder(byteOrder);
+	m_reserveByteSize=reserveByteSize;
+}
+
+PacketWriter::~PacketWriter()
+{
+	if(m_packet)
+		m_packet->ReleaseObj();
+	m_packet=NULL;
+}
+
+ByteOrder PacketWriter::GetByteOrder() const
+{
+	return m_byteOrder;
+}
+
+void PacketWriter::Clear()
+{
+	// the memory is kept to write again
+	if(m_packet)
+		m_packet->PullTrailer(m_packet->GetPacketByteSize());
+}
+
+unsigned int PacketWriter::GetStreamSize() const
+{
+	if(!m_packet)
+		return 0;
+	return m_packet->GetPacketByteSize();
+}
+
+const char *PacketWriter::GetBuffer() const
+{
+	if(!m_packet)
+		return NULL;
+	return m_packet->GetPacket();
+}
+
+Packet *PacketWriter::Detach()
+{
+	Packet *retPacket=m_packet;
+	m_packet=NULL;
+	if(!retPacket)
+		retPacket=EP_NEW Packet();
+	return retPacket;
+}
+
+bool PacketWriter::write(const void *values,size_t elementByteSize,size_t count)
+{
+	if(count==0)
+		return true;
+	if(!values)
+		return false;
+	// the packet must be addressable by unsigned int
+	if(count>(UINT_MAX-GetStreamSize())/elementByteSize)
+		return false;
+	if(!m_packet)
+		m_packet=EP_NEW Packet(NULL,0,PACKET_HEADROOM_BYTE_SIZE_DEFAULT,m_reserveByteSize);
+	char *dst=m_packet->ExtendTrailer(static_cast<unsigned int>(elementByteSize*count));
+	ByteSwapper::Copy(dst,values,elementByteSize,count,m_shouldSwap);
+	return true;
+}
+
+bool PacketWriter::writeWideCharacters(const wchar_t *str,size_t length)
+{
+	if(length>UINT_MAX || !WriteUInt(static_cast<unsigned int>(length)))
+		return false;
+	if(sizeof(wchar_t)==sizeof(unsigned short))
+		return write(str,sizeof(unsigned short),length);
+	for(size_t idx=0;idx<length;idx++)
+	{
+		if(!WriteUShort(static_cast<unsigned short>(str[idx])))
+			return false;
+	}
+	return true;
+}
+
+bool PacketWriter::WriteShort(const short value)
+{
+	return write(&value,sizeof(short),1);
+}
+
+bool PacketWriter::WriteUShort(const unsigned short value)
+{
+	return write(&value,sizeof(unsigned short),1);
+}
+
+bool PacketWriter::WriteInt(const int value)
+{
+	return write(&value,sizeof(int),1);
+}
+
+bool PacketWriter::WriteUInt(const unsigned int value)
+{
+	return write(&value,sizeof(unsigned int),1);
+}
+
+bool PacketWriter::WriteFloat(const float value)
+{
+	return write(&value,sizeof(float),1);
+}
+
+bool PacketWriter::WriteDouble(const double value)
+{
+	return write(&value,sizeof(double),1);
+}
+
+bool PacketWriter::WriteByte(const unsigned char value)
+{
+	return write(&value,sizeof(unsigned char),1);
+}
+
+bool PacketWriter::WriteShorts(const short *shortList, size_t listSize)
+{
+	return write(shortList,sizeof(short),listSize);
+}
+
+bool PacketWriter::WriteUShorts(const unsigned short *ushortList, size_t listSize)
+{
+	return write(ushortList,sizeof(unsigned short),listSize);
+}
+
+bool PacketWriter::WriteInts(const int *intList,size_t listSize)
+{
+	return write(intList,sizeof(int),listSize);
+}
+
+bool PacketWriter::WriteUInts(const unsigned int *uintList,size_t listSize)
+{
+	return write(uintList,sizeof(unsigned int),listSize);
+}
+
+bool PacketWriter::WriteFloats(const float *floatList, size_t listSize)
+{
+	return write(floatList,sizeof(float),listSize);
+}
+
+bool PacketWriter::WriteDoubles(const double *doubleList,size_t listSize)
+{
+	return write(doubleList,sizeof(double),listSize);
+}
+
+bool PacketWriter::WriteBytes(const unsigned char* byteList,size_t listSize)
+{
+	return write(byteList,sizeof(unsigned char),listSize);
+}
+
+bool PacketWriter::WriteString(const char *str)
+{
+	if(!str)
+		return false;
+	size_t length=strlen(str);
+	if(length>UINT_MAX || !WriteUInt(static_cast<unsigned int>(length)))
+		return false;
+	return write(str,sizeof(char),length);
+}
+
+bool PacketWriter::WriteWString(const wchar_t *str)
+{
+	if(!str)
+		return false;
+	return writeWideCharacters(str,wcslen(str));
+}
+
+bool PacketWriter::WriteTString(const TCHAR *str)
+{
+#if defined(_UNICODE) || defined(UNICODE)
+	return WriteWString(str);
+#else// defined(_UNICODE) || defined(UNICODE)
+	return WriteString(str);
+#endif// defined(_UNICODE) || defined(UNICODE)
+}
+
+bool PacketWriter::WriteString(const epl::EpString &str)
+{
+	if(str.length()>UINT_MAX || !WriteUInt(static_cast<unsigned int>(str.length())))
+		return false;
+	return write(str.c_str(),sizeof(char),str.length());
+}
+
+bool PacketWriter::WriteWString(const epl::EpWString &str)
+{
+	return writeWideCharacters(str.c_str(),str.length());
+}
+
+bool PacketWriter::WriteTString(const epl::EpTString &str)
+{
+#if defined(_UNICODE) || defined(UNICODE)
+	return WriteWString(str);
+#else// defined(_UNICODE) || defined(UNICODE)
+	return WriteString(str);
+#endif// defined(_UNICODE) || defined(UNICODE)
+}
\ No newline at end of file
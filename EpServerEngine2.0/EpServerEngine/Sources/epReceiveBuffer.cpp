@@ -0,0 +1,324 @@
+/*! 
+ReceiveBuffer for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epReceiveBuffer.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+ReceiveBuffer::ReceiveBuffer(unsigned int byteSize)
+{
+	if(byteSize<sizeof(unsigned int))
+		byteSize=sizeof(unsigned int);
+	m_defaultByteSize=byteSize;
+	m_bufferByteSize=byteSize;
+	m_buffer=reinterpret_cast<char*>(BufferPool::defaultBufferPool.Allocate(m_bufferByteSize));
+	m_readIdx=0;
+	m_writeIdx=0;
+	m_frameCodec=NULL;
+	m_isCorrupted=false;
+	m_maxFrameByteSize=FRAME_BYTE_SIZE_MAX_DEFAULT;
+	m_chunkByteSize=RECEIVE_CHUNK_BYTE_SIZE_NONE;
+	m_isChunking=false;
+	m_chunkMessageType=0;
+	m_chunkOffset=0;
+	m_chunkRemainingByteSize=0;
+}
+
+ReceiveBuffer::ReceiveBuffer(const ReceiveBuffer& b)
+{
+	m_frameCodec=NULL;
+	m_isCorrupted=b.m_isCorrupted;
+	m_defaultByteSize=b.m_defaultByteSize;
+	m_bufferByteSize=b.m_bufferByteSize;
+	m_buffer=reinterpret_cast<char*>(BufferPool::defaultBufferPool.Allocate(m_bufferByteSize));
+	m_readIdx=0;
+	m_writeIdx=b.m_writeIdx-b.m_readIdx;
+	epl::System::Memcpy(m_buffer,b.m_buffer+b.m_readIdx,m_writeIdx);
+	m_maxFrameByteSize=b.m_maxFrameByteSize;
+	m_chunkByteSize=b.m_chunkByteSize;
+	m_isChunking=b.m_isChunking;
+	m_chunkMessageType=b.m_chunkMessageType;
+	m_chunkOffset=b.m_chunkOffset;
+	m_chunkRemainingByteSize=b.m_chunkRemainingByteSize;
+}
+
+ReceiveBuffer::~ReceiveBuffer()
+{
+	if(m_buffer)
+		BufferPool::defaultBufferPool.Free(m_buffer);
+	m_buffer=NULL;
+}
+
+ReceiveBuffer & ReceiveBuffer::operator=(const ReceiveBuffer&b)
+{
+	if(this!=&b)
+	{
+		if(m_buffer)
+			BufferPool::defaultBufferPool.Free(m_buffer);
+		m_isCorrupted=b.m_isCorrupted;
+		m_defaultByteSize=b.m_defaultByteSize;
+		m_bufferByteSize=b.m_bufferByteSize;
+		m_buffer=reinterpret_cast<char*>(BufferPool::defaultBufferPool.Allocate(m_bufferByteSize));
+		m_readIdx=0;
+		m_writeIdx=b.m_writeIdx-b.m_readIdx;
+		epl::System::Memcpy(m_buffer,b.m_buffer+b.m_readIdx,m_writeIdx);
+		m_maxFrameByteSize=b.m_maxFrameByteSize;
+		m_chunkByteSize=b.m_chunkByteSize;
+		m_isChunking=b.m_isChunking;
+		m_chunkMessageType=b.m_chunkMessageType;
+		m_chunkOffset=b.m_chunkOffset;
+		m_chunkRemainingByteSize=b.m_chunkRemainingByteSize;
+	}
+	return *this;
+}
+
+void ReceiveBuffer::SetFrameCodec(FrameCodec *frameCodec)
+{
+	m_frameCodec=frameCodec;
+}
+
+void ReceiveBuffer::SetMaxFrameByteSize(unsigned int maxFrameByteSize)
+{
+	m_maxFrameByteSize=maxFrameByteSize;
+}
+
+void ReceiveBuffer::SetChunkByteSize(unsigned int chunkByteSize)
+{
+	m_chunkByteSize=chunkByteSize;
+}
+
+bool ReceiveBuffer::getFrontHeader(FrameCodec::FrameHeader &retHeader) const
+{
+	// the data in front is the rest of the packet popped in the chunks
+	if(m_isChunking)
+		return false;
+	if(m_frameCodec)
+		return m_frameCodec->DecodeHeader(m_buffer+m_readIdx,m_writeIdx-m_readIdx,retHeader);
+	return FrameCodec::DecodeHeader(FRAME_VERSION_LEGACY,m_buffer+m_readIdx,m_writeIdx-m_readIdx,retHeader);
+}
+
+bool ReceiveBuffer::isTooLarge(const FrameCodec::FrameHeader &header) const
+{
+	return (m_maxFrameByteSize!=FRAME_BYTE_SIZE_UNLIMITED && header.m_payloadByteSize>m_maxFrameByteSize);
+}
+
+bool ReceiveBuffer::isChunked(const FrameCodec::FrameHeader &header) const
+{
+	return (m_chunkByteSize!=RECEIVE_CHUNK_BYTE_SIZE_NONE && !header.m_isControl && !header.m_isCompressed && header.m_payloadByteSize>m_chunkByteSize);
+}
+
+unsigned int ReceiveBuffer::getFrontPacketByteSize() const
+{
+	if(m_isChunking)
+		return (m_chunkRemainingByteSize<m_chunkByteSize)?m_chunkRemainingByteSize:m_chunkByteSize;
+	FrameCodec::FrameHeader header;
+	if(m_isCorrupted || !getFrontHeader(header) || header.m_isCorrupted || isTooLarge(header))
+		return 0;
+	if(isChunked(header))
+		return header.m_headerByteSize+m_chunkByteSize;
+	// the payload is capped, so the sum does not wrap around
+	return header.m_headerByteSize+header.m_payloadByteSize;
+}
+
+void ReceiveBuffer::consumeControlFrames()
+{
+	FrameCodec::FrameHeader header;
+	// the frames after the switch are parsed in the new version
+	while(!m_isCorrupted && getFrontHeader(header))
+	{
+		if(header.m_isCorrupted || isTooLarge(header) || (header.m_isCompressed && !(m_frameCodec && m_frameCodec->IsDecompressible())) || (header.m_isControl && m_frameCodec && !m_frameCodec->ProcessControl(header)))
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Corrupted frame received\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+			m_isCorrupted=true;
+			break;
+		}
+		if(!header.m_isControl)
+			break;
+		m_readIdx+=header.m_headerByteSize;
+	}
+	if(m_readIdx==m_writeIdx)
+	{
+		m_readIdx=0;
+		m_writeIdx=0;
+	}
+}
+
+void ReceiveBuffer::relocate(unsigned int byteSize)
+{
+	unsigned int readableByteSize=m_writeIdx-m_readIdx;
+	if(byteSize!=m_bufferByteSize)
+	{
+		char *newBuffer=reinterpret_cast<char*>(BufferPool::defaultBufferPool.Allocate(byteSize));
+		epl::System::Memcpy(newBuffer,m_buffer+m_readIdx,readableByteSize);
+		BufferPool::defaultBufferPool.Free(m_buffer);
+		m_buffer=newBuffer;
+		m_bufferByteSize=byteSize;
+	}
+	else if(m_readIdx)
+	{
+		memmove(m_buffer,m_buffer+m_readIdx,readableByteSize);
+	}
+	m_readIdx=0;
+	m_writeIdx=readableByteSize;
+}
+
+char *ReceiveBuffer::GetWriteBuffer(unsigned int &writableByteSize)
+{
+	unsigned int readableByteSize=m_writeIdx-m_readIdx;
+
+	// the space required to complete the first packet, or at least one more byte
+	unsigned int requiredByteSize=getFrontPacketByteSize();
+	if(requiredByteSize<=readableByteSize)
+		requiredByteSize=readableByteSize+1;
+
+	if(requiredByteSize>m_bufferByteSize)
+	{
+		unsigned int newByteSize=m_bufferByteSize*2;
+		if(newByteSize<requiredByteSize)
+			newByteSize=requiredByteSize;
+		relocate(newByteSize);
+	}
+	else if(readableByteSize==0 && m_bufferByteSize>m_defaultByteSize)
+	{
+		// give back the memory grown for the large packet
+		relocate(m_defaultByteSize);
+	}
+	else if(m_bufferByteSize-m_writeIdx<requiredByteSize-readableByteSize || m_readIdx>=m_bufferByteSize/2)
+	{
+		relocate(m_bufferByteSize);
+	}
+
+	writableByteSize=m_bufferByteSize-m_writeIdx;
+	return m_buffer+m_writeIdx;
+}
+
+void ReceiveBuffer::CommitWrite(unsigned int byteSize)
+{
+	EP_ASSERT(m_writeIdx+byteSize<=m_bufferByteSize);
+	m_writeIdx+=byteSize;
+	consumeControlFrames();
+}
+
+bool ReceiveBuffer::IsPacketAvailable() const
+{
+	FrameCodec::FrameHeader header;
+	if(m_isCorrupted || !getFrontHeader(header) || header.m_isCorrupted || isTooLarge(header) || isChunked(header))
+		return false;
+	// the complete header is in the buffer, so compare the payload with the rest not to overflow
+	return (header.m_payloadByteSize<=m_writeIdx-m_readIdx-header.m_headerByteSize);
+}
+
+bool ReceiveBuffer::IsCorrupted() const
+{
+	return m_isCorrupted;
+}
+
+Packet *ReceiveBuffer::PopPacket()
+{
+	if(!IsPacketAvailable())
+		return NULL;
+	FrameCodec::FrameHeader header;
+	getFrontHeader(header);
+	const char *payload=m_buffer+m_readIdx+header.m_headerByteSize;
+	Packet *retPacket;
+	// the frame marked compressed is only available after the negotiation
+	if(header.m_isCompressed)
+		retPacket=m_frameCodec->DecompressPayload(payload,header.m_payloadByteSize,m_maxFrameByteSize);
+	else
+		retPacket=EP_NEW Packet(payload,header.m_payloadByteSize);
+	if(!retPacket)
+	{
+		// the peer sending the broken frame can not be trusted any further
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to decompress the packet\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		m_isCorrupted=true;
+		return NULL;
+	}
+	m_readIdx+=header.m_headerByteSize+header.m_payloadByteSize;
+	consumeControlFrames();
+	retPacket->SetMessageType(header.m_messageType);
+	retPacket->SetFrameFlags(header.m_flags);
+	return retPacket;
+}
+
+bool ReceiveBuffer::PopChunk(Chunk &retChunk)
+{
+	if(!m_isChunking)
+	{
+		FrameCodec::FrameHeader header;
+		if(m_isCorrupted || !getFrontHeader(header) || header.m_isCorrupted || isTooLarge(header) || !isChunked(header))
+			return false;
+		m_readIdx+=header.m_headerByteSize;
+		m_isChunking=true;
+		m_chunkMessageType=header.m_messageType;
+		m_chunkOffset=0;
+		m_chunkRemainingByteSize=header.m_payloadByteSize;
+	}
+	unsigned int chunkByteSize=getFrontPacketByteSize();
+	if(m_writeIdx-m_readIdx<chunkByteSize)
+		return false;
+
+	retChunk.m_messageType=m_chunkMessageType;
+	retChunk.m_offset=m_chunkOffset;
+	retChunk.m_data=m_buffer+m_readIdx;
+	retChunk.m_byteSize=chunkByteSize;
+	retChunk.m_isLast=(chunkByteSize==m_chunkRemainingByteSize);
+	m_readIdx+=chunkByteSize;
+	m_chunkOffset+=chunkByteSize;
+	m_chunkRemainingByteSize-=chunkByteSize;
+	if(retChunk.m_isLast)
+	{
+		// the data is left in place until written again, so the chunk stays valid
+		m_isChunking=false;
+		consumeControlFrames();
+	}
+	else if(m_readIdx==m_writeIdx)
+	{
+		m_readIdx=0;
+		m_writeIdx=0;
+	}
+	return true;
+}
+
+unsigned int ReceiveBuffer::GetReadableByteSize() const
+{
+	return m_writeIdx-m_readIdx;
+}
+
+void ReceiveBuffer::Clear()
+{
+	m_readIdx=0;
+	m_writeIdx=0;
+	m_isCorrupted=false;
+	m_isChunking=false;
+	m_chunkOffset=0;
+	m_chunkRemainingByteSize=0;
+}
\ No newline at end of file
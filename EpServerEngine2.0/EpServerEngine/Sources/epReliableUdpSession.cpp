@@ -0,0 +1,420 @@
+/*! 
+ReliableUdpSession for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epReliableUdpSession.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+/*!
+Write the sequence in the network byte order
+@param[out] buffer the buffer to write into
+@param[in] sequence the sequence to write
+*/
+static void writeSequence(char *buffer,unsigned int sequence)
+{
+	u_long netSequence=htonl(sequence);
+	epl::System::Memcpy(buffer,&netSequence,sizeof(u_long));
+}
+
+/*!
+Read the sequence in the network byte order
+@param[in] buffer the buffer to read from
+@return the sequence read
+*/
+static unsigned int readSequence(const char *buffer)
+{
+	u_long netSequence;
+	epl::System::Memcpy(&netSequence,buffer,sizeof(u_long));
+	return ntohl(netSequence);
+}
+
+ReliableUdpSession::ReliableUdpSession(DatagramSenderInterface *sender,unsigned int maxDatagramByteSize,epl::LockPolicy lockPolicyType)
+{
+	EP_ASSERT(sender);
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_sessionLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_sessionLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_sessionLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_sessionLock=NULL;
+		break;
+	}
+	m_sender=sender;
+	m_maxDatagramByteSize=maxDatagramByteSize;
+	for(unsigned int trav=0;trav<UDP_CHANNEL_COUNT;trav++)
+	{
+		m_sendChannelList[trav]=NULL;
+		m_receiveChannelList[trav]=NULL;
+	}
+	m_isRttMeasured=false;
+	m_smoothedRtt=0;
+	m_rttVariance=0;
+	m_rto=RELIABLE_UDP_RTO_DEFAULT;
+}
+
+ReliableUdpSession::~ReliableUdpSession()
+{
+	m_sessionLock->Lock();
+	deleteChannels();
+	m_sessionLock->Unlock();
+
+	if(m_sessionLock)
+		EP_DELETE m_sessionLock;
+	m_sessionLock=NULL;
+}
+
+void ReliableUdpSession::Reset()
+{
+	epl::LockObj lock(m_sessionLock);
+	deleteChannels();
+	m_isRttMeasured=false;
+	m_smoothedRtt=0;
+	m_rttVariance=0;
+	m_rto=RELIABLE_UDP_RTO_DEFAULT;
+}
+
+void ReliableUdpSession::deleteChannels()
+{
+	for(unsigned int trav=0;trav<UDP_CHANNEL_COUNT;trav++)
+	{
+		SendChannel *sendChannel=m_sendChannelList[trav];
+		if(sendChannel)
+		{
+			for(unsigned int slotIdx=0;slotIdx<RELIABLE_UDP_WINDOW_SIZE;slotIdx++)
+			{
+				if(sendChannel->m_slotList[slotIdx].m_datagram)
+					sendChannel->m_slotList[slotIdx].m_datagram->ReleaseObj();
+			}
+			EP_DELETE sendChannel;
+		}
+		m_sendChannelList[trav]=NULL;
+
+		ReceiveChannel *receiveChannel=m_receiveChannelList[trav];
+		if(receiveChannel)
+		{
+			for(unsigned int slotIdx=0;slotIdx<RELIABLE_UDP_WINDOW_SIZE;slotIdx++)
+			{
+				if(receiveChannel->m_packetList[slotIdx])
+					receiveChannel->m_packetList[slotIdx]->ReleaseObj();
+			}
+			EP_DELETE receiveChannel;
+		}
+		m_receiveChannelList[trav]=NULL;
+	}
+
+	while(!m_receivedList.empty())
+	{
+		m_receivedList.front()->ReleaseObj();
+		m_receivedList.pop();
+	}
+}
+
+void ReliableUdpSession::SetMaxDatagramByteSize(unsigned int maxDatagramByteSize)
+{
+	epl::LockObj lock(m_sessionLock);
+	m_maxDatagramByteSize=maxDatagramByteSize;
+}
+
+unsigned int ReliableUdpSession::GetRoundTripTime() const
+{
+	return m_smoothedRtt;
+}
+
+unsigned int ReliableUdpSession::GetRetransmissionTimeout() const
+{
+	return m_rto;
+}
+
+ReliableUdpSession::SendChannel *ReliableUdpSession::getSendChannel(UdpChannel channel)
+{
+	if(!m_sendChannelList[channel])
+	{
+		m_sendChannelList[channel]=EP_NEW SendChannel();
+		epl::System::Memset(m_sendChannelList[channel],0,sizeof(SendChannel));
+	}
+	return m_sendChannelList[channel];
+}
+
+ReliableUdpSession::ReceiveChannel *ReliableUdpSession::getReceiveChannel(UdpChannel channel)
+{
+	if(!m_receiveChannelList[channel])
+	{
+		m_receiveChannelList[channel]=EP_NEW ReceiveChannel();
+		epl::System::Memset(m_receiveChannelList[channel],0,sizeof(ReceiveChannel));
+	}
+	return m_receiveChannelList[channel];
+}
+
+int ReliableUdpSession::Send(const Packet &packet,UdpChannel channel,SendStatus *sendStatus)
+{
+	unsigned int byteSize=packet.GetPacketByteSize();
+	if(channel>=UDP_CHANNEL_COUNT || byteSize==0 || byteSize+RELIABLE_UDP_DATA_HEADER_BYTE_SIZE>m_maxDatagramByteSize)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+
+	epl::LockObj lock(m_sessionLock);
+	SendChannel *sendChannel=NULL;
+	unsigned int sequence=0;
+	if(channel!=UDP_CHANNEL_UNRELIABLE)
+	{
+		sendChannel=getSendChannel(channel);
+		if(sendChannel->m_nextSequence-sendChannel->m_sendBase>=RELIABLE_UDP_WINDOW_SIZE)
+		{
+			if(sendStatus)
+				*sendStatus=SEND_STATUS_FAIL_SEND_QUEUE_FULL;
+			return -1;
+		}
+		sequence=sendChannel->m_nextSequence++;
+	}
+
+	Packet *datagram=EP_NEW Packet(NULL,byteSize+RELIABLE_UDP_DATA_HEADER_BYTE_SIZE,true,m_lockPolicy);
+	char *datagramData=const_cast<char*>(datagram->GetPacket());
+	datagramData[0]=RELIABLE_UDP_HEADER_TYPE_DATA;
+	datagramData[1]=static_cast<char>(channel);
+	writeSequence(datagramData+2,sequence);
+	epl::System::Memcpy(datagramData+RELIABLE_UDP_DATA_HEADER_BYTE_SIZE,packet.GetPacket(),byteSize);
+
+	int sentLength=m_sender->SendDatagram(*datagram,sendStatus);
+	if(!sendChannel)
+	{
+		datagram->ReleaseObj();
+		if(sentLength<=0)
+			return sentLength;
+		return static_cast<int>(byteSize);
+	}
+
+	// kept to retransmit even if this send failed
+	SendSlot &slot=sendChannel->m_slotList[sequence&(RELIABLE_UDP_WINDOW_SIZE-1)];
+	slot.m_datagram=datagram;
+	slot.m_sentTime=GetTickCount();
+	slot.m_retransmitCount=0;
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return static_cast<int>(byteSize);
+}
+
+void ReliableUdpSession::Receive(const char *datagram,unsigned int byteSize)
+{
+	if(byteSize<2)
+		return;
+	char type=datagram[0];
+	unsigned int channel=static_cast<unsigned char>(datagram[1]);
+	if(channel>=UDP_CHANNEL_COUNT)
+		return;
+
+	epl::LockObj lock(m_sessionLock);
+	if(type==RELIABLE_UDP_HEADER_TYPE_DATA && byteSize>RELIABLE_UDP_DATA_HEADER_BYTE_SIZE)
+	{
+		const char *packetData=datagram+RELIABLE_UDP_DATA_HEADER_BYTE_SIZE;
+		unsigned int packetByteSize=byteSize-RELIABLE_UDP_DATA_HEADER_BYTE_SIZE;
+		if(channel==UDP_CHANNEL_UNRELIABLE)
+			m_receivedList.push(EP_NEW Packet(packetData,packetByteSize,true,m_lockPolicy));
+		else
+			receiveReliable(static_cast<UdpChannel>(channel),readSequence(datagram+2),packetData,packetByteSize);
+	}
+	else if(type==RELIABLE_UDP_HEADER_TYPE_ACK && byteSize>=RELIABLE_UDP_ACK_BYTE_SIZE && channel!=UDP_CHANNEL_UNRELIABLE)
+	{
+		receiveAck(static_cast<UdpChannel>(channel),readSequence(datagram+2),readSequence(datagram+6));
+	}
+}
+
+void ReliableUdpSession::receiveReliable(UdpChannel channel,unsigned int sequence,const char *packetData,unsigned int byteSize)
+{
+	ReceiveChannel *receiveChannel=getReceiveChannel(channel);
+	// the sequence behind the base is the duplicate, and too far ahead is dropped to bound the memory
+	if(sequence-receiveChannel->m_receiveBase<RELIABLE_UDP_WINDOW_SIZE)
+	{
+		unsigned int slotIdx=sequence&(RELIABLE_UDP_WINDOW_SIZE-1);
+		if(!receiveChannel->m_isReceivedList[slotIdx])
+		{
+			receiveChannel->m_isReceivedList[slotIdx]=true;
+			Packet *packet=EP_NEW Packet(packetData,byteSize,true,m_lockPolicy);
+			if(channel==UDP_CHANNEL_RELIABLE_ORDERED)
+				receiveChannel->m_packetList[slotIdx]=packet;
+			else
+				m_receivedList.push(packet);
+
+			while(receiveChannel->m_isReceivedList[receiveChannel->m_receiveBase&(RELIABLE_UDP_WINDOW_SIZE-1)])
+			{
+				unsigned int baseIdx=receiveChannel->m_receiveBase&(RELIABLE_UDP_WINDOW_SIZE-1);
+				receiveChannel->m_isReceivedList[baseIdx]=false;
+				if(receiveChannel->m_packetList[baseIdx])
+				{
+					m_receivedList.push(receiveChannel->m_packetList[baseIdx]);
+					receiveChannel->m_packetList[baseIdx]=NULL;
+				}
+				receiveChannel->m_receiveBase++;
+			}
+		}
+	}
+	// acknowledged even for the duplicate, since the previous acknowledgement might be lost
+	sendAck(channel,receiveChannel);
+}
+
+void ReliableUdpSession::sendAck(UdpChannel channel,ReceiveChannel *receiveChannel)
+{
+	unsigned int ackBase=receiveChannel->m_receiveBase;
+	unsigned int ackBits=0;
+	for(unsigned int trav=0;trav<RELIABLE_UDP_ACK_BIT_COUNT && trav+1<RELIABLE_UDP_WINDOW_SIZE;trav++)
+	{
+		if(receiveChannel->m_isReceivedList[(ackBase+1+trav)&(RELIABLE_UDP_WINDOW_SIZE-1)])
+			ackBits|=(1u<<trav);
+	}
+
+	char ack[RELIABLE_UDP_ACK_BYTE_SIZE];
+	ack[0]=RELIABLE_UDP_HEADER_TYPE_ACK;
+	ack[1]=static_cast<char>(channel);
+	writeSequence(ack+2,ackBase);
+	writeSequence(ack+6,ackBits);
+	Packet ackPacket(ack,RELIABLE_UDP_ACK_BYTE_SIZE,false,m_lockPolicy);
+	m_sender->SendDatagram(ackPacket,NULL);
+}
+
+void ReliableUdpSession::receiveAck(UdpChannel channel,unsigned int ackBase,unsigned int ackBits)
+{
+	SendChannel *sendChannel=getSendChannel(channel);
+	unsigned int currentTime=GetTickCount();
+	unsigned int inFlightCount=sendChannel->m_nextSequence-sendChannel->m_sendBase;
+
+	// the acknowledgement delayed behind the previous one has nothing new cumulatively
+	if(ackBase-sendChannel->m_sendBase<=inFlightCount)
+	{
+		for(unsigned int sequence=sendChannel->m_sendBase;sequence!=ackBase;sequence++)
+			acknowledge(sendChannel->m_slotList[sequence&(RELIABLE_UDP_WINDOW_SIZE-1)],currentTime);
+	}
+	for(unsigned int trav=0;trav<RELIABLE_UDP_ACK_BIT_COUNT;trav++)
+	{
+		if(!(ackBits&(1u<<trav)))
+			continue;
+		unsigned int sequence=ackBase+1+trav;
+		if(sequence-sendChannel->m_sendBase<inFlightCount)
+			acknowledge(sendChannel->m_slotList[sequence&(RELIABLE_UDP_WINDOW_SIZE-1)],currentTime);
+	}
+
+	while(sendChannel->m_sendBase!=sendChannel->m_nextSequence && !sendChannel->m_slotList[sendChannel->m_sendBase&(RELIABLE_UDP_WINDOW_SIZE-1)].m_datagram)
+		sendChannel->m_sendBase++;
+}
+
+void ReliableUdpSession::acknowledge(SendSlot &slot,unsigned int currentTime)
+{
+	if(!slot.m_datagram)
+		return;
+	// the retransmitted one is ambiguous which send is acknowledged, so not sampled
+	if(slot.m_retransmitCount==0)
+		updateRoundTripTime(currentTime-slot.m_sentTime);
+	slot.m_datagram->ReleaseObj();
+	slot.m_datagram=NULL;
+}
+
+void ReliableUdpSession::updateRoundTripTime(unsigned int sample)
+{
+	if(!m_isRttMeasured)
+	{
+		m_isRttMeasured=true;
+		m_smoothedRtt=sample;
+		m_rttVariance=sample/2;
+	}
+	else
+	{
+		unsigned int difference=(m_smoothedRtt>sample)?(m_smoothedRtt-sample):(sample-m_smoothedRtt);
+		m_rttVariance=(m_rttVariance*3+difference)/4;
+		m_smoothedRtt=(m_smoothedRtt*7+sample)/8;
+	}
+
+	unsigned int variance=m_rttVariance*4;
+	if(variance<RELIABLE_UDP_TICK_MILLISEC)
+		variance=RELIABLE_UDP_TICK_MILLISEC;
+	m_rto=m_smoothedRtt+variance;
+	if(m_rto<RELIABLE_UDP_RTO_MIN)
+		m_rto=RELIABLE_UDP_RTO_MIN;
+	else if(m_rto>RELIABLE_UDP_RTO_MAX)
+		m_rto=RELIABLE_UDP_RTO_MAX;
+}
+
+bool ReliableUdpSession::Update()
+{
+	epl::LockObj lock(m_sessionLock);
+	unsigned int currentTime=GetTickCount();
+	bool isAlive=true;
+	for(unsigned int channel=0;channel<UDP_CHANNEL_COUNT;channel++)
+	{
+		SendChannel *sendChannel=m_sendChannelList[channel];
+		if(!sendChannel)
+			continue;
+		for(unsigned int sequence=sendChannel->m_sendBase;sequence!=sendChannel->m_nextSequence;sequence++)
+		{
+			SendSlot &slot=sendChannel->m_slotList[sequence&(RELIABLE_UDP_WINDOW_SIZE-1)];
+			if(!slot.m_datagram)
+				continue;
+
+			// back off exponentially on every retransmission
+			unsigned int timeout=m_rto;
+			for(unsigned int trav=0;trav<slot.m_retransmitCount && timeout<RELIABLE_UDP_RTO_MAX;trav++)
+				timeout*=2;
+			if(timeout>RELIABLE_UDP_RTO_MAX)
+				timeout=RELIABLE_UDP_RTO_MAX;
+			if(currentTime-slot.m_sentTime<timeout)
+				continue;
+
+			if(slot.m_retransmitCount>=RELIABLE_UDP_RETRANSMIT_LIMIT)
+			{
+				isAlive=false;
+				continue;
+			}
+			slot.m_retransmitCount++;
+			slot.m_sentTime=currentTime;
+			m_sender->SendDatagram(*slot.m_datagram,NULL);
+		}
+	}
+	return isAlive;
+}
+
+Packet *ReliableUdpSession::PopPacket()
+{
+	epl::LockObj lock(m_sessionLock);
+	if(m_receivedList.empty())
+		return NULL;
+	Packet *packet=m_receivedList.front();
+	m_receivedList.pop();
+	return packet;
+}
\ No newline at end of file
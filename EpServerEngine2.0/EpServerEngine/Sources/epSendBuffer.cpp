@@ -0,0 +1,254 @@
+/*! 
+SendBuffer for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epSendBuffer.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+SendBuffer::SendBuffer(epl::LockPolicy lockPolicyType)
+{
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_lock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_lock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_lock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_lock=NULL;
+		break;
+	}
+	m_pushedTicket=0;
+	m_flushedTicket=0;
+	m_isFlushFailed=false;
+	m_frameCodec=NULL;
+}
+
+SendBuffer::SendBuffer(const SendBuffer& b)
+{
+	m_lockPolicy=b.m_lockPolicy;
+	switch(m_lockPolicy)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_lock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_lock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_lock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_lock=NULL;
+		break;
+	}
+	m_frameCodec=NULL;
+	epl::LockObj lock(b.m_lock);
+	m_pendingBuffer=b.m_pendingBuffer;
+	m_pushedTicket=b.m_pushedTicket;
+	m_flushedTicket=b.m_flushedTicket;
+	m_isFlushFailed=b.m_isFlushFailed;
+}
+
+SendBuffer::~SendBuffer()
+{
+	if(m_lock)
+		EP_DELETE m_lock;
+	m_lock=NULL;
+}
+
+SendBuffer & SendBuffer::operator=(const SendBuffer&b)
+{
+	if(this!=&b)
+	{
+		epl::LockObj lock(b.m_lock);
+		epl::LockObj lock2(m_lock);
+		m_pendingBuffer=b.m_pendingBuffer;
+		m_pushedTicket=b.m_pushedTicket;
+		m_flushedTicket=b.m_flushedTicket;
+		m_isFlushFailed=b.m_isFlushFailed;
+	}
+	return *this;
+}
+
+void SendBuffer::SetFrameCodec(FrameCodec *frameCodec)
+{
+	epl::LockObj lock(m_lock);
+	m_frameCodec=frameCodec;
+}
+
+unsigned int SendBuffer::encodeFrame(const Packet &packet,char *retHeader,Packet *&retCompressedPacket)
+{
+	retCompressedPacket=NULL;
+	if(m_frameCodec)
+		return m_frameCodec->EncodeFrame(packet,retHeader,retCompressedPacket);
+	return FrameCodec::EncodeLegacyHeader(packet.GetPacketByteSize(),retHeader);
+}
+
+unsigned int SendBuffer::Push(const Packet &packet)
+{
+	unsigned int length=packet.GetPacketByteSize();
+	const char *packetData=packet.GetPacket();
+	char header[FRAME_HEADER_BYTE_SIZE_MAX];
+	Packet *compressedPacket;
+
+	epl::LockObj lock(m_lock);
+	unsigned int headerByteSize=encodeFrame(packet,header,compressedPacket);
+	m_pendingBuffer.insert(m_pendingBuffer.end(),header,header+headerByteSize);
+	if(compressedPacket)
+	{
+		m_pendingBuffer.insert(m_pendingBuffer.end(),compressedPacket->GetPacket(),compressedPacket->GetPacket()+compressedPacket->GetPacketByteSize());
+		compressedPacket->ReleaseObj();
+	}
+	else if(length)
+		m_pendingBuffer.insert(m_pendingBuffer.end(),packetData,packetData+length);
+	m_pushedTicket++;
+	return m_pushedTicket;
+}
+
+bool SendBuffer::IsFlushed(unsigned int ticket) const
+{
+	// compare in the signed distance to survive the wrap around
+	return static_cast<int>(m_flushedTicket-ticket)>=0;
+}
+
+bool SendBuffer::Flush(SOCKET sendSocket,const Packet *packet)
+{
+	char header[FRAME_HEADER_BYTE_SIZE_MAX];
+	unsigned int headerByteSize=0;
+	Packet *compressedPacket=NULL;
+	m_lock->Lock();
+	m_flushingBuffer.swap(m_pendingBuffer);
+	unsigned int flushingTicket=m_pushedTicket;
+	// the header is written in the order of the frames, right after the packets held
+	if(packet)
+		headerByteSize=encodeFrame(*packet,header,compressedPacket);
+	m_lock->Unlock();
+	// the compressed is sent in place of the packet
+	if(compressedPacket)
+		packet=compressedPacket;
+
+	WSABUF wsaBufs[3];
+	unsigned int wsaBufCount=0;
+	unsigned int length=0;
+	if(m_flushingBuffer.size())
+	{
+		wsaBufs[wsaBufCount].buf=&m_flushingBuffer.at(0);
+		wsaBufs[wsaBufCount].len=static_cast<ULONG>(m_flushingBuffer.size());
+		wsaBufCount++;
+	}
+	if(packet)
+	{
+		length=packet->GetPacketByteSize();
+		// the header is written in the headroom only if no other sender can hold the packet,
+		// otherwise it is sent from the stack
+		if((compressedPacket || packet->GetReferenceCount()==1) && const_cast<Packet*>(packet)->WriteHeadroom(header,headerByteSize))
+		{
+			wsaBufs[wsaBufCount].buf=const_cast<char*>(packet->GetPacket())-headerByteSize;
+			wsaBufs[wsaBufCount].len=headerByteSize+length;
+			wsaBufCount++;
+		}
+		else
+		{
+			wsaBufs[wsaBufCount].buf=header;
+			wsaBufs[wsaBufCount].len=headerByteSize;
+			wsaBufCount++;
+			if(length)
+			{
+				wsaBufs[wsaBufCount].buf=const_cast<char*>(packet->GetPacket());
+				wsaBufs[wsaBufCount].len=length;
+				wsaBufCount++;
+			}
+		}
+	}
+
+	bool isSucceeded=true;
+	if(wsaBufCount)
+		isSucceeded=sendAll(sendSocket,wsaBufs,wsaBufCount);
+	if(compressedPacket)
+		compressedPacket->ReleaseObj();
+	m_flushingBuffer.clear();
+	if(!isSucceeded)
+		m_isFlushFailed=true;
+	m_flushedTicket=flushingTicket;
+	return isSucceeded;
+}
+
+bool SendBuffer::sendAll(SOCKET sendSocket,WSABUF *wsaBufs,unsigned int wsaBufCount)
+{
+	while(wsaBufCount)
+	{
+		DWORD sentLength=0;
+		if(WSASend(sendSocket,wsaBufs,wsaBufCount,&sentLength,0,NULL,NULL)==SOCKET_ERROR || sentLength==0)
+		{
+			epl::System::OutputDebugString(_T("%s::%s(%d) WSASend failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__);
+			return false;
+		}
+		// skip what is written for the partial write
+		while(wsaBufCount && sentLength>=wsaBufs->len)
+		{
+			sentLength-=wsaBufs->len;
+			wsaBufs++;
+			wsaBufCount--;
+		}
+		if(wsaBufCount)
+		{
+			wsaBufs->buf+=sentLength;
+			wsaBufs->len-=sentLength;
+		}
+	}
+	return true;
+}
+
+unsigned int SendBuffer::GetPendingByteSize() const
+{
+	epl::LockObj lock(m_lock);
+	return static_cast<unsigned int>(m_pendingBuffer.size());
+}
+
+bool SendBuffer::IsFlushFailed() const
+{
+	return m_isFlushFailed;
+}
+
+void SendBuffer::Clear()
+{
+	epl::LockObj lock(m_lock);
+	m_pendingBuffer.clear();
+	m_flushedTicket=m_pushedTicket;
+	m_isFlushFailed=false;
+}
\ No newline at end of file
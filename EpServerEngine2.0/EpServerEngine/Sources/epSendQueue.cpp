@@ -0,0 +1,198 @@
+/*! 
+SendQueue for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epSendQueue.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+SendQueue::SendQueue()
+{
+	m_stub.m_next=NULL;
+	m_stub.m_byteSize=0;
+	m_stub.m_messageType=0;
+	m_stub.m_flags=0;
+	m_head=&m_stub;
+	m_tail=&m_stub;
+	m_queuedByteSize=0;
+	m_isFull=0;
+	m_highWatermark=SEND_QUEUE_HIGH_WATERMARK_DEFAULT;
+	m_lowWatermark=SEND_QUEUE_LOW_WATERMARK_DEFAULT;
+	m_limit=SEND_QUEUE_LIMIT_INFINITE;
+	m_frameCodec=NULL;
+}
+
+SendQueue::~SendQueue()
+{
+	Clear();
+}
+
+void SendQueue::SetWatermark(unsigned int highWatermark,unsigned int lowWatermark,unsigned int limit)
+{
+	if(lowWatermark>highWatermark)
+		lowWatermark=highWatermark;
+	m_highWatermark=highWatermark;
+	m_lowWatermark=lowWatermark;
+	m_limit=limit;
+}
+
+void SendQueue::SetFrameCodec(FrameCodec *frameCodec)
+{
+	m_frameCodec=frameCodec;
+}
+
+bool SendQueue::Reserve(unsigned int byteSize,bool &retIsFull)
+{
+	retIsFull=false;
+	unsigned int queuedByteSize=static_cast<unsigned int>(InterlockedExchangeAdd(&m_queuedByteSize,static_cast<LONG>(byteSize)))+byteSize;
+	if(m_limit!=SEND_QUEUE_LIMIT_INFINITE && queuedByteSize>m_limit)
+	{
+		InterlockedExchangeAdd(&m_queuedByteSize,-static_cast<LONG>(byteSize));
+		return false;
+	}
+	if(queuedByteSize>=m_highWatermark && InterlockedCompareExchange(&m_isFull,1,0)==0)
+		retIsFull=true;
+	return true;
+}
+
+bool SendQueue::Release(unsigned int byteSize)
+{
+	unsigned int queuedByteSize=static_cast<unsigned int>(InterlockedExchangeAdd(&m_queuedByteSize,-static_cast<LONG>(byteSize)))-byteSize;
+	return (queuedByteSize<=m_lowWatermark && InterlockedCompareExchange(&m_isFull,0,1)==1);
+}
+
+bool SendQueue::Push(const Packet &packet,bool &retIsFull)
+{
+	unsigned int length=packet.GetPacketByteSize();
+	// accounted with the legacy size field until the header is written
+	if(!Reserve(length+sizeof(unsigned int),retIsFull))
+		return false;
+
+	// the data is placed right after the node in a single buffer of the Buffer Pool
+	char *block=reinterpret_cast<char*>(BufferPool::defaultBufferPool.Allocate(sizeof(Node)+length));
+	Node *node=reinterpret_cast<Node*>(block);
+	node->m_next=NULL;
+	node->m_byteSize=length;
+	node->m_messageType=packet.GetMessageType();
+	node->m_flags=packet.GetFrameFlags();
+	if(length)
+		epl::System::Memcpy(block+sizeof(Node),packet.GetPacket(),length);
+	pushNode(node);
+	return true;
+}
+
+void SendQueue::pushNode(Node *node)
+{
+	node->m_next=NULL;
+	Node *prev=reinterpret_cast<Node*>(InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&m_head),node));
+	// the consumer waits until the link is made
+	prev->m_next=node;
+}
+
+SendQueue::Node *SendQueue::popNode()
+{
+	Node *tail=m_tail;
+	Node *next=tail->m_next;
+	if(tail==&m_stub)
+	{
+		if(!next)
+			return NULL;
+		m_tail=next;
+		tail=next;
+		next=next->m_next;
+	}
+	if(next)
+	{
+		m_tail=next;
+		return tail;
+	}
+	// the producer is in the middle of linking
+	if(tail!=m_head)
+		return NULL;
+	pushNode(&m_stub);
+	next=tail->m_next;
+	if(next)
+	{
+		m_tail=next;
+		return tail;
+	}
+	return NULL;
+}
+
+unsigned int SendQueue::PopTo(vector<char> &retBuffer)
+{
+	unsigned int movedByteSize=0;
+	Node *node;
+	char header[FRAME_HEADER_BYTE_SIZE_MAX];
+	while((node=popNode())!=NULL)
+	{
+		char *data=reinterpret_cast<char*>(node)+sizeof(Node);
+		unsigned int byteSize=node->m_byteSize;
+		Packet *compressedPacket=NULL;
+		unsigned int headerByteSize;
+		if(m_frameCodec)
+			headerByteSize=m_frameCodec->EncodeFrame(data,byteSize,node->m_messageType,node->m_flags,header,compressedPacket);
+		else
+			headerByteSize=FrameCodec::EncodeLegacyHeader(byteSize,header);
+		if(compressedPacket)
+		{
+			data=const_cast<char*>(compressedPacket->GetPacket());
+			byteSize=compressedPacket->GetPacketByteSize();
+		}
+		// account the actual frame instead of the legacy size field and the packet
+		if(headerByteSize+byteSize!=sizeof(unsigned int)+node->m_byteSize)
+			InterlockedExchangeAdd(&m_queuedByteSize,static_cast<LONG>(headerByteSize+byteSize)-static_cast<LONG>(sizeof(unsigned int)+node->m_byteSize));
+
+		retBuffer.insert(retBuffer.end(),header,header+headerByteSize);
+		retBuffer.insert(retBuffer.end(),data,data+byteSize);
+		movedByteSize+=headerByteSize+byteSize;
+		if(compressedPacket)
+			compressedPacket->ReleaseObj();
+		BufferPool::defaultBufferPool.Free(node);
+	}
+	return movedByteSize;
+}
+
+unsigned int SendQueue::GetQueuedByteSize() const
+{
+	return static_cast<unsigned int>(m_queuedByteSize);
+}
+
+void SendQueue::Clear()
+{
+	Node *node;
+	while((node=popNode())!=NULL)
+	{
+		BufferPool::defaultBufferPool.Free(node);
+	}
+	InterlockedExchange(&m_queuedByteSize,0);
+	InterlockedExchange(&m_isFull,0);
+}
\ No newline at end of file
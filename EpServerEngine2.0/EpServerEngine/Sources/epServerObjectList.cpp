@@ -34,6 +34,8 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace epse;
 
+volatile LONG ServerObjectList::m_lastObjectId=OBJECT_ID_NONE;
+
 ServerObjectList::ServerObjectList(unsigned int waitTimeMilliSec, epl::LockPolicy lockPolicyType)
 {
 	m_waitTime=waitTimeMilliSec;
@@ -55,6 +57,7 @@ ServerObjectList::ServerObjectList(unsigned int waitTimeMilliSec, epl::LockPolic
 		m_listLock=NULL;
 		break;
 	}
+	createShards();
 }
 
 ServerObjectList::ServerObjectList(const ServerObjectList& b)
@@ -78,17 +81,8 @@ ServerObjectList::ServerObjectList(const ServerObjectList& b)
 	}
 	m_waitTime=b.m_waitTime;
 
-	ServerObjectList&unSafeB=const_cast<ServerObjectList&>(b);
-	unSafeB.m_listLock->Lock();
-	m_objectList=b.m_objectList;
-	vector<BaseServerObject*>::iterator iter;
-	for(iter=m_objectList.begin();iter!=m_objectList.end();iter++)
-	{
-		(*iter)->RetainObj();
-		(*iter)->setContainer(this);
-
-	}
-	unSafeB.m_listLock->Unlock();
+	createShards();
+	copyShards(b);
 
 	m_serverObjRemover=b.m_serverObjRemover;
 
@@ -106,6 +100,12 @@ void ServerObjectList::resetList()
 	if(m_listLock)
 		EP_DELETE m_listLock;
 	m_listLock=NULL;
+	for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
+	{
+		if(m_shardList[shardIdx].m_lock)
+			EP_DELETE m_shardList[shardIdx].m_lock;
+		m_shardList[shardIdx].m_lock=NULL;
+	}
 }
 ServerObjectList & ServerObjectList::operator=(const ServerObjectList&b)
 {
@@ -131,17 +131,9 @@ ServerObjectList & ServerObjectList::operator=(const ServerObjectList&b)
 			break;
 		}
 		m_waitTime=b.m_waitTime;
-		ServerObjectList&unSafeB=const_cast<ServerObjectList&>(b);
-		unSafeB.m_listLock->Lock();
-		m_objectList=b.m_objectList;
-		vector<BaseServerObject*>::iterator iter;
-		for(iter=m_objectList.begin();iter!=m_objectList.end();iter++)
-		{
-			(*iter)->RetainObj();
-			(*iter)->setContainer(this);
 
-		}
-		unSafeB.m_listLock->Unlock();
+		createShards();
+		copyShards(b);
 
 		m_serverObjRemover=b.m_serverObjRemover;
 
@@ -149,6 +141,65 @@ ServerObjectList & ServerObjectList::operator=(const ServerObjectList&b)
 	return *this;
 }
 
+void ServerObjectList::createShards()
+{
+	for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
+	{
+		switch(m_lockPolicy)
+		{
+		case epl::LOCK_POLICY_CRITICALSECTION:
+			m_shardList[shardIdx].m_lock=EP_NEW epl::CriticalSectionEx();
+			break;
+		case epl::LOCK_POLICY_MUTEX:
+			m_shardList[shardIdx].m_lock=EP_NEW epl::Mutex();
+			break;
+		case epl::LOCK_POLICY_NONE:
+			m_shardList[shardIdx].m_lock=EP_NEW epl::NoLock();
+			break;
+		default:
+			m_shardList[shardIdx].m_lock=NULL;
+			break;
+		}
+	}
+}
+
+void ServerObjectList::copyShards(const ServerObjectList &b)
+{
+	ServerObjectList&unSafeB=const_cast<ServerObjectList&>(b);
+	for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
+	{
+		ObjectShard &shard=m_shardList[shardIdx];
+		ObjectShard &bShard=unSafeB.m_shardList[shardIdx];
+		bShard.m_lock->Lock();
+		shard.m_objectMap=bShard.m_objectMap;
+		shard.m_addressMap=bShard.m_addressMap;
+		map<unsigned int,ObjectEntry>::iterator iter;
+		for(iter=shard.m_objectMap.begin();iter!=shard.m_objectMap.end();iter++)
+		{
+			iter->second.m_object->RetainObj();
+			iter->second.m_object->setContainer(this);
+		}
+		bShard.m_lock->Unlock();
+	}
+}
+
+unsigned int ServerObjectList::getShardIndex(unsigned int objectId)
+{
+	return objectId%SERVER_OBJECT_LIST_SHARD_COUNT;
+}
+
+unsigned int ServerObjectList::getShardIndex(const sockaddr &sockAddr)
+{
+	// FNV-1a hash of the family and the address
+	unsigned int hash=2166136261U;
+	hash=(hash^(unsigned int)sockAddr.sa_family)*16777619U;
+	for(unsigned int byteIdx=0;byteIdx<sizeof(sockAddr.sa_data);byteIdx++)
+	{
+		hash=(hash^(unsigned char)sockAddr.sa_data[byteIdx])*16777619U;
+	}
+	return hash%SERVER_OBJECT_LIST_SHARD_COUNT;
+}
+
 void ServerObjectList::SetWaitTime(unsigned int milliSec)
 {
 	epl::LockObj lock(m_listLock);
@@ -163,66 +214,131 @@ unsigned int ServerObjectList::GetWaitTime()
 
 bool ServerObjectList::Remove(const BaseServerObject* serverObj)
 {
-	epl::LockObj lock(m_listLock);
-	for(ssize_t idx=static_cast<ssize_t>(m_objectList.size())-1;idx>=0;idx--)
+	if(!serverObj)
+		return false;
+	ObjectShard &shard=m_shardList[getShardIndex(serverObj->m_objectId)];
+	shard.m_lock->Lock();
+	map<unsigned int,ObjectEntry>::iterator iter=shard.m_objectMap.find(serverObj->m_objectId);
+	if(iter==shard.m_objectMap.end() || iter->second.m_object!=serverObj)
 	{
-		if((m_objectList.at(idx))==serverObj)
-		{
-			m_serverObjRemover.Push(m_objectList.at(idx));
-			m_objectList.erase(m_objectList.begin()+idx);
-			m_sizeEvent.SetEvent();
-			return true;
-		}
+		shard.m_lock->Unlock();
+		return false;
+	}
+	ObjectEntry entry=iter->second;
+	shard.m_objectMap.erase(iter);
+	shard.m_lock->Unlock();
+
+	if(entry.m_hasAddress)
+	{
+		ObjectShard &addressShard=m_shardList[getShardIndex(entry.m_sockAddr)];
+		epl::LockObj lock(addressShard.m_lock);
+		map<sockaddr,BaseServerObject*,SockAddrLess>::iterator addressIter=addressShard.m_addressMap.find(entry.m_sockAddr);
+		if(addressIter!=addressShard.m_addressMap.end() && addressIter->second==serverObj)
+			addressShard.m_addressMap.erase(addressIter);
 	}
-	return false;
+	m_serverObjRemover.Push(entry.m_object);
+	m_sizeEvent.SetEvent();
+	return true;
 }
 
 void ServerObjectList::Clear()
 {
-	epl::LockObj lock(m_listLock);
-	vector<BaseServerObject*>::iterator iter;
-	for(iter=m_objectList.begin();iter!=m_objectList.end();iter++)
+	for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
 	{
-		if(*iter)
+		ObjectShard &shard=m_shardList[shardIdx];
+		if(!shard.m_lock)
+			continue;
+		epl::LockObj lock(shard.m_lock);
+		map<unsigned int,ObjectEntry>::iterator iter;
+		for(iter=shard.m_objectMap.begin();iter!=shard.m_objectMap.end();iter++)
 		{
-			(*iter)->setContainer(NULL);
-			m_serverObjRemover.Push(*iter);
-			
+			iter->second.m_object->setContainer(NULL);
+			m_serverObjRemover.Push(iter->second.m_object);
 		}
+		shard.m_objectMap.clear();
+		shard.m_addressMap.clear();
 	}
-	m_objectList.clear();
 	m_sizeEvent.SetEvent();
 }
 
 void ServerObjectList::Push(BaseServerObject* obj)
 {
-	epl::LockObj lock(m_listLock);
-	if(obj)
+	if(!obj)
+		return;
+	obj->RetainObj();
+
+	ObjectEntry entry;
+	entry.m_object=obj;
+	entry.m_hasAddress=obj->getIndexAddress(entry.m_sockAddr);
+	// a recycled object is given a new id for each time pushed
+	do{
+		obj->m_objectId=(unsigned int)InterlockedIncrement(&m_lastObjectId);
+	}while(obj->m_objectId==OBJECT_ID_NONE);
+
+	if(entry.m_hasAddress)
 	{
-		obj->RetainObj();
-		m_objectList.push_back(obj);
-		obj->setContainer(this);
+		ObjectShard &addressShard=m_shardList[getShardIndex(entry.m_sockAddr)];
+		epl::LockObj lock(addressShard.m_lock);
+		addressShard.m_addressMap[entry.m_sockAddr]=obj;
 	}
-	
+	ObjectShard &shard=m_shardList[getShardIndex(obj->m_objectId)];
+	shard.m_lock->Lock();
+	shard.m_objectMap[obj->m_objectId]=entry;
+	shard.m_lock->Unlock();
+	obj->setContainer(this);
 }
 
 vector<BaseServerObject*> ServerObjectList::GetList() const
 {
-	epl::LockObj lock(m_listLock);
-	return m_objectList;
+	vector<BaseServerObject*> retList;
+	for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
+	{
+		const ObjectShard &shard=m_shardList[shardIdx];
+		epl::LockObj lock(shard.m_lock);
+		map<unsigned int,ObjectEntry>::const_iterator iter;
+		for(iter=shard.m_objectMap.begin();iter!=shard.m_objectMap.end();iter++)
+		{
+			retList.push_back(iter->second.m_object);
+		}
+	}
+	return retList;
 }
 
 size_t ServerObjectList::Count() const
 {
-	epl::LockObj lock(m_listLock);
-	return m_objectList.size();
+	size_t retCount=0;
+	for(unsigned int shardIdx=0;shardIdx<SERVER_OBJECT_LIST_SHARD_COUNT;shardIdx++)
+	{
+		const ObjectShard &shard=m_shardList[shardIdx];
+		epl::LockObj lock(shard.m_lock);
+		retCount+=shard.m_objectMap.size();
+	}
+	return retCount;
+}
+
+BaseServerObject *ServerObjectList::Find(const sockaddr &sockAddr)
+{
+	ObjectShard &shard=m_shardList[getShardIndex(sockAddr)];
+	epl::LockObj lock(shard.m_lock);
+	map<sockaddr,BaseServerObject*,SockAddrLess>::iterator iter=shard.m_addressMap.find(sockAddr);
+	if(iter!=shard.m_addressMap.end())
+		return iter->second;
+	return NULL;
+}
+
+BaseServerObject *ServerObjectList::Find(unsigned int objectId)
+{
+	ObjectShard &shard=m_shardList[getShardIndex(objectId)];
+	epl::LockObj lock(shard.m_lock);
+	map<unsigned int,ObjectEntry>::iterator iter=shard.m_objectMap.find(objectId);
+	if(iter!=shard.m_objectMap.end())
+		return iter->second.m_object;
+	return NULL;
 }
 
 void ServerObjectList::Do(void (__cdecl *DoFunc)(BaseServerObject*,unsigned int,va_list),unsigned int argCount,...)
 {
-	m_listLock->Lock();
-	vector<BaseServerObject*> objList=m_objectList;
-	m_listLock->Unlock();
+	vector<BaseServerObject*> objList=GetList();
 
 	void *argPtr=NULL;
 	va_list ap=NULL;
@@ -237,9 +353,7 @@ void ServerObjectList::Do(void (__cdecl *DoFunc)(BaseServerObject*,unsigned int,
 
 void ServerObjectList::Do(void (__cdecl *DoFunc)(BaseServerObject*,unsigned int,va_list),unsigned int argCount,va_list args)
 {
-	m_listLock->Lock();
-	vector<BaseServerObject*> objList=m_objectList;
-	m_listLock->Unlock();
+	vector<BaseServerObject*> objList=GetList();
 
 	for(ssize_t idx=static_cast<ssize_t>(objList.size())-1;idx>=0;idx--)
 	{
@@ -0,0 +1,87 @@
+/*! 
+ShardChannel for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epShardChannel.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+ShardChannel::ShardChannel(unsigned int capacity)
+{
+	m_capacity=2;
+	while(m_capacity<capacity)
+		m_capacity<<=1;
+	m_ring=EP_NEW Packet*[m_capacity];
+	m_readIdx=0;
+	m_writeIdx=0;
+}
+
+ShardChannel::~ShardChannel()
+{
+	Packet *message;
+	while((message=Pop())!=NULL)
+		message->ReleaseObj();
+	if(m_ring)
+		EP_DELETE[] m_ring;
+	m_ring=NULL;
+}
+
+bool ShardChannel::Push(Packet *message)
+{
+	EP_ASSERT(message);
+	unsigned int writeIdx=m_writeIdx;
+	if(writeIdx-m_readIdx>=m_capacity)
+		return false;
+	message->RetainObj();
+	m_ring[writeIdx&(m_capacity-1)]=message;
+	// publish the message before the position
+	MemoryBarrier();
+	m_writeIdx=writeIdx+1;
+	return true;
+}
+
+Packet *ShardChannel::Pop()
+{
+	unsigned int readIdx=m_readIdx;
+	if(readIdx==m_writeIdx)
+		return NULL;
+	MemoryBarrier();
+	Packet *message=m_ring[readIdx&(m_capacity-1)];
+	// release the slot after the message is read
+	MemoryBarrier();
+	m_readIdx=readIdx+1;
+	return message;
+}
+
+bool ShardChannel::IsEmpty() const
+{
+	return (m_readIdx==m_writeIdx);
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+/*! 
+SocketPool for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epSocketPool.h"
+#include "epBaseSocket.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+SocketPool::SocketPool(unsigned int capacity,epl::LockPolicy lockPolicyType)
+{
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_listLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_listLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_listLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_listLock=NULL;
+		break;
+	}
+	m_capacity=capacity;
+}
+
+SocketPool::~SocketPool()
+{
+	Clear();
+	if(m_listLock)
+		EP_DELETE m_listLock;
+	m_listLock=NULL;
+}
+
+void SocketPool::SetCapacity(unsigned int capacity)
+{
+	epl::LockObj lock(m_listLock);
+	m_capacity=capacity;
+}
+
+unsigned int SocketPool::GetCapacity() const
+{
+	epl::LockObj lock(m_listLock);
+	return m_capacity;
+}
+
+BaseSocket *SocketPool::Acquire()
+{
+	epl::LockObj lock(m_listLock);
+	// the sockets retired earlier are more likely to be released
+	size_t searchCount=m_socketList.size();
+	if(searchCount>SOCKET_POOL_SEARCH_COUNT)
+		searchCount=SOCKET_POOL_SEARCH_COUNT;
+	for(size_t trav=0;trav<searchCount;trav++)
+	{
+		BaseSocket *socket=m_socketList.front();
+		m_socketList.pop_front();
+		if(socket->isRecyclable())
+		{
+			socket->resetConnection();
+			return socket;
+		}
+		m_socketList.push_back(socket);
+	}
+	return NULL;
+}
+
+void SocketPool::Retire(BaseSocket *socket)
+{
+	EP_ASSERT(socket);
+	epl::LockObj lock(m_listLock);
+	if(m_socketList.size()>=m_capacity)
+		return;
+	socket->RetainObj();
+	m_socketList.push_back(socket);
+}
+
+void SocketPool::Clear()
+{
+	m_listLock->Lock();
+	deque<BaseSocket*> socketList;
+	socketList.swap(m_socketList);
+	m_listLock->Unlock();
+
+	for(size_t trav=0;trav<socketList.size();trav++)
+	{
+		socketList[trav]->ReleaseObj();
+	}
+}
+
+size_t SocketPool::Count() const
+{
+	epl::LockObj lock(m_listLock);
+	return m_socketList.size();
+}
\ No newline at end of file
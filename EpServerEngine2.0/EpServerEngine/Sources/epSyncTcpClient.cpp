@@ -93,6 +93,9 @@ bool SyncTcpClient::Connect(const ClientOps &ops)
 		m_hostName=DEFAULT_HOSTNAME;
 	}
 	SetWaitTime(ops.waitTimeMilliSec);
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
+	setReceiveLimit(ops.maxFrameByteSize,ops.receiveChunkByteSize);
+	m_frameCodec.Reset(ops.frameVersion,true);
 
 
 	WSADATA wsaData;
@@ -147,6 +150,9 @@ bool SyncTcpClient::Connect(const ClientOps &ops)
 		cleanUpClient();
 		return false;
 	}
+	// discard the data left from the previous connection
+	m_recvBuffer.Clear();
+	m_pendingSendBuffer.Clear();
 	m_isConnected=true;
 	return true;
 
@@ -198,10 +204,10 @@ void SyncTcpClient::disconnect()
 	
 }
 
-int SyncTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int SyncTcpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_generalLock);
-	return BaseTcpClient::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseTcpClient::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 Packet *SyncTcpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *retStatus)
@@ -214,6 +220,15 @@ Packet *SyncTcpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 		return NULL;
 	}
 
+	// packet already in the receive buffer
+	Packet *recvPacket=popPacket();
+	if(recvPacket)
+	{
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
+	}
+
 	// select routine
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
@@ -249,40 +264,25 @@ Packet *SyncTcpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 	}
 
 	// receive routine
-	int iResult;
-	int size =receive(m_recvSizePacket);
-	if(size>0)
-	{
-		unsigned int shouldReceive=(reinterpret_cast<unsigned int*>(const_cast<char*>(m_recvSizePacket.GetPacket())))[0];
-		Packet *recvPacket=EP_NEW Packet(NULL,shouldReceive);
-		iResult = receive(*recvPacket);
-
-		if (iResult == shouldReceive) {
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_SUCCESS;
-			return recvPacket;
-		}
-		else if (iResult == 0)
-		{
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			disconnect();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
-			return NULL;
-		}
-		else  {
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			disconnect();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
-			return NULL;
-		}
+	int iResult =receive(recvPacket);
+	if (iResult > 0) {
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
 	}
-	else
+	else if (iResult == 0)
 	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		disconnect();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
+		return NULL;
+	}
+	else  {
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 		disconnect();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
 		return NULL;
 	}
 }
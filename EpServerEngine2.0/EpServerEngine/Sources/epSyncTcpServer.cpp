@@ -80,6 +80,9 @@ void SyncTcpServer::execute()
 				continue;
 			}
 			accWorker->setClientSocket(clientSocket);
+			accWorker->setCompressor(&m_compressor);
+			accWorker->setFrameVersion(m_frameVersion);
+			accWorker->setReceiveLimit(m_maxFrameByteSize,m_receiveChunkByteSize);
 			accWorker->setOwner(this);
 			accWorker->setSockAddr(sockAddr);
 			m_socketList.Push(accWorker);	
@@ -94,10 +94,10 @@ void SyncTcpSocket::killConnection()
 		m_callBackObj->OnDisconnect(this);
 	}
 }
-int SyncTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int SyncTcpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_baseSocketLock);
-	return BaseTcpSocket::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseTcpSocket::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 Packet *SyncTcpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *retStatus)
@@ -110,6 +110,15 @@ Packet *SyncTcpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 		return NULL;
 	}
 
+	// packet already in the receive buffer
+	Packet *recvPacket=popPacket();
+	if(recvPacket)
+	{
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
+	}
+
 	// select routine
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
@@ -145,44 +154,27 @@ Packet *SyncTcpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 	}
 
 	// receive routine
-	int iResult =receive(m_recvSizePacket);
-	if(iResult>0)
-	{
-		unsigned int shouldReceive=(reinterpret_cast<unsigned int*>(const_cast<char*>(m_recvSizePacket.GetPacket())))[0];
-		Packet *recvPacket=EP_NEW Packet(NULL,shouldReceive);
-		iResult = receive(*recvPacket);
-
-		if (iResult == shouldReceive) {
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_SUCCESS;
-			return recvPacket;
-		}
-		else if (iResult == 0)
-		{
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			killConnection();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
-			return NULL;
-		}
-		else  {
-			epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
-			recvPacket->ReleaseObj();
-			killConnection();
-			if(retStatus)
-				*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
-			return NULL;
-		}
+	int iResult =receive(recvPacket);
+	if (iResult > 0) {
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return recvPacket;
 	}
-	else
+	else if (iResult == 0)
 	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Connection closing...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
 		killConnection();
 		if(retStatus)
 			*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
 		return NULL;
 	}
-
+	else  {
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) recv failed with error\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		killConnection();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_RECEIVE_FAILED;
+		return NULL;
+	}
 }
 void SyncTcpSocket::execute()
 {
@@ -91,6 +91,7 @@ bool SyncUdpClient::Connect(const ClientOps &ops)
 		m_hostName=DEFAULT_HOSTNAME;
 	}
 	SetWaitTime(ops.waitTimeMilliSec);
+	m_compressor.Configure(ops.compressionThreshold,ops.compressionDictionary,ops.compressionDictionaryByteSize);
 
 	WSADATA wsaData;
 	m_maxPacketSize=0;
@@ -138,6 +139,7 @@ bool SyncUdpClient::Connect(const ClientOps &ops)
 
 	int nTmp = sizeof(int);
 	getsockopt(m_connectSocket, SOL_SOCKET,SO_MAX_MSG_SIZE, (char *)&m_maxPacketSize,&nTmp);
+	setUpSessions(ops.isReliableUdp,ops.isFragmentedUdp);
 	m_isConnected=true;
 	return true;
 }
@@ -191,10 +193,10 @@ void SyncUdpClient::disconnect()
 }
 
 
-int SyncUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int SyncUdpClient::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_generalLock);
-	return BaseUdpClient::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseUdpClient::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 
@@ -208,6 +210,26 @@ Packet *SyncUdpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 		return NULL;
 	}
 
+	if(!updateReliable())
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Server not responding...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		disconnect();
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_FAIL_CONNECTION_CLOSING;
+		return NULL;
+	}
+	Packet *readyPacket=popReceivedPacket();
+	if(readyPacket)
+	{
+		if(retStatus)
+			*retStatus=RECEIVE_STATUS_SUCCESS;
+		return readyPacket;
+	}
+
+	// the caller's receive loop drives the retransmission with the reliable UDP
+	if(m_reliableSession && (waitTimeInMilliSec==WAITTIME_INIFINITE || waitTimeInMilliSec>RELIABLE_UDP_TICK_MILLISEC))
+		waitTimeInMilliSec=RELIABLE_UDP_TICK_MILLISEC;
+
 	// select routine
 	TIMEVAL	timeOutVal;
 	fd_set	fdSet;
@@ -247,7 +269,14 @@ Packet *SyncUdpClient::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *re
 	iResult = receive(recvPacket);
 
 	if (iResult > 0) {
-		Packet *passPacket=EP_NEW Packet(recvPacket.GetPacket(),iResult);
+		Packet *passPacket=createReceivedPacket(recvPacket.GetPacket(),iResult);
+		if(!passPacket)
+		{
+			// the datagram only carried the acknowledgement or an out-of-order packet
+			if(retStatus)
+				*retStatus=RECEIVE_STATUS_FAIL_TIME_OUT;
+			return NULL;
+		}
 		if(retStatus)
 			*retStatus=RECEIVE_STATUS_SUCCESS;
 		return passPacket;
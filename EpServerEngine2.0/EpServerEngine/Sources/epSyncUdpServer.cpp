@@ -57,62 +57,76 @@ SyncUdpServer & SyncUdpServer::operator=(const SyncUdpServer&b)
 void SyncUdpServer::execute()
 {
 	Packet recvPacket(NULL,m_maxPacketSize);
-	char *packetData=const_cast<char*>(recvPacket.GetPacket());
+	char *recvBuffer=const_cast<char*>(recvPacket.GetPacket());
 	int length=recvPacket.GetPacketByteSize();
 	sockaddr clientSockAddr;
 	int sockAddrSize=sizeof(sockaddr);
 	while(m_listenSocket!=INVALID_SOCKET)
 	{
+		// receive straight into a slot of the slab, or into the heap buffer if all the slots are in use
+		PacketSlot *slot=NULL;
+		if(m_receiveSlab)
+			slot=m_receiveSlab->Acquire();
+		char *packetData=slot?slot->m_buffer:recvBuffer;
 		int recvLength=recvfrom(m_listenSocket,packetData,length, 0,&clientSockAddr,&sockAddrSize);
+		// the receive time-out only wakes up the loop to retransmit the reliable datagrams
+		if(recvLength!=SOCKET_ERROR || WSAGetLastError()!=WSAETIMEDOUT)
+			processDatagram(clientSockAddr,slot,packetData,recvLength);
+		// the packets delivered keep their own references
+		if(slot)
+			PacketSlab::ReleaseSlot(slot);
+		updateReliableSockets();
+	}
+
+	stopServer();
+}
 
-		SyncUdpSocket *workerObj=(SyncUdpSocket*)m_socketList.Find(clientSockAddr,socketCompare);
-		if(workerObj)
+void SyncUdpServer::processDatagram(const sockaddr &clientSockAddr,PacketSlot *slot,const char *packetData,int recvLength)
+{
+	SyncUdpSocket *workerObj=(SyncUdpSocket*)m_socketList.Find(clientSockAddr);
+	if(workerObj)
+	{
+		if(recvLength<=0)
 		{
-			if(recvLength<=0)
-			{
-				Packet *passPacket=EP_NEW Packet(packetData,0);
-				workerObj->addPacket(passPacket);
-				passPacket->ReleaseObj();
-				continue;
-			}	
-			Packet *passPacket=EP_NEW Packet(packetData,recvLength);
-			workerObj->addPacket(passPacket);
+			Packet *passPacket=EP_NEW Packet(packetData,0);
+			deliverPacket(workerObj,passPacket);
 			passPacket->ReleaseObj();
-		}
-		else
+			return;
+		}	
+		Packet *passPacket=createReceivedPacket(slot,packetData,recvLength);
+		deliverPacket(workerObj,passPacket);
+		passPacket->ReleaseObj();
+	}
+	else
+	{
+		if(recvLength<=0)
+			return;
+		if(GetMaximumConnectionCount()!=CONNECTION_LIMIT_INFINITE)
 		{
-			if(recvLength<=0)
-				continue;
-			if(GetMaximumConnectionCount()!=CONNECTION_LIMIT_INFINITE)
-			{
-				if(m_socketList.Count()>=GetMaximumConnectionCount())
-				{
-					continue;
-				}
-			}
-			if(!m_callBackObj->OnAccept(clientSockAddr))
+			if(m_socketList.Count()>=GetMaximumConnectionCount())
 			{
-				continue;
+				return;
 			}
-			/// Create Worker Thread
-			SyncUdpSocket *accWorker=EP_NEW SyncUdpSocket(m_callBackObj,m_waitTime,m_lockPolicy);
-			if(!accWorker)
-			{
-				continue;
-			}
-			Packet *passPacket=EP_NEW Packet(packetData,recvLength);
-			accWorker->setSockAddr(clientSockAddr);
-			accWorker->setOwner(this);
-			accWorker->setMaxPacketByteSize(m_maxPacketSize);
-			m_socketList.Push(accWorker);
-			accWorker->Start();
-			accWorker->addPacket(passPacket);
-			accWorker->ReleaseObj();
-			passPacket->ReleaseObj();
-
 		}
-
+		if(!m_callBackObj->OnAccept(clientSockAddr))
+		{
+			return;
+		}
+		/// Create Worker Thread
+		SyncUdpSocket *accWorker=EP_NEW SyncUdpSocket(m_callBackObj,m_waitTime,m_lockPolicy);
+		if(!accWorker)
+		{
+			return;
+		}
+		Packet *passPacket=createReceivedPacket(slot,packetData,recvLength);
+		accWorker->setSockAddr(clientSockAddr);
+		accWorker->setOwner(this);
+		accWorker->setMaxPacketByteSize(GetMaxPacketByteSize());
+		accWorker->setUpSessions(m_isReliableUdp,m_isFragmentedUdp);
+		m_socketList.Push(accWorker);
+		accWorker->Start();
+		deliverPacket(accWorker,passPacket);
+		accWorker->ReleaseObj();
+		passPacket->ReleaseObj();
 	}
-
-	stopServer();
 } 
@@ -107,10 +107,10 @@ void SyncUdpSocket::addPacket(Packet *packet)
 	m_packetReceivedEvent.SetEvent();
 }
 
-int SyncUdpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus)
+int SyncUdpSocket::Send(const Packet &packet, unsigned int waitTimeInMilliSec,SendStatus *sendStatus,bool isMoreComing)
 {
 	epl::LockObj lock(m_baseSocketLock);
-	return BaseUdpSocket::Send(packet,waitTimeInMilliSec,sendStatus);
+	return BaseUdpSocket::Send(packet,waitTimeInMilliSec,sendStatus,isMoreComing);
 }
 
 Packet *SyncUdpSocket::Receive(unsigned int waitTimeInMilliSec,ReceiveStatus *retStatus)
@@ -0,0 +1,216 @@
+/*! 
+Timer for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epTimer.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+volatile LONG Timer::m_lastTimerId=TIMER_ID_NONE;
+
+Timer::Timer(TimerCallbackInterface *callBackObj,EventLoop *eventLoop,epl::SmartObject *owner,epl::LockPolicy lockPolicyType):epl::SmartObject(lockPolicyType),EventLoopCallbackInterface()
+{
+	EP_ASSERT(callBackObj && eventLoop);
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_timerLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_timerLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_timerLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_timerLock=NULL;
+		break;
+	}
+	m_callBackObj=callBackObj;
+	m_eventLoop=eventLoop;
+	m_owner=owner;
+	do{
+		m_timerId=(unsigned int)InterlockedIncrement(&m_lastTimerId);
+	}while(m_timerId==TIMER_ID_NONE);
+
+	m_delayMilliSec=0;
+	m_periodMilliSec=0;
+	m_isScheduled=false;
+	m_generation=0;
+	m_linkedGeneration=0;
+
+	m_timerContext.m_callBackObj=this;
+	m_requestContext.m_callBackObj=this;
+	m_isRequestPending=0;
+}
+
+Timer::~Timer()
+{
+	if(m_timerLock)
+		EP_DELETE m_timerLock;
+	m_timerLock=NULL;
+}
+
+unsigned int Timer::GetTimerId() const
+{
+	return m_timerId;
+}
+
+unsigned int Timer::GetPeriod() const
+{
+	epl::LockObj lock(m_timerLock);
+	return m_periodMilliSec;
+}
+
+bool Timer::IsScheduled() const
+{
+	epl::LockObj lock(m_timerLock);
+	return m_isScheduled;
+}
+
+bool Timer::Schedule(unsigned int delayMilliSec,unsigned int periodMilliSec)
+{
+	m_timerLock->Lock();
+	m_delayMilliSec=delayMilliSec;
+	m_periodMilliSec=periodMilliSec;
+	m_isScheduled=true;
+	m_generation++;
+	unsigned int generation=m_generation;
+	m_timerLock->Unlock();
+
+	// the Event Loop lock must not be taken while holding the timer lock
+	if(postRequest())
+		return true;
+
+	epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Failed to schedule the timer\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+	m_timerLock->Lock();
+	if(m_generation==generation)
+		m_isScheduled=false;
+	m_timerLock->Unlock();
+	return false;
+}
+
+void Timer::Cancel()
+{
+	m_timerLock->Lock();
+	if(!m_isScheduled)
+	{
+		m_timerLock->Unlock();
+		return;
+	}
+	m_isScheduled=false;
+	m_generation++;
+	m_timerLock->Unlock();
+
+	// if failed, the Event Loop is stopped and the timer is already released.
+	postRequest();
+}
+
+bool Timer::postRequest()
+{
+	if(InterlockedCompareExchange(&m_isRequestPending,1,0)!=0)
+		return true;
+
+	// the reference is released when the request is handled.
+	retain();
+	m_requestContext.Reset();
+	if(m_eventLoop->Post(&m_requestContext))
+		return true;
+	InterlockedExchange(&m_isRequestPending,0);
+	release();
+	return false;
+}
+
+void Timer::OnIoCompleted(IoContext *context,unsigned int transferredByte,bool isSucceeded)
+{
+	EP_ASSERT(context==&m_requestContext);
+	// clear the flag first, so the request made while applying posts a new request
+	InterlockedExchange(&m_isRequestPending,0);
+
+	m_timerLock->Lock();
+	// the reference of the request, and of the timer unlinked
+	unsigned int releaseCount=1;
+	if(m_eventLoop->RemoveTimer(&m_timerContext))
+		releaseCount++;
+	if(m_isScheduled)
+	{
+		m_eventLoop->AddTimer(&m_timerContext,m_delayMilliSec);
+		m_linkedGeneration=m_generation;
+		releaseCount--;
+	}
+	m_timerLock->Unlock();
+
+	for(unsigned int trav=0;trav<releaseCount;trav++)
+		release();
+}
+
+void Timer::OnTimerExpired(TimerContext *context,bool isSucceeded)
+{
+	EP_ASSERT(context==&m_timerContext);
+	m_timerLock->Lock();
+	// the timer rescheduled or cancelled is applied by the request pending
+	bool isFired=(isSucceeded && m_isScheduled && m_linkedGeneration==m_generation);
+	bool isRelinked=false;
+	if(isFired)
+	{
+		if(m_periodMilliSec)
+		{
+			m_eventLoop->AddTimer(&m_timerContext,m_periodMilliSec);
+			isRelinked=true;
+		}
+		else
+		{
+			m_isScheduled=false;
+		}
+	}
+	m_timerLock->Unlock();
+
+	if(isFired)
+		m_callBackObj->OnTimer(this);
+
+	// release the reference held while linked
+	if(!isRelinked)
+		release();
+}
+
+void Timer::retain()
+{
+	RetainObj();
+	if(m_owner)
+		m_owner->RetainObj();
+}
+
+void Timer::release()
+{
+	if(m_owner)
+		m_owner->ReleaseObj();
+	ReleaseObj();
+}
\ No newline at end of file
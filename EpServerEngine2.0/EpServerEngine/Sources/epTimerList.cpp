@@ -0,0 +1,120 @@
+/*! 
+TimerList for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epTimerList.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+TimerList::TimerList(epl::LockPolicy lockPolicyType)
+{
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_listLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_listLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_listLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_listLock=NULL;
+		break;
+	}
+}
+
+TimerList::~TimerList()
+{
+	Clear();
+	if(m_listLock)
+		EP_DELETE m_listLock;
+	m_listLock=NULL;
+}
+
+unsigned int TimerList::Schedule(TimerCallbackInterface *callBackObj,EventLoop *eventLoop,unsigned int delayMilliSec,unsigned int periodMilliSec)
+{
+	if(!eventLoop)
+		return TIMER_ID_NONE;
+	Timer *timer=EP_NEW Timer(callBackObj,eventLoop,NULL,m_lockPolicy);
+	unsigned int timerId=timer->GetTimerId();
+
+	// in the list before scheduled, since it can expire right away
+	m_listLock->Lock();
+	m_timerMap[timerId]=timer;
+	m_listLock->Unlock();
+
+	if(timer->Schedule(delayMilliSec,periodMilliSec))
+		return timerId;
+	Cancel(timerId);
+	return TIMER_ID_NONE;
+}
+
+bool TimerList::Cancel(unsigned int timerId)
+{
+	m_listLock->Lock();
+	map<unsigned int,Timer*>::iterator iter=m_timerMap.find(timerId);
+	if(iter==m_timerMap.end())
+	{
+		m_listLock->Unlock();
+		return false;
+	}
+	Timer *timer=iter->second;
+	m_timerMap.erase(iter);
+	m_listLock->Unlock();
+
+	timer->Cancel();
+	timer->ReleaseObj();
+	return true;
+}
+
+void TimerList::Clear()
+{
+	m_listLock->Lock();
+	map<unsigned int,Timer*> timerMap;
+	timerMap.swap(m_timerMap);
+	m_listLock->Unlock();
+
+	map<unsigned int,Timer*>::iterator iter;
+	for(iter=timerMap.begin();iter!=timerMap.end();iter++)
+	{
+		iter->second->Cancel();
+		iter->second->ReleaseObj();
+	}
+}
+
+size_t TimerList::Count() const
+{
+	epl::LockObj lock(m_listLock);
+	return m_timerMap.size();
+}
\ No newline at end of file
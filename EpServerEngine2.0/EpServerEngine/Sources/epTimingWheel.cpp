@@ -0,0 +1,188 @@
+/*! 
+TimingWheel for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epTimingWheel.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+TimingWheel::TimingWheel()
+{
+	for(unsigned int level=0;level<TIMING_WHEEL_LEVEL_COUNT;level++)
+	{
+		for(unsigned int slotIdx=0;slotIdx<TIMING_WHEEL_SLOT_COUNT;slotIdx++)
+		{
+			InitList(m_slotList[level][slotIdx]);
+		}
+	}
+	m_currentTick=0;
+	m_timerCount=0;
+}
+
+TimingWheel::~TimingWheel()
+{
+	TimerContext list;
+	InitList(list);
+	Clear(list);
+	while(PopList(list)!=NULL){}
+}
+
+void TimingWheel::InitList(TimerContext &list)
+{
+	list.m_prev=&list;
+	list.m_next=&list;
+}
+
+TimerContext *TimingWheel::PopList(TimerContext &list)
+{
+	TimerContext *context=list.m_next;
+	if(context==&list)
+		return NULL;
+	list.m_next=context->m_next;
+	context->m_next->m_prev=&list;
+	context->m_prev=NULL;
+	context->m_next=NULL;
+	return context;
+}
+
+void TimingWheel::spliceList(TimerContext &slot,TimerContext &list)
+{
+	if(slot.m_next==&slot)
+		return;
+	slot.m_next->m_prev=list.m_prev;
+	list.m_prev->m_next=slot.m_next;
+	slot.m_prev->m_next=&list;
+	list.m_prev=slot.m_prev;
+	InitList(slot);
+}
+
+void TimingWheel::Add(TimerContext *context,unsigned int delayMilliSec)
+{
+	EP_ASSERT(context && !context->IsLinked());
+	unsigned int delayTick=(delayMilliSec+TIMING_WHEEL_TICK_MILLISEC-1)/TIMING_WHEEL_TICK_MILLISEC;
+	// never expire in the slot being processed
+	if(delayTick==0)
+		delayTick=1;
+	context->m_expireTick=m_currentTick+delayTick;
+	link(context);
+	m_timerCount++;
+}
+
+bool TimingWheel::Remove(TimerContext *context)
+{
+	if(!context->IsLinked())
+		return false;
+	context->m_prev->m_next=context->m_next;
+	context->m_next->m_prev=context->m_prev;
+	context->m_prev=NULL;
+	context->m_next=NULL;
+	m_timerCount--;
+	return true;
+}
+
+void TimingWheel::link(TimerContext *context)
+{
+	unsigned int remainTick=context->m_expireTick-m_currentTick;
+	unsigned int level=0;
+	while(level<TIMING_WHEEL_LEVEL_COUNT-1 && remainTick>=(1U<<(TIMING_WHEEL_SLOT_BITS*(level+1))))
+		level++;
+	unsigned int slotIdx=(context->m_expireTick>>(TIMING_WHEEL_SLOT_BITS*level))&TIMING_WHEEL_SLOT_MASK;
+	TimerContext &slot=m_slotList[level][slotIdx];
+	context->m_prev=slot.m_prev;
+	context->m_next=&slot;
+	slot.m_prev->m_next=context;
+	slot.m_prev=context;
+}
+
+void TimingWheel::cascade(unsigned int level,unsigned int slotIdx)
+{
+	TimerContext list;
+	InitList(list);
+	spliceList(m_slotList[level][slotIdx],list);
+	TimerContext *context;
+	while((context=PopList(list))!=NULL)
+		link(context);
+}
+
+void TimingWheel::Advance(unsigned int tickCount,TimerContext &expiredList)
+{
+	// nothing to expire or cascade
+	if(m_timerCount==0)
+	{
+		m_currentTick+=tickCount;
+		return;
+	}
+
+	for(unsigned int trav=0;trav<tickCount;trav++)
+	{
+		if(m_timerCount==0)
+		{
+			m_currentTick+=tickCount-trav;
+			break;
+		}
+		m_currentTick++;
+		// cascade the upper levels when the lower level wraps around
+		for(unsigned int level=1;level<TIMING_WHEEL_LEVEL_COUNT;level++)
+		{
+			if(((m_currentTick>>(TIMING_WHEEL_SLOT_BITS*(level-1)))&TIMING_WHEEL_SLOT_MASK)!=0)
+				break;
+			cascade(level,(m_currentTick>>(TIMING_WHEEL_SLOT_BITS*level))&TIMING_WHEEL_SLOT_MASK);
+		}
+
+		TimerContext &slot=m_slotList[0][m_currentTick&TIMING_WHEEL_SLOT_MASK];
+		while(slot.m_next!=&slot)
+		{
+			TimerContext *context=slot.m_next;
+			Remove(context);
+			context->m_prev=expiredList.m_prev;
+			context->m_next=&expiredList;
+			expiredList.m_prev->m_next=context;
+			expiredList.m_prev=context;
+		}
+	}
+}
+
+void TimingWheel::Clear(TimerContext &expiredList)
+{
+	for(unsigned int level=0;level<TIMING_WHEEL_LEVEL_COUNT;level++)
+	{
+		for(unsigned int slotIdx=0;slotIdx<TIMING_WHEEL_SLOT_COUNT;slotIdx++)
+		{
+			spliceList(m_slotList[level][slotIdx],expiredList);
+		}
+	}
+	m_timerCount=0;
+}
+
+bool TimingWheel::IsEmpty() const
+{
+	return (m_timerCount==0);
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+/*! 
+UdpFragmentSession for the EpServerEngine
+
+
+The MIT License (MIT)
+
+Copyright (c) 2012-2013 Woong Gyu La <juhgiyo@gmail.com>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include "epUdpFragmentSession.h"
+
+#if defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif // defined(_DEBUG) && defined(EP_ENABLE_CRTDBG)
+
+using namespace epse;
+
+/*!
+Write the 16-bit value in the network byte order
+@param[out] buffer the buffer to write into
+@param[in] value the value to write
+*/
+static void writeShort(char *buffer,unsigned int value)
+{
+	u_short netValue=htons(static_cast<u_short>(value));
+	epl::System::Memcpy(buffer,&netValue,sizeof(u_short));
+}
+
+/*!
+Read the 16-bit value in the network byte order
+@param[in] buffer the buffer to read from
+@return the value read
+*/
+static unsigned int readShort(const char *buffer)
+{
+	u_short netValue;
+	epl::System::Memcpy(&netValue,buffer,sizeof(u_short));
+	return ntohs(netValue);
+}
+
+/*!
+Write the 32-bit value in the network byte order
+@param[out] buffer the buffer to write into
+@param[in] value the value to write
+*/
+static void writeLong(char *buffer,unsigned int value)
+{
+	u_long netValue=htonl(value);
+	epl::System::Memcpy(buffer,&netValue,sizeof(u_long));
+}
+
+/*!
+Read the 32-bit value in the network byte order
+@param[in] buffer the buffer to read from
+@return the value read
+*/
+static unsigned int readLong(const char *buffer)
+{
+	u_long netValue;
+	epl::System::Memcpy(&netValue,buffer,sizeof(u_long));
+	return ntohl(netValue);
+}
+
+UdpFragmentSession::UdpFragmentSession(DatagramSenderInterface *sender,unsigned int maxDatagramByteSize,epl::LockPolicy lockPolicyType)
+{
+	EP_ASSERT(sender);
+	m_lockPolicy=lockPolicyType;
+	switch(lockPolicyType)
+	{
+	case epl::LOCK_POLICY_CRITICALSECTION:
+		m_sessionLock=EP_NEW epl::CriticalSectionEx();
+		break;
+	case epl::LOCK_POLICY_MUTEX:
+		m_sessionLock=EP_NEW epl::Mutex();
+		break;
+	case epl::LOCK_POLICY_NONE:
+		m_sessionLock=EP_NEW epl::NoLock();
+		break;
+	default:
+		m_sessionLock=NULL;
+		break;
+	}
+	m_sender=sender;
+	m_maxDatagramByteSize=maxDatagramByteSize;
+	m_nextMessageId=0;
+	m_reassemblyByteSize=0;
+	m_sendBuffer=NULL;
+}
+
+UdpFragmentSession::~UdpFragmentSession()
+{
+	m_sessionLock->Lock();
+	deleteReassemblies();
+	if(m_sendBuffer)
+		EP_DELETE[] m_sendBuffer;
+	m_sendBuffer=NULL;
+	m_sessionLock->Unlock();
+
+	if(m_sessionLock)
+		EP_DELETE m_sessionLock;
+	m_sessionLock=NULL;
+}
+
+void UdpFragmentSession::Reset()
+{
+	epl::LockObj lock(m_sessionLock);
+	deleteReassemblies();
+}
+
+void UdpFragmentSession::SetMaxDatagramByteSize(unsigned int maxDatagramByteSize)
+{
+	epl::LockObj lock(m_sessionLock);
+	if(m_maxDatagramByteSize==maxDatagramByteSize)
+		return;
+	m_maxDatagramByteSize=maxDatagramByteSize;
+	// reallocated with the new size by the next send
+	if(m_sendBuffer)
+		EP_DELETE[] m_sendBuffer;
+	m_sendBuffer=NULL;
+}
+
+unsigned int UdpFragmentSession::GetReassemblyByteSize() const
+{
+	return m_reassemblyByteSize;
+}
+
+int UdpFragmentSession::SendDatagram(const Packet &packet,SendStatus *sendStatus)
+{
+	unsigned int byteSize=packet.GetPacketByteSize();
+	const char *packetData=packet.GetPacket();
+
+	epl::LockObj lock(m_sessionLock);
+	if(byteSize==0 || byteSize>UDP_FRAGMENT_MESSAGE_BYTE_SIZE_MAX || m_maxDatagramByteSize<=UDP_FRAGMENT_HEADER_BYTE_SIZE)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+	if(!m_sendBuffer)
+		m_sendBuffer=EP_NEW char[m_maxDatagramByteSize];
+
+	if(byteSize+UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE<=m_maxDatagramByteSize)
+	{
+		m_sendBuffer[0]=UDP_FRAGMENT_HEADER_TYPE_WHOLE;
+		epl::System::Memcpy(m_sendBuffer+UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE,packetData,byteSize);
+		Packet datagram(m_sendBuffer,byteSize+UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE,false);
+		int sentLength=m_sender->SendDatagram(datagram,sendStatus);
+		if(sentLength<=0)
+			return sentLength;
+		return static_cast<int>(byteSize);
+	}
+
+	unsigned int fragmentByteSize=m_maxDatagramByteSize-UDP_FRAGMENT_HEADER_BYTE_SIZE;
+	if(fragmentByteSize>0xffff)
+		fragmentByteSize=0xffff;
+	unsigned int fragmentCount=(byteSize+fragmentByteSize-1)/fragmentByteSize;
+	if(fragmentCount>UDP_FRAGMENT_COUNT_MAX)
+	{
+		if(sendStatus)
+			*sendStatus=SEND_STATUS_FAIL_SEND_FAILED;
+		return -1;
+	}
+
+	unsigned int messageId=m_nextMessageId++;
+	m_sendBuffer[0]=UDP_FRAGMENT_HEADER_TYPE_FRAGMENT;
+	m_sendBuffer[1]=0;
+	writeShort(m_sendBuffer+4,fragmentByteSize);
+	writeLong(m_sendBuffer+6,messageId);
+	writeLong(m_sendBuffer+10,byteSize);
+	for(unsigned int fragmentIdx=0;fragmentIdx<fragmentCount;fragmentIdx++)
+	{
+		unsigned int offset=fragmentIdx*fragmentByteSize;
+		unsigned int sendByteSize=fragmentByteSize;
+		if(byteSize-offset<sendByteSize)
+			sendByteSize=byteSize-offset;
+		writeShort(m_sendBuffer+2,fragmentIdx);
+		epl::System::Memcpy(m_sendBuffer+UDP_FRAGMENT_HEADER_BYTE_SIZE,packetData+offset,sendByteSize);
+		Packet datagram(m_sendBuffer,sendByteSize+UDP_FRAGMENT_HEADER_BYTE_SIZE,false);
+		int sentLength=m_sender->SendDatagram(datagram,sendStatus);
+		// the receiver drops the rest after the time-out
+		if(sentLength<=0)
+			return sentLength;
+	}
+	if(sendStatus)
+		*sendStatus=SEND_STATUS_SUCCESS;
+	return static_cast<int>(byteSize);
+}
+
+Packet *UdpFragmentSession::Receive(const Packet &datagram)
+{
+	unsigned int byteSize=datagram.GetPacketByteSize();
+	const char *datagramData=datagram.GetPacket();
+	if(byteSize<=UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE)
+		return NULL;
+	if(datagramData[0]==UDP_FRAGMENT_HEADER_TYPE_WHOLE)
+		return EP_NEW Packet(datagram,UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE,byteSize-UDP_FRAGMENT_WHOLE_HEADER_BYTE_SIZE);
+	if(datagramData[0]!=UDP_FRAGMENT_HEADER_TYPE_FRAGMENT || byteSize<=UDP_FRAGMENT_HEADER_BYTE_SIZE)
+		return NULL;
+
+	unsigned int fragmentIdx=readShort(datagramData+2);
+	unsigned int fragmentByteSize=readShort(datagramData+4);
+	unsigned int messageId=readLong(datagramData+6);
+	unsigned int packetByteSize=readLong(datagramData+10);
+	if(fragmentByteSize==0 || packetByteSize<=fragmentByteSize || packetByteSize>UDP_FRAGMENT_MESSAGE_BYTE_SIZE_MAX)
+		return NULL;
+	unsigned int fragmentCount=(packetByteSize+fragmentByteSize-1)/fragmentByteSize;
+	unsigned int offset=fragmentIdx*fragmentByteSize;
+	if(fragmentCount>UDP_FRAGMENT_COUNT_MAX || fragmentIdx>=fragmentCount)
+		return NULL;
+	// every fragment but the last is of the fragment byte size
+	unsigned int receivedByteSize=byteSize-UDP_FRAGMENT_HEADER_BYTE_SIZE;
+	unsigned int expectedByteSize=fragmentByteSize;
+	if(packetByteSize-offset<expectedByteSize)
+		expectedByteSize=packetByteSize-offset;
+	if(receivedByteSize!=expectedByteSize)
+		return NULL;
+
+	epl::LockObj lock(m_sessionLock);
+	expireReassemblies(GetTickCount());
+
+	Reassembly *reassembly=NULL;
+	map<unsigned int,list<Reassembly*>::iterator>::iterator mapIter=m_reassemblyMap.find(messageId);
+	if(mapIter!=m_reassemblyMap.end())
+	{
+		reassembly=*(mapIter->second);
+		if(reassembly->m_fragmentByteSize!=fragmentByteSize || reassembly->m_packet->GetPacketByteSize()!=packetByteSize)
+			return NULL;
+	}
+	else
+	{
+		if(!reserveReassembly(packetByteSize))
+			return NULL;
+		reassembly=EP_NEW Reassembly();
+		reassembly->m_messageId=messageId;
+		reassembly->m_packet=EP_NEW Packet(NULL,packetByteSize,true,m_lockPolicy);
+		reassembly->m_fragmentByteSize=fragmentByteSize;
+		reassembly->m_fragmentCount=fragmentCount;
+		reassembly->m_receivedCount=0;
+		reassembly->m_isReceivedList.resize(fragmentCount,false);
+		reassembly->m_startTime=GetTickCount();
+		m_reassemblyList.push_back(reassembly);
+		list<Reassembly*>::iterator listIter=m_reassemblyList.end();
+		listIter--;
+		mapIter=m_reassemblyMap.insert(pair<unsigned int,list<Reassembly*>::iterator>(messageId,listIter)).first;
+		m_reassemblyByteSize+=packetByteSize;
+	}
+
+	if(reassembly->m_isReceivedList[fragmentIdx])
+		return NULL;
+	// straight into the final offset, so the packet complete is delivered as it is
+	epl::System::Memcpy(const_cast<char*>(reassembly->m_packet->GetPacket())+offset,datagramData+UDP_FRAGMENT_HEADER_BYTE_SIZE,receivedByteSize);
+	reassembly->m_isReceivedList[fragmentIdx]=true;
+	reassembly->m_receivedCount++;
+	if(reassembly->m_receivedCount<reassembly->m_fragmentCount)
+		return NULL;
+
+	Packet *retPacket=reassembly->m_packet;
+	retPacket->RetainObj();
+	dropReassembly(mapIter->second);
+	return retPacket;
+}
+
+void UdpFragmentSession::expireReassemblies(unsigned int currentTime)
+{
+	// the oldest is always at the front
+	while(!m_reassemblyList.empty() && currentTime-m_reassemblyList.front()->m_startTime>=UDP_REASSEMBLY_TIMEOUT_MILLISEC)
+	{
+		epl::System::OutputDebugString(_T("%s::%s(%d)(%x) Reassembly timed out...\r\n"),__TFILE__,__TFUNCTION__,__LINE__,this);
+		dropReassembly(m_reassemblyList.begin());
+	}
+}
+
+bool UdpFragmentSession::reserveReassembly(unsigned int byteSize)
+{
+	if(byteSize>UDP_REASSEMBLY_BYTE_SIZE_MAX)
+		return false;
+	while(!m_reassemblyList.empty() && m_reassemblyByteSize+byteSize>UDP_REASSEMBLY_BYTE_SIZE_MAX)
+	{
+		dropReassembly(m_reassemblyList.begin());
+	}
+	return true;
+}
+
+void UdpFragmentSession::dropReassembly(list<Reassembly*>::iterator iter)
+{
+	Reassembly *reassembly=*iter;
+	m_reassemblyByteSize-=reassembly->m_packet->GetPacketByteSize();
+	m_reassemblyMap.erase(reassembly->m_messageId);
+	m_reassemblyList.erase(iter);
+	reassembly->m_packet->ReleaseObj();
+	EP_DELETE reassembly;
+}
+
+void UdpFragmentSession::deleteReassemblies()
+{
+	while(!m_reassemblyList.empty())
+	{
+		dropReassembly(m_reassemblyList.begin());
+	}
+}
\ No newline at end of file